@@ -83,6 +83,12 @@ class AsyncRowReader : public std::enable_shared_from_this<
         std::move(row_set), rows_limit, std::move(filter),
         std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
         std::move(metadata_update_policy), std::move(parser_factory)));
+    if (res->row_set_.IsEmpty()) {
+      // There is nothing to read, e.g., when resuming a completed scan.
+      res->whole_op_finished_ = true;
+      res->cq_.RunAsync([res] { res->TryGiveRowToUser(); });
+      return res;
+    }
     res->MakeRequest();
     return res;
   }
@@ -106,9 +106,7 @@ class Benchmark {
    *
    * Return 0 if there is no embedded server, or the value from the
    * corresponding embedded server counter.  This class is tested largely by
-   * observing how many calls it makes on the embedded server.  Because the
-   * embedded server has no memory, that is the only observable effect when
-   * unit testing the class.
+   * observing how many calls it makes on the embedded server.
    */
   int create_table_count() const;
   int delete_table_count() const;
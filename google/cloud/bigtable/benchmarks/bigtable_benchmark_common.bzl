@@ -20,6 +20,8 @@ bigtable_benchmark_common_hdrs = [
     "benchmark.h",
     "constants.h",
     "embedded_server.h",
+    "in_memory_table.h",
+    "latency_histogram.h",
     "random_mutation.h",
     "setup.h",
 ]
@@ -27,6 +29,8 @@ bigtable_benchmark_common_hdrs = [
 bigtable_benchmark_common_srcs = [
     "benchmark.cc",
     "embedded_server.cc",
+    "in_memory_table.cc",
+    "latency_histogram.cc",
     "random_mutation.cc",
     "setup.cc",
 ]
@@ -19,6 +19,8 @@
 bigtable_benchmark_programs = [
     "apply_read_latency_benchmark.cc",
     "endurance_benchmark.cc",
+    "mutation_batcher_benchmark.cc",
+    "open_loop_benchmark.cc",
     "read_sync_vs_async_benchmark.cc",
     "scan_throughput_benchmark.cc",
 ]
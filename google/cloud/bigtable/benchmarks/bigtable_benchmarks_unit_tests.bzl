@@ -20,6 +20,8 @@ bigtable_benchmarks_unit_tests = [
     "bigtable_benchmark_test.cc",
     "embedded_server_test.cc",
     "format_duration_test.cc",
+    "in_memory_table_test.cc",
+    "latency_histogram_test.cc",
     "random_mutation_test.cc",
     "setup_test.cc",
 ]
@@ -13,13 +13,14 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/benchmarks/embedded_server.h"
-#include "google/cloud/bigtable/benchmarks/random_mutation.h"
-#include "google/cloud/bigtable/benchmarks/setup.h"
+#include "google/cloud/bigtable/benchmarks/in_memory_table.h"
+#include "google/cloud/internal/random.h"
 #include <google/bigtable/admin/v2/bigtable_table_admin.grpc.pb.h>
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
 #include <atomic>
-#include <iomanip>
-#include <sstream>
+#include <map>
+#include <mutex>
+#include <thread>
 
 namespace btproto = google::bigtable::v2;
 namespace btadmin = google::bigtable::admin::v2;
@@ -28,131 +29,299 @@ namespace google {
 namespace cloud {
 namespace bigtable {
 namespace benchmarks {
+namespace {
 /**
- * Implement the portions of the `google.bigtable.v2.Bigtable` interface
- * necessary for the benchmarks.
+ * The state shared by the data and admin services.
  *
- * This is not a Mock (use `google::bigtable::v2::MockBigtableStub` for that,
- * nor is this a Fake implementation (use the Cloud Bigtable Emulator for that),
- * this is an implementation of the interface that returns hardcoded values.
- * It is suitable for the benchmarks, but for nothing else.
+ * The tables are indexed by their full name, e.g.
+ * `projects/p/instances/i/tables/t`.  The services also share the
+ * configuration and a source of randomness for the error injection.
+ */
+class ServerState {
+ public:
+  explicit ServerState(EmbeddedServerOptions options)
+      : options_(std::move(options)),
+        generator_(google::cloud::internal::MakeDefaultPRNG()) {}
+
+  EmbeddedServerOptions const& options() const { return options_; }
+
+  grpc::Status CreateTable(std::string const& name,
+                           std::set<std::string> column_families) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto ins = tables_.emplace(name, nullptr);
+    if (!ins.second) {
+      return grpc::Status(grpc::StatusCode::ALREADY_EXISTS,
+                          "table " + name + " already exists");
+    }
+    ins.first->second =
+        std::make_shared<InMemoryTable>(std::move(column_families));
+    return grpc::Status::OK;
+  }
+
+  grpc::Status DeleteTable(std::string const& name) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (tables_.erase(name) == 0) {
+      return grpc::Status(grpc::StatusCode::NOT_FOUND,
+                          "table " + name + " not found");
+    }
+    return grpc::Status::OK;
+  }
+
+  /// Return the table called @p name, or `nullptr` (and @p status) on error.
+  std::shared_ptr<InMemoryTable> GetTable(std::string const& name,
+                                          grpc::Status& status) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto loc = tables_.find(name);
+    if (loc == tables_.end()) {
+      status = grpc::Status(grpc::StatusCode::NOT_FOUND,
+                            "table " + name + " not found");
+      return nullptr;
+    }
+    return loc->second;
+  }
+
+  /**
+   * Simulate the latency and the transient failures of a real service.
+   *
+   * Every RPC calls this function before doing any work.
+   */
+  grpc::Status SimulateRpc() {
+    if (options_.latency.count() > 0) {
+      std::this_thread::sleep_for(options_.latency);
+    }
+    if (Fail(options_.rpc_error_rate)) {
+      return grpc::Status(grpc::StatusCode::UNAVAILABLE, "injected error");
+    }
+    return grpc::Status::OK;
+  }
+
+  /// Return true with probability @p rate.
+  bool Fail(double rate) {
+    if (rate <= 0.0) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lk(mu_);
+    return std::uniform_real_distribution<double>(0, 1)(generator_) < rate;
+  }
+
+  /// Create a new generator, seeded from the shared one.
+  google::cloud::internal::DefaultPRNG MakeGenerator() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return google::cloud::internal::DefaultPRNG(generator_());
+  }
+
+ private:
+  EmbeddedServerOptions const options_;
+  std::mutex mu_;
+  google::cloud::internal::DefaultPRNG generator_;
+  std::map<std::string, std::shared_ptr<InMemoryTable>> tables_;
+};
+
+/**
+ * Implement the `google.bigtable.v2.Bigtable` interface over in-memory tables.
+ *
+ * This is not a Mock (use `google::bigtable::v2::MockBigtableStub` for that),
+ * it is a (simplified) emulator: the data written by the benchmarks is stored
+ * and can be read back with the same filtering and chunking behavior as the
+ * service. It is suitable for benchmarks, where the Cloud Bigtable Emulator
+ * would introduce too much overhead and variation.
  */
 class BigtableImpl final : public btproto::Bigtable::Service {
  public:
-  BigtableImpl()
-      : mutate_row_count_(0), mutate_rows_count_(0), read_rows_count_(0) {
-    // Prepare a list of random values to use at run-time.  This is because we
-    // want the overhead of this implementation to be as small as possible.
-    // Using a single value is an option, but compresses too well and makes the
-    // tests a bit unrealistic.
-    auto generator = google::cloud::internal::MakeDefaultPRNG();
-    values_.resize(1000);
-    std::generate(values_.begin(), values_.end(),
-                  [&generator]() { return MakeRandomValue(generator); });
-  }
-
-  grpc::Status MutateRow(grpc::ServerContext*, btproto::MutateRowRequest const*,
+  explicit BigtableImpl(std::shared_ptr<ServerState> state)
+      : state_(std::move(state)),
+        mutate_row_count_(0),
+        mutate_rows_count_(0),
+        read_rows_count_(0),
+        check_and_mutate_row_count_(0),
+        read_modify_write_row_count_(0),
+        sample_row_keys_count_(0) {}
+
+  grpc::Status MutateRow(grpc::ServerContext*,
+                         btproto::MutateRowRequest const* request,
                          btproto::MutateRowResponse*) override {
     ++mutate_row_count_;
-    return grpc::Status::OK;
+    auto status = state_->SimulateRpc();
+    if (!status.ok()) return status;
+    auto table = state_->GetTable(request->table_name(), status);
+    if (!table) return status;
+    return table->MutateRow(request->row_key(), request->mutations());
   }
 
   grpc::Status MutateRows(
       grpc::ServerContext*, btproto::MutateRowsRequest const* request,
       grpc::ServerWriter<btproto::MutateRowsResponse>* writer) override {
     ++mutate_rows_count_;
+    auto status = state_->SimulateRpc();
+    if (!status.ok()) return status;
+    auto table = state_->GetTable(request->table_name(), status);
+    if (!table) return status;
+
+    auto const error_rate = state_->options().mutation_error_rate;
     btproto::MutateRowsResponse msg;
     for (int index = 0; index != request->entries_size(); ++index) {
+      auto const& request_entry = request->entries(index);
       auto& entry = *msg.add_entries();
       entry.set_index(index);
-      entry.mutable_status()->set_code(grpc::StatusCode::OK);
+      if (state_->Fail(error_rate)) {
+        entry.mutable_status()->set_code(grpc::StatusCode::UNAVAILABLE);
+        entry.mutable_status()->set_message("injected error");
+        continue;
+      }
+      auto s =
+          table->MutateRow(request_entry.row_key(), request_entry.mutations());
+      entry.mutable_status()->set_code(s.error_code());
+      entry.mutable_status()->set_message(s.error_message());
     }
     writer->WriteLast(msg, grpc::WriteOptions());
     return grpc::Status::OK;
   }
 
   grpc::Status ReadRows(
-      grpc::ServerContext*, btproto::ReadRowsRequest const* request,
+      grpc::ServerContext* context, btproto::ReadRowsRequest const* request,
       grpc::ServerWriter<btproto::ReadRowsResponse>* writer) override {
     ++read_rows_count_;
-    std::int64_t rows_limit = 10000;
-    if (request->rows_limit() != 0) {
-      rows_limit = request->rows_limit();
-    }
+    auto status = state_->SimulateRpc();
+    if (!status.ok()) return status;
+    auto table = state_->GetTable(request->table_name(), status);
+    if (!table) return status;
 
+    auto const& options = state_->options();
+    auto generator = state_->MakeGenerator();
     btproto::ReadRowsResponse msg;
-    for (std::int64_t i = 0; i != rows_limit; ++i) {
-      std::size_t idx = 0;
-      char const* cf = kColumnFamily;
-      std::ostringstream os;
-      os << "user" << std::setw(12) << std::setfill('0') << i;
-      std::string row_key = os.str();
-      for (int j = 0; j != kNumFields; ++j) {
-        auto& chunk = *msg.add_chunks();
-        // This is neither the real format of the keys, nor the keys requested,
-        // but it is good enough for a simulation.
-        chunk.set_row_key(row_key);
-        chunk.set_timestamp_micros(0);
-        chunk.mutable_family_name()->set_value(cf);
-        chunk.mutable_qualifier()->set_value("field" + std::to_string(j));
-        chunk.set_value(values_[idx]);
-        chunk.set_value_size(static_cast<std::int32_t>(values_[idx].size()));
-        if (++idx >= values_.size()) {
-          idx = 0;
-        }
-        cf = "";
-        if (j == kNumFields - 1) {
-          chunk.set_value_size(0);
-          chunk.set_commit_row(true);
-        }
-      }
-      if (i != request->rows_limit() - 1) {
-        writer->Write(msg);
-        msg = {};
+    std::size_t msg_size = 0;
+    auto on_row = [&](std::string const& row_key,
+                      std::vector<InMemoryCell> cells) {
+      // Computing `ByteSizeLong()` for each row is too expensive, this is a
+      // good enough approximation to decide when to flush.
+      for (auto const& c : cells) {
+        msg_size += row_key.size() + c.qualifier.size() + c.value.size();
       }
+      AppendRowChunks(row_key, std::move(cells), options.max_chunk_size, msg);
+      if (msg_size < options.max_response_size) return true;
+      msg_size = 0;
+      if (!writer->Write(msg)) return false;
+      msg.Clear();
+      return !context->IsCancelled();
+    };
+    status = table->ReadRows(request->rows(), request->filter(),
+                             request->rows_limit(), generator, on_row);
+    if (!status.ok()) return status;
+    if (msg.chunks_size() != 0) {
+      writer->WriteLast(msg, grpc::WriteOptions());
+    }
+    return grpc::Status::OK;
+  }
+
+  grpc::Status CheckAndMutateRow(
+      grpc::ServerContext*, btproto::CheckAndMutateRowRequest const* request,
+      btproto::CheckAndMutateRowResponse* response) override {
+    ++check_and_mutate_row_count_;
+    auto status = state_->SimulateRpc();
+    if (!status.ok()) return status;
+    auto table = state_->GetTable(request->table_name(), status);
+    if (!table) return status;
+    auto generator = state_->MakeGenerator();
+    bool predicate_matched = false;
+    status = table->CheckAndMutateRow(*request, generator, predicate_matched);
+    response->set_predicate_matched(predicate_matched);
+    return status;
+  }
+
+  grpc::Status ReadModifyWriteRow(
+      grpc::ServerContext*, btproto::ReadModifyWriteRowRequest const* request,
+      btproto::ReadModifyWriteRowResponse* response) override {
+    ++read_modify_write_row_count_;
+    auto status = state_->SimulateRpc();
+    if (!status.ok()) return status;
+    auto table = state_->GetTable(request->table_name(), status);
+    if (!table) return status;
+    return table->ReadModifyWriteRow(*request, *response->mutable_row());
+  }
+
+  grpc::Status SampleRowKeys(
+      grpc::ServerContext*, btproto::SampleRowKeysRequest const* request,
+      grpc::ServerWriter<btproto::SampleRowKeysResponse>* writer) override {
+    ++sample_row_keys_count_;
+    auto status = state_->SimulateRpc();
+    if (!status.ok()) return status;
+    auto table = state_->GetTable(request->table_name(), status);
+    if (!table) return status;
+    auto samples =
+        table->SampleRowKeys(state_->options().sample_row_keys_interval);
+    for (auto const& s : samples) {
+      if (!writer->Write(s)) break;
     }
-    writer->WriteLast(msg, grpc::WriteOptions());
     return grpc::Status::OK;
   }
 
   int mutate_row_count() const { return mutate_row_count_.load(); }
   int mutate_rows_count() const { return mutate_rows_count_.load(); }
   int read_rows_count() const { return read_rows_count_.load(); }
+  int check_and_mutate_row_count() const {
+    return check_and_mutate_row_count_.load();
+  }
+  int read_modify_write_row_count() const {
+    return read_modify_write_row_count_.load();
+  }
+  int sample_row_keys_count() const { return sample_row_keys_count_.load(); }
 
  private:
-  std::vector<std::string> values_;
+  std::shared_ptr<ServerState> state_;
   std::atomic<int> mutate_row_count_;
   std::atomic<int> mutate_rows_count_;
   std::atomic<int> read_rows_count_;
+  std::atomic<int> check_and_mutate_row_count_;
+  std::atomic<int> read_modify_write_row_count_;
+  std::atomic<int> sample_row_keys_count_;
 };
 
 /**
  * Implement the `google.bigtable.admin.v2.BigtableTableAdmin` interface for the
  * benchmarks.
+ *
+ * Only creating and deleting tables is supported. The garbage collection rules
+ * and initial splits are ignored.
  */
 class TableAdminImpl final : public btadmin::BigtableTableAdmin::Service {
  public:
-  TableAdminImpl() : create_table_count_(0), delete_table_count_(0) {}
+  explicit TableAdminImpl(std::shared_ptr<ServerState> state)
+      : state_(std::move(state)),
+        create_table_count_(0),
+        delete_table_count_(0) {}
 
   grpc::Status CreateTable(grpc::ServerContext*,
                            btadmin::CreateTableRequest const* request,
                            btadmin::Table* response) override {
     ++create_table_count_;
-    response->set_name(request->parent() + "/tables/" + request->table_id());
+    auto status = state_->SimulateRpc();
+    if (!status.ok()) return status;
+    auto name = request->parent() + "/tables/" + request->table_id();
+    std::set<std::string> column_families;
+    for (auto const& kv : request->table().column_families()) {
+      column_families.insert(kv.first);
+    }
+    status = state_->CreateTable(name, std::move(column_families));
+    if (!status.ok()) return status;
+    *response = request->table();
+    response->set_name(std::move(name));
     return grpc::Status::OK;
   }
 
   grpc::Status DeleteTable(grpc::ServerContext*,
-                           btadmin::DeleteTableRequest const*,
+                           btadmin::DeleteTableRequest const* request,
                            ::google::protobuf::Empty*) override {
     ++delete_table_count_;
-    return grpc::Status::OK;
+    auto status = state_->SimulateRpc();
+    if (!status.ok()) return status;
+    return state_->DeleteTable(request->name());
   }
 
   int create_table_count() const { return create_table_count_.load(); }
   int delete_table_count() const { return delete_table_count_.load(); }
 
  private:
+  std::shared_ptr<ServerState> state_;
   std::atomic<int> create_table_count_;
   std::atomic<int> delete_table_count_;
 };
@@ -160,7 +329,10 @@ class TableAdminImpl final : public btadmin::BigtableTableAdmin::Service {
 /// The implementation of EmbeddedServer.
 class DefaultEmbeddedServer : public EmbeddedServer {
  public:
-  explicit DefaultEmbeddedServer() {
+  explicit DefaultEmbeddedServer(EmbeddedServerOptions options)
+      : state_(std::make_shared<ServerState>(std::move(options))),
+        bigtable_service_(state_),
+        admin_service_(state_) {
     int port;
     std::string server_address("[::]:0");
     builder_.AddListeningPort(server_address, grpc::InsecureServerCredentials(),
@@ -190,17 +362,34 @@ class DefaultEmbeddedServer : public EmbeddedServer {
   int read_rows_count() const override {
     return bigtable_service_.read_rows_count();
   }
+  int check_and_mutate_row_count() const override {
+    return bigtable_service_.check_and_mutate_row_count();
+  }
+  int read_modify_write_row_count() const override {
+    return bigtable_service_.read_modify_write_row_count();
+  }
+  int sample_row_keys_count() const override {
+    return bigtable_service_.sample_row_keys_count();
+  }
 
  private:
+  std::shared_ptr<ServerState> state_;
   BigtableImpl bigtable_service_;
   TableAdminImpl admin_service_;
   grpc::ServerBuilder builder_;
   std::unique_ptr<grpc::Server> server_;
   std::string address_;
 };
+}  // namespace
 
 std::unique_ptr<EmbeddedServer> CreateEmbeddedServer() {
-  return std::unique_ptr<EmbeddedServer>(new DefaultEmbeddedServer);
+  return CreateEmbeddedServer(EmbeddedServerOptions{});
+}
+
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(
+    EmbeddedServerOptions options) {
+  return std::unique_ptr<EmbeddedServer>(
+      new DefaultEmbeddedServer(std::move(options)));
 }
 
 }  // namespace benchmarks
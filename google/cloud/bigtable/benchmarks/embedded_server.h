@@ -15,6 +15,9 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_EMBEDDED_SERVER_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_EMBEDDED_SERVER_H
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -22,6 +25,33 @@ namespace google {
 namespace cloud {
 namespace bigtable {
 namespace benchmarks {
+/**
+ * Configure the behavior of the embedded server.
+ *
+ * The defaults produce a server without any artificial latency or errors,
+ * which is what most benchmarks need. Use the other values to simulate a more
+ * realistic (or adversarial) service.
+ */
+struct EmbeddedServerOptions {
+  /// Artificial latency added to each RPC before it is processed.
+  std::chrono::microseconds latency{0};
+
+  /// The probability that an RPC fails with `UNAVAILABLE`.
+  double rpc_error_rate = 0.0;
+
+  /// The probability that each `MutateRows()` entry fails with `UNAVAILABLE`.
+  double mutation_error_rate = 0.0;
+
+  /// Cell values larger than this are split across multiple chunks.
+  std::size_t max_chunk_size = 1024 * 1024;
+
+  /// `ReadRows()` flushes a response once it contains this many bytes.
+  std::size_t max_response_size = 64 * 1024;
+
+  /// The approximate distance (in bytes) between `SampleRowKeys()` samples.
+  std::int64_t sample_row_keys_interval = 16 * 1024 * 1024;
+};
+
 /**
  * An abstract class to run and stop the embedded Bigtable server.
  *
@@ -30,6 +60,10 @@ namespace benchmarks {
  * small changes to the library.  This class is used to run (using Wait()) and
  * stop (using Shutdown()) such a server, without exposing the implementation
  * details to the application.
+ *
+ * The server keeps the tables in memory (see `InMemoryTable`), so the data
+ * written by a benchmark can be read back, with the same filtering and
+ * chunking behavior as the service.
  */
 class EmbeddedServer {
  public:
@@ -44,11 +78,18 @@ class EmbeddedServer {
   virtual int mutate_row_count() const = 0;
   virtual int mutate_rows_count() const = 0;
   virtual int read_rows_count() const = 0;
+  virtual int check_and_mutate_row_count() const = 0;
+  virtual int read_modify_write_row_count() const = 0;
+  virtual int sample_row_keys_count() const = 0;
 };
 
 /// Create an embedded server.
 std::unique_ptr<EmbeddedServer> CreateEmbeddedServer();
 
+/// Create an embedded server configured by @p options.
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(
+    EmbeddedServerOptions options);
+
 }  // namespace benchmarks
 }  // namespace bigtable
 }  // namespace cloud
@@ -21,8 +21,35 @@
 
 namespace bigtable = google::cloud::bigtable;
 using bigtable::benchmarks::CreateEmbeddedServer;
+using bigtable::benchmarks::EmbeddedServer;
+using bigtable::benchmarks::EmbeddedServerOptions;
 using std::chrono::milliseconds;
 
+namespace {
+/// Create a table with a single column family ("fam") in @p server.
+void CreateTestTable(EmbeddedServer& server, std::string const& table_id) {
+  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
+  options.set_admin_endpoint(server.address());
+  bigtable::TableAdmin admin(
+      bigtable::CreateDefaultAdminClient("fake-project", options),
+      "fake-instance");
+  auto table = admin.CreateTable(
+      table_id,
+      bigtable::TableConfig({{"fam", bigtable::GcRule::MaxNumVersions(1)}},
+                            {}));
+  ASSERT_STATUS_OK(table);
+}
+
+bigtable::Table MakeTestTable(EmbeddedServer& server,
+                              std::string const& table_id) {
+  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
+  options.set_data_endpoint(server.address());
+  return bigtable::Table(bigtable::CreateDefaultDataClient(
+                             "fake-project", "fake-instance", options),
+                         table_id);
+}
+}  // namespace
+
 TEST(EmbeddedServer, WaitAndShutdown) {
   auto server = CreateEmbeddedServer();
   EXPECT_FALSE(server->address().empty());
@@ -47,12 +74,26 @@ TEST(EmbeddedServer, Admin) {
 
   auto gc = bigtable::GcRule::MaxNumVersions(42);
   EXPECT_EQ(0, server->create_table_count());
-  admin.CreateTable("fake-table-01", bigtable::TableConfig({{"fam", gc}}, {}));
+  auto table = admin.CreateTable("fake-table-01",
+                                 bigtable::TableConfig({{"fam", gc}}, {}));
+  ASSERT_STATUS_OK(table);
   EXPECT_EQ(1, server->create_table_count());
+  EXPECT_EQ(
+      "projects/fake-project/instances/fake-instance/tables/fake-table-01",
+      table->name());
+
+  table = admin.CreateTable("fake-table-01",
+                            bigtable::TableConfig({{"fam", gc}}, {}));
+  EXPECT_EQ(google::cloud::StatusCode::kAlreadyExists,
+            table.status().code());
+  EXPECT_EQ(2, server->create_table_count());
 
   EXPECT_EQ(0, server->delete_table_count());
-  admin.DeleteTable("fake-table-02");
+  EXPECT_STATUS_OK(admin.DeleteTable("fake-table-01"));
   EXPECT_EQ(1, server->delete_table_count());
+  EXPECT_EQ(google::cloud::StatusCode::kNotFound,
+            admin.DeleteTable("fake-table-02").code());
+  EXPECT_EQ(2, server->delete_table_count());
 
   server->Shutdown();
   wait_thread.join();
@@ -62,11 +103,8 @@ TEST(EmbeddedServer, TableApply) {
   auto server = CreateEmbeddedServer();
   std::thread wait_thread([&server]() { server->Wait(); });
 
-  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
-  options.set_data_endpoint(server->address());
-  bigtable::Table table(bigtable::CreateDefaultDataClient(
-                            "fake-project", "fake-instance", options),
-                        "fake-table");
+  CreateTestTable(*server, "fake-table");
+  auto table = MakeTestTable(*server, "fake-table");
 
   bigtable::SingleRowMutation mutation(
       "row1", {bigtable::SetCell("fam", "col", milliseconds(0), "val"),
@@ -85,11 +123,8 @@ TEST(EmbeddedServer, TableBulkApply) {
   auto server = CreateEmbeddedServer();
   std::thread wait_thread([&server]() { server->Wait(); });
 
-  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
-  options.set_data_endpoint(server->address());
-  bigtable::Table table(bigtable::CreateDefaultDataClient(
-                            "fake-project", "fake-instance", options),
-                        "fake-table");
+  CreateTestTable(*server, "fake-table");
+  auto table = MakeTestTable(*server, "fake-table");
 
   bigtable::BulkMutation bulk;
   bulk.emplace_back(bigtable::SingleRowMutation(
@@ -110,17 +145,20 @@ TEST(EmbeddedServer, ReadRows1) {
   auto server = CreateEmbeddedServer();
   std::thread wait_thread([&server]() { server->Wait(); });
 
-  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
-  options.set_data_endpoint(server->address());
-  bigtable::Table table(bigtable::CreateDefaultDataClient(
-                            "fake-project", "fake-instance", options),
-                        "fake-table");
+  CreateTestTable(*server, "fake-table");
+  auto table = MakeTestTable(*server, "fake-table");
+
+  ASSERT_STATUS_OK(table.Apply(bigtable::SingleRowMutation(
+      "row1", {bigtable::SetCell("fam", "col", milliseconds(0), "val")})));
 
   EXPECT_EQ(0, server->read_rows_count());
-  auto reader = table.ReadRows(bigtable::RowSet("row1"), 1,
-                               bigtable::Filter::PassAllFilter());
-  auto count = std::distance(reader.begin(), reader.end());
-  EXPECT_EQ(1, count);
+  auto row = table.ReadRow("row1", bigtable::Filter::PassAllFilter());
+  ASSERT_STATUS_OK(row);
+  ASSERT_TRUE(row->first);
+  ASSERT_EQ(1, row->second.cells().size());
+  EXPECT_EQ("fam", row->second.cells()[0].family_name());
+  EXPECT_EQ("col", row->second.cells()[0].column_qualifier());
+  EXPECT_EQ("val", row->second.cells()[0].value());
   EXPECT_EQ(1, server->read_rows_count());
 
   server->Shutdown();
@@ -131,20 +169,141 @@ TEST(EmbeddedServer, ReadRows100) {
   auto server = CreateEmbeddedServer();
   std::thread wait_thread([&server]() { server->Wait(); });
 
-  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
-  options.set_data_endpoint(server->address());
-  bigtable::Table table(bigtable::CreateDefaultDataClient(
-                            "fake-project", "fake-instance", options),
-                        "fake-table");
+  CreateTestTable(*server, "fake-table");
+  auto table = MakeTestTable(*server, "fake-table");
+
+  bigtable::BulkMutation bulk;
+  for (int i = 0; i != 200; ++i) {
+    char key[16];
+    snprintf(key, sizeof(key), "row%03d", i);
+    bulk.emplace_back(bigtable::SingleRowMutation(
+        key, {bigtable::SetCell("fam", "col", milliseconds(0), "val")}));
+  }
+  ASSERT_TRUE(table.BulkApply(std::move(bulk)).empty());
 
   EXPECT_EQ(0, server->read_rows_count());
   auto reader =
-      table.ReadRows(bigtable::RowSet(bigtable::RowRange::StartingAt("foo")),
+      table.ReadRows(bigtable::RowSet(bigtable::RowRange::StartingAt("row050")),
                      100, bigtable::Filter::PassAllFilter());
-  auto count = std::distance(reader.begin(), reader.end());
-  EXPECT_EQ(100, count);
+  std::vector<std::string> keys;
+  for (auto& row : reader) {
+    ASSERT_STATUS_OK(row);
+    keys.push_back(row->row_key());
+  }
+  ASSERT_EQ(100, keys.size());
+  EXPECT_EQ("row050", keys.front());
+  EXPECT_EQ("row149", keys.back());
   EXPECT_EQ(1, server->read_rows_count());
 
   server->Shutdown();
   wait_thread.join();
 }
+
+TEST(EmbeddedServer, TableNotFound) {
+  auto server = CreateEmbeddedServer();
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  auto table = MakeTestTable(*server, "fake-table");
+  auto status = table.Apply(bigtable::SingleRowMutation(
+      "row1", {bigtable::SetCell("fam", "col", milliseconds(0), "val")}));
+  EXPECT_EQ(google::cloud::StatusCode::kNotFound, status.code());
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
+TEST(EmbeddedServer, CheckAndMutateRow) {
+  auto server = CreateEmbeddedServer();
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  CreateTestTable(*server, "fake-table");
+  auto table = MakeTestTable(*server, "fake-table");
+
+  EXPECT_EQ(0, server->check_and_mutate_row_count());
+  auto matched = table.CheckAndMutateRow(
+      "row1", bigtable::Filter::PassAllFilter(), {},
+      {bigtable::SetCell("fam", "col", milliseconds(0), "val")});
+  ASSERT_STATUS_OK(matched);
+  EXPECT_EQ(bigtable::MutationBranch::kPredicateNotMatched, *matched);
+  matched = table.CheckAndMutateRow("row1", bigtable::Filter::PassAllFilter(),
+                                    {bigtable::DeleteFromRow()}, {});
+  ASSERT_STATUS_OK(matched);
+  EXPECT_EQ(bigtable::MutationBranch::kPredicateMatched, *matched);
+  EXPECT_EQ(2, server->check_and_mutate_row_count());
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
+TEST(EmbeddedServer, ReadModifyWriteRow) {
+  auto server = CreateEmbeddedServer();
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  CreateTestTable(*server, "fake-table");
+  auto table = MakeTestTable(*server, "fake-table");
+
+  EXPECT_EQ(0, server->read_modify_write_row_count());
+  auto row = table.ReadModifyWriteRow(
+      "row1", bigtable::ReadModifyWriteRule::AppendValue("fam", "col", "a"));
+  ASSERT_STATUS_OK(row);
+  row = table.ReadModifyWriteRow(
+      "row1", bigtable::ReadModifyWriteRule::AppendValue("fam", "col", "b"));
+  ASSERT_STATUS_OK(row);
+  ASSERT_EQ(1, row->cells().size());
+  EXPECT_EQ("ab", row->cells()[0].value());
+  EXPECT_EQ(2, server->read_modify_write_row_count());
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
+TEST(EmbeddedServer, SampleRows) {
+  EmbeddedServerOptions options;
+  options.sample_row_keys_interval = 1000;
+  auto server = CreateEmbeddedServer(options);
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  CreateTestTable(*server, "fake-table");
+  auto table = MakeTestTable(*server, "fake-table");
+  bigtable::BulkMutation bulk;
+  for (int i = 0; i != 100; ++i) {
+    char key[16];
+    snprintf(key, sizeof(key), "row%03d", i);
+    bulk.emplace_back(bigtable::SingleRowMutation(
+        key, {bigtable::SetCell("fam", "col", milliseconds(0),
+                                std::string(100, 'x'))}));
+  }
+  ASSERT_TRUE(table.BulkApply(std::move(bulk)).empty());
+
+  EXPECT_EQ(0, server->sample_row_keys_count());
+  auto samples = table.SampleRows();
+  ASSERT_STATUS_OK(samples);
+  EXPECT_LE(5, samples->size());
+  EXPECT_TRUE(samples->back().row_key.empty());
+  EXPECT_EQ(1, server->sample_row_keys_count());
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
+TEST(EmbeddedServer, InjectedMutationErrors) {
+  EmbeddedServerOptions options;
+  options.mutation_error_rate = 0.5;
+  auto server = CreateEmbeddedServer(options);
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  CreateTestTable(*server, "fake-table");
+  auto table = MakeTestTable(*server, "fake-table");
+  bigtable::BulkMutation bulk;
+  for (int i = 0; i != 100; ++i) {
+    bulk.emplace_back(bigtable::SingleRowMutation(
+        "row" + std::to_string(i),
+        {bigtable::SetCell("fam", "col", milliseconds(0), "val")}));
+  }
+  // The errors are transient, so the client retries them until they succeed.
+  ASSERT_TRUE(table.BulkApply(std::move(bulk)).empty());
+  EXPECT_LT(1, server->mutate_rows_count());
+
+  server->Shutdown();
+  wait_thread.join();
+}
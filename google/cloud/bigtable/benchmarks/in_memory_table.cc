@@ -0,0 +1,742 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/in_memory_table.h"
+#include "google/cloud/version.h"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <regex>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+
+namespace btproto = ::google::bigtable::v2;
+
+namespace {
+
+/// The current time, with the millisecond granularity used by the service.
+std::int64_t ServerTimestampMicros() {
+  using std::chrono::duration_cast;
+  auto const now = std::chrono::system_clock::now().time_since_epoch();
+  return duration_cast<std::chrono::milliseconds>(now).count() * 1000;
+}
+
+bool CellLess(InMemoryCell const& a, InMemoryCell const& b) {
+  if (a.family != b.family) return a.family < b.family;
+  if (a.qualifier != b.qualifier) return a.qualifier < b.qualifier;
+  return a.timestamp_micros > b.timestamp_micros;
+}
+
+bool InRange(btproto::ColumnRange const& r, std::string const& qualifier) {
+  switch (r.start_qualifier_case()) {
+    case btproto::ColumnRange::kStartQualifierClosed:
+      if (qualifier < r.start_qualifier_closed()) return false;
+      break;
+    case btproto::ColumnRange::kStartQualifierOpen:
+      if (qualifier <= r.start_qualifier_open()) return false;
+      break;
+    default:
+      break;
+  }
+  switch (r.end_qualifier_case()) {
+    case btproto::ColumnRange::kEndQualifierClosed:
+      return qualifier <= r.end_qualifier_closed();
+    case btproto::ColumnRange::kEndQualifierOpen:
+      return qualifier < r.end_qualifier_open();
+    default:
+      break;
+  }
+  return true;
+}
+
+bool InRange(btproto::ValueRange const& r, std::string const& value) {
+  switch (r.start_value_case()) {
+    case btproto::ValueRange::kStartValueClosed:
+      if (value < r.start_value_closed()) return false;
+      break;
+    case btproto::ValueRange::kStartValueOpen:
+      if (value <= r.start_value_open()) return false;
+      break;
+    default:
+      break;
+  }
+  switch (r.end_value_case()) {
+    case btproto::ValueRange::kEndValueClosed:
+      return value <= r.end_value_closed();
+    case btproto::ValueRange::kEndValueOpen:
+      return value < r.end_value_open();
+    default:
+      break;
+  }
+  return true;
+}
+
+template <typename Predicate>
+std::vector<InMemoryCell> KeepIf(std::vector<InMemoryCell> cells,
+                                 Predicate pred) {
+  auto end = std::remove_if(
+      cells.begin(), cells.end(),
+      [&pred](InMemoryCell const& c) { return !pred(c); });
+  cells.erase(end, cells.end());
+  return cells;
+}
+
+/// Return true if @p key is not past the end of @p range.
+bool BeforeEnd(btproto::RowRange const& range, std::string const& key) {
+  // An empty end key means the range is unbounded.
+  switch (range.end_key_case()) {
+    case btproto::RowRange::kEndKeyClosed:
+      return range.end_key_closed().empty() || key <= range.end_key_closed();
+    case btproto::RowRange::kEndKeyOpen:
+      return range.end_key_open().empty() || key < range.end_key_open();
+    default:
+      break;
+  }
+  return true;
+}
+
+/// The first key included in @p range, and whether it is included.
+std::pair<std::string, bool> RangeStart(btproto::RowRange const& range) {
+  switch (range.start_key_case()) {
+    case btproto::RowRange::kStartKeyClosed:
+      return {range.start_key_closed(), true};
+    case btproto::RowRange::kStartKeyOpen:
+      return {range.start_key_open(), range.start_key_open().empty()};
+    default:
+      break;
+  }
+  return {std::string{}, true};
+}
+
+/**
+ * A `RowFilter` prepared for evaluation.
+ *
+ * The regular expressions are compiled once per request, the rest of the
+ * parameters are read from the (borrowed) proto.
+ */
+class CompiledFilter {
+ public:
+  explicit CompiledFilter(btproto::RowFilter const& filter) : proto_(filter) {
+    switch (filter.filter_case()) {
+      case btproto::RowFilter::kChain:
+        for (auto const& f : filter.chain().filters()) {
+          children_.emplace_back(new CompiledFilter(f));
+        }
+        break;
+      case btproto::RowFilter::kInterleave:
+        for (auto const& f : filter.interleave().filters()) {
+          children_.emplace_back(new CompiledFilter(f));
+        }
+        break;
+      case btproto::RowFilter::kCondition:
+        children_.emplace_back(
+            new CompiledFilter(filter.condition().predicate_filter()));
+        children_.emplace_back(
+            new CompiledFilter(filter.condition().true_filter()));
+        children_.emplace_back(
+            new CompiledFilter(filter.condition().false_filter()));
+        break;
+      case btproto::RowFilter::kRowKeyRegexFilter:
+        re_ = std::regex(filter.row_key_regex_filter());
+        break;
+      case btproto::RowFilter::kFamilyNameRegexFilter:
+        re_ = std::regex(filter.family_name_regex_filter());
+        break;
+      case btproto::RowFilter::kColumnQualifierRegexFilter:
+        re_ = std::regex(filter.column_qualifier_regex_filter());
+        break;
+      case btproto::RowFilter::kValueRegexFilter:
+        re_ = std::regex(filter.value_regex_filter());
+        break;
+      default:
+        break;
+    }
+  }
+
+  /**
+   * Apply the filter to the cells in a row.
+   *
+   * Cells reaching a `sink` filter are appended to @p sink, and not returned
+   * to the parent filter.
+   */
+  std::vector<InMemoryCell> Apply(
+      std::string const& row_key, std::vector<InMemoryCell> cells,
+      std::vector<InMemoryCell>& sink,
+      google::cloud::internal::DefaultPRNG& generator) const {
+    switch (proto_.filter_case()) {
+      case btproto::RowFilter::kChain:
+        for (auto const& child : children_) {
+          if (cells.empty()) break;
+          cells = child->Apply(row_key, std::move(cells), sink, generator);
+        }
+        return cells;
+
+      case btproto::RowFilter::kInterleave: {
+        std::vector<InMemoryCell> result;
+        for (auto const& child : children_) {
+          auto r = child->Apply(row_key, cells, sink, generator);
+          std::move(r.begin(), r.end(), std::back_inserter(result));
+        }
+        std::stable_sort(result.begin(), result.end(), CellLess);
+        return result;
+      }
+
+      case btproto::RowFilter::kCondition: {
+        auto const& condition = proto_.condition();
+        // Cells sunk by the predicate never reach the output.
+        std::vector<InMemoryCell> unused;
+        auto const matched =
+            !children_[0]->Apply(row_key, cells, unused, generator).empty();
+        if (matched && condition.has_true_filter()) {
+          return children_[1]->Apply(row_key, std::move(cells), sink,
+                                     generator);
+        }
+        if (!matched && condition.has_false_filter()) {
+          return children_[2]->Apply(row_key, std::move(cells), sink,
+                                     generator);
+        }
+        return {};
+      }
+
+      case btproto::RowFilter::kSink:
+        if (!proto_.sink()) return cells;
+        std::move(cells.begin(), cells.end(), std::back_inserter(sink));
+        return {};
+
+      case btproto::RowFilter::kPassAllFilter:
+        return cells;
+
+      case btproto::RowFilter::kBlockAllFilter:
+        if (!proto_.block_all_filter()) return cells;
+        return {};
+
+      case btproto::RowFilter::kRowKeyRegexFilter:
+        if (std::regex_match(row_key, re_)) return cells;
+        return {};
+
+      case btproto::RowFilter::kRowSampleFilter: {
+        std::uniform_real_distribution<double> d(0.0, 1.0);
+        if (d(generator) < proto_.row_sample_filter()) return cells;
+        return {};
+      }
+
+      case btproto::RowFilter::kFamilyNameRegexFilter:
+        return KeepIf(std::move(cells), [this](InMemoryCell const& c) {
+          return std::regex_match(c.family, re_);
+        });
+
+      case btproto::RowFilter::kColumnQualifierRegexFilter:
+        return KeepIf(std::move(cells), [this](InMemoryCell const& c) {
+          return std::regex_match(c.qualifier, re_);
+        });
+
+      case btproto::RowFilter::kColumnRangeFilter: {
+        auto const& range = proto_.column_range_filter();
+        return KeepIf(std::move(cells), [&range](InMemoryCell const& c) {
+          return c.family == range.family_name() && InRange(range, c.qualifier);
+        });
+      }
+
+      case btproto::RowFilter::kTimestampRangeFilter: {
+        auto const& range = proto_.timestamp_range_filter();
+        return KeepIf(std::move(cells), [&range](InMemoryCell const& c) {
+          return c.timestamp_micros >= range.start_timestamp_micros() &&
+                 (range.end_timestamp_micros() == 0 ||
+                  c.timestamp_micros < range.end_timestamp_micros());
+        });
+      }
+
+      case btproto::RowFilter::kValueRegexFilter:
+        return KeepIf(std::move(cells), [this](InMemoryCell const& c) {
+          return std::regex_match(c.value, re_);
+        });
+
+      case btproto::RowFilter::kValueRangeFilter: {
+        auto const& range = proto_.value_range_filter();
+        return KeepIf(std::move(cells), [&range](InMemoryCell const& c) {
+          return InRange(range, c.value);
+        });
+      }
+
+      case btproto::RowFilter::kCellsPerRowOffsetFilter: {
+        auto const offset = static_cast<std::size_t>(
+            (std::max)(proto_.cells_per_row_offset_filter(), 0));
+        if (offset >= cells.size()) return {};
+        cells.erase(cells.begin(),
+                    cells.begin() + static_cast<std::ptrdiff_t>(offset));
+        return cells;
+      }
+
+      case btproto::RowFilter::kCellsPerRowLimitFilter: {
+        auto const limit = static_cast<std::size_t>(
+            (std::max)(proto_.cells_per_row_limit_filter(), 0));
+        if (cells.size() > limit) cells.resize(limit);
+        return cells;
+      }
+
+      case btproto::RowFilter::kCellsPerColumnLimitFilter: {
+        auto const limit = proto_.cells_per_column_limit_filter();
+        std::vector<InMemoryCell> result;
+        int count = 0;
+        for (std::size_t i = 0; i != cells.size(); ++i) {
+          if (result.empty() || cells[i].family != result.back().family ||
+              cells[i].qualifier != result.back().qualifier) {
+            count = 0;
+          }
+          if (count++ < limit) result.push_back(std::move(cells[i]));
+        }
+        return result;
+      }
+
+      case btproto::RowFilter::kStripValueTransformer:
+        if (!proto_.strip_value_transformer()) return cells;
+        for (auto& c : cells) c.value.clear();
+        return cells;
+
+      case btproto::RowFilter::kApplyLabelTransformer:
+        for (auto& c : cells) {
+          c.labels.push_back(proto_.apply_label_transformer());
+        }
+        return cells;
+
+      default:
+        break;
+    }
+    // An empty filter passes all the cells.
+    return cells;
+  }
+
+  /// Apply the filter, including any cells captured by `sink` filters.
+  std::vector<InMemoryCell> ApplyToRow(
+      std::string const& row_key, std::vector<InMemoryCell> cells,
+      google::cloud::internal::DefaultPRNG& generator) const {
+    std::vector<InMemoryCell> sink;
+    auto result = Apply(row_key, std::move(cells), sink, generator);
+    if (sink.empty()) return result;
+    std::move(sink.begin(), sink.end(), std::back_inserter(result));
+    std::stable_sort(result.begin(), result.end(), CellLess);
+    return result;
+  }
+
+ private:
+  btproto::RowFilter const& proto_;
+  std::vector<std::unique_ptr<CompiledFilter>> children_;
+  std::regex re_;
+};
+
+/**
+ * Prepare @p filter for evaluation.
+ *
+ * Invalid regular expressions are reported as errors when exceptions are
+ * enabled, `std::regex` has no other mechanism to report them.
+ */
+grpc::Status Compile(btproto::RowFilter const& filter,
+                     std::unique_ptr<CompiledFilter>& compiled) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  try {
+    compiled.reset(new CompiledFilter(filter));
+  } catch (std::regex_error const& ex) {
+    return grpc::Status(
+        grpc::StatusCode::INVALID_ARGUMENT,
+        std::string("Invalid regular expression: ") + ex.what());
+  }
+#else
+  compiled.reset(new CompiledFilter(filter));
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  return grpc::Status::OK;
+}
+
+std::string EncodeBigEndian(std::int64_t value) {
+  auto v = static_cast<std::uint64_t>(value);
+  std::string result(8, '\0');
+  for (int i = 7; i >= 0; --i) {
+    result[static_cast<std::size_t>(i)] = static_cast<char>(v & 0xFF);
+    v >>= 8;
+  }
+  return result;
+}
+
+std::int64_t DecodeBigEndian(std::string const& value) {
+  std::uint64_t v = 0;
+  for (auto c : value) {
+    v = (v << 8) | static_cast<std::uint8_t>(c);
+  }
+  return static_cast<std::int64_t>(v);
+}
+
+}  // namespace
+
+InMemoryTable::InMemoryTable(std::set<std::string> column_families)
+    : column_families_(std::move(column_families)) {}
+
+grpc::Status InMemoryTable::MutateRow(
+    std::string const& row_key,
+    google::protobuf::RepeatedPtrField<btproto::Mutation> const& mutations) {
+  if (mutations.empty()) {
+    return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                        "No mutations provided");
+  }
+  auto status = ValidateMutations(mutations);
+  if (!status.ok()) return status;
+
+  std::lock_guard<std::mutex> lk(mu_);
+  auto& row = rows_[row_key];
+  ApplyMutations(row, mutations);
+  if (row.empty()) rows_.erase(row_key);
+  return grpc::Status::OK;
+}
+
+grpc::Status InMemoryTable::ReadRows(
+    btproto::RowSet const& row_set, btproto::RowFilter const& filter,
+    std::int64_t rows_limit, google::cloud::internal::DefaultPRNG& generator,
+    std::function<bool(std::string const&, std::vector<InMemoryCell>)> const&
+        on_row) {
+  std::unique_ptr<CompiledFilter> compiled;
+  auto status = Compile(filter, compiled);
+  if (!status.ok()) return status;
+
+  // Convert the row set to a list of ranges sorted by their start key.
+  std::vector<btproto::RowRange> ranges;
+  for (auto const& key : row_set.row_keys()) {
+    // The empty row key is not valid, and as an end key it means "unbounded".
+    if (key.empty()) continue;
+    btproto::RowRange r;
+    r.set_start_key_closed(key);
+    r.set_end_key_closed(key);
+    ranges.push_back(std::move(r));
+  }
+  ranges.insert(ranges.end(), row_set.row_ranges().begin(),
+                row_set.row_ranges().end());
+  // An empty row set means "all the rows".
+  if (row_set.row_keys().empty() && row_set.row_ranges().empty()) {
+    ranges.emplace_back();
+  }
+  std::sort(ranges.begin(), ranges.end(),
+            [](btproto::RowRange const& a, btproto::RowRange const& b) {
+              return RangeStart(a).first < RangeStart(b).first;
+            });
+
+  std::int64_t row_count = 0;
+  bool has_last_key = false;
+  std::string last_key;
+  for (auto const& range : ranges) {
+    auto const start = RangeStart(range);
+    for (;;) {
+      std::string key;
+      std::vector<InMemoryCell> cells;
+      {
+        // Only hold the lock while copying one row, the map iterators may be
+        // invalidated as soon as the lock is released.
+        std::lock_guard<std::mutex> lk(mu_);
+        auto it = start.second ? rows_.lower_bound(start.first)
+                               : rows_.upper_bound(start.first);
+        if (has_last_key && it != rows_.end() && it->first <= last_key) {
+          it = rows_.upper_bound(last_key);
+        }
+        if (it == rows_.end() || !BeforeEnd(range, it->first)) break;
+        key = it->first;
+        cells = Flatten(it->second);
+      }
+      has_last_key = true;
+      last_key = key;
+      cells = compiled->ApplyToRow(key, std::move(cells), generator);
+      if (cells.empty()) continue;
+      if (!on_row(key, std::move(cells))) return grpc::Status::OK;
+      if (rows_limit != 0 && ++row_count >= rows_limit) {
+        return grpc::Status::OK;
+      }
+    }
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status InMemoryTable::CheckAndMutateRow(
+    btproto::CheckAndMutateRowRequest const& request,
+    google::cloud::internal::DefaultPRNG& generator, bool& predicate_matched) {
+  std::unique_ptr<CompiledFilter> compiled;
+  auto status = Compile(request.predicate_filter(), compiled);
+  if (!status.ok()) return status;
+  status = ValidateMutations(request.true_mutations());
+  if (!status.ok()) return status;
+  status = ValidateMutations(request.false_mutations());
+  if (!status.ok()) return status;
+
+  std::lock_guard<std::mutex> lk(mu_);
+  auto& row = rows_[request.row_key()];
+  auto cells = Flatten(row);
+  if (request.has_predicate_filter()) {
+    cells =
+        compiled->ApplyToRow(request.row_key(), std::move(cells), generator);
+  }
+  predicate_matched = !cells.empty();
+  ApplyMutations(row, predicate_matched ? request.true_mutations()
+                                        : request.false_mutations());
+  if (row.empty()) rows_.erase(request.row_key());
+  return grpc::Status::OK;
+}
+
+grpc::Status InMemoryTable::ReadModifyWriteRow(
+    btproto::ReadModifyWriteRowRequest const& request, btproto::Row& row) {
+  if (request.rules().empty()) {
+    return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                        "No rules provided");
+  }
+  for (auto const& rule : request.rules()) {
+    if (column_families_.count(rule.family_name()) == 0) {
+      return grpc::Status(grpc::StatusCode::NOT_FOUND,
+                          "Column family " + rule.family_name() + " not found");
+    }
+    if (rule.rule_case() == btproto::ReadModifyWriteRule::RULE_NOT_SET) {
+      return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                          "Rule must have append_value or increment_amount");
+    }
+  }
+
+  std::lock_guard<std::mutex> lk(mu_);
+  // Validate the existing values before modifying anything, the operation is
+  // atomic.
+  auto loc = rows_.find(request.row_key());
+  for (auto const& rule : request.rules()) {
+    if (rule.rule_case() != btproto::ReadModifyWriteRule::kIncrementAmount ||
+        loc == rows_.end()) {
+      continue;
+    }
+    auto f = loc->second.find(rule.family_name());
+    if (f == loc->second.end()) continue;
+    auto c = f->second.find(rule.column_qualifier());
+    if (c == f->second.end() || c->second.empty()) continue;
+    if (c->second.begin()->second.size() != 8) {
+      return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                          "Existing value for increment is not 8 bytes");
+    }
+  }
+
+  auto& stored = rows_[request.row_key()];
+  auto const now = ServerTimestampMicros();
+  // Each cell is only reported once, with its final value.
+  std::map<std::string, std::map<std::string, std::pair<std::int64_t,
+                                                        std::string>>>
+      modified;
+  for (auto const& rule : request.rules()) {
+    auto& column = stored[rule.family_name()][rule.column_qualifier()];
+    std::string value;
+    std::int64_t timestamp = now;
+    if (!column.empty()) {
+      value = column.begin()->second;
+      timestamp = (std::max)(now, column.begin()->first);
+    }
+    if (rule.rule_case() == btproto::ReadModifyWriteRule::kAppendValue) {
+      value += rule.append_value();
+    } else {
+      auto const current = value.empty() ? 0 : DecodeBigEndian(value);
+      value = EncodeBigEndian(static_cast<std::int64_t>(
+          static_cast<std::uint64_t>(current) +
+          static_cast<std::uint64_t>(rule.increment_amount())));
+    }
+    column[timestamp] = value;
+    modified[rule.family_name()][rule.column_qualifier()] =
+        std::make_pair(timestamp, std::move(value));
+  }
+
+  row.set_key(request.row_key());
+  for (auto& f : modified) {
+    auto& family = *row.add_families();
+    family.set_name(f.first);
+    for (auto& c : f.second) {
+      auto& column = *family.add_columns();
+      column.set_qualifier(c.first);
+      auto& cell = *column.add_cells();
+      cell.set_timestamp_micros(c.second.first);
+      cell.set_value(std::move(c.second.second));
+    }
+  }
+  return grpc::Status::OK;
+}
+
+std::vector<btproto::SampleRowKeysResponse> InMemoryTable::SampleRowKeys(
+    std::int64_t interval_bytes) const {
+  std::vector<btproto::SampleRowKeysResponse> result;
+  std::int64_t offset = 0;
+  std::int64_t last_sample = 0;
+  std::lock_guard<std::mutex> lk(mu_);
+  for (auto const& kv : rows_) {
+    offset += static_cast<std::int64_t>(kv.first.size());
+    for (auto const& family : kv.second) {
+      for (auto const& column : family.second) {
+        for (auto const& cell : column.second) {
+          offset += static_cast<std::int64_t>(
+              family.first.size() + column.first.size() + sizeof(cell.first) +
+              cell.second.size());
+        }
+      }
+    }
+    if (offset - last_sample >= interval_bytes) {
+      btproto::SampleRowKeysResponse sample;
+      sample.set_row_key(kv.first);
+      sample.set_offset_bytes(offset);
+      result.push_back(std::move(sample));
+      last_sample = offset;
+    }
+  }
+  btproto::SampleRowKeysResponse last;
+  last.set_offset_bytes(offset);
+  result.push_back(std::move(last));
+  return result;
+}
+
+std::size_t InMemoryTable::size() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return rows_.size();
+}
+
+grpc::Status InMemoryTable::ValidateMutations(
+    google::protobuf::RepeatedPtrField<btproto::Mutation> const& mutations)
+    const {
+  auto check_family = [this](std::string const& name) {
+    if (column_families_.count(name) != 0) return grpc::Status::OK;
+    return grpc::Status(grpc::StatusCode::NOT_FOUND,
+                        "Column family " + name + " not found");
+  };
+  for (auto const& m : mutations) {
+    grpc::Status status;
+    switch (m.mutation_case()) {
+      case btproto::Mutation::kSetCell: {
+        auto const ts = m.set_cell().timestamp_micros();
+        if (ts < -1 || (ts != -1 && ts % 1000 != 0)) {
+          return grpc::Status(
+              grpc::StatusCode::INVALID_ARGUMENT,
+              "Timestamp granularity mismatch, expected milliseconds");
+        }
+        status = check_family(m.set_cell().family_name());
+        break;
+      }
+      case btproto::Mutation::kDeleteFromColumn:
+        status = check_family(m.delete_from_column().family_name());
+        break;
+      case btproto::Mutation::kDeleteFromFamily:
+        status = check_family(m.delete_from_family().family_name());
+        break;
+      case btproto::Mutation::kDeleteFromRow:
+        break;
+      default:
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                            "Mutation has no type");
+    }
+    if (!status.ok()) return status;
+  }
+  return grpc::Status::OK;
+}
+
+void InMemoryTable::ApplyMutations(
+    Row& row,
+    google::protobuf::RepeatedPtrField<btproto::Mutation> const& mutations) {
+  for (auto const& m : mutations) {
+    switch (m.mutation_case()) {
+      case btproto::Mutation::kSetCell: {
+        auto const& set_cell = m.set_cell();
+        auto ts = set_cell.timestamp_micros();
+        if (ts == -1) ts = ServerTimestampMicros();
+        row[set_cell.family_name()][set_cell.column_qualifier()][ts] =
+            set_cell.value();
+        break;
+      }
+      case btproto::Mutation::kDeleteFromColumn: {
+        auto const& d = m.delete_from_column();
+        auto f = row.find(d.family_name());
+        if (f == row.end()) break;
+        auto c = f->second.find(d.column_qualifier());
+        if (c == f->second.end()) break;
+        auto const start = d.time_range().start_timestamp_micros();
+        auto const end = d.time_range().end_timestamp_micros();
+        for (auto i = c->second.begin(); i != c->second.end();) {
+          if (i->first >= start && (end == 0 || i->first < end)) {
+            i = c->second.erase(i);
+          } else {
+            ++i;
+          }
+        }
+        if (c->second.empty()) f->second.erase(c);
+        if (f->second.empty()) row.erase(f);
+        break;
+      }
+      case btproto::Mutation::kDeleteFromFamily:
+        row.erase(m.delete_from_family().family_name());
+        break;
+      case btproto::Mutation::kDeleteFromRow:
+        row.clear();
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+std::vector<InMemoryCell> InMemoryTable::Flatten(Row const& row) {
+  std::vector<InMemoryCell> cells;
+  for (auto const& family : row) {
+    for (auto const& column : family.second) {
+      for (auto const& cell : column.second) {
+        cells.push_back(InMemoryCell{family.first, column.first, cell.first,
+                                     cell.second, {}});
+      }
+    }
+  }
+  return cells;
+}
+
+void AppendRowChunks(std::string const& row_key,
+                     std::vector<InMemoryCell> cells,
+                     std::size_t max_chunk_size,
+                     btproto::ReadRowsResponse& response) {
+  if (max_chunk_size == 0) max_chunk_size = std::string::npos;
+  for (std::size_t i = 0; i != cells.size(); ++i) {
+    auto& cell = cells[i];
+    bool const new_family = i == 0 || cell.family != cells[i - 1].family;
+    bool const new_column =
+        new_family || cell.qualifier != cells[i - 1].qualifier;
+    bool const last_cell = i + 1 == cells.size();
+    auto const size = cell.value.size();
+    std::size_t offset = 0;
+    do {
+      auto& chunk = *response.add_chunks();
+      if (offset == 0) {
+        if (i == 0) chunk.set_row_key(row_key);
+        if (new_family) chunk.mutable_family_name()->set_value(cell.family);
+        if (new_column) chunk.mutable_qualifier()->set_value(cell.qualifier);
+        chunk.set_timestamp_micros(cell.timestamp_micros);
+        for (auto& label : cell.labels) chunk.add_labels(std::move(label));
+      }
+      auto const n = (std::min)(max_chunk_size, size - offset);
+      if (offset == 0 && n == size) {
+        chunk.set_value(std::move(cell.value));
+      } else {
+        chunk.set_value(cell.value.substr(offset, n));
+      }
+      offset += n;
+      // All the chunks of a split value, except the last, report its size.
+      if (offset < size) chunk.set_value_size(static_cast<std::int32_t>(size));
+      if (offset == size && last_cell) chunk.set_commit_row(true);
+    } while (offset < size);
+  }
+}
+
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
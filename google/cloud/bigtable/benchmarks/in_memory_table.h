@@ -0,0 +1,141 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_IN_MEMORY_TABLE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_IN_MEMORY_TABLE_H
+
+#include "google/cloud/internal/random.h"
+#include <google/bigtable/v2/bigtable.pb.h>
+#include <grpcpp/grpcpp.h>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+
+/// A single cell, as returned by `InMemoryTable::ReadRows()`.
+struct InMemoryCell {
+  std::string family;
+  std::string qualifier;
+  std::int64_t timestamp_micros;
+  std::string value;
+  std::vector<std::string> labels;
+};
+
+/**
+ * A Cloud Bigtable table stored in memory.
+ *
+ * This class implements the semantics of the Cloud Bigtable data API over a
+ * sorted map: mutations, conditional mutations, read-modify-write operations,
+ * row sampling, and reading rows with the full `RowFilter` language.
+ *
+ * The regular expressions in filters are evaluated using `std::regex` (with
+ * the ECMAScript grammar), which is a close approximation of the RE2 syntax
+ * used by the service for the common cases.
+ *
+ * All the member functions are thread-safe. Single row operations are atomic,
+ * scans read each row atomically, but the scan as a whole may observe
+ * concurrent mutations, just like the service.
+ */
+class InMemoryTable {
+ public:
+  explicit InMemoryTable(std::set<std::string> column_families);
+
+  /// Atomically apply @p mutations to the row at @p row_key.
+  grpc::Status MutateRow(
+      std::string const& row_key,
+      google::protobuf::RepeatedPtrField<google::bigtable::v2::Mutation> const&
+          mutations);
+
+  /**
+   * Read the rows in @p row_set after applying @p filter.
+   *
+   * The @p on_row callback is called for each row that has at least one cell
+   * after filtering, with the cells sorted by family, column and decreasing
+   * timestamp. If the callback returns `false` the scan stops.
+   *
+   * @param rows_limit the maximum number of rows returned, 0 means no limit.
+   */
+  grpc::Status ReadRows(
+      google::bigtable::v2::RowSet const& row_set,
+      google::bigtable::v2::RowFilter const& filter, std::int64_t rows_limit,
+      google::cloud::internal::DefaultPRNG& generator,
+      std::function<bool(std::string const&, std::vector<InMemoryCell>)> const&
+          on_row);
+
+  /// Implement `CheckAndMutateRow()`, returns whether the predicate matched.
+  grpc::Status CheckAndMutateRow(
+      google::bigtable::v2::CheckAndMutateRowRequest const& request,
+      google::cloud::internal::DefaultPRNG& generator, bool& predicate_matched);
+
+  /// Implement `ReadModifyWriteRow()`, returns the modified cells in @p row.
+  grpc::Status ReadModifyWriteRow(
+      google::bigtable::v2::ReadModifyWriteRowRequest const& request,
+      google::bigtable::v2::Row& row);
+
+  /**
+   * Return a sample of the row keys, roughly every @p interval_bytes.
+   *
+   * The last sample always has an empty row key and the size of the table.
+   */
+  std::vector<google::bigtable::v2::SampleRowKeysResponse> SampleRowKeys(
+      std::int64_t interval_bytes) const;
+
+  /// The number of rows in the table.
+  std::size_t size() const;
+
+ private:
+  using Column =
+      std::map<std::int64_t, std::string, std::greater<std::int64_t>>;
+  using Family = std::map<std::string, Column>;
+  using Row = std::map<std::string, Family>;
+
+  grpc::Status ValidateMutations(
+      google::protobuf::RepeatedPtrField<google::bigtable::v2::Mutation> const&
+          mutations) const;
+  static void ApplyMutations(
+      Row& row,
+      google::protobuf::RepeatedPtrField<google::bigtable::v2::Mutation> const&
+          mutations);
+  static std::vector<InMemoryCell> Flatten(Row const& row);
+
+  std::set<std::string> const column_families_;
+  mutable std::mutex mu_;
+  std::map<std::string, Row> rows_;
+};
+
+/**
+ * Append the chunks to return @p cells as part of a `ReadRowsResponse`.
+ *
+ * Values larger than @p max_chunk_size are split across multiple chunks,
+ * as the service does for large cells.
+ */
+void AppendRowChunks(std::string const& row_key,
+                     std::vector<InMemoryCell> cells,
+                     std::size_t max_chunk_size,
+                     google::bigtable::v2::ReadRowsResponse& response);
+
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_IN_MEMORY_TABLE_H
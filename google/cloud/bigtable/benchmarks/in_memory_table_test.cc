@@ -0,0 +1,348 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/in_memory_table.h"
+#include <google/protobuf/text_format.h>
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+namespace {
+
+namespace btproto = google::bigtable::v2;
+using ::testing::ElementsAre;
+using Mutations = google::protobuf::RepeatedPtrField<btproto::Mutation>;
+
+Mutations ParseMutations(std::vector<std::string> const& texts) {
+  Mutations result;
+  for (auto const& text : texts) {
+    EXPECT_TRUE(google::protobuf::TextFormat::ParseFromString(
+        text, result.Add()));
+  }
+  return result;
+}
+
+template <typename Proto>
+Proto Parse(std::string const& text) {
+  Proto proto;
+  EXPECT_TRUE(google::protobuf::TextFormat::ParseFromString(text, &proto));
+  return proto;
+}
+
+std::string SetCell(std::string const& family, std::string const& column,
+                    std::int64_t timestamp, std::string const& value) {
+  return "set_cell { family_name: '" + family + "' column_qualifier: '" +
+         column + "' timestamp_micros: " + std::to_string(timestamp) +
+         " value: '" + value + "' }";
+}
+
+/// Read the table and return one string per cell.
+std::vector<std::string> ReadAll(InMemoryTable& table,
+                                 btproto::RowFilter const& filter = {},
+                                 btproto::RowSet const& row_set = {},
+                                 std::int64_t rows_limit = 0) {
+  std::vector<std::string> result;
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  auto status = table.ReadRows(
+      row_set, filter, rows_limit, generator,
+      [&result](std::string const& key, std::vector<InMemoryCell> cells) {
+        for (auto const& c : cells) {
+          std::string labels;
+          for (auto const& l : c.labels) labels += "[" + l + "]";
+          result.push_back(key + "/" + c.family + ":" + c.qualifier + "@" +
+                           std::to_string(c.timestamp_micros) + "=" + c.value +
+                           labels);
+        }
+        return true;
+      });
+  EXPECT_TRUE(status.ok()) << status.error_message();
+  return result;
+}
+
+void Populate(InMemoryTable& table) {
+  ASSERT_TRUE(table
+                  .MutateRow("r1", ParseMutations({
+                                       SetCell("fam", "c1", 1000, "v1"),
+                                       SetCell("fam", "c1", 2000, "v2"),
+                                       SetCell("fam", "c2", 1000, "v3"),
+                                       SetCell("other", "c1", 1000, "v4"),
+                                   }))
+                  .ok());
+  ASSERT_TRUE(
+      table.MutateRow("r2", ParseMutations({SetCell("fam", "c1", 1000, "v5")}))
+          .ok());
+  ASSERT_TRUE(
+      table.MutateRow("r3", ParseMutations({SetCell("fam", "c3", 3000, "v6")}))
+          .ok());
+}
+
+TEST(InMemoryTableTest, MutateAndRead) {
+  InMemoryTable table({"fam", "other"});
+  Populate(table);
+  EXPECT_EQ(3, table.size());
+  EXPECT_THAT(ReadAll(table),
+              ElementsAre("r1/fam:c1@2000=v2", "r1/fam:c1@1000=v1",
+                          "r1/fam:c2@1000=v3", "r1/other:c1@1000=v4",
+                          "r2/fam:c1@1000=v5", "r3/fam:c3@3000=v6"));
+}
+
+TEST(InMemoryTableTest, MutateRowErrors) {
+  InMemoryTable table({"fam"});
+  EXPECT_EQ(grpc::StatusCode::NOT_FOUND,
+            table
+                .MutateRow("r1",
+                           ParseMutations({SetCell("unknown", "c1", 0, "v")}))
+                .error_code());
+  EXPECT_EQ(
+      grpc::StatusCode::INVALID_ARGUMENT,
+      table.MutateRow("r1", ParseMutations({SetCell("fam", "c1", 1, "v")}))
+          .error_code());
+  EXPECT_EQ(grpc::StatusCode::INVALID_ARGUMENT,
+            table.MutateRow("r1", Mutations{}).error_code());
+  EXPECT_EQ(0, table.size());
+}
+
+TEST(InMemoryTableTest, Deletes) {
+  InMemoryTable table({"fam", "other"});
+  Populate(table);
+  ASSERT_TRUE(table
+                  .MutateRow("r1", ParseMutations({
+                                       R"pb(delete_from_column {
+                                              family_name: "fam"
+                                              column_qualifier: "c1"
+                                              time_range {
+                                                start_timestamp_micros: 2000
+                                              }
+                                            })pb",
+                                       R"pb(delete_from_family {
+                                              family_name: "other"
+                                            })pb",
+                                   }))
+                  .ok());
+  ASSERT_TRUE(
+      table.MutateRow("r2", ParseMutations({"delete_from_row {}"})).ok());
+  EXPECT_EQ(2, table.size());
+  EXPECT_THAT(ReadAll(table),
+              ElementsAre("r1/fam:c1@1000=v1", "r1/fam:c2@1000=v3",
+                          "r3/fam:c3@3000=v6"));
+}
+
+TEST(InMemoryTableTest, ReadRowSet) {
+  InMemoryTable table({"fam", "other"});
+  Populate(table);
+  auto const row_set = Parse<btproto::RowSet>(R"pb(
+    row_keys: "r3"
+    row_ranges { start_key_open: "r1" end_key_closed: "r2" }
+    row_ranges { start_key_closed: "r2" end_key_open: "r3" }
+  )pb");
+  EXPECT_THAT(ReadAll(table, {}, row_set),
+              ElementsAre("r2/fam:c1@1000=v5", "r3/fam:c3@3000=v6"));
+  EXPECT_THAT(ReadAll(table, {}, {}, 2),
+              ElementsAre("r1/fam:c1@2000=v2", "r1/fam:c1@1000=v1",
+                          "r1/fam:c2@1000=v3", "r1/other:c1@1000=v4",
+                          "r2/fam:c1@1000=v5"));
+}
+
+TEST(InMemoryTableTest, ReadWithFilters) {
+  InMemoryTable table({"fam", "other"});
+  Populate(table);
+
+  EXPECT_THAT(
+      ReadAll(table, Parse<btproto::RowFilter>(R"pb(
+                chain {
+                  filters { family_name_regex_filter: "fam" }
+                  filters { cells_per_column_limit_filter: 1 }
+                  filters { strip_value_transformer: true }
+                }
+              )pb")),
+      ElementsAre("r1/fam:c1@2000=", "r1/fam:c2@1000=", "r2/fam:c1@1000=",
+                  "r3/fam:c3@3000="));
+
+  EXPECT_THAT(ReadAll(table, Parse<btproto::RowFilter>(R"pb(
+                        interleave {
+                          filters { value_regex_filter: "v[13]" }
+                          filters {
+                            chain {
+                              filters { row_key_regex_filter: "r3" }
+                              filters { apply_label_transformer: "l" }
+                            }
+                          }
+                        }
+                      )pb")),
+              ElementsAre("r1/fam:c1@1000=v1", "r1/fam:c2@1000=v3",
+                          "r3/fam:c3@3000=v6[l]"));
+
+  EXPECT_THAT(ReadAll(table, Parse<btproto::RowFilter>(R"pb(
+                        condition {
+                          predicate_filter {
+                            column_qualifier_regex_filter: "c2"
+                          }
+                          true_filter { cells_per_row_limit_filter: 1 }
+                          false_filter { block_all_filter: true }
+                        }
+                      )pb")),
+              ElementsAre("r1/fam:c1@2000=v2"));
+
+  EXPECT_THAT(ReadAll(table, Parse<btproto::RowFilter>(R"pb(
+                        chain {
+                          filters {
+                            timestamp_range_filter {
+                              start_timestamp_micros: 1000
+                              end_timestamp_micros: 2000
+                            }
+                          }
+                          filters { cells_per_row_offset_filter: 2 }
+                        }
+                      )pb")),
+              ElementsAre("r1/other:c1@1000=v4"));
+}
+
+TEST(InMemoryTableTest, InvalidRegex) {
+  InMemoryTable table({"fam"});
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  auto status = table.ReadRows(
+      {}, Parse<btproto::RowFilter>(R"pb(row_key_regex_filter: "[")pb"), 0,
+      generator, [](std::string const&, std::vector<InMemoryCell>) {
+        return true;
+      });
+  EXPECT_EQ(grpc::StatusCode::INVALID_ARGUMENT, status.error_code());
+}
+
+TEST(InMemoryTableTest, CheckAndMutateRow) {
+  InMemoryTable table({"fam", "other"});
+  Populate(table);
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+
+  auto request = Parse<btproto::CheckAndMutateRowRequest>(R"pb(
+    row_key: "r2"
+    predicate_filter { value_regex_filter: "v5" }
+    true_mutations { delete_from_row {} }
+    false_mutations {
+      set_cell {
+        family_name: "fam"
+        column_qualifier: "c9"
+        timestamp_micros: 0
+        value: "no-match"
+      }
+    }
+  )pb");
+  bool matched = false;
+  ASSERT_TRUE(table.CheckAndMutateRow(request, generator, matched).ok());
+  EXPECT_TRUE(matched);
+  EXPECT_EQ(2, table.size());
+
+  request.set_row_key("r4");
+  ASSERT_TRUE(table.CheckAndMutateRow(request, generator, matched).ok());
+  EXPECT_FALSE(matched);
+  auto row_set = Parse<btproto::RowSet>(R"pb(row_keys: "r4")pb");
+  EXPECT_THAT(ReadAll(table, {}, row_set), ElementsAre("r4/fam:c9@0=no-match"));
+}
+
+TEST(InMemoryTableTest, ReadModifyWriteRow) {
+  InMemoryTable table({"fam"});
+  auto request = Parse<btproto::ReadModifyWriteRowRequest>(R"pb(
+    row_key: "r1"
+    rules { family_name: "fam" column_qualifier: "counter" increment_amount: 3 }
+    rules { family_name: "fam" column_qualifier: "log" append_value: "a" }
+    rules { family_name: "fam" column_qualifier: "log" append_value: "b" }
+  )pb");
+  btproto::Row row;
+  ASSERT_TRUE(table.ReadModifyWriteRow(request, row).ok());
+  ASSERT_TRUE(table.ReadModifyWriteRow(request, row = {}).ok());
+
+  EXPECT_EQ("r1", row.key());
+  ASSERT_EQ(1, row.families_size());
+  ASSERT_EQ(2, row.families(0).columns_size());
+  EXPECT_EQ("counter", row.families(0).columns(0).qualifier());
+  EXPECT_EQ(std::string("\0\0\0\0\0\0\0\6", 8),
+            row.families(0).columns(0).cells(0).value());
+  EXPECT_EQ("log", row.families(0).columns(1).qualifier());
+  EXPECT_EQ("abab", row.families(0).columns(1).cells(0).value());
+
+  // The increment rule requires 8-byte values.
+  request = Parse<btproto::ReadModifyWriteRowRequest>(R"pb(
+    row_key: "r1"
+    rules { family_name: "fam" column_qualifier: "log" increment_amount: 1 }
+  )pb");
+  EXPECT_EQ(grpc::StatusCode::FAILED_PRECONDITION,
+            table.ReadModifyWriteRow(request, row = {}).error_code());
+}
+
+TEST(InMemoryTableTest, SampleRowKeys) {
+  InMemoryTable table({"fam"});
+  for (int i = 0; i != 100; ++i) {
+    char key[16];
+    snprintf(key, sizeof(key), "row%03d", i);
+    ASSERT_TRUE(table
+                    .MutateRow(key, ParseMutations({SetCell(
+                                        "fam", "c", 0, std::string(90, 'x'))}))
+                    .ok());
+  }
+  auto samples = table.SampleRowKeys(1000);
+  // Each row uses about 100 bytes, so we expect roughly 10 samples.
+  EXPECT_LE(9, samples.size());
+  EXPECT_GE(11, samples.size());
+  EXPECT_TRUE(samples.back().row_key().empty());
+  for (std::size_t i = 1; i < samples.size(); ++i) {
+    EXPECT_LE(samples[i - 1].offset_bytes(), samples[i].offset_bytes());
+  }
+}
+
+TEST(InMemoryTableTest, AppendRowChunks) {
+  std::vector<InMemoryCell> cells{
+      {"fam", "c1", 2000, "0123456789", {}},
+      {"fam", "c1", 1000, "abc", {"l"}},
+      {"other", "c2", 0, "", {}},
+  };
+  btproto::ReadRowsResponse response;
+  AppendRowChunks("r1", cells, 4, response);
+  ASSERT_EQ(5, response.chunks_size());
+
+  auto const& c0 = response.chunks(0);
+  EXPECT_EQ("r1", c0.row_key());
+  EXPECT_EQ("fam", c0.family_name().value());
+  EXPECT_EQ("c1", c0.qualifier().value());
+  EXPECT_EQ(2000, c0.timestamp_micros());
+  EXPECT_EQ("0123", c0.value());
+  EXPECT_EQ(10, c0.value_size());
+
+  EXPECT_EQ("4567", response.chunks(1).value());
+  EXPECT_EQ(10, response.chunks(1).value_size());
+  EXPECT_EQ("89", response.chunks(2).value());
+  EXPECT_EQ(0, response.chunks(2).value_size());
+
+  auto const& c3 = response.chunks(3);
+  EXPECT_TRUE(c3.row_key().empty());
+  EXPECT_FALSE(c3.has_family_name());
+  EXPECT_FALSE(c3.has_qualifier());
+  EXPECT_EQ(1000, c3.timestamp_micros());
+  EXPECT_THAT(c3.labels(), ElementsAre("l"));
+  EXPECT_EQ("abc", c3.value());
+
+  EXPECT_FALSE(c3.commit_row());
+
+  auto const& c4 = response.chunks(4);
+  EXPECT_EQ("other", c4.family_name().value());
+  EXPECT_EQ("c2", c4.qualifier().value());
+  EXPECT_EQ("", c4.value());
+  EXPECT_TRUE(c4.commit_row());
+}
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,203 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+namespace {
+double const kHistogramPercentiles[] = {50, 75, 90, 95, 99, 99.9, 99.99};
+
+/// The number of bits needed to represent @p value.
+int BitLength(std::int64_t value) {
+  int r = 0;
+  for (auto v = static_cast<std::uint64_t>(value); v != 0; v >>= 1) ++r;
+  return r;
+}
+
+std::string JsonQuote(std::string const& value) {
+  std::string r = "\"";
+  for (auto c : value) {
+    if (c == '"' || c == '\\') r.push_back('\\');
+    r.push_back(c);
+  }
+  r.push_back('"');
+  return r;
+}
+
+double Throughput(std::int64_t count, std::chrono::milliseconds elapsed) {
+  if (elapsed.count() <= 0) return 0;
+  return 1000.0 * static_cast<double>(count) /
+         static_cast<double>(elapsed.count());
+}
+}  // namespace
+
+LatencyHistogram::LatencyHistogram(std::chrono::microseconds highest,
+                                   int significant_digits)
+    : highest_((std::max)(highest.count(), std::int64_t(2))),
+      min_((std::numeric_limits<std::int64_t>::max)()) {
+  significant_digits = (std::min)((std::max)(significant_digits, 1), 5);
+  std::int64_t single_unit_resolution = 2;
+  for (int i = 0; i != significant_digits; ++i) single_unit_resolution *= 10;
+  // Each power of two range is divided in `sub_bucket_count` linear buckets,
+  // enough to represent `single_unit_resolution` distinct values.
+  int const sub_bucket_count_magnitude = BitLength(single_unit_resolution - 1);
+  sub_bucket_half_count_magnitude_ = sub_bucket_count_magnitude - 1;
+  std::int64_t const sub_bucket_count = std::int64_t(1)
+                                        << sub_bucket_count_magnitude;
+  sub_bucket_half_count_ = sub_bucket_count / 2;
+  sub_bucket_mask_ = sub_bucket_count - 1;
+
+  std::int64_t bucket_count = 1;
+  for (auto smallest_untrackable = sub_bucket_count;
+       smallest_untrackable <= highest_; smallest_untrackable <<= 1) {
+    ++bucket_count;
+  }
+  counts_.resize(
+      static_cast<std::size_t>((bucket_count + 1) * sub_bucket_half_count_));
+}
+
+void LatencyHistogram::Record(std::chrono::microseconds value,
+                              std::int64_t count) {
+  auto v = (std::min)((std::max)(value.count(), std::int64_t(0)), highest_);
+  counts_[CountsIndex(v)] += count;
+  total_count_ += count;
+  min_ = (std::min)(min_, v);
+  max_ = (std::max)(max_, v);
+  sum_ += static_cast<double>(v) * static_cast<double>(count);
+}
+
+void LatencyHistogram::Merge(LatencyHistogram const& rhs) {
+  auto const n = (std::min)(counts_.size(), rhs.counts_.size());
+  for (std::size_t i = 0; i != n; ++i) counts_[i] += rhs.counts_[i];
+  total_count_ += rhs.total_count_;
+  min_ = (std::min)(min_, rhs.min_);
+  max_ = (std::max)(max_, rhs.max_);
+  sum_ += rhs.sum_;
+}
+
+void LatencyHistogram::Reset() {
+  std::fill(counts_.begin(), counts_.end(), 0);
+  total_count_ = 0;
+  min_ = (std::numeric_limits<std::int64_t>::max)();
+  max_ = 0;
+  sum_ = 0;
+}
+
+std::chrono::microseconds LatencyHistogram::min() const {
+  return std::chrono::microseconds(total_count_ == 0 ? 0 : min_);
+}
+
+std::chrono::microseconds LatencyHistogram::max() const {
+  return std::chrono::microseconds(max_);
+}
+
+std::chrono::microseconds LatencyHistogram::mean() const {
+  if (total_count_ == 0) return std::chrono::microseconds(0);
+  return std::chrono::microseconds(static_cast<std::int64_t>(
+      std::llround(sum_ / static_cast<double>(total_count_))));
+}
+
+std::chrono::microseconds LatencyHistogram::ValueAtPercentile(
+    double percentile) const {
+  if (total_count_ == 0) return std::chrono::microseconds(0);
+  percentile = (std::min)((std::max)(percentile, 0.0), 100.0);
+  auto target = static_cast<std::int64_t>(
+      std::ceil(percentile * static_cast<double>(total_count_) / 100.0));
+  target = (std::max)(target, std::int64_t(1));
+  std::int64_t running = 0;
+  for (std::size_t i = 0; i != counts_.size(); ++i) {
+    running += counts_[i];
+    if (running >= target) {
+      return std::chrono::microseconds(
+          (std::min)(HighestEquivalentValue(i), max_));
+    }
+  }
+  return max();
+}
+
+std::size_t LatencyHistogram::CountsIndex(std::int64_t value) const {
+  auto const bucket_index = BitLength(value | sub_bucket_mask_) -
+                            (sub_bucket_half_count_magnitude_ + 1);
+  auto const sub_bucket_index = value >> bucket_index;
+  return static_cast<std::size_t>(
+      ((std::int64_t(bucket_index) + 1) << sub_bucket_half_count_magnitude_) +
+      (sub_bucket_index - sub_bucket_half_count_));
+}
+
+std::int64_t LatencyHistogram::HighestEquivalentValue(std::size_t index) const {
+  auto const i = static_cast<std::int64_t>(index);
+  auto bucket_index = (i >> sub_bucket_half_count_magnitude_) - 1;
+  auto sub_bucket_index =
+      (i & (sub_bucket_half_count_ - 1)) + sub_bucket_half_count_;
+  if (bucket_index < 0) {
+    sub_bucket_index -= sub_bucket_half_count_;
+    bucket_index = 0;
+  }
+  return (sub_bucket_index << bucket_index) +
+         (std::int64_t(1) << bucket_index) - 1;
+}
+
+std::string HistogramCsvHeader() {
+  std::ostringstream os;
+  os << "name,op.name,measurement,count,errors,throughput.ops,min,mean";
+  for (auto p : kHistogramPercentiles) os << ",p" << p;
+  os << ",max,units";
+  return std::move(os).str();
+}
+
+void PrintHistogramCsv(std::ostream& os, std::string const& test_name,
+                       std::string const& op_name,
+                       std::string const& measurement, std::int64_t errors,
+                       std::chrono::milliseconds elapsed,
+                       LatencyHistogram const& histogram) {
+  os << test_name << "," << op_name << "," << measurement << ","
+     << histogram.count() << "," << errors << ","
+     << Throughput(histogram.count(), elapsed) << ","
+     << histogram.min().count() << "," << histogram.mean().count();
+  for (auto p : kHistogramPercentiles) {
+    os << "," << histogram.ValueAtPercentile(p).count();
+  }
+  os << "," << histogram.max().count() << ",us\n";
+}
+
+void PrintHistogramJson(std::ostream& os, std::string const& test_name,
+                        std::string const& op_name,
+                        std::string const& measurement, std::int64_t errors,
+                        std::chrono::milliseconds elapsed,
+                        LatencyHistogram const& histogram) {
+  os << "{\"name\": " << JsonQuote(test_name)
+     << ", \"op.name\": " << JsonQuote(op_name)
+     << ", \"measurement\": " << JsonQuote(measurement)
+     << ", \"count\": " << histogram.count() << ", \"errors\": " << errors
+     << ", \"throughput.ops\": " << Throughput(histogram.count(), elapsed)
+     << ", \"min\": " << histogram.min().count()
+     << ", \"mean\": " << histogram.mean().count();
+  for (auto p : kHistogramPercentiles) {
+    os << ", \"p" << p << "\": " << histogram.ValueAtPercentile(p).count();
+  }
+  os << ", \"max\": " << histogram.max().count() << ", \"units\": \"us\"}";
+}
+
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
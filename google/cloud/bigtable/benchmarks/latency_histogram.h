@@ -0,0 +1,124 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_LATENCY_HISTOGRAM_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_LATENCY_HISTOGRAM_H
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+/**
+ * A high dynamic range (HDR) histogram of latencies.
+ *
+ * Keeping every sample, as `BenchmarkResult` does, is too expensive for long
+ * running, high throughput benchmarks. This histogram uses a fixed amount of
+ * memory, and reports any percentile with a bounded relative error, controlled
+ * by the number of significant digits.
+ *
+ * The values are bucketed in the same way as the HdrHistogram library: each
+ * power of two range is divided in `2^k` linear sub-buckets, where `k` is
+ * large enough to preserve the requested number of significant digits.
+ *
+ * This class is not thread-safe, use a histogram per thread and `Merge()` the
+ * results, or provide external synchronization.
+ */
+class LatencyHistogram {
+ public:
+  /**
+   * Create a histogram for latencies in the range [1us, @p highest].
+   *
+   * @param highest larger values are recorded as @p highest.
+   * @param significant_digits the number of decimal digits preserved for each
+   *     value, must be in the [1, 5] range.
+   */
+  explicit LatencyHistogram(
+      std::chrono::microseconds highest = std::chrono::hours(1),
+      int significant_digits = 3);
+
+  /// Record a single value.
+  void Record(std::chrono::microseconds value) { Record(value, 1); }
+
+  /// Record @p count instances of @p value.
+  void Record(std::chrono::microseconds value, std::int64_t count);
+
+  /// Add all the samples in @p rhs, which must use the same configuration.
+  void Merge(LatencyHistogram const& rhs);
+
+  /// Remove all the samples.
+  void Reset();
+
+  std::int64_t count() const { return total_count_; }
+  std::chrono::microseconds min() const;
+  std::chrono::microseconds max() const;
+  std::chrono::microseconds mean() const;
+
+  /**
+   * Return the value at the @p percentile, which is in the [0, 100] range.
+   *
+   * The result is the largest value equivalent (within the histogram
+   * precision) to the sample at that percentile, clamped to `max()`.
+   */
+  std::chrono::microseconds ValueAtPercentile(double percentile) const;
+
+ private:
+  std::size_t CountsIndex(std::int64_t value) const;
+  std::int64_t HighestEquivalentValue(std::size_t index) const;
+
+  std::int64_t highest_;
+  int sub_bucket_half_count_magnitude_;
+  std::int64_t sub_bucket_half_count_;
+  std::int64_t sub_bucket_mask_;
+  std::vector<std::int64_t> counts_;
+  std::int64_t total_count_ = 0;
+  std::int64_t min_;
+  std::int64_t max_ = 0;
+  double sum_ = 0;
+};
+
+/// Return the header for `PrintHistogramCsv()`.
+std::string HistogramCsvHeader();
+
+/**
+ * Print the summary of a histogram as a CSV line, all the values in us.
+ *
+ * The summary includes the count, the number of errors, the throughput, the
+ * minimum, mean and maximum values, and the p50, p75, p90, p95, p99, p99.9 and
+ * p99.99 percentiles.
+ */
+void PrintHistogramCsv(std::ostream& os, std::string const& test_name,
+                       std::string const& op_name,
+                       std::string const& measurement, std::int64_t errors,
+                       std::chrono::milliseconds elapsed,
+                       LatencyHistogram const& histogram);
+
+/// Print the same summary as `PrintHistogramCsv()` as a JSON object.
+void PrintHistogramJson(std::ostream& os, std::string const& test_name,
+                        std::string const& op_name,
+                        std::string const& measurement, std::int64_t errors,
+                        std::chrono::milliseconds elapsed,
+                        LatencyHistogram const& histogram);
+
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_LATENCY_HISTOGRAM_H
@@ -0,0 +1,130 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/latency_histogram.h"
+#include <gmock/gmock.h>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+namespace {
+
+using std::chrono::microseconds;
+using ::testing::HasSubstr;
+using ::testing::StartsWith;
+
+TEST(LatencyHistogramTest, Empty) {
+  LatencyHistogram h;
+  EXPECT_EQ(0, h.count());
+  EXPECT_EQ(microseconds(0), h.min());
+  EXPECT_EQ(microseconds(0), h.max());
+  EXPECT_EQ(microseconds(0), h.mean());
+  EXPECT_EQ(microseconds(0), h.ValueAtPercentile(50));
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+  LatencyHistogram h;
+  for (int i = 1; i <= 100; ++i) h.Record(microseconds(i));
+  EXPECT_EQ(100, h.count());
+  EXPECT_EQ(microseconds(1), h.min());
+  EXPECT_EQ(microseconds(100), h.max());
+  EXPECT_EQ(microseconds(51), h.mean());
+  EXPECT_EQ(microseconds(1), h.ValueAtPercentile(0));
+  EXPECT_EQ(microseconds(50), h.ValueAtPercentile(50));
+  EXPECT_EQ(microseconds(90), h.ValueAtPercentile(90));
+  EXPECT_EQ(microseconds(99), h.ValueAtPercentile(99));
+  EXPECT_EQ(microseconds(100), h.ValueAtPercentile(100));
+}
+
+TEST(LatencyHistogramTest, LargeValuesWithinPrecision) {
+  LatencyHistogram h;
+  for (int i = 1; i <= 1000000; ++i) h.Record(microseconds(i));
+  for (double p : {50.0, 90.0, 99.0, 99.9, 99.99}) {
+    auto const expected = p * 1000000 / 100;
+    auto const actual = static_cast<double>(h.ValueAtPercentile(p).count());
+    EXPECT_NEAR(expected, actual, expected * 0.001) << "p=" << p;
+  }
+  EXPECT_EQ(microseconds(1000000), h.ValueAtPercentile(100));
+}
+
+TEST(LatencyHistogramTest, ClampsLargeValues) {
+  LatencyHistogram h(microseconds(1000));
+  h.Record(microseconds(5));
+  h.Record(microseconds(1000000));
+  EXPECT_EQ(microseconds(1000), h.max());
+  EXPECT_EQ(microseconds(1000), h.ValueAtPercentile(100));
+}
+
+TEST(LatencyHistogramTest, RecordWithCount) {
+  LatencyHistogram h;
+  h.Record(microseconds(10), 99);
+  h.Record(microseconds(20000), 1);
+  EXPECT_EQ(100, h.count());
+  EXPECT_EQ(microseconds(10), h.ValueAtPercentile(99));
+  EXPECT_EQ(microseconds(20000), h.ValueAtPercentile(99.99));
+}
+
+TEST(LatencyHistogramTest, MergeAndReset) {
+  LatencyHistogram a;
+  LatencyHistogram b;
+  for (int i = 1; i <= 50; ++i) a.Record(microseconds(i));
+  for (int i = 51; i <= 100; ++i) b.Record(microseconds(i));
+  a.Merge(b);
+  EXPECT_EQ(100, a.count());
+  EXPECT_EQ(microseconds(1), a.min());
+  EXPECT_EQ(microseconds(100), a.max());
+  EXPECT_EQ(microseconds(75), a.ValueAtPercentile(75));
+
+  a.Reset();
+  EXPECT_EQ(0, a.count());
+  EXPECT_EQ(microseconds(0), a.ValueAtPercentile(75));
+}
+
+TEST(LatencyHistogramTest, PrintCsv) {
+  LatencyHistogram h;
+  for (int i = 1; i <= 100; ++i) h.Record(microseconds(i));
+
+  auto const header = HistogramCsvHeader();
+  EXPECT_THAT(header, StartsWith("name,op.name,measurement,count,errors"));
+  EXPECT_THAT(header, HasSubstr(",p99.99,max,units"));
+
+  std::ostringstream os;
+  PrintHistogramCsv(os, "test", "Read", "Latency", 3,
+                    std::chrono::milliseconds(1000), h);
+  EXPECT_EQ("test,Read,Latency,100,3,100,1,51,50,75,90,95,99,100,100,100,us\n",
+            os.str());
+}
+
+TEST(LatencyHistogramTest, PrintJson) {
+  LatencyHistogram h;
+  h.Record(microseconds(42));
+
+  std::ostringstream os;
+  PrintHistogramJson(os, "test", "Read\"", "Latency", 0,
+                     std::chrono::milliseconds(2000), h);
+  EXPECT_EQ(
+      R"js({"name": "test", "op.name": "Read\"", "measurement": "Latency",)js"
+      R"js( "count": 1, "errors": 0, "throughput.ops": 0.5, "min": 42,)js"
+      R"js( "mean": 42, "p50": 42, "p75": 42, "p90": 42, "p95": 42,)js"
+      R"js( "p99": 42, "p99.9": 42, "p99.99": 42, "max": 42, "units": "us"})js",
+      os.str());
+}
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,406 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/benchmarks/latency_histogram.h"
+#include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include "google/cloud/bigtable/mutation_batcher.h"
+#include "google/cloud/internal/port_platform.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <thread>
+
+/**
+ * @file
+ *
+ * Measure the throughput of `MutationBatcher` for different configurations.
+ *
+ * This benchmark is intended to evaluate changes to `MutationBatcher` and the
+ * bulk mutation code path. It should run with `use-embedded-server=true`, so
+ * the results measure the client library and not the service. The benchmark:
+ *
+ * - Creates an empty table with a single column family.
+ * - The name of the table starts with `batch`, followed by random characters.
+ * - Starts T threads to run a `CompletionQueue` event loop.
+ * - For each combination of the `--batch-sizes` and `--max-batches` values:
+ *   - Creates a `MutationBatcher` with these options.
+ *   - Starts P producer threads, each calling `AsyncApply()` with a mutation
+ *     writing all the columns of a random key, and waiting on the *admission*
+ *     future before submitting the next mutation.
+ *   - After the configured time, waits until all the mutations complete.
+ *   - Reports the throughput, the number of `MutateRows()` RPCs, the time
+ *     waiting for admission (p50, p99, p99.9 and max), and the number of heap
+ *     allocations per mutation.
+ *
+ * The test duration is divided evenly among the configurations.
+ *
+ * Allocations are counted by replacing the global `operator new`, and only on
+ * the producer and `CompletionQueue` threads, so the allocations made by the
+ * embedded server are excluded. Allocations in threads created internally by
+ * gRPC are also excluded.
+ *
+ * In addition to the common benchmark arguments, the benchmark accepts these
+ * flags, which can appear anywhere in the command-line:
+ *
+ * - `--producers=N`: the number of producer threads, default 4.
+ * - `--batch-sizes=N[,N...]`: the values for
+ *   `MutationBatcher::Options::max_mutations_per_batch`, default
+ *   `10,100,1000`.
+ * - `--max-batches=N[,N...]`: the values for
+ *   `MutationBatcher::Options::max_batches`, default `1,4,16`.
+ */
+
+/// Helper functions and types for the mutation_batcher_benchmark.
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using bigtable::benchmarks::Benchmark;
+using bigtable::benchmarks::kNumFields;
+using bigtable::benchmarks::LatencyHistogram;
+using bigtable::benchmarks::MakeBenchmarkSetup;
+using bigtable::benchmarks::MakeRandomMutation;
+
+// Only allocations in threads with this flag set are counted.
+thread_local bool count_allocations = false;
+std::atomic<std::int64_t> allocation_count(0);
+std::atomic<std::int64_t> allocation_bytes(0);
+
+/// Count the heap allocations in the current thread while this object lives.
+class CountAllocations {
+ public:
+  CountAllocations() { count_allocations = true; }
+  ~CountAllocations() { count_allocations = false; }
+};
+
+/// The configuration specific to this benchmark.
+struct BatcherOptions {
+  int producers = 4;
+  std::vector<std::size_t> batch_sizes = {10, 100, 1000};
+  std::vector<std::size_t> max_batches = {1, 4, 16};
+};
+
+/**
+ * Parse (and remove from @p argv) the flags specific to this benchmark.
+ *
+ * The remaining arguments are parsed by `MakeBenchmarkSetup()`.
+ */
+google::cloud::StatusOr<BatcherOptions> ParseBatcherOptions(int& argc,
+                                                            char* argv[]);
+
+/// The results for a single configuration.
+struct RunResult {
+  std::size_t batch_size;
+  std::size_t max_batches;
+  std::int64_t mutations = 0;
+  std::int64_t errors = 0;
+  std::int64_t rpcs = 0;
+  std::int64_t allocations = 0;
+  std::int64_t allocated_bytes = 0;
+  std::chrono::milliseconds elapsed;
+  LatencyHistogram admission_wait;
+};
+
+class MutationBatcherBenchmark {
+ public:
+  MutationBatcherBenchmark(Benchmark& benchmark,
+                           std::string const& app_profile_id,
+                           std::string const& table_id, int producers)
+      : benchmark_(benchmark),
+        table_(benchmark_.MakeDataClient(), app_profile_id, table_id),
+        producers_(producers) {}
+
+  ~MutationBatcherBenchmark() {
+    cq_.Shutdown();
+    for (auto& t : cq_threads_) {
+      t.join();
+    }
+  }
+
+  void ActivateCompletionQueue();
+
+  /// Run a single configuration for @p duration.
+  RunResult Run(std::size_t batch_size, std::size_t max_batches,
+                std::chrono::milliseconds duration);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /// The body of each producer thread.
+  void Producer(bigtable::MutationBatcher& batcher, Clock::time_point deadline,
+                RunResult& result);
+
+  Benchmark& benchmark_;
+  bigtable::Table table_;
+  int const producers_;
+  google::cloud::CompletionQueue cq_;
+  std::vector<std::thread> cq_threads_;
+
+  std::mutex mu_;
+  std::int64_t errors_ = 0;
+};
+
+void PrintCsvHeader(std::ostream& os) {
+  os << "name,batch_size,max_batches,producers,mutations,errors,rpcs"
+     << ",mutations_per_rpc,elapsed_ms,throughput.mutations"
+     << ",admission.p50.us,admission.p99.us,admission.p999.us"
+     << ",admission.max.us,allocations_per_mutation,bytes_per_mutation\n";
+}
+
+void PrintCsv(std::ostream& os, int producers, RunResult const& r) {
+  auto ratio = [](std::int64_t n, std::int64_t d) {
+    return d == 0 ? 0.0 : static_cast<double>(n) / static_cast<double>(d);
+  };
+  os << "batch," << r.batch_size << "," << r.max_batches << "," << producers
+     << "," << r.mutations << "," << r.errors << "," << r.rpcs << ","
+     << ratio(r.mutations, r.rpcs) << "," << r.elapsed.count() << ","
+     << ratio(r.mutations * 1000, r.elapsed.count()) << ","
+     << r.admission_wait.ValueAtPercentile(50).count() << ","
+     << r.admission_wait.ValueAtPercentile(99).count() << ","
+     << r.admission_wait.ValueAtPercentile(99.9).count() << ","
+     << r.admission_wait.max().count() << ","
+     << ratio(r.allocations, r.mutations) << ","
+     << ratio(r.allocated_bytes, r.mutations) << "\n";
+}
+
+}  // anonymous namespace
+
+void* operator new(std::size_t size) {
+  if (count_allocations) {
+    ++allocation_count;
+    allocation_bytes += static_cast<std::int64_t>(size);
+  }
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    throw std::bad_alloc();
+#else
+    std::abort();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+int main(int argc, char* argv[]) {
+  auto options = ParseBatcherOptions(argc, argv);
+  if (!options) {
+    std::cerr << options.status() << "\n";
+    return -1;
+  }
+  auto setup = MakeBenchmarkSetup("batch", argc, argv);
+  if (!setup) {
+    std::cerr << setup.status() << "\n";
+    return -1;
+  }
+  if (!setup->use_embedded_server()) {
+    std::cout << "# WARNING: not using the embedded server, the results"
+              << " include the service latency\n";
+  }
+
+  Benchmark benchmark(*setup);
+  benchmark.CreateTable();
+
+  MutationBatcherBenchmark batcher_benchmark(
+      benchmark, setup->app_profile_id(), setup->table_id(),
+      options->producers);
+  for (int i = 0; i != setup->thread_count(); ++i) {
+    batcher_benchmark.ActivateCompletionQueue();
+  }
+
+  auto const configurations = static_cast<std::chrono::milliseconds::rep>(
+      options->batch_sizes.size() * options->max_batches.size());
+  auto const run_duration = (std::max)(
+      std::chrono::milliseconds(1000),
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          setup->test_duration()) /
+          configurations);
+
+  std::vector<RunResult> results;
+  for (auto batch_size : options->batch_sizes) {
+    for (auto max_batches : options->max_batches) {
+      std::cout << "# Running batch_size=" << batch_size
+                << " max_batches=" << max_batches << " " << std::flush;
+      results.push_back(
+          batcher_benchmark.Run(batch_size, max_batches, run_duration));
+      std::cout << " DONE. Elapsed="
+                << bigtable::benchmarks::FormatDuration(
+                       results.back().elapsed)
+                << "\n";
+    }
+  }
+
+  PrintCsvHeader(std::cout);
+  for (auto const& r : results) {
+    PrintCsv(std::cout, options->producers, r);
+  }
+
+  benchmark.DeleteTable();
+  return 0;
+}
+
+namespace {
+
+google::cloud::StatusOr<std::vector<std::size_t>> ParseSizeList(
+    std::string const& value) {
+  std::vector<std::size_t> result;
+  std::istringstream is(value);
+  for (std::string item; std::getline(is, item, ',');) {
+    auto const v = std::stol(item);
+    if (v <= 0) {
+      return google::cloud::Status(google::cloud::StatusCode::kInvalidArgument,
+                                   "values must be positive: " + value);
+    }
+    result.push_back(static_cast<std::size_t>(v));
+  }
+  if (result.empty()) {
+    return google::cloud::Status(google::cloud::StatusCode::kInvalidArgument,
+                                 "empty list of values");
+  }
+  return result;
+}
+
+google::cloud::StatusOr<BatcherOptions> ParseBatcherOptions(int& argc,
+                                                            char* argv[]) {
+  BatcherOptions options;
+  auto invalid = [](std::string const& arg) {
+    return google::cloud::Status(google::cloud::StatusCode::kInvalidArgument,
+                                 "invalid flag " + arg);
+  };
+  int next = 1;
+  for (int i = 1; i != argc; ++i) {
+    std::string const arg = argv[i];
+    if (arg.rfind("--", 0) != 0) {
+      argv[next++] = argv[i];
+      continue;
+    }
+    auto const eq = arg.find('=');
+    if (eq == std::string::npos) return invalid(arg);
+    auto const name = arg.substr(2, eq - 2);
+    auto const value = arg.substr(eq + 1);
+    if (name == "producers") {
+      options.producers = std::stoi(value);
+      if (options.producers <= 0) return invalid(arg);
+    } else if (name == "batch-sizes") {
+      auto list = ParseSizeList(value);
+      if (!list) return std::move(list).status();
+      options.batch_sizes = *std::move(list);
+    } else if (name == "max-batches") {
+      auto list = ParseSizeList(value);
+      if (!list) return std::move(list).status();
+      options.max_batches = *std::move(list);
+    } else {
+      return invalid(arg);
+    }
+  }
+  argc = next;
+  return options;
+}
+
+void MutationBatcherBenchmark::ActivateCompletionQueue() {
+  cq_threads_.emplace_back(std::thread([this] {
+    CountAllocations counter;
+    cq_.Run();
+  }));
+}
+
+RunResult MutationBatcherBenchmark::Run(std::size_t batch_size,
+                                        std::size_t max_batches,
+                                        std::chrono::milliseconds duration) {
+  RunResult result;
+  result.batch_size = batch_size;
+  result.max_batches = max_batches;
+  bigtable::MutationBatcher batcher(
+      table_, bigtable::MutationBatcher::Options()
+                  .SetMaxMutationsPerBatch(batch_size)
+                  .SetMaxBatches(max_batches));
+
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    errors_ = 0;
+  }
+  auto const initial_rpcs = benchmark_.mutate_rows_count();
+  auto const initial_allocations = allocation_count.load();
+  auto const initial_bytes = allocation_bytes.load();
+  auto const start = Clock::now();
+  auto const deadline = start + duration;
+
+  std::vector<RunResult> partial(static_cast<std::size_t>(producers_));
+  std::vector<std::thread> threads;
+  for (auto& p : partial) {
+    threads.emplace_back(
+        [this, &batcher, deadline, &p] { Producer(batcher, deadline, p); });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  batcher.AsyncWaitForNoPendingRequests().get();
+
+  result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      Clock::now() - start);
+  result.rpcs = benchmark_.mutate_rows_count() - initial_rpcs;
+  result.allocations = allocation_count.load() - initial_allocations;
+  result.allocated_bytes = allocation_bytes.load() - initial_bytes;
+  for (auto const& p : partial) {
+    result.mutations += p.mutations;
+    result.admission_wait.Merge(p.admission_wait);
+  }
+  std::lock_guard<std::mutex> lk(mu_);
+  result.errors = errors_;
+  return result;
+}
+
+void MutationBatcherBenchmark::Producer(bigtable::MutationBatcher& batcher,
+                                        Clock::time_point deadline,
+                                        RunResult& result) {
+  using google::cloud::future;
+  using google::cloud::Status;
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  // Create the mutations before counting allocations, the benchmark measures
+  // the cost of batching them, not the cost of building them.
+  auto make_mutation = [this, &generator] {
+    bigtable::SingleRowMutation mutation(benchmark_.MakeRandomKey(generator));
+    for (int field = 0; field != kNumFields; ++field) {
+      mutation.emplace_back(MakeRandomMutation(generator, field));
+    }
+    return mutation;
+  };
+
+  auto mutation = make_mutation();
+  for (auto now = Clock::now(); now < deadline; now = Clock::now()) {
+    {
+      CountAllocations counter;
+      auto fut = batcher.AsyncApply(cq_, std::move(mutation));
+      fut.second.then([this](future<Status> f) {
+        if (f.get().ok()) return;
+        std::lock_guard<std::mutex> lk(mu_);
+        ++errors_;
+      });
+      fut.first.get();
+    }
+    result.admission_wait.Record(
+        duration_cast<microseconds>(Clock::now() - now));
+    ++result.mutations;
+    mutation = make_mutation();
+  }
+}
+
+}  // anonymous namespace
@@ -0,0 +1,386 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/benchmarks/latency_histogram.h"
+#include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+/**
+ * @file
+ *
+ * Measure the latency of a mixed Cloud Bigtable workload at a fixed rate.
+ *
+ * The other benchmarks are closed-loop: each thread waits for a response before
+ * sending the next request. When the service (or the client library) slows
+ * down, the benchmark also slows down, and the requests that would have been
+ * sent during the slowdown are never measured. This problem, known as
+ * "coordinated omission", hides queueing delays and under-reports the tail
+ * latency.
+ *
+ * This benchmark is open-loop: requests arrive following a Poisson process
+ * with a fixed target rate, independently of how fast the previous requests
+ * complete. The benchmark:
+ *
+ * - Creates a table with a single column family and 10 columns, and populates
+ *   it like the other benchmarks.
+ * - The name of the table starts with `open`, followed by random characters.
+ * - Starts T threads to run a `CompletionQueue` event loop.
+ * - During S seconds, schedules requests at the target rate. Each request is,
+ *   at random and with the configured proportions, one of:
+ *   - `AsyncReadRow()` for a random key,
+ *   - `AsyncApply()` writing all the columns of a random key,
+ *   - `AsyncReadRows()` scanning a fixed number of rows from a random key.
+ * - Waits for all the outstanding requests.
+ *
+ * The latency of each request is measured from the time it was *scheduled* to
+ * start, which corrects for coordinated omission: if the client falls behind,
+ * the time waiting to send the request is included in the latency. The
+ * benchmark also reports the service time (measured from the time the request
+ * actually started), and the scheduling delay itself, which shows if the
+ * client could keep up with the target rate.
+ *
+ * The results are recorded in HDR histograms, and reported (from p50 to
+ * p99.99) as CSV or JSON.
+ *
+ * In addition to the common benchmark arguments, the benchmark accepts these
+ * flags, which can appear anywhere in the command-line:
+ *
+ * - `--target-rate=N`: the number of requests per second, default 1000.
+ * - `--read-percent=N`: the percentage of `AsyncReadRow()`, default 60.
+ * - `--write-percent=N`: the percentage of `AsyncApply()`, default 30, the
+ *   rest of the requests are scans.
+ * - `--scan-size=N`: the number of rows read by each scan, default 100.
+ * - `--output-format=csv|json`: how to report the results, default csv.
+ */
+
+/// Helper functions and types for the open_loop_benchmark.
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using bigtable::benchmarks::Benchmark;
+using bigtable::benchmarks::kColumnFamily;
+using bigtable::benchmarks::kNumFields;
+using bigtable::benchmarks::LatencyHistogram;
+using bigtable::benchmarks::MakeBenchmarkSetup;
+using bigtable::benchmarks::MakeRandomMutation;
+
+/// The configuration specific to this benchmark.
+struct OpenLoopOptions {
+  double target_rate = 1000.0;
+  int read_percent = 60;
+  int write_percent = 30;
+  long scan_size = 100;  // NOLINT(google-runtime-int)
+  std::string output_format = "csv";
+};
+
+/**
+ * Parse (and remove from @p argv) the flags specific to this benchmark.
+ *
+ * The remaining arguments are parsed by `MakeBenchmarkSetup()`.
+ */
+google::cloud::StatusOr<OpenLoopOptions> ParseOpenLoopOptions(int& argc,
+                                                              char* argv[]);
+
+enum OpType { kRead = 0, kWrite = 1, kScan = 2, kOpTypeCount };
+
+char const* const kOpNames[kOpTypeCount] = {"AsyncReadRow()", "AsyncApply()",
+                                            "AsyncReadRows()"};
+
+/// The results for each type of operation.
+struct OpResults {
+  LatencyHistogram response_time;
+  LatencyHistogram service_time;
+  std::int64_t errors = 0;
+};
+
+class OpenLoopBenchmark {
+ public:
+  OpenLoopBenchmark(Benchmark& benchmark, std::string const& app_profile_id,
+                    std::string const& table_id, OpenLoopOptions options)
+      : benchmark_(benchmark),
+        table_(benchmark_.MakeDataClient(), app_profile_id, table_id),
+        options_(std::move(options)),
+        generator_(std::random_device{}()) {}
+
+  ~OpenLoopBenchmark() {
+    cq_.Shutdown();
+    for (auto& t : cq_threads_) {
+      t.join();
+    }
+  }
+
+  void ActivateCompletionQueue();
+
+  /// Run the benchmark for @p test_duration, return the elapsed time.
+  std::chrono::milliseconds Run(std::chrono::seconds test_duration);
+
+  OpResults const& results(OpType type) const { return results_[type]; }
+  LatencyHistogram const& schedule_delay() const { return schedule_delay_; }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  OpType PickOpType();
+  void Issue(OpType type, Clock::time_point scheduled);
+  void OnDone(OpType type, Clock::time_point scheduled, Clock::time_point start,
+              google::cloud::Status const& status);
+
+  Benchmark& benchmark_;
+  bigtable::Table table_;
+  OpenLoopOptions const options_;
+  // Only used by the thread calling `Run()`, no locking required.
+  google::cloud::internal::DefaultPRNG generator_;
+  google::cloud::CompletionQueue cq_;
+  std::vector<std::thread> cq_threads_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::int64_t outstanding_requests_ = 0;
+  OpResults results_[kOpTypeCount];
+  LatencyHistogram schedule_delay_;
+};
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  auto options = ParseOpenLoopOptions(argc, argv);
+  if (!options) {
+    std::cerr << options.status() << "\n";
+    return -1;
+  }
+  auto setup = MakeBenchmarkSetup("open", argc, argv);
+  if (!setup) {
+    std::cerr << setup.status() << "\n";
+    return -1;
+  }
+
+  Benchmark benchmark(*setup);
+
+  // Create and populate the table for the benchmark.
+  benchmark.CreateTable();
+  auto populate_results = benchmark.PopulateTable();
+  if (!populate_results) {
+    std::cerr << populate_results.status() << "\n";
+    return 1;
+  }
+  Benchmark::PrintThroughputResult(std::cout, "open", "Upload",
+                                   *populate_results);
+
+  std::cout << "# Running open-loop benchmark at " << options->target_rate
+            << " ops/s " << std::flush;
+  OpenLoopBenchmark open_loop(benchmark, setup->app_profile_id(),
+                              setup->table_id(), *options);
+  for (int i = 0; i != setup->thread_count(); ++i) {
+    open_loop.ActivateCompletionQueue();
+  }
+  auto elapsed = open_loop.Run(setup->test_duration());
+  std::cout << " DONE. Elapsed="
+            << bigtable::benchmarks::FormatDuration(elapsed) << "\n";
+
+  struct Line {
+    std::string op_name;
+    std::string measurement;
+    std::int64_t errors;
+    LatencyHistogram const* histogram;
+  };
+  std::vector<Line> lines;
+  for (int i = 0; i != kOpTypeCount; ++i) {
+    auto const& r = open_loop.results(static_cast<OpType>(i));
+    lines.push_back({kOpNames[i], "ResponseTime", r.errors, &r.response_time});
+    lines.push_back({kOpNames[i], "ServiceTime", r.errors, &r.service_time});
+  }
+  lines.push_back({"Schedule", "Delay", 0, &open_loop.schedule_delay()});
+
+  if (options->output_format == "json") {
+    std::cout << "[\n";
+    char const* sep = "";
+    for (auto const& l : lines) {
+      std::cout << sep << "  ";
+      bigtable::benchmarks::PrintHistogramJson(std::cout, "open", l.op_name,
+                                               l.measurement, l.errors,
+                                               elapsed, *l.histogram);
+      sep = ",\n";
+    }
+    std::cout << "\n]\n";
+  } else {
+    std::cout << bigtable::benchmarks::HistogramCsvHeader() << "\n";
+    for (auto const& l : lines) {
+      bigtable::benchmarks::PrintHistogramCsv(std::cout, "open", l.op_name,
+                                              l.measurement, l.errors, elapsed,
+                                              *l.histogram);
+    }
+  }
+
+  benchmark.DeleteTable();
+  return 0;
+}
+
+namespace {
+
+google::cloud::StatusOr<OpenLoopOptions> ParseOpenLoopOptions(int& argc,
+                                                              char* argv[]) {
+  OpenLoopOptions options;
+  auto invalid = [](std::string const& arg) {
+    return google::cloud::Status(google::cloud::StatusCode::kInvalidArgument,
+                                 "invalid flag " + arg);
+  };
+  int next = 1;
+  for (int i = 1; i != argc; ++i) {
+    std::string const arg = argv[i];
+    if (arg.rfind("--", 0) != 0) {
+      argv[next++] = argv[i];
+      continue;
+    }
+    auto const eq = arg.find('=');
+    if (eq == std::string::npos) return invalid(arg);
+    auto const name = arg.substr(2, eq - 2);
+    auto const value = arg.substr(eq + 1);
+    if (name == "target-rate") {
+      options.target_rate = std::stod(value);
+      if (options.target_rate <= 0) return invalid(arg);
+    } else if (name == "read-percent") {
+      options.read_percent = std::stoi(value);
+    } else if (name == "write-percent") {
+      options.write_percent = std::stoi(value);
+    } else if (name == "scan-size") {
+      options.scan_size = std::stol(value);
+      if (options.scan_size <= 0) return invalid(arg);
+    } else if (name == "output-format") {
+      if (value != "csv" && value != "json") return invalid(arg);
+      options.output_format = value;
+    } else {
+      return invalid(arg);
+    }
+  }
+  argc = next;
+  if (options.read_percent < 0 || options.write_percent < 0 ||
+      options.read_percent + options.write_percent > 100) {
+    return google::cloud::Status(
+        google::cloud::StatusCode::kInvalidArgument,
+        "read-percent and write-percent must add up to at most 100");
+  }
+  return options;
+}
+
+void OpenLoopBenchmark::ActivateCompletionQueue() {
+  cq_threads_.emplace_back(std::thread([this] { cq_.Run(); }));
+}
+
+std::chrono::milliseconds OpenLoopBenchmark::Run(
+    std::chrono::seconds test_duration) {
+  auto const start = Clock::now();
+  auto const end = start + test_duration;
+  auto mark = start + std::chrono::seconds(1);
+  std::exponential_distribution<double> interval(options_.target_rate);
+
+  for (auto scheduled = start; scheduled < end;) {
+    // The schedule does not depend on how long the requests take, if the
+    // client falls behind it sends the pending requests as fast as it can.
+    std::this_thread::sleep_until(scheduled);
+    Issue(PickOpType(), scheduled);
+    scheduled += std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(interval(generator_)));
+    if (scheduled >= mark) {
+      std::cout << "." << std::flush;
+      mark += std::chrono::seconds(1);
+    }
+  }
+
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return outstanding_requests_ == 0; });
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() -
+                                                               start);
+}
+
+OpType OpenLoopBenchmark::PickOpType() {
+  auto const p = std::uniform_int_distribution<int>(0, 99)(generator_);
+  if (p < options_.read_percent) return kRead;
+  if (p < options_.read_percent + options_.write_percent) return kWrite;
+  return kScan;
+}
+
+void OpenLoopBenchmark::Issue(OpType type, Clock::time_point scheduled) {
+  using google::cloud::future;
+  using google::cloud::Status;
+  using google::cloud::StatusOr;
+
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    ++outstanding_requests_;
+  }
+  auto row_key = benchmark_.MakeRandomKey(generator_);
+  auto const start = Clock::now();
+  auto const filter =
+      bigtable::Filter::ColumnRangeClosed(kColumnFamily, "field0", "field9");
+  switch (type) {
+    case kRead:
+      table_.AsyncReadRow(cq_, std::move(row_key), filter)
+          .then([this, scheduled,
+                 start](future<StatusOr<std::pair<bool, bigtable::Row>>> f) {
+            OnDone(kRead, scheduled, start, f.get().status());
+          });
+      break;
+
+    case kWrite: {
+      bigtable::SingleRowMutation mutation(std::move(row_key));
+      for (int field = 0; field != kNumFields; ++field) {
+        mutation.emplace_back(MakeRandomMutation(generator_, field));
+      }
+      table_.AsyncApply(std::move(mutation), cq_)
+          .then([this, scheduled, start](future<Status> f) {
+            OnDone(kWrite, scheduled, start, f.get());
+          });
+      break;
+    }
+
+    case kScan:
+    default:
+      table_.AsyncReadRows(
+          cq_,
+          [](bigtable::Row const&) {
+            return google::cloud::make_ready_future(true);
+          },
+          [this, scheduled, start](Status const& status) {
+            OnDone(kScan, scheduled, start, status);
+          },
+          bigtable::RowSet(bigtable::RowRange::StartingAt(std::move(row_key))),
+          options_.scan_size, filter);
+      break;
+  }
+}
+
+void OpenLoopBenchmark::OnDone(OpType type, Clock::time_point scheduled,
+                               Clock::time_point start,
+                               google::cloud::Status const& status) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  auto const now = Clock::now();
+
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& r = results_[type];
+  r.response_time.Record(duration_cast<microseconds>(now - scheduled));
+  r.service_time.Record(duration_cast<microseconds>(now - start));
+  schedule_delay_.Record(duration_cast<microseconds>(start - scheduled));
+  if (!status.ok()) ++r.errors;
+  if (--outstanding_requests_ == 0) {
+    cv_.notify_all();
+  }
+}
+
+}  // anonymous namespace
@@ -58,6 +58,7 @@ bigtable_client_hdrs = [
     "mutations.h",
     "polling_policy.h",
     "read_modify_write_rule.h",
+    "read_rows_checkpoint.h",
     "row.h",
     "row_key.h",
     "row_key_sample.h",
@@ -98,6 +99,7 @@ bigtable_client_srcs = [
     "mutation_batcher.cc",
     "mutations.cc",
     "polling_policy.cc",
+    "read_rows_checkpoint.cc",
     "row_range.cc",
     "row_reader.cc",
     "row_set.cc",
@@ -51,6 +51,7 @@ bigtable_client_unit_tests = [
     "mutations_test.cc",
     "polling_policy_test.cc",
     "read_modify_write_rule_test.cc",
+    "read_rows_checkpoint_test.cc",
     "row_range_test.cc",
     "row_reader_test.cc",
     "row_set_test.cc",
@@ -48,6 +48,10 @@ inline namespace BIGTABLE_CLIENT_NS {
  */
 class Filter {
  public:
+  /// Create a filter from its protobuf representation.
+  explicit Filter(::google::bigtable::v2::RowFilter rhs)
+      : filter_(std::move(rhs)) {}
+
   Filter(Filter&&) noexcept = default;
   Filter& operator=(Filter&&) noexcept = default;
   Filter(Filter const&) = default;
@@ -28,11 +28,11 @@ future<std::vector<FailedMutation>> AsyncRetryBulkApply::Create(
     MetadataUpdatePolicy metadata_update_policy,
     std::shared_ptr<bigtable::DataClient> client,
     std::string const& app_profile_id, std::string const& table_name,
-    BulkMutation mut) {
+    BulkMutation mut, BulkApplyProgressCallback on_progress) {
   std::shared_ptr<AsyncRetryBulkApply> bulk_apply(new AsyncRetryBulkApply(
       std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
       idempotent_policy, std::move(metadata_update_policy), std::move(client),
-      app_profile_id, table_name, std::move(mut)));
+      app_profile_id, table_name, std::move(mut), std::move(on_progress)));
   bulk_apply->StartIterationIfNeeded(std::move(cq));
   return bulk_apply->promise_.get_future();
 }
@@ -44,12 +44,13 @@ AsyncRetryBulkApply::AsyncRetryBulkApply(
     MetadataUpdatePolicy metadata_update_policy,
     std::shared_ptr<bigtable::DataClient> client,
     std::string const& app_profile_id, std::string const& table_name,
-    BulkMutation mut)
+    BulkMutation mut, BulkApplyProgressCallback on_progress)
     : rpc_retry_policy_(std::move(rpc_retry_policy)),
       rpc_backoff_policy_(std::move(rpc_backoff_policy)),
       metadata_update_policy_(std::move(metadata_update_policy)),
       client_(std::move(client)),
-      state_(app_profile_id, table_name, idempotent_policy, std::move(mut)) {}
+      state_(app_profile_id, table_name, idempotent_policy, std::move(mut)),
+      on_progress_(std::move(on_progress)) {}
 
 void AsyncRetryBulkApply::StartIterationIfNeeded(CompletionQueue cq) {
   if (!state_.HasPendingMutations()) {
@@ -83,7 +84,13 @@ void AsyncRetryBulkApply::StartIterationIfNeeded(CompletionQueue cq) {
 
 void AsyncRetryBulkApply::OnRead(
     google::bigtable::v2::MutateRowsResponse response) {
-  state_.OnRead(response);
+  auto succeeded = state_.OnRead(response);
+  if (!on_progress_) return;
+  // Permanent failures are also final, report them with the successes so the
+  // caller does not need to wait for any retries to learn about them.
+  auto failed = state_.ConsumeAccumulatedFailures();
+  if (succeeded.empty() && failed.empty()) return;
+  on_progress_(std::move(succeeded), std::move(failed));
 }
 
 void AsyncRetryBulkApply::OnFinish(CompletionQueue cq, Status status) {
@@ -23,12 +23,25 @@
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "absl/memory/memory.h"
+#include <functional>
+#include <vector>
 
 namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
+/**
+ * Receive the results for some of the mutations in a bulk apply.
+ *
+ * The first argument contains the original indices of the mutations that
+ * succeeded, the second the mutations that failed permanently. Mutations
+ * reported via this callback are not reported again in the result of the
+ * `AsyncRetryBulkApply` future.
+ */
+using BulkApplyProgressCallback =
+    std::function<void(std::vector<int>, std::vector<FailedMutation>)>;
+
 /**
  * Implement the retry loop for AsyncBulkApply.
  *
@@ -36,6 +49,10 @@ namespace internal {
  * retry loops: only those mutations that are idempotent and had a transient
  * failure can be retried, and the result for each mutation arrives in a stream.
  * This class implements that retry loop.
+ *
+ * If the caller provides a `BulkApplyProgressCallback` it is invoked as soon as
+ * the final status of each mutation is known, that is, before any other
+ * mutations in the same request are retried. Callbacks are invoked serially.
  */
 class AsyncRetryBulkApply
     : public std::enable_shared_from_this<AsyncRetryBulkApply> {
@@ -47,7 +64,7 @@ class AsyncRetryBulkApply
       MetadataUpdatePolicy metadata_update_policy,
       std::shared_ptr<bigtable::DataClient> client,
       std::string const& app_profile_id, std::string const& table_name,
-      BulkMutation mut);
+      BulkMutation mut, BulkApplyProgressCallback on_progress = {});
 
  private:
   AsyncRetryBulkApply(std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
@@ -56,7 +73,8 @@ class AsyncRetryBulkApply
                       MetadataUpdatePolicy metadata_update_policy,
                       std::shared_ptr<bigtable::DataClient> client,
                       std::string const& app_profile_id,
-                      std::string const& table_name, BulkMutation mut);
+                      std::string const& table_name, BulkMutation mut,
+                      BulkApplyProgressCallback on_progress);
 
   void StartIterationIfNeeded(CompletionQueue cq);
 
@@ -68,6 +86,7 @@ class AsyncRetryBulkApply
   MetadataUpdatePolicy metadata_update_policy_;
   std::shared_ptr<bigtable::DataClient> client_;
   BulkMutatorState state_;
+  BulkApplyProgressCallback on_progress_;
   promise<std::vector<FailedMutation>> promise_;
 };
 
@@ -72,8 +72,8 @@ std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
   admission_promises_to_satisfy.emplace_back(
       std::move(pending.admission_promise));
   Admit(std::move(pending));
-  FlushIfPossible(cq);
-  SatisfyPromises(std::move(admission_promises_to_satisfy), lk);
+  FlushIfPossible();
+  SatisfyPromises(cq, std::move(admission_promises_to_satisfy), lk);
   return res;
 }
 
@@ -136,62 +136,101 @@ bool MutationBatcher::HasSpaceFor(PendingSingleRowMutation const& mut) const {
 }
 
 future<std::vector<FailedMutation>> MutationBatcher::AsyncBulkApplyImpl(
-    Table& table, BulkMutation&& mut, CompletionQueue& cq) {
-  return table.AsyncBulkApply(std::move(mut), cq);
+    Table& table, BulkMutation&& mut, CompletionQueue& cq,
+    internal::BulkApplyProgressCallback on_progress) {
+  return table.AsyncBulkApply(std::move(mut), cq, std::move(on_progress));
 }
 
-bool MutationBatcher::FlushIfPossible(CompletionQueue cq) {
+bool MutationBatcher::FlushIfPossible() {
   if (cur_batch_->num_mutations > 0 &&
       num_outstanding_batches_ < options_.max_batches) {
     ++num_outstanding_batches_;
 
     auto batch = std::make_shared<Batch>();
     cur_batch_.swap(batch);
-    AsyncBulkApplyImpl(table_, std::move(batch->requests), cq)
-        .then([this, cq,
-               batch](future<std::vector<FailedMutation>> failed) mutable {
-          // Calling OnBulkApplyDone here might lead to a deadlock if the
-          // underlying operation completes very quickly, yielding the outer
-          // `.then()` call synchronous. The deadlock would occur because the
-          // mutex is held here and OnBulkApplyDone would try to reacquire it.
-          //
-          // We're not using a lambda here because in C++11 that would mean
-          // copying the `failed` vector.
-          struct Functor {
-            void operator()(CompletionQueue& cq) {
-              self->OnBulkApplyDone(cq, std::move(*batch), std::move(failed));
-            }
-
-            MutationBatcher* self;
-            std::shared_ptr<Batch> batch;
-            std::vector<FailedMutation> failed;
-          };
-          cq.RunAsync(Functor{this, std::move(batch), failed.get()});
-        });
+    flushed_batches_.push_back(std::move(batch));
     return true;
   }
   return false;
 }
 
+void MutationBatcher::SendBatch(CompletionQueue& cq,
+                                std::shared_ptr<Batch> batch) {
+  // The progress callbacks are invoked serially, and always before the future
+  // is satisfied, so they can safely use the batch without locking.
+  auto on_progress = [this, cq, batch](std::vector<int> succeeded,
+                                       std::vector<FailedMutation> failed) {
+    OnBulkApplyProgress(cq, *batch, succeeded, failed);
+  };
+  AsyncBulkApplyImpl(table_, std::move(batch->requests), cq,
+                     std::move(on_progress))
+      .then([this, cq,
+             batch](future<std::vector<FailedMutation>> failed) mutable {
+        // Calling OnBulkApplyDone here might run it (and any continuations
+        // attached to the user's futures) inline with `AsyncApply()` if the
+        // underlying operation completes very quickly, yielding the outer
+        // `.then()` call synchronous.
+        //
+        // We're not using a lambda here because in C++11 that would mean
+        // copying the `failed` vector.
+        struct Functor {
+          void operator()(CompletionQueue& cq) {
+            self->OnBulkApplyDone(cq, std::move(*batch), std::move(failed));
+          }
+
+          MutationBatcher* self;
+          std::shared_ptr<Batch> batch;
+          std::vector<FailedMutation> failed;
+        };
+        cq.RunAsync(Functor{this, std::move(batch), failed.get()});
+      });
+}
+
+bool MutationBatcher::CompleteMutation(Batch& batch, int idx,
+                                       Status status) {
+  if (idx < 0 || static_cast<std::size_t>(idx) >= batch.mutation_data.size()) {
+    // This is a bug on the server or the client, either terminate (when
+    // -fno-exceptions is set) or throw an exception.
+    std::ostringstream os;
+    os << "Index " << idx << " is out of range [0,"
+       << batch.mutation_data.size() << ")";
+    google::cloud::internal::ThrowRuntimeError(std::move(os).str());
+  }
+  MutationData& data = batch.mutation_data[idx];
+  if (data.done) return false;
+  data.completion_promise.set_value(std::move(status));
+  data.done = true;
+  return true;
+}
+
+void MutationBatcher::OnBulkApplyProgress(
+    CompletionQueue cq, Batch& batch, std::vector<int> const& succeeded,
+    std::vector<FailedMutation> const& failed) {
+  // Mutations reported more than once only release their capacity once.
+  std::size_t num_completed = 0;
+  std::size_t completed_size = 0;
+  auto complete = [&](int idx, Status status) {
+    if (!CompleteMutation(batch, idx, std::move(status))) return;
+    ++num_completed;
+    completed_size += batch.mutation_data[idx].request_size;
+  };
+  for (auto idx : succeeded) complete(idx, Status());
+  for (auto const& f : failed) complete(f.original_index(), f.status());
+  batch.num_completed += num_completed;
+  batch.completed_size += completed_size;
+
+  std::unique_lock<std::mutex> lk(mu_);
+  OnMutationsCompleted(cq, num_completed, completed_size,
+                       lk);  // unlocks the lock
+}
+
 void MutationBatcher::OnBulkApplyDone(
     CompletionQueue cq, MutationBatcher::Batch batch,
     std::vector<FailedMutation> const& failed) {
   // First process all the failures, marking the mutations as done after
   // processing them.
   for (auto const& f : failed) {
-    int const idx = f.original_index();
-    if (idx < 0 ||
-        static_cast<std::size_t>(idx) >= batch.mutation_data.size()) {
-      // This is a bug on the server or the client, either terminate (when
-      // -fno-exceptions is set) or throw an exception.
-      std::ostringstream os;
-      os << "Index " << idx << " is out of range [0,"
-         << batch.mutation_data.size() << ")";
-      google::cloud::internal::ThrowRuntimeError(std::move(os).str());
-    }
-    MutationData& data = batch.mutation_data[idx];
-    data.completion_promise.set_value(f.status());
-    data.done = true;
+    CompleteMutation(batch, f.original_index(), f.status());
   }
   // Any remaining mutations are treated as successful.
   for (auto& data : batch.mutation_data) {
@@ -200,18 +239,26 @@ void MutationBatcher::OnBulkApplyDone(
       data.done = true;
     }
   }
-  auto const num_mutations = batch.mutation_data.size();
+  // Only release the capacity not already released by OnBulkApplyProgress().
+  auto const num_mutations = batch.mutation_data.size() - batch.num_completed;
+  auto const size = batch.requests_size - batch.completed_size;
   batch.mutation_data.clear();
 
   std::unique_lock<std::mutex> lk(mu_);
-  outstanding_size_ -= batch.requests_size;
-  num_requests_pending_ -= num_mutations;
   num_outstanding_batches_--;
-  SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
+  OnMutationsCompleted(cq, num_mutations, size, lk);  // unlocks the lock
 }
 
-std::vector<MutationBatcher::AdmissionPromise> MutationBatcher::TryAdmit(
-    CompletionQueue& cq) {
+void MutationBatcher::OnMutationsCompleted(CompletionQueue& cq,
+                                           std::size_t num_completed,
+                                           std::size_t completed_size,
+                                           std::unique_lock<std::mutex>& lk) {
+  outstanding_size_ -= completed_size;
+  num_requests_pending_ -= num_completed;
+  SatisfyPromises(cq, TryAdmit(), lk);  // unlocks the lock
+}
+
+std::vector<MutationBatcher::AdmissionPromise> MutationBatcher::TryAdmit() {
   // Defer satisfying promises until we release the lock.
   std::vector<AdmissionPromise> admission_promises;
 
@@ -223,7 +270,7 @@ std::vector<MutationBatcher::AdmissionPromise> MutationBatcher::TryAdmit(
       Admit(std::move(mut));
       pending_mutations_.pop();
     }
-  } while (FlushIfPossible(cq));
+  } while (FlushIfPossible());
   return admission_promises;
 }
 
@@ -236,8 +283,10 @@ void MutationBatcher::Admit(PendingSingleRowMutation mut) {
 }
 
 void MutationBatcher::SatisfyPromises(
-    std::vector<AdmissionPromise> admission_promises,
+    CompletionQueue& cq, std::vector<AdmissionPromise> admission_promises,
     std::unique_lock<std::mutex>& lk) {
+  std::vector<std::shared_ptr<Batch>> batches;
+  batches.swap(flushed_batches_);
   std::vector<NoMorePendingPromise> no_more_pending_promises;
   if (num_requests_pending_ == 0 && num_outstanding_batches_ == 0) {
     // We should wait not only on num_requests_pending_ being zero but also on
@@ -249,6 +298,12 @@ void MutationBatcher::SatisfyPromises(
   }
   lk.unlock();
 
+  // Start the RPCs without holding the lock, the progress callbacks need to
+  // acquire it and may run before `AsyncBulkApplyImpl()` returns.
+  for (auto& batch : batches) {
+    SendBatch(cq, std::move(batch));
+  }
+
   // Inform the user that we've admitted these mutations and there might be some
   // space in the buffer finally.
   for (auto& promise : admission_promises) {
@@ -17,6 +17,7 @@
 
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/internal/async_bulk_apply.h"
 #include "google/cloud/bigtable/mutations.h"
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/version.h"
@@ -113,7 +114,9 @@ class MutationBatcher {
    * @return *admission* and *completion* futures
    *
    * The *completion* future will report the mutation's status once it
-   * completes.
+   * completes. This happens as soon as the service reports the status for this
+   * mutation, even if other mutations in the same batch are still being
+   * retried.
    *
    * The *admission* future should be used for flow control. In order to bound
    * the memory usage used by `MutationBatcher`, one should not submit more
@@ -161,7 +164,8 @@ class MutationBatcher {
  protected:
   // Wrap calling underlying operation in a virtual function to ease testing.
   virtual future<std::vector<FailedMutation>> AsyncBulkApplyImpl(
-      Table& table, BulkMutation&& mut, CompletionQueue& cq);
+      Table& table, BulkMutation&& mut, CompletionQueue& cq,
+      internal::BulkApplyProgressCallback on_progress);
 
  private:
   using CompletionPromise = promise<Status>;
@@ -188,14 +192,18 @@ class MutationBatcher {
    * A mutation that has been sent to the Cloud Bigtable service.
    *
    * We need to save the `CompletionPromise` associated with each mutation.
-   * Because only failures are reported, we need to track whether the mutation
-   * is "done", so we can simulate a success report.
+   * The result of a mutation may be reported while the batch is in progress or
+   * when the batch completes, we need to track whether the mutation is "done",
+   * so we only satisfy the promise once. The size is needed to release the
+   * admission capacity as soon as the mutation is done.
    */
   struct MutationData {
     explicit MutationData(PendingSingleRowMutation pending)
         : completion_promise(std::move(pending.completion_promise)),
+          request_size(pending.request_size),
           done(false) {}
     CompletionPromise completion_promise;
+    std::size_t request_size;
     bool done;
   };
 
@@ -213,7 +221,8 @@ class MutationBatcher {
    * that `AsyncBulkApply` invokes the callbacks serially. This in turn
    * relies on the fact that `CompletionQueue` invokes callbacks from a
    * streaming response in sequence and that `AsyncRetryOp` doesn't schedule
-   * another attempt before invoking callbacks for the previous one.
+   * another attempt before invoking callbacks for the previous one. The
+   * progress callbacks all happen before the final result is delivered.
    */
   struct Batch {
     Batch() = default;
@@ -222,6 +231,9 @@ class MutationBatcher {
     size_t requests_size{};
     BulkMutation requests;
     std::vector<MutationData> mutation_data;
+    /// Number and size of mutations completed before the batch finished.
+    size_t num_completed{};
+    size_t completed_size{};
   };
 
   /// Check if a mutation doesn't exceed allowed limits.
@@ -246,22 +258,49 @@ class MutationBatcher {
   }
 
   /**
-   * Send the currently constructed batch if there are not too many outstanding
-   * already. If there are no mutations in the batch, it's a noop.
+   * Flush the currently constructed batch if there are not too many
+   * outstanding already. If there are no mutations in the batch, it's a noop.
+   *
+   * Flushed batches are queued in `flushed_batches_`, they are sent once `mu_`
+   * is released, in `SatisfyPromises()`.
    */
-  bool FlushIfPossible(CompletionQueue cq);
+  bool FlushIfPossible();
+
+  /// Send the batch to the service.
+  void SendBatch(CompletionQueue& cq, std::shared_ptr<Batch> batch);
+
+  /// Handle the mutations whose final status is known before the batch ends.
+  void OnBulkApplyProgress(CompletionQueue cq, Batch& batch,
+                           std::vector<int> const& succeeded,
+                           std::vector<FailedMutation> const& failed);
 
   /// Handle a completed batch.
   void OnBulkApplyDone(CompletionQueue cq, MutationBatcher::Batch batch,
                        std::vector<FailedMutation> const& failed);
 
+  /**
+   * Satisfy the completion promise for the mutation at @p idx in @p batch.
+   *
+   * @return false if the mutation was already completed.
+   */
+  static bool CompleteMutation(Batch& batch, int idx, Status status);
+
+  /**
+   * Release the admission capacity used by mutations which are completed.
+   *
+   * Unlocks `lk`.
+   */
+  void OnMutationsCompleted(CompletionQueue& cq, std::size_t num_completed,
+                            std::size_t completed_size,
+                            std::unique_lock<std::mutex>& lk);
+
   /**
    * Try to move mutations waiting in `pending_mutations_` to the currently
    * constructed batch.
    *
    * @return the admission promises of the newly admitted mutations.
    */
-  std::vector<MutationBatcher::AdmissionPromise> TryAdmit(CompletionQueue& cq);
+  std::vector<MutationBatcher::AdmissionPromise> TryAdmit();
 
   /**
    * Append mutation `mut` to the currently constructed batch.
@@ -269,10 +308,10 @@ class MutationBatcher {
   void Admit(PendingSingleRowMutation mut);
 
   /**
-   * Satisfies passed admission promises and potentially the promises of no more
-   * pending requests. Unlocks `lk`.
+   * Sends any flushed batches, satisfies passed admission promises and
+   * potentially the promises of no more pending requests. Unlocks `lk`.
    */
-  void SatisfyPromises(std::vector<AdmissionPromise>,
+  void SatisfyPromises(CompletionQueue& cq, std::vector<AdmissionPromise>,
                        std::unique_lock<std::mutex>& lk);
 
   std::mutex mu_;
@@ -289,6 +328,9 @@ class MutationBatcher {
   /// Currently contructed batch of mutations.
   std::shared_ptr<Batch> cur_batch_;
 
+  /// Batches flushed while holding `mu_`, but not sent yet.
+  std::vector<std::shared_ptr<Batch>> flushed_batches_;
+
   /**
    * These are the mutations which have not been admitted yet. If the user is
    * properly reacting to `admission_promise`s, there should be very few of
@@ -544,6 +544,64 @@ TEST_F(MutationBatcherTest, SmallMutationsDontSkipPending) {
   EXPECT_EQ(0, NumOperationsOutstanding());
 }
 
+TEST_F(MutationBatcherTest, MutationsCompleteBeforeRetries) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo1", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo2", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo3", {bt::SetCell("fam", "col1", 0_ms, "baz"),
+                                  bt::SetCell("fam", "col2", 0_ms, "baz")})});
+  batcher_.reset(new MutationBatcher(
+      table_, MutationBatcher::Options().SetMaxBatches(1).SetMaxOutstandingSize(
+                  MutationSize(mutations[0]) + MutationSize(mutations[1]) +
+                  MutationSize(mutations[2]))));
+
+  // Mutation 2 fails with a transient error and is retried on its own, while
+  // mutation 1 completes immediately and makes space for mutation 3.
+  ExpectInteraction(
+      {Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+       Exchange({mutations[1], mutations[2]}, {ResultPiece({0}, {1}, {})}),
+       Exchange({mutations[2]}, {ResultPiece({0}, {}, {})}),
+       Exchange({mutations[3]}, {ResultPiece({0}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  auto state1 = Apply(mutations[1]);
+  auto state2 = Apply(mutations[2]);
+  EXPECT_TRUE(state2->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(state0->completed);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  auto state3 = Apply(mutations[3]);
+  EXPECT_FALSE(state3->admitted);
+
+  OpenStream();
+  ReadPiece();
+
+  EXPECT_TRUE(state1->completed);
+  EXPECT_STATUS_OK(state1->completion_status);
+  EXPECT_FALSE(state2->completed);
+  EXPECT_TRUE(state3->admitted);
+  EXPECT_FALSE(state3->completed);
+
+  // The original stream finishes, the retry starts.
+  FinishStream();
+  ReadPiece();
+
+  EXPECT_TRUE(state2->completed);
+  EXPECT_STATUS_OK(state2->completion_status);
+  EXPECT_FALSE(state3->completed);
+
+  FinishStream();
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(state3->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
 // Test that waiting until all pending operations finish works in a simple case.
 TEST_F(MutationBatcherTest, WaitForNoPendingSimple) {
   std::vector<SingleRowMutation> mutations(
@@ -678,8 +736,10 @@ TEST_F(MutationBatcherTest, ApplyCompletesImmediately) {
 
    protected:
     future<std::vector<FailedMutation>> AsyncBulkApplyImpl(
-        Table& table, BulkMutation&& mut, CompletionQueue& cq) override {
-      auto res = MutationBatcher::AsyncBulkApplyImpl(table, std::move(mut), cq);
+        Table& table, BulkMutation&& mut, CompletionQueue& cq,
+        internal::BulkApplyProgressCallback on_progress) override {
+      auto res = MutationBatcher::AsyncBulkApplyImpl(
+          table, std::move(mut), cq, std::move(on_progress));
       on_bulk_apply_();
       return res;
     }
@@ -731,7 +791,8 @@ TEST_F(MutationBatcherTest, ApplyCompletesImmediately) {
 
   auto state = Apply(mutations[0]);
   EXPECT_TRUE(state->admitted);
-  EXPECT_FALSE(state->completed);
+  // The mutation is completed as soon as its status is streamed back.
+  EXPECT_TRUE(state->completed);
   EXPECT_EQ(1, NumOperationsOutstanding());
 
   // RunAsync
@@ -741,6 +802,46 @@ TEST_F(MutationBatcherTest, ApplyCompletesImmediately) {
   EXPECT_EQ(0, NumOperationsOutstanding());
 }
 
+TEST_F(MutationBatcherTest, DuplicateProgressCountedOnce) {
+  // Reports the first mutation twice, and leaves the batch outstanding until
+  // `Finish()` is called.
+  class DuplicateProgressBatcher : public MutationBatcher {
+   public:
+    explicit DuplicateProgressBatcher(Table table)
+        : MutationBatcher(std::move(table)) {}
+
+    void Finish() { done_.set_value({}); }
+
+   protected:
+    future<std::vector<FailedMutation>> AsyncBulkApplyImpl(
+        Table&, BulkMutation&&, CompletionQueue&,
+        internal::BulkApplyProgressCallback on_progress) override {
+      on_progress({0}, {});
+      on_progress({0}, {});
+      return done_.get_future();
+    }
+
+   private:
+    promise<std::vector<FailedMutation>> done_;
+  };
+
+  auto* batcher_raw_ptr = new DuplicateProgressBatcher(table_);
+  batcher_.reset(batcher_raw_ptr);
+
+  auto state =
+      Apply(SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}));
+  EXPECT_TRUE(state->admitted);
+  EXPECT_TRUE(state->completed);
+  EXPECT_EQ(batcher_->AsyncWaitForNoPendingRequests().wait_for(1_ms),
+            std::future_status::ready);
+
+  batcher_raw_ptr->Finish();
+  // RunAsync
+  cq_impl_->SimulateCompletion(true);
+  EXPECT_EQ(batcher_->AsyncWaitForNoPendingRequests().wait_for(1_ms),
+            std::future_status::ready);
+}
+
 }  // namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
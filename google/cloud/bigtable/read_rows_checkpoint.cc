@@ -0,0 +1,145 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_rows_checkpoint.h"
+#include <google/bigtable/v2/bigtable.pb.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+// The field numbers in the serialized checkpoint.
+int const kRequestField = 1;
+int const kLastRowKeyField = 2;
+int const kDoneField = 3;
+
+std::uint32_t MakeTag(int field, int wire_type) {
+  return static_cast<std::uint32_t>(field << 3 | wire_type);
+}
+
+int const kWireTypeVarint = 0;
+int const kWireTypeLengthDelimited = 2;
+}  // namespace
+
+ReadRowsCheckpoint::ReadRowsCheckpoint(std::string table_name,
+                                       std::string app_profile_id,
+                                       RowSet row_set, std::int64_t rows_limit,
+                                       Filter filter, RowKeyType last_row_key)
+    : table_name_(std::move(table_name)),
+      app_profile_id_(std::move(app_profile_id)),
+      row_set_(std::move(row_set)),
+      rows_limit_(rows_limit),
+      filter_(std::move(filter)),
+      last_row_key_(std::move(last_row_key)) {
+  if (!last_row_key_.empty()) {
+    row_set_ = row_set_.Intersect(RowRange::Open(last_row_key_, ""));
+  }
+}
+
+void ReadRowsCheckpoint::AdvancePast(RowKeyType const& row_key) {
+  last_row_key_ = row_key;
+  row_set_ = row_set_.Intersect(RowRange::Open(last_row_key_, ""));
+  if (rows_limit_ == 0) return;
+  // Once the limit is reached the scan is done, and `rows_limit_ == 0` would
+  // mean "no limit".
+  if (--rows_limit_ == 0) done_ = true;
+}
+
+std::string ReadRowsCheckpoint::SerializeAsString() const {
+  google::bigtable::v2::ReadRowsRequest request;
+  request.set_table_name(table_name_);
+  request.set_app_profile_id(app_profile_id_);
+  *request.mutable_rows() = row_set_.as_proto();
+  *request.mutable_filter() = filter_.as_proto();
+  request.set_rows_limit(rows_limit_);
+  auto const request_bytes = request.SerializeAsString();
+
+  std::string result;
+  {
+    google::protobuf::io::StringOutputStream output(&result);
+    google::protobuf::io::CodedOutputStream coded(&output);
+    coded.WriteTag(MakeTag(kRequestField, kWireTypeLengthDelimited));
+    coded.WriteVarint32(static_cast<std::uint32_t>(request_bytes.size()));
+    coded.WriteString(request_bytes);
+    coded.WriteTag(MakeTag(kLastRowKeyField, kWireTypeLengthDelimited));
+    coded.WriteVarint32(static_cast<std::uint32_t>(last_row_key_.size()));
+    coded.WriteString(last_row_key_);
+    coded.WriteTag(MakeTag(kDoneField, kWireTypeVarint));
+    coded.WriteVarint32(done_ ? 1 : 0);
+  }
+  return result;
+}
+
+StatusOr<ReadRowsCheckpoint> ReadRowsCheckpoint::ParseFromString(
+    std::string const& serialized) {
+  auto invalid = [](char const* msg) {
+    return Status(StatusCode::kInvalidArgument,
+                  std::string("invalid ReadRowsCheckpoint: ") + msg);
+  };
+  google::bigtable::v2::ReadRowsRequest request;
+  std::string last_row_key;
+  bool done = false;
+
+  google::protobuf::io::CodedInputStream coded(
+      reinterpret_cast<std::uint8_t const*>(serialized.data()),
+      static_cast<int>(serialized.size()));
+  for (auto tag = coded.ReadTag(); tag != 0; tag = coded.ReadTag()) {
+    std::uint32_t size;
+    std::string value;
+    if (tag == MakeTag(kRequestField, kWireTypeLengthDelimited)) {
+      if (!coded.ReadVarint32(&size) || !coded.ReadString(&value, size) ||
+          !request.ParseFromString(value)) {
+        return invalid("cannot parse request");
+      }
+    } else if (tag == MakeTag(kLastRowKeyField, kWireTypeLengthDelimited)) {
+      if (!coded.ReadVarint32(&size) ||
+          !coded.ReadString(&last_row_key, size)) {
+        return invalid("cannot parse last_row_key");
+      }
+    } else if (tag == MakeTag(kDoneField, kWireTypeVarint)) {
+      std::uint32_t v;
+      if (!coded.ReadVarint32(&v)) return invalid("cannot parse done");
+      done = v != 0;
+    } else {
+      return invalid("unknown field");
+    }
+  }
+  if (!coded.ConsumedEntireMessage() || request.table_name().empty()) {
+    return invalid("missing or truncated fields");
+  }
+
+  // The row set in the request already excludes `last_row_key`.
+  RowSet row_set;
+  for (auto& key : *request.mutable_rows()->mutable_row_keys()) {
+    row_set.Append(std::move(key));
+  }
+  for (auto& range : *request.mutable_rows()->mutable_row_ranges()) {
+    row_set.Append(RowRange(std::move(range)));
+  }
+  ReadRowsCheckpoint checkpoint(
+      std::move(*request.mutable_table_name()),
+      std::move(*request.mutable_app_profile_id()), std::move(row_set),
+      request.rows_limit(), Filter(std::move(*request.mutable_filter())));
+  checkpoint.last_row_key_ = std::move(last_row_key);
+  checkpoint.done_ = done;
+  return checkpoint;
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
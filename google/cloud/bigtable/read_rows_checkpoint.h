@@ -0,0 +1,134 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROWS_CHECKPOINT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROWS_CHECKPOINT_H
+
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/row_key.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * The state of a (possibly partially completed) scan.
+ *
+ * Long running scans can use checkpoints to resume after the application
+ * restarts, instead of scanning the table again from the beginning. The
+ * checkpoint contains the rows that remain to be read, the filter, and the
+ * number of rows that remain to be read (if the scan had a limit).
+ *
+ * Use `RowReader::Checkpoint()` to create a checkpoint from a synchronous
+ * scan. For asynchronous scans (`Table::AsyncReadRows()`) create a checkpoint
+ * with the parameters of the scan and call `AdvancePast()` with each row
+ * received by the `on_row` callback. To resume the scan call
+ * `Table::ReadRows()` or `Table::AsyncReadRows()` with the checkpoint.
+ *
+ * The checkpoint can be saved with `SerializeAsString()` and restored with
+ * `ParseFromString()`. The serialized format is a protobuf message:
+ *
+ * @code
+ * message ReadRowsCheckpoint {
+ *   google.bigtable.v2.ReadRowsRequest request = 1;
+ *   bytes last_row_key = 2;
+ *   bool done = 3;
+ * }
+ * @endcode
+ *
+ * @par Example
+ * @code
+ * auto reader = table.ReadRows(bigtable::RowRange::InfiniteRange(),
+ *                              bigtable::Filter::PassAllFilter());
+ * for (auto& row : reader) {
+ *   if (!row) throw std::runtime_error(row.status().message());
+ *   Process(*row);
+ *   if (++count % 10000 == 0) Save(reader.Checkpoint().SerializeAsString());
+ * }
+ * @endcode
+ */
+class ReadRowsCheckpoint {
+ public:
+  /**
+   * Create a checkpoint for a scan.
+   *
+   * @param table_name the full name of the table,
+   *     `projects/<PROJECT>/instances/<INSTANCE>/tables/<TABLE>`.
+   * @param app_profile_id the application profile used by the scan.
+   * @param row_set the rows to read.
+   * @param rows_limit the maximum number of rows to read, zero means no limit.
+   * @param filter the filter applied to the rows.
+   * @param last_row_key if not empty, all the rows up to (and including) this
+   *     key are removed from @p row_set.
+   */
+  ReadRowsCheckpoint(std::string table_name, std::string app_profile_id,
+                     RowSet row_set, std::int64_t rows_limit, Filter filter,
+                     RowKeyType last_row_key = {});
+
+  std::string const& table_name() const { return table_name_; }
+  std::string const& app_profile_id() const { return app_profile_id_; }
+
+  /// The rows that remain to be read.
+  RowSet const& row_set() const { return row_set_; }
+
+  /// The number of rows that remain to be read, zero means no limit.
+  std::int64_t rows_limit() const { return rows_limit_; }
+
+  Filter const& filter() const { return filter_; }
+
+  /// The last row delivered to the application, empty if none.
+  RowKeyType const& last_row_key() const { return last_row_key_; }
+
+  /// Returns true if there are no more rows to read.
+  bool done() const { return done_ || row_set_.IsEmpty(); }
+
+  /**
+   * Update the checkpoint after @p row_key is delivered to the application.
+   *
+   * Rows are delivered in order, so this removes all the keys up to (and
+   * including) @p row_key from `row_set()`, and decrements `rows_limit()`.
+   */
+  void AdvancePast(RowKeyType const& row_key);
+
+  /// Mark the scan as completed, used when the stream ends successfully.
+  void MarkDone() { done_ = true; }
+
+  /// Serialize the checkpoint, see the class documentation for the format.
+  std::string SerializeAsString() const;
+
+  /// Restore a checkpoint saved with `SerializeAsString()`.
+  static StatusOr<ReadRowsCheckpoint> ParseFromString(
+      std::string const& serialized);
+
+ private:
+  std::string table_name_;
+  std::string app_profile_id_;
+  RowSet row_set_;
+  std::int64_t rows_limit_;
+  Filter filter_;
+  RowKeyType last_row_key_;
+  bool done_ = false;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROWS_CHECKPOINT_H
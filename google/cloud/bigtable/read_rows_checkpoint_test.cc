@@ -0,0 +1,136 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_rows_checkpoint.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <google/protobuf/util/message_differencer.h>
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+using ::google::protobuf::util::MessageDifferencer;
+
+auto constexpr kTableName = "projects/p/instances/i/tables/t";
+
+TEST(ReadRowsCheckpointTest, Constructor) {
+  ReadRowsCheckpoint checkpoint(kTableName, "profile",
+                                RowSet(RowRange::Range("a", "m")), 10,
+                                Filter::Latest(1));
+  EXPECT_EQ(kTableName, checkpoint.table_name());
+  EXPECT_EQ("profile", checkpoint.app_profile_id());
+  EXPECT_EQ(RowRange::Range("a", "m"),
+            RowRange(checkpoint.row_set().as_proto().row_ranges(0)));
+  EXPECT_EQ(10, checkpoint.rows_limit());
+  EXPECT_TRUE(MessageDifferencer::Equivalent(Filter::Latest(1).as_proto(),
+                                             checkpoint.filter().as_proto()));
+  EXPECT_EQ("", checkpoint.last_row_key());
+  EXPECT_FALSE(checkpoint.done());
+}
+
+TEST(ReadRowsCheckpointTest, ConstructorWithLastRowKey) {
+  ReadRowsCheckpoint checkpoint(kTableName, "",
+                                RowSet(RowRange::Range("a", "m")), 0,
+                                Filter::PassAllFilter(), "c");
+  auto proto = checkpoint.row_set().as_proto();
+  ASSERT_EQ(1, proto.row_ranges_size());
+  EXPECT_EQ(RowRange::Open("c", "m"), RowRange(proto.row_ranges(0)));
+  EXPECT_EQ("c", checkpoint.last_row_key());
+}
+
+TEST(ReadRowsCheckpointTest, AdvancePast) {
+  ReadRowsCheckpoint checkpoint(kTableName, "",
+                                RowSet(RowRange::Range("a", "m"), "x"), 0,
+                                Filter::PassAllFilter());
+  checkpoint.AdvancePast("b");
+  EXPECT_EQ("b", checkpoint.last_row_key());
+  auto proto = checkpoint.row_set().as_proto();
+  ASSERT_EQ(1, proto.row_ranges_size());
+  EXPECT_EQ(RowRange::Open("b", "m"), RowRange(proto.row_ranges(0)));
+  ASSERT_EQ(1, proto.row_keys_size());
+  EXPECT_EQ("x", proto.row_keys(0));
+  EXPECT_EQ(0, checkpoint.rows_limit());
+  EXPECT_FALSE(checkpoint.done());
+
+  checkpoint.AdvancePast("x");
+  EXPECT_TRUE(checkpoint.done());
+}
+
+TEST(ReadRowsCheckpointTest, AdvancePastLimit) {
+  ReadRowsCheckpoint checkpoint(kTableName, "", RowSet(), 2,
+                                Filter::PassAllFilter());
+  checkpoint.AdvancePast("a");
+  EXPECT_EQ(1, checkpoint.rows_limit());
+  EXPECT_FALSE(checkpoint.done());
+  checkpoint.AdvancePast("b");
+  EXPECT_TRUE(checkpoint.done());
+}
+
+TEST(ReadRowsCheckpointTest, SerializationRoundTrip) {
+  ReadRowsCheckpoint checkpoint(kTableName, "profile",
+                                RowSet(RowRange::Range("a", "m"), "x"), 10,
+                                Filter::Latest(1));
+  checkpoint.AdvancePast("c");
+
+  auto restored =
+      ReadRowsCheckpoint::ParseFromString(checkpoint.SerializeAsString());
+  ASSERT_STATUS_OK(restored);
+  EXPECT_EQ(kTableName, restored->table_name());
+  EXPECT_EQ("profile", restored->app_profile_id());
+  EXPECT_TRUE(MessageDifferencer::Equivalent(checkpoint.row_set().as_proto(),
+                                             restored->row_set().as_proto()));
+  EXPECT_EQ(9, restored->rows_limit());
+  EXPECT_TRUE(MessageDifferencer::Equivalent(Filter::Latest(1).as_proto(),
+                                             restored->filter().as_proto()));
+  EXPECT_EQ("c", restored->last_row_key());
+  EXPECT_FALSE(restored->done());
+}
+
+TEST(ReadRowsCheckpointTest, SerializationDone) {
+  ReadRowsCheckpoint checkpoint(kTableName, "", RowSet(), 0,
+                                Filter::PassAllFilter());
+  checkpoint.MarkDone();
+  auto restored =
+      ReadRowsCheckpoint::ParseFromString(checkpoint.SerializeAsString());
+  ASSERT_STATUS_OK(restored);
+  EXPECT_TRUE(restored->done());
+}
+
+TEST(ReadRowsCheckpointTest, ParseInvalid) {
+  auto restored = ReadRowsCheckpoint::ParseFromString("not-a-checkpoint");
+  EXPECT_EQ(StatusCode::kInvalidArgument, restored.status().code());
+
+  // A valid encoding, but the table name is missing.
+  ReadRowsCheckpoint checkpoint("", "", RowSet(), 0, Filter::PassAllFilter());
+  restored =
+      ReadRowsCheckpoint::ParseFromString(checkpoint.SerializeAsString());
+  EXPECT_EQ(StatusCode::kInvalidArgument, restored.status().code());
+
+  // Truncated input.
+  checkpoint = ReadRowsCheckpoint(kTableName, "", RowSet(), 0,
+                                  Filter::PassAllFilter(), "last-key");
+  auto serialized = checkpoint.SerializeAsString();
+  restored = ReadRowsCheckpoint::ParseFromString(
+      serialized.substr(0, serialized.size() - 5));
+  EXPECT_EQ(StatusCode::kInvalidArgument, restored.status().code());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
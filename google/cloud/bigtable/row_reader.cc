@@ -91,9 +91,26 @@ RowReader::RowReader(
       parser_factory_(std::move(parser_factory)),
       stream_is_open_(false),
       operation_cancelled_(false),
+      finished_(false),
       processed_chunks_count_(0),
       rows_count_(0) {}
 
+RowReader::RowReader(
+    std::shared_ptr<DataClient> client, ReadRowsCheckpoint checkpoint,
+    std::unique_ptr<RPCRetryPolicy> retry_policy,
+    std::unique_ptr<RPCBackoffPolicy> backoff_policy,
+    MetadataUpdatePolicy metadata_update_policy,
+    std::unique_ptr<internal::ReadRowsParserFactory> parser_factory)
+    : RowReader(std::move(client), checkpoint.app_profile_id(),
+                checkpoint.table_name(),
+                checkpoint.done() ? RowSet(RowRange::Empty())
+                                  : RowSet(checkpoint.row_set()),
+                checkpoint.rows_limit(), checkpoint.filter(),
+                std::move(retry_policy), std::move(backoff_policy),
+                std::move(metadata_update_policy), std::move(parser_factory)) {
+  last_read_row_key_ = checkpoint.last_row_key();
+}
+
 // The name must be all lowercase to work with range-for loops.
 RowReader::iterator RowReader::begin() {
   return internal::RowReaderIterator(this);
@@ -152,6 +169,7 @@ StatusOr<RowReader::OptionalRow> RowReader::Advance() {
     OptionalRow row;
     grpc::Status status = AdvanceOrFail(row);
     if (status.ok()) {
+      if (!row) finished_ = true;
       return row;
     }
     row.reset();
@@ -191,6 +209,8 @@ grpc::Status RowReader::AdvanceOrFail(OptionalRow& row) {
   row.reset();
   grpc::Status status;
   if (!stream_) {
+    // There is nothing to read, e.g., when resuming a completed scan.
+    if (row_set_.IsEmpty()) return status;
     MakeRequest();
   }
   while (!parser_->HasNext()) {
@@ -244,6 +264,17 @@ void RowReader::Cancel() {
   (void)stream_->Finish();  // ignore errors
 }
 
+ReadRowsCheckpoint RowReader::Checkpoint() const {
+  auto rows_limit = rows_limit_;
+  if (rows_limit_ != NO_ROWS_LIMIT) rows_limit -= rows_count_;
+  ReadRowsCheckpoint checkpoint(table_name_, app_profile_id_, row_set_,
+                                rows_limit, filter_, last_read_row_key_);
+  if (finished_ || (rows_limit_ != NO_ROWS_LIMIT && rows_limit <= 0)) {
+    checkpoint.MarkDone();
+  }
+  return checkpoint;
+}
+
 RowReader::~RowReader() {
   // Make sure we don't leave open streams.
   Cancel();
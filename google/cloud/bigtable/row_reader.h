@@ -20,6 +20,7 @@
 #include "google/cloud/bigtable/internal/readrowsparser.h"
 #include "google/cloud/bigtable/internal/rowreaderiterator.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
+#include "google/cloud/bigtable/read_rows_checkpoint.h"
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/bigtable/row_set.h"
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
@@ -66,6 +67,18 @@ class RowReader {
             MetadataUpdatePolicy metadata_update_policy,
             std::unique_ptr<internal::ReadRowsParserFactory> parser_factory);
 
+  /**
+   * Resume a scan from @p checkpoint.
+   *
+   * The reader returns the rows that were not delivered when the checkpoint
+   * was created, using the same filter and (remaining) rows limit.
+   */
+  RowReader(std::shared_ptr<DataClient> client, ReadRowsCheckpoint checkpoint,
+            std::unique_ptr<RPCRetryPolicy> retry_policy,
+            std::unique_ptr<RPCBackoffPolicy> backoff_policy,
+            MetadataUpdatePolicy metadata_update_policy,
+            std::unique_ptr<internal::ReadRowsParserFactory> parser_factory);
+
   RowReader(RowReader&&) noexcept = default;
 
   ~RowReader();
@@ -100,6 +113,16 @@ class RowReader {
    */
   void Cancel();
 
+  /**
+   * Return a checkpoint to resume this scan.
+   *
+   * The checkpoint excludes all the rows returned by the iterators so far,
+   * that is, the rows already delivered to the application. Use it with
+   * `Table::ReadRows(ReadRowsCheckpoint)` to continue the scan, for example,
+   * after the application restarts.
+   */
+  ReadRowsCheckpoint Checkpoint() const;
+
  private:
   using OptionalRow = absl::optional<Row>;
 
@@ -151,6 +174,8 @@ class RowReader {
       stream_;
   bool stream_is_open_;
   bool operation_cancelled_;
+  /// Set when the scan completes successfully.
+  bool finished_;
 
   /// The last received response, chunks are being parsed one by one from it.
   google::bigtable::v2::ReadRowsResponse response_;
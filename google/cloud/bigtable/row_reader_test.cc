@@ -26,6 +26,7 @@
 #include <initializer_list>
 
 using testing::_;
+using testing::AllOf;
 using testing::DoAll;
 using testing::Eq;
 using testing::Matcher;
@@ -797,3 +798,99 @@ TEST_F(RowReaderTest, FailedStreamRetryNewContext) {
   EXPECT_EQ((*it)->row_key(), "r1");
   EXPECT_EQ(++it, reader.end());
 }
+
+TEST_F(RowReaderTest, CheckpointExcludesDeliveredRows) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = absl::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1", "r2"});
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _)).WillOnce(stream->MakeMockReturner());
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, kTableName, bigtable::RowSet("r1", "r2", "r3"), 10,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+
+  auto checkpoint = reader.Checkpoint();
+  EXPECT_EQ(3, checkpoint.row_set().as_proto().row_keys_size());
+  EXPECT_EQ(10, checkpoint.rows_limit());
+  EXPECT_FALSE(checkpoint.done());
+
+  auto it = reader.begin();
+  ASSERT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r1");
+
+  checkpoint = reader.Checkpoint();
+  EXPECT_EQ(kTableName, checkpoint.table_name());
+  EXPECT_EQ("r1", checkpoint.last_row_key());
+  auto proto = checkpoint.row_set().as_proto();
+  ASSERT_EQ(2, proto.row_keys_size());
+  EXPECT_EQ("r2", proto.row_keys(0));
+  EXPECT_EQ("r3", proto.row_keys(1));
+  EXPECT_EQ(9, checkpoint.rows_limit());
+  EXPECT_FALSE(checkpoint.done());
+
+  ASSERT_NE(++it, reader.end());
+  EXPECT_EQ(++it, reader.end());
+  EXPECT_TRUE(reader.Checkpoint().done());
+}
+
+TEST_F(RowReaderTest, ResumeFromCheckpoint) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = absl::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r2"});
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, AllOf(RequestWithRowKeysCount(1),
+                                            RequestWithRowsLimit(4))))
+        .WillOnce(stream->MakeMockReturner());
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::ReadRowsCheckpoint checkpoint(
+      kTableName, "", bigtable::RowSet("r1", "r2"), 5,
+      bigtable::Filter::PassAllFilter());
+  checkpoint.AdvancePast("r1");
+  bigtable::RowReader reader(client_, std::move(checkpoint),
+                             std::move(retry_policy_),
+                             std::move(backoff_policy_),
+                             metadata_update_policy_,
+                             std::move(parser_factory_));
+
+  auto it = reader.begin();
+  ASSERT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r2");
+  EXPECT_EQ(++it, reader.end());
+}
+
+TEST_F(RowReaderTest, ResumeCompletedScanDoesNotCallRpc) {
+  EXPECT_CALL(*client_, ReadRows(_, _)).Times(0);
+  EXPECT_CALL(*parser_factory_, CreateHook()).Times(0);
+
+  bigtable::ReadRowsCheckpoint checkpoint(kTableName, "", bigtable::RowSet(),
+                                          bigtable::RowReader::NO_ROWS_LIMIT,
+                                          bigtable::Filter::PassAllFilter());
+  checkpoint.MarkDone();
+  bigtable::RowReader reader(client_, std::move(checkpoint),
+                             std::move(retry_policy_),
+                             std::move(backoff_policy_),
+                             metadata_update_policy_,
+                             std::move(parser_factory_));
+
+  EXPECT_EQ(reader.begin(), reader.end());
+  EXPECT_TRUE(reader.Checkpoint().done());
+}
@@ -178,6 +178,17 @@ future<std::vector<FailedMutation>> Table::AsyncBulkApply(BulkMutation mut,
       app_profile_id_, table_name(), std::move(mut));
 }
 
+future<std::vector<FailedMutation>> Table::AsyncBulkApply(
+    BulkMutation mut, CompletionQueue& cq,
+    std::function<void(std::vector<int>, std::vector<FailedMutation>)>
+        on_progress) {
+  auto mutation_policy = clone_idempotent_mutation_policy();
+  return internal::AsyncRetryBulkApply::Create(
+      cq, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+      *mutation_policy, clone_metadata_update_policy(), client_,
+      app_profile_id_, table_name(), std::move(mut), std::move(on_progress));
+}
+
 RowReader Table::ReadRows(RowSet row_set, Filter filter) {
   return RowReader(
       client_, app_profile_id_, table_name_, std::move(row_set),
@@ -195,6 +206,13 @@ RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
       absl::make_unique<bigtable::internal::ReadRowsParserFactory>());
 }
 
+RowReader Table::ReadRows(ReadRowsCheckpoint checkpoint) {
+  return RowReader(
+      client_, std::move(checkpoint), clone_rpc_retry_policy(),
+      clone_rpc_backoff_policy(), metadata_update_policy_,
+      absl::make_unique<bigtable::internal::ReadRowsParserFactory>());
+}
+
 StatusOr<std::pair<bool, Row>> Table::ReadRow(std::string row_key,
                                               Filter filter) {
   RowSet row_set(std::move(row_key));
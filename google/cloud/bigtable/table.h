@@ -19,9 +19,11 @@
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/async_bulk_apply.h"
 #include "google/cloud/bigtable/idempotent_mutation_policy.h"
 #include "google/cloud/bigtable/mutations.h"
 #include "google/cloud/bigtable/read_modify_write_rule.h"
+#include "google/cloud/bigtable/read_rows_checkpoint.h"
 #include "google/cloud/bigtable/row_key_sample.h"
 #include "google/cloud/bigtable/row_reader.h"
 #include "google/cloud/bigtable/row_set.h"
@@ -33,6 +35,7 @@
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include "absl/meta/type_traits.h"
+#include <functional>
 
 namespace google {
 namespace cloud {
@@ -477,6 +480,18 @@ class Table {
    */
   RowReader ReadRows(RowSet row_set, std::int64_t rows_limit, Filter filter);
 
+  /**
+   * Resumes a scan from a checkpoint.
+   *
+   * @param checkpoint the state of the scan, typically obtained from
+   *     `RowReader::Checkpoint()`. The table name and application profile in
+   *     the checkpoint are used, the policies are taken from this object.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   */
+  RowReader ReadRows(ReadRowsCheckpoint checkpoint);
+
   /**
    * Read and return a single row from the table.
    *
@@ -734,6 +749,42 @@ class Table {
         absl::make_unique<bigtable::internal::ReadRowsParserFactory>());
   }
 
+  /**
+   * Asynchronously resumes a scan from a checkpoint.
+   *
+   * @warning This is an early version of the asynchronous APIs for Cloud
+   *     Bigtable. These APIs might be changed in backward-incompatible ways. It
+   *     is not subject to any SLA or deprecation policy.
+   *
+   * The application maintains the checkpoint, calling
+   * `ReadRowsCheckpoint::AdvancePast()` with each row received by @p on_row.
+   * If the checkpoint is done @p on_finish is called without contacting the
+   * service.
+   *
+   * @param cq the completion queue that will execute the asynchronous calls.
+   * @param on_row the callback to be invoked on each successfully read row,
+   *     see `AsyncReadRows(CompletionQueue, RowSet, Filter)` for details.
+   * @param on_finish the callback to be invoked when the stream is closed.
+   * @param checkpoint the state of the scan. The table name and application
+   *     profile in the checkpoint are used, the policies are taken from this
+   *     object.
+   *
+   * @tparam RowFunctor the type of the @p on_row callback.
+   * @tparam FinishFunctor the type of the @p on_finish callback.
+   */
+  template <typename RowFunctor, typename FinishFunctor>
+  void AsyncReadRows(CompletionQueue& cq, RowFunctor on_row,
+                     FinishFunctor on_finish, ReadRowsCheckpoint checkpoint) {
+    auto row_set = checkpoint.done() ? RowSet(RowRange::Empty())
+                                     : checkpoint.row_set();
+    AsyncRowReader<RowFunctor, FinishFunctor>::Create(
+        cq, client_, checkpoint.app_profile_id(), checkpoint.table_name(),
+        std::move(on_row), std::move(on_finish), std::move(row_set),
+        checkpoint.rows_limit(), checkpoint.filter(), clone_rpc_retry_policy(),
+        clone_rpc_backoff_policy(), metadata_update_policy_,
+        absl::make_unique<bigtable::internal::ReadRowsParserFactory>());
+  }
+
   /**
    * Asynchronously read and return a single row from the table.
    *
@@ -766,6 +817,16 @@ class Table {
                                                       Filter filter);
 
  private:
+  /**
+   * Like `AsyncBulkApply()` but report the results of each mutation early.
+   *
+   * @p on_progress is called with the mutations whose final status becomes
+   * known on each response, these are not included in the returned vector.
+   */
+  future<std::vector<FailedMutation>> AsyncBulkApply(
+      BulkMutation mut, CompletionQueue& cq,
+      internal::BulkApplyProgressCallback on_progress);
+
   /**
    * Send request ReadModifyWriteRowRequest to modify the row and get it back
    */
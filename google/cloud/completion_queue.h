@@ -100,7 +100,9 @@ class CompletionQueue {
    *
    * @param async_call a callable to start the asynchronous RPC.
    * @param request the contents of the request.
-   * @param context an initialized request context to make the call.
+   * @param context an initialized request context to make the call. The
+   *     returned future shares its ownership, so continuations of the future
+   *     may read, for example, the trailing metadata of the call.
    *
    * @tparam AsyncCallType the type of @a async_call. It must be invocable with
    *     `(grpc::ClientContext*, RequestType const&, grpc::CompletionQueue*)`.
@@ -122,10 +124,10 @@ class CompletionQueue {
   future<StatusOr<Response>> MakeUnaryRpc(
       AsyncCallType async_call, Request const& request,
       std::unique_ptr<grpc::ClientContext> context) {
-    auto op =
-        std::make_shared<internal::AsyncUnaryRpcFuture<Request, Response>>();
+    using Operation = internal::AsyncUnaryRpcFuture<Request, Response>;
+    auto op = std::make_shared<Operation>(std::move(context));
     impl_->StartOperation(op, [&](void* tag) {
-      op->Start(async_call, std::move(context), request, &impl_->cq(), tag);
+      op->Start(async_call, request, &impl_->cq(), tag);
     });
     return op->GetFuture();
   }
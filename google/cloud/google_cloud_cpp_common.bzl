@@ -24,6 +24,7 @@ google_cloud_cpp_common_hdrs = [
     "iam_bindings.h",
     "iam_policy.h",
     "internal/backoff_policy.h",
+    "internal/base64.h",
     "internal/big_endian.h",
     "internal/build_info.h",
     "internal/compiler_info.h",
@@ -64,6 +65,7 @@ google_cloud_cpp_common_srcs = [
     "iam_bindings.cc",
     "iam_policy.cc",
     "internal/backoff_policy.cc",
+    "internal/base64.cc",
     "internal/compiler_info.cc",
     "internal/filesystem.cc",
     "internal/format_time_point.cc",
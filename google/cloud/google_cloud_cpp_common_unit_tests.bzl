@@ -23,6 +23,7 @@ google_cloud_cpp_common_unit_tests = [
     "future_void_then_test.cc",
     "iam_bindings_test.cc",
     "internal/backoff_policy_test.cc",
+    "internal/base64_test.cc",
     "internal/big_endian_test.cc",
     "internal/compiler_info_test.cc",
     "internal/env_test.cc",
@@ -14,6 +14,7 @@
 
 #include "google/cloud/internal/backoff_policy.h"
 #include "absl/memory/memory.h"
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -54,6 +55,40 @@ std::chrono::milliseconds ExponentialBackoffPolicy::OnCompletion() {
   return duration_cast<milliseconds>(delay);
 }
 
+std::unique_ptr<BackoffPolicy> DecorrelatedJitterBackoffPolicy::clone() const {
+  return absl::make_unique<DecorrelatedJitterBackoffPolicy>(*this);
+}
+
+std::chrono::milliseconds DecorrelatedJitterBackoffPolicy::OnCompletion() {
+  return NextDelay(initial_delay_);
+}
+
+std::chrono::milliseconds
+DecorrelatedJitterBackoffPolicy::OnCompletionWithDelay(
+    std::chrono::milliseconds server_delay) {
+  return NextDelay((std::max)(
+      initial_delay_,
+      std::chrono::duration_cast<std::chrono::microseconds>(server_delay)));
+}
+
+std::chrono::milliseconds DecorrelatedJitterBackoffPolicy::NextDelay(
+    std::chrono::microseconds lower_bound) {
+  using std::chrono::microseconds;
+  // See `ExponentialBackoffPolicy::OnCompletion()` for why the PRNG is
+  // initialized here.
+  if (!generator_) {
+    generator_ = google::cloud::internal::MakeDefaultPRNG();
+  }
+  // The maximum delay truncates the growth of the delays, but a (longer)
+  // delay suggested by the service always wins.
+  auto const upper_bound =
+      (std::max)(lower_bound, (std::min)(maximum_delay_, 3 * last_delay_));
+  std::uniform_int_distribution<microseconds::rep> rng_distribution(
+      lower_bound.count(), upper_bound.count());
+  last_delay_ = microseconds(rng_distribution(*generator_));
+  return std::chrono::duration_cast<std::chrono::milliseconds>(last_delay_);
+}
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
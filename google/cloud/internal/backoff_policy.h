@@ -19,6 +19,7 @@
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/version.h"
 #include "absl/types/optional.h"
+#include <algorithm>
 #include <chrono>
 #include <memory>
 
@@ -70,6 +71,22 @@ class BackoffPolicy {
    * @return the delay to wait before the next retry attempt.
    */
   virtual std::chrono::milliseconds OnCompletion() = 0;
+
+  /**
+   * Handle an operation completion where the service suggested a delay.
+   *
+   * Some services tell the client how long to wait before retrying, for
+   * example, with a `google.rpc.RetryInfo` error detail. The default
+   * implementation waits for the longer of @p server_delay and the delay
+   * returned by `OnCompletion()`.
+   *
+   * @return the delay to wait before the next retry attempt.
+   */
+  virtual std::chrono::milliseconds OnCompletionWithDelay(
+      std::chrono::milliseconds server_delay) {
+    auto const delay = OnCompletion();
+    return (std::max)(delay, server_delay);
+  }
 };
 
 /**
@@ -157,6 +174,73 @@ class ExponentialBackoffPolicy : public BackoffPolicy {
   absl::optional<DefaultPRNG> generator_;
 };
 
+/**
+ * Implements a backoff policy with "decorrelated jitter".
+ *
+ * Each delay is chosen at random between the initial delay and three times the
+ * previous delay, and truncated to the maximum delay. Compared to
+ * `ExponentialBackoffPolicy` the delays grow about as fast, but they are
+ * spread over a much wider range, so clients that failed at the same time
+ * (for example, several transactions aborted by the same conflict) are less
+ * likely to retry at the same time, too.
+ *
+ * When the service suggests a delay (see `OnCompletionWithDelay()`) that
+ * delay becomes the lower bound for the next one, and the base for the
+ * delays that follow it.
+ *
+ * @see https://aws.amazon.com/blogs/architecture/exponential-backoff-and-jitter/
+ */
+class DecorrelatedJitterBackoffPolicy : public BackoffPolicy {
+ public:
+  /**
+   * Constructor for a decorrelated jitter backoff policy.
+   *
+   * @param initial_delay the smallest delay between operations, must be
+   *     positive.
+   * @param maximum_delay the maximum value for the delay between operations,
+   *     unless the service suggests a longer delay. Must not be smaller than
+   *     @p initial_delay.
+   */
+  template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+  DecorrelatedJitterBackoffPolicy(
+      std::chrono::duration<Rep1, Period1> initial_delay,
+      std::chrono::duration<Rep2, Period2> maximum_delay)
+      : initial_delay_(std::chrono::duration_cast<std::chrono::microseconds>(
+            initial_delay)),
+        maximum_delay_(std::chrono::duration_cast<std::chrono::microseconds>(
+            maximum_delay)),
+        last_delay_(initial_delay_) {
+    if (initial_delay_.count() <= 0) {
+      google::cloud::internal::ThrowInvalidArgument(
+          "initial delay must be positive");
+    }
+    if (maximum_delay_ < initial_delay_) {
+      google::cloud::internal::ThrowInvalidArgument(
+          "maximum delay must be >= initial delay");
+    }
+  }
+
+  // Do not copy the PRNG, see `ExponentialBackoffPolicy` for the details.
+  DecorrelatedJitterBackoffPolicy(
+      DecorrelatedJitterBackoffPolicy const& rhs) noexcept
+      : initial_delay_(rhs.initial_delay_),
+        maximum_delay_(rhs.maximum_delay_),
+        last_delay_(rhs.last_delay_) {}
+
+  std::unique_ptr<BackoffPolicy> clone() const override;
+  std::chrono::milliseconds OnCompletion() override;
+  std::chrono::milliseconds OnCompletionWithDelay(
+      std::chrono::milliseconds server_delay) override;
+
+ private:
+  std::chrono::milliseconds NextDelay(std::chrono::microseconds lower_bound);
+
+  std::chrono::microseconds initial_delay_;
+  std::chrono::microseconds maximum_delay_;
+  std::chrono::microseconds last_delay_;
+  absl::optional<DefaultPRNG> generator_;
+};
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
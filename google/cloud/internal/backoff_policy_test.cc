@@ -17,6 +17,8 @@
 #include <chrono>
 #include <vector>
 
+using google::cloud::internal::BackoffPolicy;
+using google::cloud::internal::DecorrelatedJitterBackoffPolicy;
 using google::cloud::internal::ExponentialBackoffPolicy;
 using ms = std::chrono::milliseconds;
 
@@ -137,3 +139,82 @@ TEST(ExponentialBackoffPolicy, ClonesHaveDifferentSequences) {
 
   EXPECT_THAT(sequence_1, Not(ElementsAreArray(sequence_2)));
 }
+
+/// @test The default OnCompletionWithDelay() honors the service delay.
+TEST(ExponentialBackoffPolicy, OnCompletionWithDelay) {
+  ExponentialBackoffPolicy tested(ms(10), ms(100), 2.0);
+  BackoffPolicy& base = tested;
+
+  EXPECT_EQ(ms(500), base.OnCompletionWithDelay(ms(500)));
+  auto delay = base.OnCompletionWithDelay(ms(0));
+  EXPECT_LE(ms(20), delay);
+  EXPECT_GE(ms(40), delay);
+}
+
+/// @test A simple test for the DecorrelatedJitterBackoffPolicy.
+TEST(DecorrelatedJitterBackoffPolicy, Simple) {
+  DecorrelatedJitterBackoffPolicy tested(ms(10), ms(100));
+
+  auto previous = ms(10);
+  for (int i = 0; i != 100; ++i) {
+    auto delay = tested.OnCompletion();
+    EXPECT_LE(ms(10), delay) << "i=" << i;
+    EXPECT_GE((std::min)(ms(100), 3 * previous), delay) << "i=" << i;
+    // The delays are truncated to milliseconds, the next upper bound is
+    // computed from the exact value.
+    previous = delay + ms(1);
+  }
+}
+
+/// @test Verify that the arguments are validated.
+TEST(DecorrelatedJitterBackoffPolicy, ValidateArguments) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(DecorrelatedJitterBackoffPolicy(ms(0), ms(50)),
+               std::invalid_argument);
+  EXPECT_THROW(DecorrelatedJitterBackoffPolicy(ms(10), ms(5)),
+               std::invalid_argument);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(DecorrelatedJitterBackoffPolicy(ms(0), ms(50)),
+                            "exceptions are disabled");
+  EXPECT_DEATH_IF_SUPPORTED(DecorrelatedJitterBackoffPolicy(ms(10), ms(5)),
+                            "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+/// @test Verify that the delay suggested by the service drives the policy.
+TEST(DecorrelatedJitterBackoffPolicy, OnCompletionWithDelay) {
+  DecorrelatedJitterBackoffPolicy tested(ms(10), ms(100));
+
+  // A suggested delay longer than the maximum is honored.
+  EXPECT_EQ(ms(250), tested.OnCompletionWithDelay(ms(250)));
+  // ... and it is the base for the next delays, subject to the maximum.
+  auto delay = tested.OnCompletion();
+  EXPECT_LE(ms(10), delay);
+  EXPECT_GE(ms(100), delay);
+
+  for (int i = 0; i != 100; ++i) {
+    delay = tested.OnCompletionWithDelay(ms(40));
+    EXPECT_LE(ms(40), delay) << "i=" << i;
+    EXPECT_GE(ms(100), delay) << "i=" << i;
+  }
+}
+
+/// @test Test that cloning produces different numbers.
+TEST(DecorrelatedJitterBackoffPolicy, ClonesHaveDifferentSequences) {
+  // See the comments in the similar ExponentialBackoffPolicy test.
+  std::size_t test_length = 20;
+  DecorrelatedJitterBackoffPolicy original(ms(10), ms((1 << 20) * 10));
+  auto c1 = original.clone();
+  auto c2 = original.clone();
+
+  using milliseconds_type = std::chrono::milliseconds::rep;
+  std::vector<milliseconds_type> sequence_1(test_length);
+  std::generate_n(sequence_1.begin(), test_length,
+                  [&] { return c1->OnCompletion().count(); });
+
+  std::vector<milliseconds_type> sequence_2(test_length);
+  std::generate_n(sequence_2.begin(), test_length,
+                  [&] { return c2->OnCompletion().count(); });
+
+  EXPECT_THAT(sequence_1, Not(ElementsAreArray(sequence_2)));
+}
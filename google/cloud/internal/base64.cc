@@ -0,0 +1,188 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/base64.h"
+#include <array>
+#include <climits>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+constexpr char kPadding = '=';
+
+// The extra braces are working around an old clang bug that was fixed in 6.0
+// https://bugs.llvm.org/show_bug.cgi?id=21629
+constexpr std::array<char, 64> kIndexToChar = {{
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+    'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+    'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/',
+}};
+
+// Maps each character to its 6-bit value, or to 0xFF if it is not part of the
+// alphabet. As the valid values fit in 6 bits, OR-ing the entries for many
+// characters and testing the top bits validates all of them at once.
+//
+// The extra braces are working around an old clang bug that was fixed in 6.0
+// https://bugs.llvm.org/show_bug.cgi?id=21629
+constexpr std::array<unsigned char, UCHAR_MAX + 1> kCharToIndex = {{
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 62,  255,
+    255, 255, 63,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  255, 255,
+    255, 255, 255, 255, 255, 0,   1,   2,   3,   4,   5,   6,   7,   8,   9,
+    10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,
+    25,  255, 255, 255, 255, 255, 255, 26,  27,  28,  29,  30,  31,  32,  33,
+    34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,
+    49,  50,  51,  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255,
+}};
+
+constexpr unsigned kInvalidBits = 0xC0;
+
+// kCharToIndex[] assumes an ASCII execution character set.
+static_assert('A' == 65, "required by base64 decoder");
+
+// UCHAR_MAX is required to be at least 255, meaning std::string::value_type
+// can always hold an octet. If UCHAR_MAX > 255, however, we have no way to
+// base64 encode large values. So, we demand exactly 255.
+static_assert(UCHAR_MAX == 255, "required by base64 decoder");
+
+// The number of characters validated before testing for errors. Grouping the
+// tests keeps the loop free of unpredictable branches.
+constexpr std::ptrdiff_t kValidateStride = 16;
+
+// Returns the number of octets in the chunk at @p p, which ends the input, or
+// -1 if it is not valid. A chunk with padding always ends the input.
+int LastChunkSize(unsigned char const* p) {
+  unsigned const i0 = kCharToIndex[p[0]];
+  unsigned const i1 = kCharToIndex[p[1]];
+  if (((i0 | i1) & kInvalidBits) != 0) return -1;
+  if (p[3] != kPadding) {
+    unsigned const i2 = kCharToIndex[p[2]];
+    unsigned const i3 = kCharToIndex[p[3]];
+    return ((i2 | i3) & kInvalidBits) == 0 ? 3 : -1;
+  }
+  if (p[2] == kPadding) return (i1 & 0xf) == 0 ? 1 : -1;
+  unsigned const i2 = kCharToIndex[p[2]];
+  return (i2 & kInvalidBits) == 0 && (i2 & 0x3) == 0 ? 2 : -1;
+}
+
+}  // namespace
+
+void Base64Encode(unsigned char const* data, std::size_t size, char* out) {
+  auto const* const end = data + size / 3 * 3;
+  for (; data != end; data += 3, out += 4) {
+    std::uint32_t const v = std::uint32_t{data[0]} << 16 |
+                            std::uint32_t{data[1]} << 8 | data[2];
+    out[0] = kIndexToChar[v >> 18];
+    out[1] = kIndexToChar[v >> 12 & 0x3f];
+    out[2] = kIndexToChar[v >> 6 & 0x3f];
+    out[3] = kIndexToChar[v & 0x3f];
+  }
+  switch (size % 3) {
+    case 2: {
+      std::uint32_t const v =
+          std::uint32_t{data[0]} << 16 | std::uint32_t{data[1]} << 8;
+      out[0] = kIndexToChar[v >> 18];
+      out[1] = kIndexToChar[v >> 12 & 0x3f];
+      out[2] = kIndexToChar[v >> 6 & 0x3f];
+      out[3] = kPadding;
+      break;
+    }
+    case 1: {
+      std::uint32_t const v = std::uint32_t{data[0]} << 16;
+      out[0] = kIndexToChar[v >> 18];
+      out[1] = kIndexToChar[v >> 12 & 0x3f];
+      out[2] = kPadding;
+      out[3] = kPadding;
+      break;
+    }
+  }
+}
+
+std::string Base64Encode(unsigned char const* data, std::size_t size) {
+  std::string result(Base64EncodedSize(size), '\0');
+  if (!result.empty()) Base64Encode(data, size, &result[0]);
+  return result;
+}
+
+std::size_t Base64ValidPrefix(char const* data, std::size_t size) {
+  if (size < 4) return 0;
+  auto const* const begin = reinterpret_cast<unsigned char const*>(data);
+  auto const* const last = begin + size / 4 * 4 - 4;
+  auto const* p = begin;
+  while (last - p >= kValidateStride) {
+    unsigned bits = 0;
+    for (auto const* q = p; q != p + kValidateStride; q += 4) {
+      bits |= kCharToIndex[q[0]] | kCharToIndex[q[1]] | kCharToIndex[q[2]] |
+              kCharToIndex[q[3]];
+    }
+    if ((bits & kInvalidBits) != 0) break;
+    p += kValidateStride;
+  }
+  for (; p != last; p += 4) {
+    unsigned const bits = kCharToIndex[p[0]] | kCharToIndex[p[1]] |
+                          kCharToIndex[p[2]] | kCharToIndex[p[3]];
+    if ((bits & kInvalidBits) != 0) break;
+  }
+  if (LastChunkSize(p) >= 0) p += 4;
+  return p - begin;
+}
+
+std::size_t Base64Decode(char const* data, std::size_t size,
+                         unsigned char* out) {
+  if (size < 4) return 0;
+  auto const* p = reinterpret_cast<unsigned char const*>(data);
+  auto const* const last = p + size / 4 * 4 - 4;
+  auto* const begin = out;
+  for (; p != last; p += 4, out += 3) {
+    std::uint32_t const i0 = kCharToIndex[p[0]];
+    std::uint32_t const i1 = kCharToIndex[p[1]];
+    std::uint32_t const i2 = kCharToIndex[p[2]];
+    std::uint32_t const i3 = kCharToIndex[p[3]];
+    if (((i0 | i1 | i2 | i3) & kInvalidBits) != 0) break;
+    std::uint32_t const v = i0 << 18 | i1 << 12 | i2 << 6 | i3;
+    out[0] = static_cast<unsigned char>(v >> 16);
+    out[1] = static_cast<unsigned char>(v >> 8);
+    out[2] = static_cast<unsigned char>(v);
+  }
+  auto const n = LastChunkSize(p);
+  if (n < 0) return out - begin;
+  std::uint32_t v = std::uint32_t{kCharToIndex[p[0]]} << 18 |
+                    std::uint32_t{kCharToIndex[p[1]]} << 12;
+  if (n > 1) v |= std::uint32_t{kCharToIndex[p[2]]} << 6;
+  if (n > 2) v |= kCharToIndex[p[3]];
+  out[0] = static_cast<unsigned char>(v >> 16);
+  if (n > 1) out[1] = static_cast<unsigned char>(v >> 8);
+  if (n > 2) out[2] = static_cast<unsigned char>(v);
+  return out - begin + n;
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,75 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_BASE64_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_BASE64_H
+
+#include "google/cloud/version.h"
+#include <cstddef>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+// Bulk encoding and decoding of padded base64 (RFC 4648 section 4), shared by
+// the libraries that move binary data as base64 text. The functions work on
+// whole buffers, four characters (three octets) at a time, so the callers
+// should avoid feeding them one octet at a time.
+
+/// Returns the number of characters needed to encode @p size octets.
+inline std::size_t Base64EncodedSize(std::size_t size) {
+  return (size + 2) / 3 * 4;
+}
+
+/// Returns the maximum number of octets encoded by @p size characters.
+inline std::size_t Base64DecodedMaxSize(std::size_t size) {
+  return size / 4 * 3;
+}
+
+/**
+ * Writes the padded base64 encoding of the @p size octets at @p data to
+ * @p out, which must have room for `Base64EncodedSize(size)` characters.
+ */
+void Base64Encode(unsigned char const* data, std::size_t size, char* out);
+
+/// Returns the padded base64 encoding of the @p size octets at @p data.
+std::string Base64Encode(unsigned char const* data, std::size_t size);
+
+/**
+ * Returns the length of the longest prefix of @p data made of valid base64
+ * chunks, which is @p size when the whole input is valid.
+ *
+ * A chunk with padding ends the valid prefix, and the bits its padding
+ * discards must be zero, so every valid input is the unique encoding of its
+ * octets.
+ */
+std::size_t Base64ValidPrefix(char const* data, std::size_t size);
+
+/**
+ * Decodes the longest valid prefix of the @p size characters at @p data into
+ * @p out, which must have room for `Base64DecodedMaxSize(size)` octets.
+ *
+ * @return the number of octets written to @p out.
+ */
+std::size_t Base64Decode(char const* data, std::size_t size,
+                         unsigned char* out);
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_BASE64_H
@@ -0,0 +1,139 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/base64.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+std::string Encode(std::string const& octets) {
+  return Base64Encode(reinterpret_cast<unsigned char const*>(octets.data()),
+                      octets.size());
+}
+
+std::string Decode(std::string const& base64) {
+  std::vector<unsigned char> buf(Base64DecodedMaxSize(base64.size()) + 1);
+  auto const n = Base64Decode(base64.data(), base64.size(), buf.data());
+  return std::string(buf.begin(), buf.begin() + n);
+}
+
+TEST(Base64Test, RFC4648TestVectors) {
+  // https://tools.ietf.org/html/rfc4648#section-10
+  std::vector<std::pair<std::string, std::string>> test_cases = {
+      {"", ""},
+      {"f", "Zg=="},
+      {"fo", "Zm8="},
+      {"foo", "Zm9v"},
+      {"foob", "Zm9vYg=="},
+      {"fooba", "Zm9vYmE="},
+      {"foobar", "Zm9vYmFy"},
+  };
+  for (auto const& tc : test_cases) {
+    EXPECT_EQ(tc.second, Encode(tc.first));
+    EXPECT_EQ(tc.second.size(), Base64EncodedSize(tc.first.size()));
+    EXPECT_EQ(tc.second.size(),
+              Base64ValidPrefix(tc.second.data(), tc.second.size()));
+    EXPECT_EQ(tc.first, Decode(tc.second));
+  }
+}
+
+TEST(Base64Test, RoundTripAllOctets) {
+  std::string octets;
+  for (int i = 0; i != 3 * 256; ++i) {
+    octets.push_back(static_cast<char>((i * 7) & 0xff));
+  }
+  // Exercise every length, so each tail and the bulk loops are covered.
+  for (std::size_t n = 0; n != octets.size(); ++n) {
+    auto const input = octets.substr(0, n);
+    auto const encoded = Encode(input);
+    ASSERT_EQ(encoded.size(),
+              Base64ValidPrefix(encoded.data(), encoded.size()))
+        << "n=" << n;
+    ASSERT_EQ(input, Decode(encoded)) << "n=" << n;
+  }
+}
+
+TEST(Base64Test, Alphabet) {
+  std::string const alphabet =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string octets;
+  for (std::size_t i = 0; i != alphabet.size(); i += 4) {
+    unsigned const v = static_cast<unsigned>(i) << 18 |
+                       static_cast<unsigned>(i + 1) << 12 |
+                       static_cast<unsigned>(i + 2) << 6 |
+                       static_cast<unsigned>(i + 3);
+    octets.push_back(static_cast<char>(v >> 16));
+    octets.push_back(static_cast<char>(v >> 8));
+    octets.push_back(static_cast<char>(v));
+  }
+  EXPECT_EQ(alphabet, Encode(octets));
+  EXPECT_EQ(octets, Decode(alphabet));
+}
+
+TEST(Base64Test, ValidPrefix) {
+  struct {
+    std::string input;
+    std::size_t expected;
+  } test_cases[] = {
+      {"A", 0},
+      {"AAA", 0},
+      {"AAAAA", 4},
+      {"AAA=", 4},
+      {"AA==", 4},
+      {"A===", 0},
+      {"====", 0},
+      {"AAAA*AAA", 4},
+      {"AA=AAAAA", 0},
+      {"AA==AAAA", 4},
+      {"AAA=AAAA", 4},
+      {"AB==", 0},  // discards non-zero bits
+      {"AAB=", 0},  // discards non-zero bits
+      {"AAAA\n", 4},
+  };
+  for (auto const& tc : test_cases) {
+    EXPECT_EQ(tc.expected, Base64ValidPrefix(tc.input.data(), tc.input.size()))
+        << "input=" << tc.input;
+  }
+}
+
+TEST(Base64Test, ValidPrefixLongInput) {
+  // Invalid characters are found at any position, including inside the
+  // groups that are validated together.
+  std::string const valid(4 * 100, 'A');
+  for (std::size_t i = 0; i != valid.size(); ++i) {
+    auto input = valid;
+    input[i] = '.';
+    EXPECT_EQ(i / 4 * 4, Base64ValidPrefix(input.data(), input.size()))
+        << "i=" << i;
+    EXPECT_EQ(i / 4 * 3, Decode(input).size()) << "i=" << i;
+  }
+}
+
+TEST(Base64Test, DecodeStopsAtInvalidChunk) {
+  EXPECT_EQ("foo", Decode("Zm9v*m9v"));
+  EXPECT_EQ("foob", Decode("Zm9vYg==Zm9v"));
+  EXPECT_EQ("", Decode("Zm9"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
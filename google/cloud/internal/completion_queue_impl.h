@@ -25,6 +25,7 @@
 #include <grpcpp/alarm.h>
 #include <grpcpp/support/async_stream.h>
 #include <grpcpp/support/async_unary_call.h>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -84,16 +85,16 @@ class AsyncGrpcOperation : public AsyncOperation {
 template <typename Request, typename Response>
 class AsyncUnaryRpcFuture : public AsyncGrpcOperation {
  public:
-  AsyncUnaryRpcFuture() = default;
+  explicit AsyncUnaryRpcFuture(std::unique_ptr<grpc::ClientContext> context)
+      : AsyncUnaryRpcFuture(
+            std::shared_ptr<grpc::ClientContext>(std::move(context))) {}
 
   future<StatusOr<Response>> GetFuture() { return promise_.get_future(); }
 
   /// Prepare the operation to receive the response and start the RPC.
   template <typename AsyncFunctionType>
-  void Start(AsyncFunctionType async_call,
-             std::unique_ptr<grpc::ClientContext> context,
-             Request const& request, grpc::CompletionQueue* cq, void* tag) {
-    context_ = std::move(context);
+  void Start(AsyncFunctionType async_call, Request const& request,
+             grpc::CompletionQueue* cq, void* tag) {
     auto rpc = async_call(context_.get(), request, cq);
     rpc->Finish(&response_, &status_, tag);
   }
@@ -101,6 +102,9 @@ class AsyncUnaryRpcFuture : public AsyncGrpcOperation {
   void Cancel() override { context_->TryCancel(); }
 
  private:
+  explicit AsyncUnaryRpcFuture(std::shared_ptr<grpc::ClientContext> context)
+      : context_(context), promise_([context] { context->TryCancel(); }) {}
+
   bool Notify(bool ok) override {
     if (!ok) {
       // `Finish()` always returns `true` for unary RPCs, so the only time we
@@ -120,11 +124,13 @@ class AsyncUnaryRpcFuture : public AsyncGrpcOperation {
   }
 
   // These are the parameters for the RPC, most of them have obvious semantics.
-  // `context_` is stored as a `unique_ptr` because (a) we need to receive it
+  // `context_` is received as a `unique_ptr` because (a) we need to receive it
   // as a parameter, otherwise the caller could not set timeouts, metadata, or
   // any other attributes, and (b) there is no move or assignment operator for
-  // `grpc::ClientContext`.
-  std::unique_ptr<grpc::ClientContext> context_;
+  // `grpc::ClientContext`. The cancellation callback of the future shares it,
+  // so continuations can still read, e.g., its trailing metadata once this
+  // operation is gone.
+  std::shared_ptr<grpc::ClientContext> context_;
   grpc::Status status_;
   Response response_;
 
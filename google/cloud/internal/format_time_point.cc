@@ -14,16 +14,91 @@
 
 #include "google/cloud/internal/format_time_point.h"
 #include "absl/time/time.h"
+#include <array>
+#include <cstdint>
 
 namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
 
+namespace {
+
+// The range of times that `FormatRfc3339()` formats directly:
+//     [0000-01-01T00:00:00Z, 9999-12-31T23:59:59.999999999Z]
+std::int64_t constexpr kMinFastSeconds = -62167219200;
+std::int64_t constexpr kMaxFastSeconds = 253402300799;
+
+auto constexpr kSecondsPerDay = 24 * 60 * 60;
+
+// Writes @p value to @p p as @p width decimal digits.
+char* FormatDigits(char* p, unsigned value, int width) {
+  for (int i = width - 1; i >= 0; --i) {
+    p[i] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+  return p + width;
+}
+
+}  // namespace
+
 std::string FormatRfc3339(std::chrono::system_clock::time_point tp) {
-  auto constexpr kFormat = "%E4Y-%m-%dT%H:%M:%E*SZ";
-  auto const t = absl::FromChrono(tp);
-  return absl::FormatTime(kFormat, t, absl::UTCTimeZone());
+  using std::chrono::duration_cast;
+  auto const d = tp - std::chrono::system_clock::from_time_t(0);
+  auto s = duration_cast<std::chrono::seconds>(d);
+  if (s > d) s -= std::chrono::seconds(1);  // round toward the infinite past
+  auto const nanos = duration_cast<std::chrono::nanoseconds>(d - s);
+  return FormatRfc3339(static_cast<std::int64_t>(s.count()),
+                       static_cast<std::int32_t>(nanos.count()));
+}
+
+std::string FormatRfc3339(std::int64_t seconds, std::int32_t nanos) {
+  if (seconds < kMinFastSeconds || seconds > kMaxFastSeconds) {
+    auto constexpr kFormat = "%E4Y-%m-%dT%H:%M:%E*SZ";
+    auto const t = absl::FromUnixSeconds(seconds) + absl::Nanoseconds(nanos);
+    return absl::FormatTime(kFormat, t, absl::UTCTimeZone());
+  }
+
+  auto const since_min = static_cast<std::uint64_t>(seconds - kMinFastSeconds);
+  auto const sod = static_cast<unsigned>(since_min % kSecondsPerDay);
+
+  // Convert the day to a civil date, counting from -0400-03-01 so all the
+  // values are positive. See
+  //   http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+  auto constexpr kDaysPerEra = 146097;
+  auto const z =
+      static_cast<unsigned>(since_min / kSecondsPerDay) + kDaysPerEra - 60;
+  auto const era = z / kDaysPerEra;
+  auto const doe = z - era * kDaysPerEra;
+  auto const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  auto const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  auto const mp = (5 * doy + 2) / 153;
+  auto const day = doy - (153 * mp + 2) / 5 + 1;
+  auto const month = mp < 10 ? mp + 3 : mp - 9;
+  auto const year = era * 400 + yoe + (month <= 2 ? 1 : 0) - 400;
+
+  // "YYYY-MM-DDTHH:MM:SS.FFFFFFFFFZ"
+  std::array<char, 30> buf;
+  char* p = buf.data();
+  p = FormatDigits(p, year, 4);
+  *p++ = '-';
+  p = FormatDigits(p, month, 2);
+  *p++ = '-';
+  p = FormatDigits(p, day, 2);
+  *p++ = 'T';
+  p = FormatDigits(p, sod / 3600, 2);
+  *p++ = ':';
+  p = FormatDigits(p, sod / 60 % 60, 2);
+  *p++ = ':';
+  p = FormatDigits(p, sod % 60, 2);
+  if (nanos != 0) {
+    // Like `%E*S`, drop the trailing zeros of the fractional seconds.
+    *p++ = '.';
+    p = FormatDigits(p, static_cast<unsigned>(nanos), 9);
+    while (p[-1] == '0') --p;
+  }
+  *p++ = 'Z';
+  return std::string(buf.data(), p);
 }
 
 std::string FormatUtcDate(std::chrono::system_clock::time_point tp) {
@@ -17,6 +17,7 @@
 
 #include "google/cloud/version.h"
 #include <chrono>
+#include <cstdint>
 #include <string>
 
 namespace google {
@@ -42,6 +43,15 @@ namespace internal {
  */
 std::string FormatRfc3339(std::chrono::system_clock::time_point tp);
 
+/**
+ * Formats the time @p seconds and @p nanos after the Unix epoch as a RFC-3339
+ * timestamp, using the same format as `FormatRfc3339(time_point)`.
+ *
+ * Times in the years 0000 to 9999 are formatted directly, without going through
+ * a generic formatter. @p nanos must be in the range [0, 999999999].
+ */
+std::string FormatRfc3339(std::int64_t seconds, std::int32_t nanos);
+
 /// Format a time point as YYYY-MM-DD.
 std::string FormatUtcDate(std::chrono::system_clock::time_point tp);
 
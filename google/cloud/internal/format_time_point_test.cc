@@ -14,7 +14,10 @@
 
 #include "google/cloud/internal/format_time_point.h"
 #include "google/cloud/internal/parse_rfc3339.h"
+#include "absl/time/time.h"
 #include <gmock/gmock.h>
+#include <cstdint>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -72,6 +75,50 @@ TEST(FormatRfc3339Test, FractionalNanos) {
   }
 }
 
+TEST(FormatRfc3339Test, SecondsAndNanos) {
+  struct {
+    std::int64_t seconds;
+    std::int32_t nanos;
+    std::string expected;
+  } tests[] = {
+      {0, 0, "1970-01-01T00:00:00Z"},
+      {1526654523L, 0, "2018-05-18T14:42:03Z"},
+      {1526654523L, 100000000, "2018-05-18T14:42:03.1Z"},
+      {1526654523L, 1, "2018-05-18T14:42:03.000000001Z"},
+      {1526654523L, 123456780, "2018-05-18T14:42:03.12345678Z"},
+      {1583020799L, 0, "2020-02-29T23:59:59Z"},
+      {-1, 500000000, "1969-12-31T23:59:59.5Z"},
+      {-2203891200L, 0, "1900-03-01T00:00:00Z"},
+      {-62135596800L, 0, "0001-01-01T00:00:00Z"},
+      {-62167219200L, 0, "0000-01-01T00:00:00Z"},
+      {253402300799L, 999999999, "9999-12-31T23:59:59.999999999Z"},
+      // These are outside the range formatted directly.
+      {-62167219201L, 0, "-001-12-31T23:59:59Z"},
+      {253402300800L, 0, "10000-01-01T00:00:00Z"},
+  };
+  for (auto const& test : tests) {
+    EXPECT_EQ(test.expected, FormatRfc3339(test.seconds, test.nanos));
+  }
+}
+
+TEST(FormatRfc3339Test, RoundTripMatchesAbsl) {
+  // Walk through the range an odd number of seconds at a time, so all the days
+  // of the month, and many month and year boundaries, are covered.
+  auto constexpr kStep = std::int64_t{86399 * 7 + 13};
+  for (std::int64_t s = -62167219200L; s <= 253402300799L; s += kStep) {
+    auto const t = absl::FromUnixSeconds(s);
+    auto const formatted = FormatRfc3339(s, 0);
+    ASSERT_EQ(absl::FormatTime("%E4Y-%m-%dT%H:%M:%SZ", t, absl::UTCTimeZone()),
+              formatted);
+    std::int64_t parsed;
+    std::int32_t nanos;
+    ASSERT_TRUE(ParseCanonicalRfc3339(formatted, &parsed, &nanos))
+        << formatted;
+    ASSERT_EQ(s, parsed) << formatted;
+    ASSERT_EQ(0, nanos) << formatted;
+  }
+}
+
 TEST(FormatV4SignedUrlTimestampTest, Base) {
   auto timestamp = ParseRfc3339("2019-08-02T01:02:03Z");
   std::string actual = FormatV4SignedUrlTimestamp(timestamp);
@@ -16,6 +16,7 @@
 #include "google/cloud/internal/throw_delegate.h"
 #include <array>
 #include <cctype>
+#include <cstdint>
 #include <cstdio>
 #include <iomanip>
 #include <iostream>
@@ -35,6 +36,19 @@ bool IsLeapYear(int year) {
   return (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0));
 }
 
+// Returns the number of days from 1970-01-01 to the given date, in the
+// proleptic Gregorian calendar. See
+//   http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+std::int64_t DaysFromCivil(std::int64_t year, unsigned month, unsigned day) {
+  year -= month <= 2 ? 1 : 0;
+  auto const era = (year >= 0 ? year : year - 399) / 400;
+  auto const yoe = static_cast<unsigned>(year - era * 400);
+  auto const mp = month > 2 ? month - 3 : month + 9;  // March is 0
+  auto const doy = (153 * mp + 2) / 5 + day - 1;
+  auto const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
 auto constexpr kMonthsInYear = 12;
 auto constexpr kHoursInDay = 24;
 auto constexpr kMinutesInHour =
@@ -192,8 +206,79 @@ namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
+bool ParseCanonicalRfc3339(std::string const& timestamp, std::int64_t* seconds,
+                           std::int32_t* nanos) {
+  // "YYYY-MM-DDTHH:MM:SSZ" has 20 characters, and each fractional digit, plus
+  // the '.' before them, adds one more.
+  std::size_t constexpr kMinSize = 20;
+  std::size_t constexpr kMaxSize = kMinSize + 1 + 9;
+  auto const size = timestamp.size();
+  if (size < kMinSize || size == kMinSize + 1 || size > kMaxSize) return false;
+
+  // Check all the characters before rejecting the input, so the common case
+  // runs without branches.
+  char const* p = timestamp.data();
+  bool bad = false;
+  auto digit = [p, &bad](std::size_t i) {
+    unsigned const d = static_cast<unsigned char>(p[i]) - unsigned{'0'};
+    bad |= d > 9;
+    return d;
+  };
+  auto const year = digit(0) * 1000 + digit(1) * 100 + digit(2) * 10 + digit(3);
+  auto const month = digit(5) * 10 + digit(6);
+  auto const day = digit(8) * 10 + digit(9);
+  auto const hours = digit(11) * 10 + digit(12);
+  auto const minutes = digit(14) * 10 + digit(15);
+  auto const secs = digit(17) * 10 + digit(18);
+  bad |= p[4] != '-';
+  bad |= p[7] != '-';
+  bad |= p[10] != 'T';
+  bad |= p[13] != ':';
+  bad |= p[16] != ':';
+  bad |= p[size - 1] != 'Z';
+  std::uint32_t fraction = 0;
+  if (size != kMinSize) {
+    bad |= p[kMinSize - 1] != '.';
+    for (auto i = kMinSize; i != size - 1; ++i) {
+      fraction = fraction * 10 + digit(i);
+    }
+    // Scale to nanoseconds, there are `size - kMinSize - 1` digits.
+    for (auto i = size; i != kMaxSize; ++i) fraction *= 10;
+  }
+  if (bad) return false;
+
+  // Double braces are needed to workaround a clang-3.8 bug.
+  std::array<unsigned, kMonthsInYear> constexpr kDaysInMonth{{
+      31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31,
+  }};
+  if (month < 1 || month > kMonthsInYear || day < 1) return false;
+  auto const leap = month == 2 && IsLeapYear(static_cast<int>(year));
+  if (day > kDaysInMonth[month - 1] + (leap ? 1 : 0)) return false;
+  if (hours >= kHoursInDay || minutes >= kMinutesInHour ||
+      secs >= kSecondsInMinute) {
+    return false;
+  }
+
+  auto const days = DaysFromCivil(year, month, day);
+  *seconds = ((days * kHoursInDay + hours) * kMinutesInHour + minutes) *
+                 kSecondsInMinute +
+             secs;
+  *nanos = static_cast<std::int32_t>(fraction);
+  return true;
+}
+
 std::chrono::system_clock::time_point ParseRfc3339(
     std::string const& timestamp) {
+  std::int64_t seconds;
+  std::int32_t nanos;
+  if (ParseCanonicalRfc3339(timestamp, &seconds, &nanos)) {
+    using std::chrono::duration_cast;
+    using Duration = std::chrono::system_clock::duration;
+    return std::chrono::system_clock::from_time_t(0) +
+           duration_cast<Duration>(std::chrono::seconds(seconds)) +
+           duration_cast<Duration>(std::chrono::nanoseconds(nanos));
+  }
+
   // TODO(#530) - dynamically change the timezone offset.
   // Because this computation is a bit expensive, assume the timezone offset
   // does not change during the lifetime of the program.  This function takes
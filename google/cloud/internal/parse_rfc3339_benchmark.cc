@@ -0,0 +1,85 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/format_time_point.h"
+#include "google/cloud/internal/parse_rfc3339.h"
+#include "absl/time/time.h"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+// Run on (1 X 2100 MHz CPU )
+// CPU Caches:
+//   L1 Data 48 KiB (x1)
+//   L1 Instruction 32 KiB (x1)
+//   L2 Unified 2048 KiB (x1)
+//   L3 Unified 307200 KiB (x1)
+// Load Average: 0.52, 0.61, 0.66
+// -------------------------------------------------------------------
+// Benchmark                         Time             CPU   Iterations
+// -------------------------------------------------------------------
+// BM_ParseRfc3339Canonical       49.8 ns         47.1 ns     13859788
+// BM_ParseRfc3339Offset          2554 ns         2479 ns       211518
+// BM_FormatRfc3339               68.4 ns         62.3 ns     12438058
+// BM_FormatRfc3339Absl            534 ns          464 ns      1595264
+
+// The timestamps in the metadata of each object or bucket use the canonical
+// form, while the offset form goes through the general parser.
+std::string const kCanonical = "2020-09-25T17:42:03.123456789Z";
+std::string const kOffset = "2020-09-25T17:42:03.123456789+00:00";
+
+void BM_ParseRfc3339Canonical(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ParseRfc3339(kCanonical));
+  }
+}
+BENCHMARK(BM_ParseRfc3339Canonical);
+
+void BM_ParseRfc3339Offset(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ParseRfc3339(kOffset));
+  }
+}
+BENCHMARK(BM_ParseRfc3339Offset);
+
+void BM_FormatRfc3339(benchmark::State& state) {
+  auto const tp = ParseRfc3339(kCanonical);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FormatRfc3339(tp));
+  }
+}
+BENCHMARK(BM_FormatRfc3339);
+
+// The generic formatter, as used by `FormatRfc3339()` outside the years 0000
+// to 9999.
+void BM_FormatRfc3339Absl(benchmark::State& state) {
+  auto const t = absl::FromChrono(ParseRfc3339(kCanonical));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        absl::FormatTime("%E4Y-%m-%dT%H:%M:%E*SZ", t, absl::UTCTimeZone()));
+  }
+}
+BENCHMARK(BM_FormatRfc3339Absl);
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -14,7 +14,9 @@
 
 #include "google/cloud/internal/parse_rfc3339.h"
 #include <gtest/gtest.h>
+#include <cstdint>
 #include <ctime>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -408,6 +410,76 @@ TEST(ParseRfc3339Test, DetectOutOfRangeOffsetMinute) {
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 }
 
+TEST(ParseCanonicalRfc3339Test, Parse) {
+  struct {
+    std::string input;
+    std::int64_t seconds;
+    std::int32_t nanos;
+  } tests[] = {
+      // Use `date -u +%s --date='....'` to get the expected values.
+      {"1970-01-01T00:00:00Z", 0, 0},
+      {"2018-05-18T14:42:03Z", 1526654523L, 0},
+      {"2018-05-18T14:42:03.1Z", 1526654523L, 100000000},
+      {"2018-05-18T14:42:03.000000001Z", 1526654523L, 1},
+      {"2018-05-18T14:42:03.123456789Z", 1526654523L, 123456789},
+      {"2020-02-29T23:59:59Z", 1583020799L, 0},
+      {"1969-12-31T23:59:59.5Z", -1, 500000000},
+      {"1900-03-01T00:00:00Z", -2203891200L, 0},
+      {"0001-01-01T00:00:00Z", -62135596800L, 0},
+      {"0000-01-01T00:00:00Z", -62167219200L, 0},
+      {"9999-12-31T23:59:59.999999999Z", 253402300799L, 999999999},
+  };
+  for (auto const& test : tests) {
+    std::int64_t seconds = -42;
+    std::int32_t nanos = -42;
+    EXPECT_TRUE(ParseCanonicalRfc3339(test.input, &seconds, &nanos))
+        << " when testing with input=" << test.input;
+    EXPECT_EQ(test.seconds, seconds)
+        << " when testing with input=" << test.input;
+    EXPECT_EQ(test.nanos, nanos) << " when testing with input=" << test.input;
+  }
+}
+
+TEST(ParseCanonicalRfc3339Test, OtherForms) {
+  std::string const inputs[] = {
+      "",
+      "2018-05-18t14:42:03Z",
+      "2018-05-18T14:42:03z",
+      "2018-05-18T14:42:03+08:00",
+      "2018-05-18T14:42:03.Z",
+      "2018-05-18T14:42:03.1234567890Z",
+      "2018-05-18T14:42:60Z",
+      "2018-05-18T14:60:03Z",
+      "2018-05-18T24:42:03Z",
+      "2018-02-29T14:42:03Z",
+      "2018-04-31T14:42:03Z",
+      "2018-00-18T14:42:03Z",
+      "2018-13-18T14:42:03Z",
+      "2018-05-00T14:42:03Z",
+      "2018-05-18 14:42:03Z",
+      "2018/05/18T14:42:03Z",
+      "2018-05-18T14-42-03Z",
+      "2018-05-18T14:42:0aZ",
+      "2018-05-18T14:42:03.12a4Z",
+      "12018-05-18T14:42:03Z",
+  };
+  for (auto const& input : inputs) {
+    std::int64_t seconds = -42;
+    std::int32_t nanos = -42;
+    EXPECT_FALSE(ParseCanonicalRfc3339(input, &seconds, &nanos))
+        << " when testing with input=" << input;
+    EXPECT_EQ(-42, seconds);
+    EXPECT_EQ(-42, nanos);
+  }
+}
+
+TEST(ParseRfc3339Test, LeapSecondUsesGeneralParser) {
+  auto timestamp = ParseRfc3339("2016-12-31T23:59:60Z");
+  // Use `date -u +%s --date='2017-01-01T00:00:00Z'` to get the magic value.
+  EXPECT_EQ(1483228800L,
+            duration_cast<seconds>(timestamp.time_since_epoch()).count());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
@@ -30,6 +30,16 @@ using BackoffPolicy = ::google::cloud::internal::BackoffPolicy;
 using ExponentialBackoffPolicy =
     google::cloud::internal::ExponentialBackoffPolicy;
 
+/**
+ * A backoff policy with randomized delays that honors the delay suggested by
+ * the service, see `google::cloud::internal::DecorrelatedJitterBackoffPolicy`.
+ *
+ * `Client::Commit()` uses this policy by default to wait before rerunning an
+ * aborted transaction.
+ */
+using DecorrelatedJitterBackoffPolicy =
+    google::cloud::internal::DecorrelatedJitterBackoffPolicy;
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
 }  // namespace cloud
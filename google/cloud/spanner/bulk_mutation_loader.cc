@@ -0,0 +1,253 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/bulk_mutation_loader.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+namespace spanner_proto = ::google::spanner::v1;
+
+std::string const& TableName(spanner_proto::Mutation const& m) {
+  switch (m.operation_case()) {
+    case spanner_proto::Mutation::kInsert:
+      return m.insert().table();
+    case spanner_proto::Mutation::kUpdate:
+      return m.update().table();
+    case spanner_proto::Mutation::kInsertOrUpdate:
+      return m.insert_or_update().table();
+    case spanner_proto::Mutation::kReplace:
+      return m.replace().table();
+    case spanner_proto::Mutation::kDelete:
+      return m.delete_().table();
+    default:
+      break;
+  }
+  static auto const* const kEmpty = new std::string;
+  return *kEmpty;
+}
+
+std::size_t CellCount(spanner_proto::Mutation const& m) {
+  auto write_cells = [](spanner_proto::Mutation::Write const& w) {
+    return static_cast<std::size_t>(w.columns_size()) *
+           static_cast<std::size_t>(w.values_size());
+  };
+  std::size_t cells = 0;
+  switch (m.operation_case()) {
+    case spanner_proto::Mutation::kInsert:
+      cells = write_cells(m.insert());
+      break;
+    case spanner_proto::Mutation::kUpdate:
+      cells = write_cells(m.update());
+      break;
+    case spanner_proto::Mutation::kInsertOrUpdate:
+      cells = write_cells(m.insert_or_update());
+      break;
+    case spanner_proto::Mutation::kReplace:
+      cells = write_cells(m.replace());
+      break;
+    case spanner_proto::Mutation::kDelete:
+      cells = static_cast<std::size_t>(m.delete_().key_set().keys_size() +
+                                       m.delete_().key_set().ranges_size());
+      break;
+    default:
+      break;
+  }
+  return (std::max)(cells, std::size_t{1});
+}
+
+}  // namespace
+
+double BulkMutationLoaderStats::MutationsPerSecond() const {
+  if (elapsed.count() <= 0) return 0;
+  return static_cast<double>(mutations_committed) * 1.0e6 /
+         static_cast<double>(elapsed.count());
+}
+
+BulkMutationLoader::BulkMutationLoader(Client client,
+                                       BulkMutationLoaderOptions options)
+    : client_(std::move(client)),
+      options_(std::move(options)),
+      start_(std::chrono::steady_clock::now()) {}
+
+BulkMutationLoader::~BulkMutationLoader() { Flush(); }
+
+BulkMutationLoader::PendingCommit::PendingCommit(
+    Batch b, BulkMutationLoaderOptions const& options)
+    : batch(std::move(b)),
+      transaction(MakeReadWriteTransaction()),
+      rerun_policy(options.rerun_policy()->clone()),
+      retry_policy(options.retry_policy()->clone()),
+      backoff_policy(options.backoff_policy()->clone()) {}
+
+Status BulkMutationLoader::Apply(Mutation mutation) {
+  auto const& proto = internal::MutationProto(mutation);
+  auto const cells = CellCount(proto);
+  auto const bytes = proto.ByteSizeLong();
+  auto const& table = TableName(proto);
+
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!status_.ok()) return status_;
+  DrainRetries(lk, (std::numeric_limits<std::size_t>::max)());
+
+  std::vector<Batch> ready;
+  auto& batch = batches_[table];
+  if (!batch.mutations.empty() &&
+      (batch.cells + cells > options_.max_cells_per_commit() ||
+       batch.bytes + bytes > options_.max_bytes_per_commit())) {
+    ready.push_back(std::move(batch));
+    batch = Batch{};
+  }
+  batch.mutations.push_back(std::move(mutation));
+  batch.cells += cells;
+  batch.bytes += bytes;
+  if (batch.cells >= options_.max_cells_per_commit() ||
+      batch.bytes >= options_.max_bytes_per_commit()) {
+    ready.push_back(std::move(batch));
+    batch = Batch{};
+  }
+  for (auto& b : ready) Send(lk, std::move(b));
+  return status_;
+}
+
+Status BulkMutationLoader::Flush() {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto batches = std::move(batches_);
+  batches_.clear();
+  for (auto& kv : batches) {
+    if (!kv.second.mutations.empty()) Send(lk, std::move(kv.second));
+  }
+  DrainRetries(lk, 0);
+  return status_;
+}
+
+BulkMutationLoaderStats BulkMutationLoader::Stats() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto stats = stats_;
+  stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_);
+  return stats;
+}
+
+void BulkMutationLoader::Send(std::unique_lock<std::mutex>& lk, Batch batch) {
+  auto const max_in_flight =
+      (std::max)(options_.max_commits_in_flight(), std::size_t{1});
+  DrainRetries(lk, max_in_flight - 1);
+  if (!status_.ok()) {
+    stats_.mutations_failed +=
+        static_cast<std::int64_t>(batch.mutations.size());
+    return;
+  }
+  ++in_flight_;
+  StartCommit(lk, std::make_shared<PendingCommit>(std::move(batch), options_));
+}
+
+void BulkMutationLoader::StartCommit(std::unique_lock<std::mutex>& lk,
+                                     std::shared_ptr<PendingCommit> commit) {
+  // Keep the mutations until the commit succeeds, they are needed to rerun it.
+  auto transaction = commit->transaction;
+  auto mutations = commit->batch.mutations;
+  // The continuation may run in this thread if the commit completes at once.
+  lk.unlock();
+  client_.AsyncCommit(std::move(transaction), std::move(mutations))
+      .then([this, commit](future<StatusOr<CommitResult>> f) {
+        OnCommit(commit, f.get().status());
+      });
+  lk.lock();
+}
+
+void BulkMutationLoader::OnCommit(std::shared_ptr<PendingCommit> commit,
+                                  Status const& status) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto const& batch = commit->batch;
+  auto const size = static_cast<std::int64_t>(batch.mutations.size());
+  if (status.ok()) {
+    stats_.mutations_committed += size;
+    stats_.cells_committed += static_cast<std::int64_t>(batch.cells);
+    stats_.bytes_committed += static_cast<std::int64_t>(batch.bytes);
+    ++stats_.commits;
+    --in_flight_;
+    cv_.notify_all();
+    return;
+  }
+
+  bool retry;
+  if (status.code() == StatusCode::kAborted) {
+    // Rerun in a transaction that shares the lock priority of the aborted one.
+    retry = commit->rerun_policy->OnFailure(status);
+    commit->transaction = MakeReadWriteTransaction(commit->transaction);
+  } else {
+    retry = commit->retry_policy->OnFailure(status);
+    commit->transaction = MakeReadWriteTransaction();
+  }
+  if (retry && status_.ok()) {
+    commit->ready = std::chrono::steady_clock::now() +
+                    commit->backoff_policy->OnCompletion();
+    ++stats_.commit_retries;
+    retries_.push_back(std::move(commit));
+  } else {
+    stats_.mutations_failed += size;
+    if (status_.ok()) status_ = status;
+    --in_flight_;
+  }
+  cv_.notify_all();
+}
+
+// Restarts the commits whose backoff has expired, and then waits until at most
+// `max_outstanding` commits are outstanding. Retries are started by the threads
+// calling `Apply()` and `Flush()`, so the completion threads never block.
+void BulkMutationLoader::DrainRetries(std::unique_lock<std::mutex>& lk,
+                                      std::size_t max_outstanding) {
+  for (;;) {
+    auto const now = std::chrono::steady_clock::now();
+    auto next = std::chrono::steady_clock::time_point::max();
+    for (auto i = retries_.begin(); i != retries_.end();) {
+      if (!status_.ok()) {
+        stats_.mutations_failed +=
+            static_cast<std::int64_t>((*i)->batch.mutations.size());
+        --in_flight_;
+        i = retries_.erase(i);
+        continue;
+      }
+      if ((*i)->ready > now) {
+        next = (std::min)(next, (*i)->ready);
+        ++i;
+        continue;
+      }
+      auto commit = std::move(*i);
+      retries_.erase(i);
+      StartCommit(lk, std::move(commit));
+      // `retries_` may have changed while the lock was released.
+      i = retries_.begin();
+    }
+    if (in_flight_ <= max_outstanding) return;
+    if (retries_.empty()) {
+      cv_.wait(lk);
+    } else {
+      cv_.wait_until(lk, next);
+    }
+  }
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
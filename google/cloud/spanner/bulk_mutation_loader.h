@@ -0,0 +1,264 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_BULK_MUTATION_LOADER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_BULK_MUTATION_LOADER_H
+
+#include "google/cloud/spanner/backoff_policy.h"
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/mutations.h"
+#include "google/cloud/spanner/retry_policy.h"
+#include "google/cloud/spanner/transaction.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/status.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Controls how `BulkMutationLoader` groups mutations into commits.
+ */
+class BulkMutationLoaderOptions {
+ public:
+  BulkMutationLoaderOptions()
+      : rerun_policy_(std::make_shared<LimitedTimeTransactionRerunPolicy>(
+            std::chrono::minutes(10))),
+        retry_policy_(std::make_shared<LimitedErrorCountRetryPolicy>(3)),
+        backoff_policy_(std::make_shared<ExponentialBackoffPolicy>(
+            std::chrono::milliseconds(100), std::chrono::minutes(1), 2.0)) {}
+
+  /**
+   * The maximum number of mutated cells in a single commit.
+   *
+   * A cell is one column of one row in an insert, update, or replace, or one
+   * key or key range in a delete. Cloud Spanner also counts the cells of any
+   * secondary indexes against its per-commit limit, so tables with indexes
+   * may need a smaller value.
+   */
+  BulkMutationLoaderOptions& set_max_cells_per_commit(std::size_t count) {
+    max_cells_per_commit_ = count;
+    return *this;
+  }
+  std::size_t max_cells_per_commit() const { return max_cells_per_commit_; }
+
+  /// The maximum size of the mutations in a single commit, in bytes.
+  BulkMutationLoaderOptions& set_max_bytes_per_commit(std::size_t bytes) {
+    max_bytes_per_commit_ = bytes;
+    return *this;
+  }
+  std::size_t max_bytes_per_commit() const { return max_bytes_per_commit_; }
+
+  /**
+   * The maximum number of commits outstanding at the same time.
+   *
+   * Each commit uses its own transaction, and therefore its own session.
+   */
+  BulkMutationLoaderOptions& set_max_commits_in_flight(std::size_t count) {
+    max_commits_in_flight_ = count;
+    return *this;
+  }
+  std::size_t max_commits_in_flight() const { return max_commits_in_flight_; }
+
+  /// Controls how often a commit that was aborted is rerun.
+  BulkMutationLoaderOptions& set_rerun_policy(
+      std::shared_ptr<TransactionRerunPolicy const> policy) {
+    rerun_policy_ = std::move(policy);
+    return *this;
+  }
+  std::shared_ptr<TransactionRerunPolicy const> const& rerun_policy() const {
+    return rerun_policy_;
+  }
+
+  /**
+   * Controls how often a commit that failed with a transient error is retried.
+   *
+   * The outcome of such a commit is unknown, so it may have been applied. Use
+   * mutations that can be applied more than once, such as
+   * `InsertOrUpdateMutationBuilder`, or set a policy that does not retry.
+   */
+  BulkMutationLoaderOptions& set_retry_policy(
+      std::shared_ptr<RetryPolicy const> policy) {
+    retry_policy_ = std::move(policy);
+    return *this;
+  }
+  std::shared_ptr<RetryPolicy const> const& retry_policy() const {
+    return retry_policy_;
+  }
+
+  /// Controls how long to wait before rerunning or retrying a commit.
+  BulkMutationLoaderOptions& set_backoff_policy(
+      std::shared_ptr<BackoffPolicy const> policy) {
+    backoff_policy_ = std::move(policy);
+    return *this;
+  }
+  std::shared_ptr<BackoffPolicy const> const& backoff_policy() const {
+    return backoff_policy_;
+  }
+
+ private:
+  std::size_t max_cells_per_commit_ = 20000;
+  std::size_t max_bytes_per_commit_ = 8 * 1024 * 1024;
+  std::size_t max_commits_in_flight_ = 8;
+  std::shared_ptr<TransactionRerunPolicy const> rerun_policy_;
+  std::shared_ptr<RetryPolicy const> retry_policy_;
+  std::shared_ptr<BackoffPolicy const> backoff_policy_;
+};
+
+/**
+ * Counters describing the progress of a `BulkMutationLoader`.
+ */
+struct BulkMutationLoaderStats {
+  /// The number of mutations, cells, and bytes in successful commits.
+  std::int64_t mutations_committed = 0;
+  std::int64_t cells_committed = 0;
+  std::int64_t bytes_committed = 0;
+
+  /// The number of successful commits.
+  std::int64_t commits = 0;
+
+  /// The number of commits that were rerun or retried.
+  std::int64_t commit_retries = 0;
+
+  /// The number of mutations in commits that failed permanently.
+  std::int64_t mutations_failed = 0;
+
+  /// The time since the loader was created.
+  std::chrono::microseconds elapsed{};
+
+  /// The number of mutations committed per second.
+  double MutationsPerSecond() const;
+};
+
+/**
+ * Applies a large stream of mutations using many concurrent commits.
+ *
+ * Loading many rows through `Client::Commit()` one mutation at a time is slow,
+ * while putting too many mutations in a single commit exceeds the service
+ * limits. This class groups the mutations given to `Apply()` into commits, one
+ * group for each table, and closes a group once it reaches the configured
+ * number of cells or bytes. Mutations of the same table keep their order, so
+ * sorting the input by key keeps each commit within a narrow key range.
+ *
+ * Up to `max_commits_in_flight()` commits are outstanding at the same time,
+ * each in its own transaction. `Apply()` blocks while that many commits are
+ * outstanding, which bounds the memory used by the loader. Each commit is
+ * rerun on its own if it aborts, and retried if it fails with a transient
+ * error, as allowed by the options. There is no ordering between different
+ * commits, so mutations of the same row should not be split across commits
+ * unless their order does not matter.
+ *
+ * Once a commit fails permanently, `Apply()` and `Flush()` return its error,
+ * and further mutations are discarded.
+ *
+ * Instances of this class are safe to use from several threads.
+ *
+ * @par Example
+ * @code
+ * spanner::BulkMutationLoader loader(client);
+ * while (HasMoreRows()) {
+ *   auto status = loader.Apply(spanner::InsertOrUpdateMutationBuilder(...)
+ *                                  .EmplaceRow(...)
+ *                                  .Build());
+ *   if (!status.ok()) throw std::runtime_error(status.message());
+ * }
+ * auto status = loader.Flush();
+ * @endcode
+ */
+class BulkMutationLoader {
+ public:
+  explicit BulkMutationLoader(
+      Client client,
+      BulkMutationLoaderOptions options = BulkMutationLoaderOptions());
+
+  /// Commits any pending mutations, and waits for all outstanding commits.
+  ~BulkMutationLoader();
+
+  BulkMutationLoader(BulkMutationLoader const&) = delete;
+  BulkMutationLoader& operator=(BulkMutationLoader const&) = delete;
+
+  /**
+   * Adds @p mutation to the group for its table.
+   *
+   * If the group is full it is committed first, which may block until there
+   * is room for another commit.
+   *
+   * @return the error of the first commit that failed permanently, if any.
+   */
+  Status Apply(Mutation mutation);
+
+  /**
+   * Commits all pending mutations, and waits until every commit finishes.
+   *
+   * @return the error of the first commit that failed permanently, if any.
+   */
+  Status Flush();
+
+  /// Returns the progress so far.
+  BulkMutationLoaderStats Stats() const;
+
+ private:
+  struct Batch {
+    Mutations mutations;
+    std::size_t cells = 0;
+    std::size_t bytes = 0;
+  };
+
+  struct PendingCommit {
+    PendingCommit(Batch b, BulkMutationLoaderOptions const& options);
+
+    Batch batch;
+    Transaction transaction;
+    std::unique_ptr<TransactionRerunPolicy> rerun_policy;
+    std::unique_ptr<RetryPolicy> retry_policy;
+    std::unique_ptr<BackoffPolicy> backoff_policy;
+    std::chrono::steady_clock::time_point ready;
+  };
+
+  void Send(std::unique_lock<std::mutex>& lk, Batch batch);
+  void StartCommit(std::unique_lock<std::mutex>& lk,
+                   std::shared_ptr<PendingCommit> commit);
+  void OnCommit(std::shared_ptr<PendingCommit> commit, Status const& status);
+  void DrainRetries(std::unique_lock<std::mutex>& lk,
+                    std::size_t max_outstanding);
+
+  Client client_;
+  BulkMutationLoaderOptions const options_;
+  std::chrono::steady_clock::time_point const start_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::map<std::string, Batch> batches_;
+  std::deque<std::shared_ptr<PendingCommit>> retries_;
+  std::size_t in_flight_ = 0;
+  Status status_;
+  BulkMutationLoaderStats stats_;
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_BULK_MUTATION_LOADER_H
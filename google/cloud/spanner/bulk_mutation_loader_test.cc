@@ -0,0 +1,176 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/bulk_mutation_loader.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::testing::_;
+using ::testing::UnorderedElementsAre;
+
+Mutation MakeInsert(std::string const& table, std::int64_t key) {
+  return InsertOrUpdateMutationBuilder(table, {"Key", "Value"})
+      .EmplaceRow(key, "value")
+      .Build();
+}
+
+BulkMutationLoaderOptions TestOptions() {
+  return BulkMutationLoaderOptions()
+      .set_max_cells_per_commit(10)
+      .set_max_commits_in_flight(2)
+      .set_backoff_policy(std::make_shared<ExponentialBackoffPolicy>(
+          std::chrono::microseconds(1), std::chrono::microseconds(10), 2.0));
+}
+
+future<StatusOr<CommitResult>> Success() {
+  return make_ready_future(StatusOr<CommitResult>(CommitResult{}));
+}
+
+future<StatusOr<CommitResult>> Failure(StatusCode code) {
+  return make_ready_future(StatusOr<CommitResult>(Status(code, "failed")));
+}
+
+TEST(BulkMutationLoaderTest, GroupsByTableAndCells) {
+  auto conn = std::make_shared<MockConnection>();
+  std::vector<std::string> commits;
+  EXPECT_CALL(*conn, AsyncCommit(_))
+      .WillRepeatedly([&commits](Connection::CommitParams const& p) {
+        auto table = internal::MutationProto(p.mutations.front())
+                         .insert_or_update()
+                         .table();
+        commits.push_back(table + ":" + std::to_string(p.mutations.size()));
+        return Success();
+      });
+
+  BulkMutationLoader loader(Client(conn), TestOptions());
+  for (int i = 0; i != 12; ++i) {
+    EXPECT_STATUS_OK(loader.Apply(MakeInsert("Singers", i)));
+    if (i % 4 == 0) {
+      EXPECT_STATUS_OK(loader.Apply(MakeInsert("Albums", i)));
+    }
+  }
+  EXPECT_STATUS_OK(loader.Flush());
+  // Each row has two cells, so a commit holds up to five rows.
+  EXPECT_THAT(commits, UnorderedElementsAre("Singers:5", "Singers:5",
+                                            "Singers:2", "Albums:3"));
+
+  auto stats = loader.Stats();
+  EXPECT_EQ(15, stats.mutations_committed);
+  EXPECT_EQ(30, stats.cells_committed);
+  EXPECT_EQ(4, stats.commits);
+  EXPECT_EQ(0, stats.commit_retries);
+  EXPECT_EQ(0, stats.mutations_failed);
+}
+
+TEST(BulkMutationLoaderTest, LimitsBytesPerCommit) {
+  auto conn = std::make_shared<MockConnection>();
+  std::vector<std::size_t> sizes;
+  EXPECT_CALL(*conn, AsyncCommit(_))
+      .WillRepeatedly([&sizes](Connection::CommitParams const& p) {
+        sizes.push_back(p.mutations.size());
+        return Success();
+      });
+
+  auto const bytes = internal::MutationProto(MakeInsert("T", 0)).ByteSizeLong();
+  BulkMutationLoader loader(
+      Client(conn), TestOptions().set_max_bytes_per_commit(3 * bytes));
+  for (int i = 0; i != 4; ++i) {
+    EXPECT_STATUS_OK(loader.Apply(MakeInsert("T", 0)));
+  }
+  EXPECT_STATUS_OK(loader.Flush());
+  EXPECT_THAT(sizes, UnorderedElementsAre(3, 1));
+}
+
+TEST(BulkMutationLoaderTest, RetriesAbortedAndTransient) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, AsyncCommit(_))
+      .WillOnce([](Connection::CommitParams const&) {
+        return Failure(StatusCode::kAborted);
+      })
+      .WillOnce([](Connection::CommitParams const&) {
+        return Failure(StatusCode::kUnavailable);
+      })
+      .WillOnce([](Connection::CommitParams const& p) {
+        EXPECT_EQ(3, p.mutations.size());
+        return Success();
+      });
+
+  BulkMutationLoader loader(Client(conn), TestOptions());
+  for (int i = 0; i != 3; ++i) {
+    EXPECT_STATUS_OK(loader.Apply(MakeInsert("T", i)));
+  }
+  EXPECT_STATUS_OK(loader.Flush());
+  auto stats = loader.Stats();
+  EXPECT_EQ(3, stats.mutations_committed);
+  EXPECT_EQ(1, stats.commits);
+  EXPECT_EQ(2, stats.commit_retries);
+}
+
+TEST(BulkMutationLoaderTest, PermanentErrorStopsLoader) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, AsyncCommit(_))
+      .WillOnce([](Connection::CommitParams const&) {
+        return Failure(StatusCode::kPermissionDenied);
+      });
+
+  BulkMutationLoader loader(Client(conn), TestOptions());
+  Status status;
+  for (int i = 0; i != 8 && status.ok(); ++i) {
+    status = loader.Apply(MakeInsert("T", i));
+  }
+  EXPECT_EQ(StatusCode::kPermissionDenied, status.code());
+  EXPECT_EQ(StatusCode::kPermissionDenied, loader.Flush().code());
+  auto stats = loader.Stats();
+  EXPECT_EQ(0, stats.mutations_committed);
+  EXPECT_EQ(5, stats.mutations_failed);
+}
+
+TEST(BulkMutationLoaderTest, DestructorFlushes) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, AsyncCommit(_))
+      .WillOnce([](Connection::CommitParams const& p) {
+        EXPECT_EQ(2, p.mutations.size());
+        return Success();
+      });
+
+  BulkMutationLoader loader(Client(conn), TestOptions());
+  EXPECT_STATUS_OK(loader.Apply(MakeInsert("T", 1)));
+  EXPECT_STATUS_OK(loader.Apply(MakeInsert("T", 2)));
+}
+
+TEST(BulkMutationLoaderStatsTest, MutationsPerSecond) {
+  BulkMutationLoaderStats stats;
+  EXPECT_EQ(0, stats.MutationsPerSecond());
+  stats.mutations_committed = 500;
+  stats.elapsed = std::chrono::milliseconds(250);
+  EXPECT_DOUBLE_EQ(2000.0, stats.MutationsPerSecond());
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -17,8 +17,6 @@
 
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/status_or.h"
-#include <array>
-#include <cstddef>
 #include <iterator>
 #include <ostream>
 #include <string>
@@ -50,14 +48,8 @@ class Bytes {
   /// Construction from a sequence of octets.
   ///@{
   template <typename InputIt>
-  Bytes(InputIt first, InputIt last) {
-    Encoder encoder(base64_rep_);
-    while (first != last) {
-      encoder.buf_[encoder.len_++] = *first++;
-      if (encoder.len_ == encoder.buf_.size()) encoder.Flush();
-    }
-    if (encoder.len_ != 0) encoder.FlushAndPad();
-  }
+  Bytes(InputIt first, InputIt last)
+      : base64_rep_(Encode(std::string(first, last))) {}
   template <typename Container>
   explicit Bytes(Container const& c) : Bytes(std::begin(c), std::end(c)) {}
   ///@}
@@ -66,8 +58,8 @@ class Bytes {
   /// construction from a range specified as a pair of input iterators.
   template <typename Container>
   Container get() const {
-    Decoder decoder(base64_rep_);
-    return Container(decoder.begin(), decoder.end());
+    auto const octets = Decode(base64_rep_);
+    return Container(octets.begin(), octets.end());
   }
 
   /// @name Relational operators
@@ -90,66 +82,10 @@ class Bytes {
   friend StatusOr<Bytes> internal::BytesFromBase64(std::string input);
   friend std::string internal::BytesToBase64(Bytes b);
 
-  struct Encoder {
-    explicit Encoder(std::string& rep) : rep_(rep), len_(0) {}
-    void Flush();
-    void FlushAndPad();
-
-    std::string& rep_;  // encoded
-    std::size_t len_;   // buf_[0 .. len_-1] pending encode
-    std::array<unsigned char, 3> buf_;
-  };
-
-  struct Decoder {
-    class Iterator {
-     public:
-      using iterator_category = std::input_iterator_tag;
-      using value_type = unsigned char;
-      using difference_type = std::ptrdiff_t;
-      using pointer = value_type*;
-      using reference = value_type&;
-
-      Iterator(std::string::const_iterator begin,
-               std::string::const_iterator end)
-          : pos_(begin), end_(end), len_(0) {
-        Fill();
-      }
-
-      void Fill();
-
-      reference operator*() { return buf_[len_]; }
-      pointer operator->() { return &buf_[len_]; }
-
-      Iterator& operator++() {
-        if (--len_ == 0) Fill();
-        return *this;
-      }
-      Iterator operator++(int) {
-        auto const old = *this;
-        operator++();
-        return old;
-      }
-
-      friend bool operator==(Iterator const& a, Iterator const& b) {
-        return a.pos_ == b.pos_ && a.len_ == b.len_;
-      }
-      friend bool operator!=(Iterator const& a, Iterator const& b) {
-        return !(a == b);
-      }
-
-     private:
-      std::string::const_iterator pos_;  // [pos_ .. end_) pending decode
-      std::string::const_iterator end_;
-      std::size_t len_;  // buf_[len_ .. 1] decoded
-      std::array<value_type, 1 + 3> buf_;
-    };
-
-    explicit Decoder(std::string const& rep) : rep_(rep) {}
-    Iterator begin() { return Iterator(rep_.begin(), rep_.end()); }
-    Iterator end() { return Iterator(rep_.end(), rep_.end()); }
-
-    std::string const& rep_;  // encoded
-  };
+  // The octets are first gathered into, or decoded from, a contiguous buffer
+  // so the conversions run over whole chunks rather than one octet at a time.
+  static std::string Encode(std::string const& octets);
+  static std::string Decode(std::string const& base64_rep);
 
   std::string base64_rep_;  // valid base64 representation
 };
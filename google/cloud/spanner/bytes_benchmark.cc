@@ -14,6 +14,7 @@
 
 #include "google/cloud/spanner/bytes.h"
 #include <benchmark/benchmark.h>
+#include <cstdint>
 #include <string>
 
 namespace google {
@@ -22,18 +23,27 @@ namespace spanner {
 inline namespace SPANNER_CLIENT_NS {
 namespace {
 
-// Run on (6 X 2300 MHz CPU s)
+// Run on (1 X 2100 MHz CPU )
 // CPU Caches:
-//   L1 Data 32K (x3)
-//   L1 Instruction 32K (x3)
-//   L2 Unified 256K (x3)
-//   L3 Unified 46080K (x1)
-// Load Average: 0.22, 0.24, 0.26
-// ----------------------------------------------------------------
-// Benchmark            Time       CPU   Iterations UserCounters...
-// ----------------------------------------------------------------
-// BM_BytesCtor      8386 ns   8318 ns        82963 bytes_per_second=167.843M/s
-// BM_BytesGet       6094 ns   6057 ns       115399 bytes_per_second=307.34M/s
+//   L1 Data 48K (x1)
+//   L1 Instruction 32K (x1)
+//   L2 Unified 2048K (x1)
+//   L3 Unified 307200K (x1)
+// Load Average: 0.75, 0.59, 0.63
+// ---------------------------------------------------------------------------
+// Benchmark                       Time       CPU Iterations UserCounters...
+// ---------------------------------------------------------------------------
+// BM_BytesCtor                 2791 ns   2314 ns     350571 645M/s
+// BM_BytesGet                  2345 ns   2108 ns     318519 944M/s
+// BM_BytesCtorLarge/1024       1332 ns   1319 ns     487260 740M/s
+// BM_BytesCtorLarge/32768     46456 ns  45499 ns      15656 687M/s
+// BM_BytesCtorLarge/1048576 1480325 ns 1390785 ns      496 719M/s
+// BM_BytesGetLarge/1024        1397 ns   1365 ns     514671 955M/s
+// BM_BytesGetLarge/32768      46890 ns  42585 ns      16543 978M/s
+// BM_BytesGetLarge/1048576  1712669 ns 1349008 ns      470 988M/s
+// BM_BytesFromBase64/1024       829 ns    699 ns     947054 1.82G/s
+// BM_BytesFromBase64/32768    23113 ns  22476 ns      33587 1.81G/s
+// BM_BytesFromBase64/1048576 762345 ns 736469 ns       921 1.77G/s
 
 std::string const kText = R"""(
     Four score and seven years ago our fathers brought forth on this
@@ -81,6 +91,48 @@ void BM_BytesGet(benchmark::State& state) {
 }
 BENCHMARK(BM_BytesGet);
 
+// Large BYTES values, as returned by queries over blob columns, with every
+// octet value represented.
+std::string MakeOctets(std::size_t size) {
+  std::string octets(size, '\0');
+  std::uint32_t state = 12345;
+  for (auto& c : octets) {
+    state = state * 1103515245 + 12345;
+    c = static_cast<char>(state >> 24);
+  }
+  return octets;
+}
+
+void BM_BytesCtorLarge(benchmark::State& state) {
+  auto const octets = MakeOctets(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Bytes(octets));
+  }
+  state.SetBytesProcessed(state.iterations() * octets.size());
+}
+BENCHMARK(BM_BytesCtorLarge)->Range(1 << 10, 1 << 20);
+
+void BM_BytesGetLarge(benchmark::State& state) {
+  Bytes b(MakeOctets(static_cast<std::size_t>(state.range(0))));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(b.get<std::string>());
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          internal::BytesToBase64(b).size());
+}
+BENCHMARK(BM_BytesGetLarge)->Range(1 << 10, 1 << 20);
+
+// The validation done for each BYTES value received from Spanner.
+void BM_BytesFromBase64(benchmark::State& state) {
+  auto const base64 = internal::BytesToBase64(
+      Bytes(MakeOctets(static_cast<std::size_t>(state.range(0)))));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(internal::BytesFromBase64(base64));
+  }
+  state.SetBytesProcessed(state.iterations() * base64.size());
+}
+BENCHMARK(BM_BytesFromBase64)->Range(1 << 10, 1 << 20);
+
 }  // namespace
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
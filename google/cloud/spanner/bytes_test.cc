@@ -15,6 +15,7 @@
 #include "google/cloud/spanner/bytes.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include <gmock/gmock.h>
+#include <array>
 #include <cstdint>
 #include <deque>
 #include <limits>
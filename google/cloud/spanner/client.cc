@@ -22,7 +22,10 @@
 #include "google/cloud/spanner/transaction.h"
 #include "google/cloud/internal/getenv.h"
 #include "google/cloud/log.h"
+#include "absl/types/optional.h"
 #include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <memory>
 #include <thread>
 
 namespace google {
@@ -185,13 +188,184 @@ StatusOr<BatchDmlResult> Client::ExecuteBatchDml(
       {std::move(transaction), std::move(statements)});
 }
 
+namespace {
+
+// The status-code discriminator of TransactionRerunPolicy.
+using RerunnablePolicy = internal::SafeTransactionRerun;
+
+std::unique_ptr<TransactionRerunPolicy> DefaultCommitRerunPolicy() {
+  auto const rerun_maximum_duration = std::chrono::minutes(10);
+  return LimitedTimeTransactionRerunPolicy(rerun_maximum_duration).clone();
+}
+
+std::unique_ptr<BackoffPolicy> DefaultCommitBackoffPolicy() {
+  auto const backoff_initial_delay = std::chrono::milliseconds(100);
+  auto const backoff_maximum_delay = std::chrono::minutes(5);
+  auto const backoff_scaling = 2.0;
+  return ExponentialBackoffPolicy(backoff_initial_delay, backoff_maximum_delay,
+                                  backoff_scaling)
+      .clone();
+}
+
+std::unique_ptr<BackoffPolicy> DefaultAsyncCommitBackoffPolicy() {
+  // Spanner aborts a transaction when it conflicts with another one, and
+  // the conflict is usually resolved as soon as the other transaction ends.
+  // So start with short delays, but spread the reruns widely so the
+  // transactions that aborted together do not conflict again.
+  auto const backoff_initial_delay = std::chrono::milliseconds(10);
+  auto const backoff_maximum_delay = std::chrono::seconds(32);
+  return DecorrelatedJitterBackoffPolicy(backoff_initial_delay,
+                                         backoff_maximum_delay)
+      .clone();
+}
+
+/**
+ * Prepares @p txn to rerun a transaction that failed with @p status, and
+ * returns how long to wait before the rerun.
+ *
+ * The wait honors the delay suggested by the service when it aborted the
+ * transaction, if any.
+ */
+std::chrono::milliseconds PrepareRerun(Transaction& txn, Status const& status,
+                                       BackoffPolicy& backoff_policy) {
+  bool const session_not_found = internal::IsSessionNotFound(status);
+  absl::optional<std::chrono::milliseconds> server_delay;
+  internal::Visit(
+      txn, [session_not_found, &server_delay](
+               internal::SessionHolder& s,
+               StatusOr<google::spanner::v1::TransactionSelector> const&,
+               std::int64_t) {
+        if (!s) return true;
+        if (session_not_found) {
+          s->set_bad();
+        } else {
+          server_delay = s->TakeRetryDelay();
+        }
+        return true;
+      });
+  if (session_not_found) {
+    // Creates a new Transaction (and session) for the next loop.
+    txn = MakeReadWriteTransaction();
+  } else {
+    // Create a new transaction for the next loop, but reuse the session
+    // so that we have a slightly better chance of avoiding another abort.
+    txn = MakeReadWriteTransaction(txn);
+  }
+  if (server_delay) return backoff_policy.OnCompletionWithDelay(*server_delay);
+  return backoff_policy.OnCompletion();
+}
+
+/**
+ * The rerun loop of `Client::AsyncCommit()`.
+ *
+ * The loop mirrors the one in `Client::Commit()`, but it never blocks while
+ * waiting to rerun the transaction. Instead it waits using
+ * `Connection::AsyncBackoff()`. That future is satisfied by a completion
+ * queue thread, where the mutator (or the blocking `Rollback()` after it)
+ * could stall other operations, or deadlock waiting for one. So each rerun
+ * starts a thread of its own.
+ */
+class AsyncCommitLoop : public std::enable_shared_from_this<AsyncCommitLoop> {
+ public:
+  AsyncCommitLoop(std::shared_ptr<Connection> conn,
+                  std::function<StatusOr<Mutations>(Transaction)> mutator,
+                  std::unique_ptr<TransactionRerunPolicy> rerun_policy,
+                  std::unique_ptr<BackoffPolicy> backoff_policy)
+      : conn_(std::move(conn)),
+        mutator_(std::move(mutator)),
+        rerun_policy_(std::move(rerun_policy)),
+        backoff_policy_(std::move(backoff_policy)) {}
+
+  future<StatusOr<CommitResult>> Start() {
+    auto f = result_.get_future();
+    Run(MakeReadWriteTransaction());
+    return f;
+  }
+
+ private:
+  void Run(Transaction txn) {
+    StatusOr<Mutations> mutations;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+#endif
+      mutations = mutator_(txn);
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    } catch (RuntimeStatusError const& error) {
+      // Treat this like mutator() returned a bad Status.
+      Status status = error.status();
+      if (status.ok()) {
+        status = Status(StatusCode::kUnknown, "OK Status thrown from mutator");
+      }
+      mutations = status;
+    } catch (...) {
+      Rollback(txn);
+      result_.set_exception(std::current_exception());
+      return;
+    }
+#endif
+    auto status = mutations.status();
+    if (RerunnablePolicy::IsOk(status)) {
+      auto self = shared_from_this();
+      conn_->AsyncCommit({txn, *std::move(mutations)})
+          .then([self, txn](future<StatusOr<CommitResult>> f) {
+            self->OnCommit(txn, f.get());
+          });
+      return;
+    }
+    if (!RerunnablePolicy::IsTransientFailure(status)) {
+      Rollback(txn);
+      result_.set_value(std::move(status));
+      return;
+    }
+    Rerun(std::move(txn), std::move(status));
+  }
+
+  void OnCommit(Transaction txn, StatusOr<CommitResult> result) {
+    if (!RerunnablePolicy::IsTransientFailure(result.status())) {
+      result_.set_value(std::move(result));
+      return;
+    }
+    Rerun(std::move(txn), std::move(result).status());
+  }
+
+  void Rerun(Transaction txn, Status status) {
+    if (!rerun_policy_->OnFailure(status)) {
+      result_.set_value(std::move(status));  // reruns exhausted
+      return;
+    }
+    auto const delay = PrepareRerun(txn, status, *backoff_policy_);
+    auto self = shared_from_this();
+    conn_->AsyncBackoff(delay).then([self, txn](future<Status> f) {
+      auto status = f.get();
+      if (!status.ok()) {
+        self->result_.set_value(std::move(status));
+        return;
+      }
+      std::thread([self, txn] { self->Run(txn); }).detach();
+    });
+  }
+
+  void Rollback(Transaction txn) {
+    auto status = conn_->Rollback({std::move(txn)});
+    if (!RerunnablePolicy::IsOk(status)) {
+      GCP_LOG(WARNING) << "Rollback() failure in Client::AsyncCommit(): "
+                       << status.message();
+    }
+  }
+
+  std::shared_ptr<Connection> conn_;
+  std::function<StatusOr<Mutations>(Transaction)> mutator_;
+  std::unique_ptr<TransactionRerunPolicy> rerun_policy_;
+  std::unique_ptr<BackoffPolicy> backoff_policy_;
+  promise<StatusOr<CommitResult>> result_;
+};
+
+}  // namespace
+
 StatusOr<CommitResult> Client::Commit(
     std::function<StatusOr<Mutations>(Transaction)> const& mutator,
     std::unique_ptr<TransactionRerunPolicy> rerun_policy,
     std::unique_ptr<BackoffPolicy> backoff_policy) {
-  // The status-code discriminator of TransactionRerunPolicy.
-  using RerunnablePolicy = internal::SafeTransactionRerun;
-
   Transaction txn = MakeReadWriteTransaction();
   for (int rerun = 0;; ++rerun) {
     StatusOr<Mutations> mutations;
@@ -237,41 +411,14 @@ StatusOr<CommitResult> Client::Commit(
     if (!rerun_policy->OnFailure(status)) {
       return status;  // reruns exhausted
     }
-    if (internal::IsSessionNotFound(status)) {
-      // Marks the session bad and creates a new Transaction for the next loop.
-      internal::Visit(
-          txn, [](internal::SessionHolder& s,
-                  StatusOr<google::spanner::v1::TransactionSelector> const&,
-                  std::int64_t) {
-            if (s) s->set_bad();
-            return true;
-          });
-      txn = MakeReadWriteTransaction();
-    } else {
-      // Create a new transaction for the next loop, but reuse the session
-      // so that we have a slightly better chance of avoiding another abort.
-      txn = MakeReadWriteTransaction(txn);
-    }
-    std::this_thread::sleep_for(backoff_policy->OnCompletion());
+    std::this_thread::sleep_for(PrepareRerun(txn, status, *backoff_policy));
   }
 }
 
 StatusOr<CommitResult> Client::Commit(
     std::function<StatusOr<Mutations>(Transaction)> const& mutator) {
-  auto const rerun_maximum_duration = std::chrono::minutes(10);
-  auto default_commit_rerun_policy =
-      LimitedTimeTransactionRerunPolicy(rerun_maximum_duration).clone();
-
-  auto const backoff_initial_delay = std::chrono::milliseconds(100);
-  auto const backoff_maximum_delay = std::chrono::minutes(5);
-  auto const backoff_scaling = 2.0;
-  auto default_commit_backoff_policy =
-      ExponentialBackoffPolicy(backoff_initial_delay, backoff_maximum_delay,
-                               backoff_scaling)
-          .clone();
-
-  return Commit(mutator, std::move(default_commit_rerun_policy),
-                std::move(default_commit_backoff_policy));
+  return Commit(mutator, DefaultCommitRerunPolicy(),
+                DefaultCommitBackoffPolicy());
 }
 
 StatusOr<CommitResult> Client::Commit(Mutations mutations) {
@@ -292,6 +439,62 @@ StatusOr<PartitionedDmlResult> Client::ExecutePartitionedDml(
   return conn_->ExecutePartitionedDml({std::move(statement)});
 }
 
+future<StatusOr<RowStream>> Client::AsyncRead(
+    Transaction transaction, std::string table, KeySet keys,
+    std::vector<std::string> columns, ReadOptions read_options) {
+  return conn_->AsyncRead({std::move(transaction),
+                           std::move(table),
+                           std::move(keys),
+                           std::move(columns),
+                           std::move(read_options),
+                           {}});
+}
+
+future<StatusOr<RowStream>> Client::AsyncExecuteQuery(
+    Transaction transaction, SqlStatement statement,
+    QueryOptions const& opts) {
+  return conn_->AsyncExecuteQuery({std::move(transaction),
+                                   std::move(statement),
+                                   OverlayQueryOptions(opts),
+                                   {}});
+}
+
+future<StatusOr<DmlResult>> Client::AsyncExecuteDml(Transaction transaction,
+                                                    SqlStatement statement,
+                                                    QueryOptions const& opts) {
+  return conn_->AsyncExecuteDml({std::move(transaction),
+                                 std::move(statement),
+                                 OverlayQueryOptions(opts),
+                                 {}});
+}
+
+future<StatusOr<BatchDmlResult>> Client::AsyncExecuteBatchDml(
+    Transaction transaction, std::vector<SqlStatement> statements) {
+  return conn_->AsyncExecuteBatchDml(
+      {std::move(transaction), std::move(statements)});
+}
+
+future<StatusOr<CommitResult>> Client::AsyncCommit(Transaction transaction,
+                                                   Mutations mutations) {
+  return conn_->AsyncCommit({std::move(transaction), std::move(mutations)});
+}
+
+future<StatusOr<CommitResult>> Client::AsyncCommit(
+    std::function<StatusOr<Mutations>(Transaction)> mutator,
+    std::unique_ptr<TransactionRerunPolicy> rerun_policy,
+    std::unique_ptr<BackoffPolicy> backoff_policy) {
+  auto loop = std::make_shared<AsyncCommitLoop>(
+      conn_, std::move(mutator), std::move(rerun_policy),
+      std::move(backoff_policy));
+  return loop->Start();
+}
+
+future<StatusOr<CommitResult>> Client::AsyncCommit(
+    std::function<StatusOr<Mutations>(Transaction)> mutator) {
+  return AsyncCommit(std::move(mutator), DefaultCommitRerunPolicy(),
+                     DefaultAsyncCommitBackoffPolicy());
+}
+
 // Returns a QueryOptions struct that has each field set according to the
 // hierarchy that options specified as to the function call (i.e., `preferred`)
 // are preferred, followed by options set at the Client level, followed by an
@@ -315,6 +518,13 @@ QueryOptions Client::OverlayQueryOptions(QueryOptions const& preferred) {
     opts.set_optimizer_version(*kOptimizerVersionEnvValue);
   }
 
+  // Choose the `prefetch_rows` option.
+  if (preferred.prefetch_rows().has_value()) {
+    opts.set_prefetch_rows(preferred.prefetch_rows());
+  } else {
+    opts.set_prefetch_rows(fallback.prefetch_rows());
+  }
+
   return opts;
 }
 
@@ -35,6 +35,7 @@
 #include "google/cloud/spanner/sql_statement.h"
 #include "google/cloud/spanner/transaction.h"
 #include "google/cloud/spanner/version.h"
+#include "google/cloud/future.h"
 #include "google/cloud/optional.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
@@ -622,6 +623,88 @@ class Client {
    */
   StatusOr<PartitionedDmlResult> ExecutePartitionedDml(SqlStatement statement);
 
+  //@{
+  /**
+   * @name Asynchronous operations.
+   *
+   * These functions mirror `Read()`, `ExecuteQuery()`, `ExecuteDml()`,
+   * `ExecuteBatchDml()` and `Commit()`, but return immediately. The returned
+   * `future` is satisfied once the operation completes, without blocking a
+   * thread for each outstanding request, which makes it practical to keep
+   * many small operations in flight at once.
+   *
+   * The transaction semantics are the same as for the blocking functions. In
+   * particular, the first operation in a read-write transaction begins it, and
+   * other operations on that transaction wait until it has begun.
+   *
+   * @note `AsyncRead()` and `AsyncExecuteQuery()` use the unary `Read` and
+   *     `ExecuteSql` RPCs, so the whole result must fit in a single response
+   *     (about 10 MiB). Use `Read()` or `ExecuteQuery()` for larger results.
+   */
+  future<StatusOr<RowStream>> AsyncRead(Transaction transaction,
+                                        std::string table, KeySet keys,
+                                        std::vector<std::string> columns,
+                                        ReadOptions read_options = {});
+
+  future<StatusOr<RowStream>> AsyncExecuteQuery(Transaction transaction,
+                                                SqlStatement statement,
+                                                QueryOptions const& opts = {});
+
+  future<StatusOr<DmlResult>> AsyncExecuteDml(Transaction transaction,
+                                              SqlStatement statement,
+                                              QueryOptions const& opts = {});
+
+  future<StatusOr<BatchDmlResult>> AsyncExecuteBatchDml(
+      Transaction transaction, std::vector<SqlStatement> statements);
+
+  future<StatusOr<CommitResult>> AsyncCommit(Transaction transaction,
+                                             Mutations mutations);
+
+  /**
+   * Commits a read-write transaction, rerunning it if it aborts.
+   *
+   * This mirrors `Commit()` with a @p mutator, but it does not block the
+   * calling thread while it waits to rerun an aborted transaction, nor while
+   * the commit is in progress. The waits use the `Connection`'s completion
+   * queue, so a burst of aborted transactions does not tie up one application
+   * thread per transaction.
+   *
+   * The first call to @p mutator happens before this function returns, in the
+   * calling thread. Each rerun calls @p mutator from a new thread, never from
+   * the background threads of the `Connection`, so @p mutator may use this
+   * `Client` synchronously, but it must be safe to call from any thread. If
+   * @p mutator fails, the transaction is rolled back from that same thread.
+   * Continuations attached to the returned future may run on the background
+   * threads of the `Connection`.
+   *
+   * Before each rerun the function waits for the delay that Spanner suggested
+   * when it aborted the transaction, if any, as adjusted by the
+   * @p backoff_policy.
+   *
+   * @param mutator the function called to create mutations
+   * @param rerun_policy controls for how long (or how many times) the mutator
+   *     will be rerun after the transaction aborts.
+   * @param backoff_policy controls how long `AsyncCommit` waits between
+   *     reruns.
+   *
+   * @return a future satisfied with the result of the last commit. If
+   *     @p mutator throws an exception other than `RuntimeStatusError`, the
+   *     transaction is rolled back and `future::get()` rethrows it.
+   */
+  future<StatusOr<CommitResult>> AsyncCommit(
+      std::function<StatusOr<Mutations>(Transaction)> mutator,
+      std::unique_ptr<TransactionRerunPolicy> rerun_policy,
+      std::unique_ptr<BackoffPolicy> backoff_policy);
+
+  /**
+   * Commits a read-write transaction, rerunning it if it aborts.
+   *
+   * Same as above, but uses the default rerun and backoff policies.
+   */
+  future<StatusOr<CommitResult>> AsyncCommit(
+      std::function<StatusOr<Mutations>(Transaction)> mutator);
+  //@}
+
  private:
   QueryOptions OverlayQueryOptions(QueryOptions const&);
 
@@ -30,7 +30,10 @@
 #include <array>
 #include <chrono>
 #include <cstdint>
+#include <memory>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -360,6 +363,43 @@ TEST(ClientTest, CommitError) {
   EXPECT_THAT(commit.status().message(), HasSubstr("blah"));
 }
 
+TEST(ClientTest, AsyncCommitSuccess) {
+  auto conn = std::make_shared<MockConnection>();
+
+  auto ts = MakeTimestamp(std::chrono::system_clock::from_time_t(123)).value();
+  CommitResult result;
+  result.commit_timestamp = ts;
+
+  Client client(conn);
+  EXPECT_CALL(*conn, AsyncCommit(_))
+      .WillOnce([&result](Connection::CommitParams const&) {
+        return make_ready_future(StatusOr<CommitResult>(result));
+      });
+
+  auto txn = MakeReadWriteTransaction();
+  auto commit = client.AsyncCommit(txn, {}).get();
+  EXPECT_STATUS_OK(commit);
+  EXPECT_EQ(ts, commit->commit_timestamp);
+}
+
+TEST(ClientTest, AsyncExecuteDmlError) {
+  auto conn = std::make_shared<MockConnection>();
+
+  Client client(conn);
+  EXPECT_CALL(*conn, AsyncExecuteDml(_))
+      .WillOnce([](Connection::SqlParams const& params) {
+        EXPECT_EQ(params.statement, SqlStatement("UPDATE T SET C = 1"));
+        return make_ready_future(StatusOr<DmlResult>(
+            Status(StatusCode::kPermissionDenied, "blah")));
+      });
+
+  auto txn = MakeReadWriteTransaction();
+  auto dml =
+      client.AsyncExecuteDml(txn, SqlStatement("UPDATE T SET C = 1")).get();
+  EXPECT_EQ(StatusCode::kPermissionDenied, dml.status().code());
+  EXPECT_THAT(dml.status().message(), HasSubstr("blah"));
+}
+
 TEST(ClientTest, RollbackSuccess) {
   auto conn = std::make_shared<MockConnection>();
 
@@ -871,6 +911,228 @@ TEST(ClientTest, CommitSessionNotFound) {
   EXPECT_EQ(*timestamp, result->commit_timestamp);
 }
 
+bool SetRetryDelay(Transaction const& txn, std::chrono::milliseconds delay) {
+  return internal::Visit(
+      txn, [delay](internal::SessionHolder& session,
+                   StatusOr<google::spanner::v1::TransactionSelector>&,
+                   std::int64_t) {
+        session->set_retry_delay(delay);
+        return true;
+      });
+}
+
+/// A backoff policy that records the service delays it is given.
+class RecordingBackoffPolicy : public BackoffPolicy {
+ public:
+  explicit RecordingBackoffPolicy(
+      std::shared_ptr<std::vector<std::chrono::milliseconds>> delays)
+      : delays_(std::move(delays)) {}
+
+  std::unique_ptr<BackoffPolicy> clone() const override {
+    return absl::make_unique<RecordingBackoffPolicy>(delays_);
+  }
+  std::chrono::milliseconds OnCompletion() override {
+    delays_->push_back(std::chrono::milliseconds(0));
+    return std::chrono::milliseconds(0);
+  }
+  std::chrono::milliseconds OnCompletionWithDelay(
+      std::chrono::milliseconds server_delay) override {
+    delays_->push_back(server_delay);
+    return std::chrono::milliseconds(0);
+  }
+
+ private:
+  std::shared_ptr<std::vector<std::chrono::milliseconds>> delays_;
+};
+
+TEST(ClientTest, CommitMutatorHonorsServerDelay) {
+  auto timestamp = internal::TimestampFromRFC3339("2020-08-14T21:16:21.123Z");
+  ASSERT_STATUS_OK(timestamp);
+
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Commit(_))
+      .WillOnce([](Connection::CommitParams const& cp) {
+        SetSessionName(cp.transaction, "session-1");
+        SetRetryDelay(cp.transaction, std::chrono::milliseconds(250));
+        return Status(StatusCode::kAborted, "Aborted transaction");
+      })
+      .WillOnce([](Connection::CommitParams const&) {
+        return Status(StatusCode::kAborted, "Aborted transaction");
+      })
+      .WillOnce([&timestamp](Connection::CommitParams const& cp) {
+        EXPECT_THAT(cp.transaction, HasSession("session-1"));
+        return CommitResult{*timestamp};
+      });
+
+  auto delays = std::make_shared<std::vector<std::chrono::milliseconds>>();
+  Client client(conn);
+  auto result = client.Commit(
+      [](Transaction const&) { return Mutations{}; },
+      LimitedErrorCountTransactionRerunPolicy(2).clone(),
+      RecordingBackoffPolicy(delays).clone());
+  EXPECT_STATUS_OK(result);
+  // The service delay is used once, the second abort did not include one.
+  EXPECT_THAT(*delays, ElementsAre(std::chrono::milliseconds(250),
+                                   std::chrono::milliseconds(0)));
+}
+
+TEST(ClientTest, AsyncCommitMutatorRerunTransientFailures) {
+  auto timestamp = internal::TimestampFromRFC3339("2020-08-14T21:16:21.123Z");
+  ASSERT_STATUS_OK(timestamp);
+
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, AsyncCommit(_))
+      .WillOnce([](Connection::CommitParams const& cp) {
+        SetSessionName(cp.transaction, "session-1");
+        SetRetryDelay(cp.transaction, std::chrono::milliseconds(250));
+        return make_ready_future(StatusOr<CommitResult>(
+            Status(StatusCode::kAborted, "Aborted transaction")));
+      })
+      .WillOnce([&timestamp](Connection::CommitParams const& cp) {
+        EXPECT_THAT(cp.transaction, HasSession("session-1"));
+        EXPECT_EQ(1, cp.mutations.size());
+        return make_ready_future(
+            StatusOr<CommitResult>(CommitResult{*timestamp}));
+      });
+  // The loop waits using the connection, instead of blocking the thread.
+  EXPECT_CALL(*conn, AsyncBackoff(std::chrono::milliseconds(0)))
+      .WillOnce([](std::chrono::milliseconds) {
+        return make_ready_future(Status());
+      });
+
+  int calls = 0;
+  auto mutator = [&calls](Transaction const&) -> StatusOr<Mutations> {
+    ++calls;
+    return Mutations{MakeDeleteMutation("table", KeySet::All())};
+  };
+
+  auto delays = std::make_shared<std::vector<std::chrono::milliseconds>>();
+  Client client(conn);
+  auto result =
+      client
+          .AsyncCommit(mutator,
+                       LimitedErrorCountTransactionRerunPolicy(2).clone(),
+                       RecordingBackoffPolicy(delays).clone())
+          .get();
+  EXPECT_STATUS_OK(result);
+  EXPECT_EQ(*timestamp, result->commit_timestamp);
+  EXPECT_EQ(2, calls);
+  EXPECT_THAT(*delays, ElementsAre(std::chrono::milliseconds(250)));
+}
+
+TEST(ClientTest, AsyncCommitMutatorRerunsOffBackoffThread) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, AsyncCommit(_))
+      .WillOnce([](Connection::CommitParams const&) {
+        return make_ready_future(StatusOr<CommitResult>(
+            Status(StatusCode::kAborted, "Aborted transaction")));
+      });
+  // The backoff is satisfied by this thread, standing in for a completion
+  // queue thread.
+  promise<Status> backoff;
+  EXPECT_CALL(*conn, AsyncBackoff(_))
+      .WillOnce([&backoff](std::chrono::milliseconds) {
+        return backoff.get_future();
+      });
+  // The rerun fails, so it also rolls back the transaction.
+  EXPECT_CALL(*conn, Rollback(_)).WillOnce(Return(Status()));
+
+  std::vector<std::thread::id> threads;
+  auto mutator = [&threads](Transaction const&) -> StatusOr<Mutations> {
+    threads.push_back(std::this_thread::get_id());
+    if (threads.size() == 1) return Mutations{};
+    return Status(StatusCode::kInvalidArgument, "blah");
+  };
+
+  Client client(conn);
+  auto result = client.AsyncCommit(
+      mutator, LimitedErrorCountTransactionRerunPolicy(2).clone(),
+      RecordingBackoffPolicy(
+          std::make_shared<std::vector<std::chrono::milliseconds>>())
+          .clone());
+  backoff.set_value(Status());
+  EXPECT_EQ(StatusCode::kInvalidArgument, result.get().status().code());
+  ASSERT_EQ(2, threads.size());
+  EXPECT_EQ(std::this_thread::get_id(), threads[0]);
+  EXPECT_NE(std::this_thread::get_id(), threads[1]);
+}
+
+TEST(ClientTest, AsyncCommitMutatorTooManyFailures) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, AsyncCommit(_))
+      .Times(3)
+      .WillRepeatedly([](Connection::CommitParams const&) {
+        return make_ready_future(StatusOr<CommitResult>(
+            Status(StatusCode::kAborted, "Aborted transaction")));
+      });
+  EXPECT_CALL(*conn, AsyncBackoff(_))
+      .Times(2)
+      .WillRepeatedly([](std::chrono::milliseconds) {
+        return make_ready_future(Status());
+      });
+
+  Client client(conn);
+  auto result =
+      client
+          .AsyncCommit([](Transaction const&) { return Mutations{}; },
+                       LimitedErrorCountTransactionRerunPolicy(2).clone(),
+                       ExponentialBackoffPolicy(std::chrono::microseconds(10),
+                                                std::chrono::microseconds(10),
+                                                2.0)
+                           .clone())
+          .get();
+  EXPECT_EQ(StatusCode::kAborted, result.status().code());
+  EXPECT_THAT(result.status().message(), HasSubstr("Aborted transaction"));
+}
+
+TEST(ClientTest, AsyncCommitMutatorBackoffFailure) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, AsyncCommit(_))
+      .WillOnce([](Connection::CommitParams const&) {
+        return make_ready_future(StatusOr<CommitResult>(
+            Status(StatusCode::kAborted, "Aborted transaction")));
+      });
+  EXPECT_CALL(*conn, AsyncBackoff(_))
+      .WillOnce([](std::chrono::milliseconds) {
+        return make_ready_future(
+            Status(StatusCode::kCancelled, "shutting down"));
+      });
+
+  Client client(conn);
+  auto result =
+      client.AsyncCommit([](Transaction const&) { return Mutations{}; }).get();
+  EXPECT_EQ(StatusCode::kCancelled, result.status().code());
+}
+
+TEST(ClientTest, AsyncCommitMutatorRollback) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, AsyncCommit(_)).Times(0);
+  EXPECT_CALL(*conn, Rollback(_)).WillOnce(Return(Status()));
+
+  Client client(conn);
+  auto result = client
+                    .AsyncCommit([](Transaction const&) -> StatusOr<Mutations> {
+                      return Status(StatusCode::kInvalidArgument, "blah");
+                    })
+                    .get();
+  EXPECT_EQ(StatusCode::kInvalidArgument, result.status().code());
+  EXPECT_THAT(result.status().message(), HasSubstr("blah"));
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST(ClientTest, AsyncCommitMutatorException) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Rollback(_)).WillOnce(Return(Status()));
+
+  Client client(conn);
+  auto f =
+      client.AsyncCommit([](Transaction const&) -> StatusOr<Mutations> {
+        throw std::runtime_error("uh-oh");
+      });
+  EXPECT_THROW(f.get(), std::runtime_error);
+}
+#endif
+
 TEST(ClientTest, ProfileQuerySuccess) {
   auto conn = std::make_shared<MockConnection>();
   Client client(conn);
@@ -0,0 +1,60 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/connection.h"
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+namespace {
+template <typename T>
+future<StatusOr<T>> Unimplemented(char const* name) {
+  return make_ready_future(StatusOr<T>(Status(
+      StatusCode::kUnimplemented, std::string(name) + " not implemented")));
+}
+}  // namespace
+
+future<StatusOr<RowStream>> Connection::AsyncRead(ReadParams) {
+  return Unimplemented<RowStream>(__func__);
+}
+
+future<StatusOr<RowStream>> Connection::AsyncExecuteQuery(SqlParams) {
+  return Unimplemented<RowStream>(__func__);
+}
+
+future<StatusOr<DmlResult>> Connection::AsyncExecuteDml(SqlParams) {
+  return Unimplemented<DmlResult>(__func__);
+}
+
+future<StatusOr<BatchDmlResult>> Connection::AsyncExecuteBatchDml(
+    ExecuteBatchDmlParams) {
+  return Unimplemented<BatchDmlResult>(__func__);
+}
+
+future<StatusOr<CommitResult>> Connection::AsyncCommit(CommitParams) {
+  return Unimplemented<CommitResult>(__func__);
+}
+
+future<Status> Connection::AsyncBackoff(std::chrono::milliseconds) {
+  return make_ready_future(
+      Status(StatusCode::kUnimplemented, "AsyncBackoff not implemented"));
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
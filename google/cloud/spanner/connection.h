@@ -28,9 +28,11 @@
 #include "google/cloud/spanner/sql_statement.h"
 #include "google/cloud/spanner/transaction.h"
 #include "google/cloud/spanner/version.h"
+#include "google/cloud/future.h"
 #include "google/cloud/optional.h"
 #include "google/cloud/status_or.h"
 #include "absl/types/optional.h"
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -162,6 +164,42 @@ class Connection {
 
   /// Defines the interface for `Client::Rollback()`
   virtual Status Rollback(RollbackParams) = 0;
+
+  //@{
+  /**
+   * @name Asynchronous operations.
+   *
+   * These are not pure-virtual, so existing classes derived from `Connection`
+   * need not implement them. The default implementations return
+   * `StatusCode::kUnimplemented`.
+   */
+
+  /// Defines the interface for `Client::AsyncRead()`
+  virtual future<StatusOr<RowStream>> AsyncRead(ReadParams);
+
+  /// Defines the interface for `Client::AsyncExecuteQuery()`
+  virtual future<StatusOr<RowStream>> AsyncExecuteQuery(SqlParams);
+
+  /// Defines the interface for `Client::AsyncExecuteDml()`
+  virtual future<StatusOr<DmlResult>> AsyncExecuteDml(SqlParams);
+
+  /// Defines the interface for `Client::AsyncExecuteBatchDml()`
+  virtual future<StatusOr<BatchDmlResult>> AsyncExecuteBatchDml(
+      ExecuteBatchDmlParams);
+
+  /// Defines the interface for `Client::AsyncCommit()`
+  virtual future<StatusOr<CommitResult>> AsyncCommit(CommitParams);
+
+  /**
+   * Returns a future that is satisfied once @p delay has elapsed.
+   *
+   * `Client::AsyncCommit()` uses this to wait before rerunning an aborted
+   * transaction, without blocking a thread while it waits. The future is
+   * satisfied with an error if the wait cannot complete, for example, because
+   * the connection is shutting down.
+   */
+  virtual future<Status> AsyncBackoff(std::chrono::milliseconds delay);
+  //@}
 };
 
 }  // namespace SPANNER_CLIENT_NS
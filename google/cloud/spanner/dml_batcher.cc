@@ -0,0 +1,121 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/dml_batcher.h"
+#include "google/cloud/log.h"
+#include <algorithm>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+DmlBatcher::DmlBatcher(Client client, Transaction transaction,
+                       DmlBatcherOptions options)
+    : client_(std::move(client)),
+      transaction_(std::move(transaction)),
+      options_(std::move(options)) {}
+
+DmlBatcher::~DmlBatcher() {
+  // Any error is reported through the futures of the statements.
+  Flush();
+}
+
+future<StatusOr<std::int64_t>> DmlBatcher::ExecuteDml(
+    SqlStatement statement) {
+  statements_.push_back(std::move(statement));
+  row_counts_.emplace_back();
+  auto f = row_counts_.back().get_future();
+  if (statements_.size() >= (std::max)(options_.max_batch_statements(),
+                                       std::size_t{1})) {
+    Flush();
+  }
+  return f;
+}
+
+Status DmlBatcher::Flush() {
+  auto status = SendBatch();
+  if (first_error_.ok()) first_error_ = std::move(status);
+  return first_error_;
+}
+
+Status DmlBatcher::SendBatch() {
+  if (statements_.empty()) return {};
+  auto statements = std::move(statements_);
+  auto row_counts = std::move(row_counts_);
+  statements_.clear();
+  row_counts_.clear();
+
+  auto result = client_.ExecuteBatchDml(transaction_, std::move(statements));
+  if (!result) {
+    for (auto& p : row_counts) p.set_value(result.status());
+    return std::move(result).status();
+  }
+
+  // The statements run in order, and the batch stops at the first failure, so
+  // `stats` has an entry for each statement before the one that failed.
+  auto const executed = (std::min)(result->stats.size(), row_counts.size());
+  for (std::size_t i = 0; i != executed; ++i) {
+    row_counts[i].set_value(result->stats[i].row_count);
+  }
+  if (executed == row_counts.size()) return {};
+
+  auto status = result->status;
+  if (status.ok()) {
+    status = Status(StatusCode::kInternal,
+                    "ExecuteBatchDml() returned fewer results than statements");
+  }
+  row_counts[executed].set_value(status);
+  for (auto i = executed + 1; i != row_counts.size(); ++i) {
+    row_counts[i].set_value(Status(
+        StatusCode::kCancelled,
+        "statement not executed, an earlier statement in the batch failed: " +
+            status.message()));
+  }
+  return status;
+}
+
+RowStream DmlBatcher::ExecuteQuery(SqlStatement statement,
+                                   QueryOptions const& opts) {
+  Flush();
+  return client_.ExecuteQuery(transaction_, std::move(statement), opts);
+}
+
+RowStream DmlBatcher::Read(std::string table, KeySet keys,
+                           std::vector<std::string> columns,
+                           ReadOptions read_options) {
+  Flush();
+  return client_.Read(transaction_, std::move(table), std::move(keys),
+                      std::move(columns), std::move(read_options));
+}
+
+StatusOr<CommitResult> DmlBatcher::Commit(Mutations mutations) {
+  // Any earlier batch may have failed too, and `Flush()` reports those.
+  auto status = Flush();
+  if (!status.ok()) {
+    auto rb_status = client_.Rollback(transaction_);
+    if (!rb_status.ok()) {
+      GCP_LOG(WARNING) << "Rollback() failure in DmlBatcher::Commit(): "
+                       << rb_status.message();
+    }
+    return status;
+  }
+  return client_.Commit(transaction_, std::move(mutations));
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,168 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_DML_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_DML_BATCHER_H
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/commit_result.h"
+#include "google/cloud/spanner/keys.h"
+#include "google/cloud/spanner/mutations.h"
+#include "google/cloud/spanner/query_options.h"
+#include "google/cloud/spanner/read_options.h"
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/sql_statement.h"
+#include "google/cloud/spanner/transaction.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Controls when `DmlBatcher` sends its pending statements.
+ */
+class DmlBatcherOptions {
+ public:
+  /**
+   * The maximum number of statements in a single `ExecuteBatchDml()` call.
+   *
+   * Once this many statements are pending, `DmlBatcher::ExecuteDml()` sends
+   * them before returning.
+   */
+  DmlBatcherOptions& set_max_batch_statements(std::size_t count) {
+    max_batch_statements_ = count;
+    return *this;
+  }
+  std::size_t max_batch_statements() const { return max_batch_statements_; }
+
+ private:
+  std::size_t max_batch_statements_ = 100;
+};
+
+/**
+ * Groups the DML statements of a read-write transaction into batches.
+ *
+ * Each `Client::ExecuteDml()` call is a round trip to the service. Code that
+ * runs many small statements in one transaction, but does not need their row
+ * counts right away, can use this class instead. `ExecuteDml()` adds the
+ * statement to a pending batch and returns a future for its row count. The
+ * pending statements are sent as a single `Client::ExecuteBatchDml()` call
+ * when:
+ *
+ * - `max_batch_statements()` statements are pending,
+ * - `ExecuteQuery()`, `Read()`, `Commit()`, or `Flush()` is called, so the
+ *   reads observe the effect of the earlier statements, or
+ * - the batcher is destroyed.
+ *
+ * Cloud Spanner stops a batch at the first statement that fails. The future
+ * of that statement is satisfied with its error, and the futures of the
+ * statements that followed it with `StatusCode::kCancelled`. The transaction
+ * remains usable, but the changes of the failed statements are not applied.
+ * The batcher remembers the first failure, including those of the batches
+ * sent by `ExecuteDml()`, `ExecuteQuery()` and `Read()`: `Flush()` returns it,
+ * and `Commit()` rolls the transaction back instead of committing it.
+ *
+ * The futures are only satisfied when the statements are sent, so call
+ * `Flush()` before waiting on them. Instances of this class are not safe to
+ * use from several threads.
+ *
+ * @par Example
+ * @code
+ * auto commit = client.Commit([&client](spanner::Transaction txn)
+ *                                 -> StatusOr<spanner::Mutations> {
+ *   spanner::DmlBatcher batcher(client, txn);
+ *   for (auto const& id : ids) {
+ *     batcher.ExecuteDml(spanner::SqlStatement(
+ *         "UPDATE Albums SET Plays = Plays + 1 WHERE AlbumId = @id",
+ *         {{"id", spanner::Value(id)}}));
+ *   }
+ *   auto status = batcher.Flush();
+ *   if (!status.ok()) return status;
+ *   return spanner::Mutations{};
+ * });
+ * @endcode
+ */
+class DmlBatcher {
+ public:
+  DmlBatcher(Client client, Transaction transaction,
+             DmlBatcherOptions options = DmlBatcherOptions());
+
+  /// Sends any pending statements.
+  ~DmlBatcher();
+
+  DmlBatcher(DmlBatcher const&) = delete;
+  DmlBatcher& operator=(DmlBatcher const&) = delete;
+
+  /**
+   * Adds @p statement to the pending batch.
+   *
+   * @return a future satisfied with the number of rows modified by the
+   *     statement once it is sent, or with its error.
+   */
+  future<StatusOr<std::int64_t>> ExecuteDml(SqlStatement statement);
+
+  /**
+   * Sends the pending statements, if any.
+   *
+   * @return the error of the first statement that failed, if any, in this or
+   *     any earlier batch.
+   */
+  Status Flush();
+
+  /// Sends the pending statements, then runs the query in the transaction.
+  RowStream ExecuteQuery(SqlStatement statement, QueryOptions const& opts = {});
+
+  /// Sends the pending statements, then reads in the transaction.
+  RowStream Read(std::string table, KeySet keys,
+                 std::vector<std::string> columns,
+                 ReadOptions read_options = {});
+
+  /**
+   * Sends the pending statements, then commits the transaction.
+   *
+   * If any statement sent by this batcher failed, the transaction is rolled
+   * back instead, and the error of the first one is returned.
+   */
+  StatusOr<CommitResult> Commit(Mutations mutations = {});
+
+  /// The number of statements not yet sent.
+  std::size_t pending() const { return statements_.size(); }
+
+ private:
+  // Sends the pending statements, returning the error of this batch.
+  Status SendBatch();
+
+  Client client_;
+  Transaction transaction_;
+  DmlBatcherOptions const options_;
+  std::vector<SqlStatement> statements_;
+  std::vector<promise<StatusOr<std::int64_t>>> row_counts_;
+  Status first_error_;
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_DML_BATCHER_H
@@ -0,0 +1,236 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/dml_batcher.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::InSequence;
+using ::testing::Return;
+
+SqlStatement MakeUpdate(std::int64_t id) {
+  return SqlStatement("UPDATE T SET C = 1 WHERE Id = " + std::to_string(id));
+}
+
+std::vector<std::string> StatementText(
+    Connection::ExecuteBatchDmlParams const& params) {
+  std::vector<std::string> text;
+  for (auto const& s : params.statements) text.push_back(s.sql());
+  return text;
+}
+
+// Returns a result where the first @p count statements modified `10 * i` rows.
+BatchDmlResult MakeResult(std::int64_t count, Status status = Status()) {
+  BatchDmlResult result;
+  for (std::int64_t i = 0; i != count; ++i) {
+    result.stats.push_back(BatchDmlResult::Stats{10 * i});
+  }
+  result.status = std::move(status);
+  return result;
+}
+
+RowStream EmptyStream() {
+  auto source = absl::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*source, NextRow()).WillRepeatedly(Return(Row()));
+  return RowStream(std::move(source));
+}
+
+TEST(DmlBatcherTest, BatchesUntilFlush) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml(_))
+      .WillOnce([](Connection::ExecuteBatchDmlParams const& params) {
+        EXPECT_THAT(StatementText(params),
+                    ElementsAre(MakeUpdate(0).sql(), MakeUpdate(1).sql(),
+                                MakeUpdate(2).sql()));
+        return MakeResult(3);
+      });
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  std::vector<future<StatusOr<std::int64_t>>> row_counts;
+  for (std::int64_t i = 0; i != 3; ++i) {
+    row_counts.push_back(batcher.ExecuteDml(MakeUpdate(i)));
+  }
+  EXPECT_EQ(3, batcher.pending());
+  EXPECT_STATUS_OK(batcher.Flush());
+  EXPECT_EQ(0, batcher.pending());
+  for (std::int64_t i = 0; i != 3; ++i) {
+    auto count = row_counts[i].get();
+    ASSERT_STATUS_OK(count);
+    EXPECT_EQ(10 * i, *count);
+  }
+  // There is nothing left to send.
+  EXPECT_STATUS_OK(batcher.Flush());
+}
+
+TEST(DmlBatcherTest, FlushesAtLimit) {
+  auto conn = std::make_shared<MockConnection>();
+  std::vector<std::size_t> batch_sizes;
+  EXPECT_CALL(*conn, ExecuteBatchDml(_))
+      .Times(3)
+      .WillRepeatedly(
+          [&batch_sizes](Connection::ExecuteBatchDmlParams const& params) {
+            batch_sizes.push_back(params.statements.size());
+            return MakeResult(
+                static_cast<std::int64_t>(params.statements.size()));
+          });
+
+  {
+    DmlBatcher batcher(Client(conn), MakeReadWriteTransaction(),
+                       DmlBatcherOptions().set_max_batch_statements(2));
+    for (std::int64_t i = 0; i != 5; ++i) batcher.ExecuteDml(MakeUpdate(i));
+    EXPECT_EQ(1, batcher.pending());
+    // The destructor sends the last statement.
+  }
+  EXPECT_THAT(batch_sizes, ElementsAre(2, 2, 1));
+}
+
+TEST(DmlBatcherTest, StatementErrors) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml(_))
+      .WillOnce(Return(
+          MakeResult(1, Status(StatusCode::kInvalidArgument, "bad column"))));
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  auto f0 = batcher.ExecuteDml(MakeUpdate(0));
+  auto f1 = batcher.ExecuteDml(MakeUpdate(1));
+  auto f2 = batcher.ExecuteDml(MakeUpdate(2));
+  auto status = batcher.Flush();
+  EXPECT_EQ(StatusCode::kInvalidArgument, status.code());
+
+  auto r0 = f0.get();
+  ASSERT_STATUS_OK(r0);
+  EXPECT_EQ(0, *r0);
+  auto r1 = f1.get();
+  EXPECT_EQ(StatusCode::kInvalidArgument, r1.status().code());
+  EXPECT_EQ("bad column", r1.status().message());
+  auto r2 = f2.get();
+  EXPECT_EQ(StatusCode::kCancelled, r2.status().code());
+}
+
+TEST(DmlBatcherTest, RequestError) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml(_))
+      .WillOnce(Return(Status(StatusCode::kPermissionDenied, "uh-oh")));
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  auto f0 = batcher.ExecuteDml(MakeUpdate(0));
+  auto f1 = batcher.ExecuteDml(MakeUpdate(1));
+  EXPECT_EQ(StatusCode::kPermissionDenied, batcher.Flush().code());
+  EXPECT_EQ(StatusCode::kPermissionDenied, f0.get().status().code());
+  EXPECT_EQ(StatusCode::kPermissionDenied, f1.get().status().code());
+}
+
+TEST(DmlBatcherTest, ReadsFlushFirst) {
+  auto conn = std::make_shared<MockConnection>();
+  {
+    InSequence seq;
+    EXPECT_CALL(*conn, ExecuteBatchDml(_)).WillOnce(Return(MakeResult(1)));
+    EXPECT_CALL(*conn, ExecuteQuery(_))
+        .WillOnce([](Connection::SqlParams const&) { return EmptyStream(); });
+    EXPECT_CALL(*conn, ExecuteBatchDml(_)).WillOnce(Return(MakeResult(1)));
+    EXPECT_CALL(*conn, Read(_))
+        .WillOnce([](Connection::ReadParams const& params) {
+          EXPECT_EQ("T", params.table);
+          return EmptyStream();
+        });
+  }
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  auto f0 = batcher.ExecuteDml(MakeUpdate(0));
+  batcher.ExecuteQuery(SqlStatement("SELECT C FROM T"));
+  EXPECT_STATUS_OK(f0.get());
+  auto f1 = batcher.ExecuteDml(MakeUpdate(1));
+  batcher.Read("T", KeySet::All(), {"C"});
+  EXPECT_STATUS_OK(f1.get());
+}
+
+TEST(DmlBatcherTest, CommitFlushesFirst) {
+  auto conn = std::make_shared<MockConnection>();
+  {
+    InSequence seq;
+    EXPECT_CALL(*conn, ExecuteBatchDml(_)).WillOnce(Return(MakeResult(1)));
+    EXPECT_CALL(*conn, Commit(_)).WillOnce(Return(CommitResult{}));
+  }
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  auto f0 = batcher.ExecuteDml(MakeUpdate(0));
+  EXPECT_STATUS_OK(batcher.Commit());
+  EXPECT_STATUS_OK(f0.get());
+}
+
+TEST(DmlBatcherTest, CommitRollsBackAfterError) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml(_))
+      .WillOnce(
+          Return(MakeResult(0, Status(StatusCode::kAlreadyExists, "dup"))));
+  EXPECT_CALL(*conn, Commit(_)).Times(0);
+  EXPECT_CALL(*conn, Rollback(_)).WillOnce(Return(Status()));
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  auto f0 = batcher.ExecuteDml(MakeUpdate(0));
+  auto commit = batcher.Commit();
+  EXPECT_EQ(StatusCode::kAlreadyExists, commit.status().code());
+  EXPECT_EQ(StatusCode::kAlreadyExists, f0.get().status().code());
+}
+
+TEST(DmlBatcherTest, CommitRollsBackAfterErrorAtLimit) {
+  auto conn = std::make_shared<MockConnection>();
+  {
+    InSequence seq;
+    EXPECT_CALL(*conn, ExecuteBatchDml(_))
+        .WillOnce(Return(
+            MakeResult(1, Status(StatusCode::kInvalidArgument, "bad column"))));
+    EXPECT_CALL(*conn, ExecuteQuery(_))
+        .WillOnce([](Connection::SqlParams const&) { return EmptyStream(); });
+    EXPECT_CALL(*conn, ExecuteBatchDml(_)).WillOnce(Return(MakeResult(1)));
+    EXPECT_CALL(*conn, Rollback(_)).WillOnce(Return(Status()));
+  }
+  EXPECT_CALL(*conn, Commit(_)).Times(0);
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction(),
+                     DmlBatcherOptions().set_max_batch_statements(2));
+  // The batch is sent when it fills, and the second statement fails.
+  batcher.ExecuteDml(MakeUpdate(0));
+  auto f1 = batcher.ExecuteDml(MakeUpdate(1));
+  EXPECT_EQ(0, batcher.pending());
+  EXPECT_EQ(StatusCode::kInvalidArgument, f1.get().status().code());
+
+  // The later statements succeed, but must not commit the partial work.
+  batcher.ExecuteQuery(SqlStatement("SELECT C FROM T"));
+  batcher.ExecuteDml(MakeUpdate(2));
+  auto commit = batcher.Commit();
+  EXPECT_EQ(StatusCode::kInvalidArgument, commit.status().code());
+  EXPECT_EQ("bad column", commit.status().message());
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -17,6 +17,7 @@
 
 #include "google/cloud/spanner/internal/spanner_stub.h"
 #include "google/cloud/spanner/version.h"
+#include <atomic>
 #include <memory>
 
 namespace google {
@@ -38,7 +39,11 @@ struct Channel {
   Channel& operator=(Channel const&) = delete;
 
   std::shared_ptr<SpannerStub> const stub;
-  int session_count = 0;
+  int session_count = 0;  // GUARDED_BY(SessionPool::mu_)
+  // The sessions on this channel that are not idle in the pool, i.e., the
+  // ones in use by a caller, or beginning a transaction in the background.
+  // Used as an estimate of the RPCs in flight on the channel.
+  std::atomic<int> active_sessions{0};
 };
 
 }  // namespace internal
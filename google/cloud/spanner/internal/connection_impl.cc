@@ -16,11 +16,14 @@
 #include "google/cloud/spanner/internal/logging_result_set_reader.h"
 #include "google/cloud/spanner/internal/partial_result_set_resume.h"
 #include "google/cloud/spanner/internal/partial_result_set_source.h"
+#include "google/cloud/spanner/internal/pipelined_result_source.h"
 #include "google/cloud/spanner/internal/retry_loop.h"
 #include "google/cloud/spanner/internal/status_utils.h"
 #include "google/cloud/spanner/query_partition.h"
 #include "google/cloud/spanner/read_partition.h"
+#include "google/cloud/completion_queue.h"
 #include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/internal/async_retry_unary_rpc.h"
 #include "absl/memory/memory.h"
 #include <limits>
 
@@ -103,6 +106,49 @@ Status MissingTransactionStatus(std::string const& operation) {
                     operation + ")");
 }
 
+spanner_proto::ReadRequest MakeReadRequest(
+    Session const& session, spanner_proto::TransactionSelector const& s,
+    Connection::ReadParams params) {
+  spanner_proto::ReadRequest request;
+  request.set_session(session.session_name());
+  *request.mutable_transaction() = s;
+  request.set_table(std::move(params.table));
+  request.set_index(std::move(params.read_options.index_name));
+  for (auto&& column : params.columns) {
+    request.add_columns(std::move(column));
+  }
+  *request.mutable_key_set() = internal::ToProto(std::move(params.keys));
+  request.set_limit(params.read_options.limit);
+  if (params.partition_token) {
+    request.set_partition_token(*std::move(params.partition_token));
+  }
+  return request;
+}
+
+spanner_proto::ExecuteSqlRequest MakeExecuteSqlRequest(
+    Session const& session, spanner_proto::TransactionSelector const& s,
+    std::int64_t seqno, Connection::SqlParams params,
+    spanner_proto::ExecuteSqlRequest::QueryMode query_mode) {
+  spanner_proto::ExecuteSqlRequest request;
+  request.set_session(session.session_name());
+  *request.mutable_transaction() = s;
+  auto sql_statement = internal::ToProto(std::move(params.statement));
+  request.set_sql(std::move(*sql_statement.mutable_sql()));
+  *request.mutable_params() = std::move(*sql_statement.mutable_params());
+  *request.mutable_param_types() =
+      std::move(*sql_statement.mutable_param_types());
+  request.set_seqno(seqno);
+  request.set_query_mode(query_mode);
+  if (params.partition_token) {
+    request.set_partition_token(*std::move(params.partition_token));
+  }
+  if (params.query_options.optimizer_version()) {
+    request.mutable_query_options()->set_optimizer_version(
+        *params.query_options.optimizer_version());
+  }
+  return request;
+}
+
 ConnectionImpl::ConnectionImpl(Database db,
                                std::vector<std::shared_ptr<SpannerStub>> stubs,
                                ConnectionOptions const& options,
@@ -360,39 +406,30 @@ RowStream ConnectionImpl::ReadImpl(
     return MakeStatusOnlyResult<RowStream>(std::move(prepare_status));
   }
 
-  spanner_proto::ReadRequest request;
-  request.set_session(session->session_name());
-  *request.mutable_transaction() = *s;
-  request.set_table(std::move(params.table));
-  request.set_index(std::move(params.read_options.index_name));
-  for (auto&& column : params.columns) {
-    request.add_columns(std::move(column));
-  }
-  *request.mutable_key_set() = internal::ToProto(std::move(params.keys));
-  request.set_limit(params.read_options.limit);
-  if (params.partition_token) {
-    request.set_partition_token(*std::move(params.partition_token));
-  }
+  auto const prefetch_rows = params.read_options.prefetch_rows;
+  auto request = MakeReadRequest(*session, *s, std::move(params));
 
   // Capture a copy of `stub` to ensure the `shared_ptr<>` remains valid through
   // the lifetime of the lambda.
   auto stub = session_pool_->GetStub(*session);
   auto const tracing_enabled = rpc_stream_tracing_enabled_;
   auto const tracing_options = tracing_options_;
-  auto factory = [stub, &request, tracing_enabled,
-                  tracing_options](std::string const& resume_token) mutable {
-    request.set_resume_token(resume_token);
-    auto context = absl::make_unique<grpc::ClientContext>();
-    std::unique_ptr<PartialResultSetReader> reader =
-        absl::make_unique<DefaultPartialResultSetReader>(
-            std::move(context), stub->StreamingRead(*context, request));
-    if (tracing_enabled) {
-      reader = absl::make_unique<LoggingResultSetReader>(std::move(reader),
-                                                         tracing_options);
-    }
-    return reader;
-  };
   for (;;) {
+    // Capture a copy of `request`, as the stream may be resumed after this
+    // function returns.
+    auto factory = [stub, request, tracing_enabled,
+                    tracing_options](std::string const& resume_token) mutable {
+      request.set_resume_token(resume_token);
+      auto context = absl::make_unique<grpc::ClientContext>();
+      std::unique_ptr<PartialResultSetReader> reader =
+          absl::make_unique<DefaultPartialResultSetReader>(
+              std::move(context), stub->StreamingRead(*context, request));
+      if (tracing_enabled) {
+        reader = absl::make_unique<LoggingResultSetReader>(std::move(reader),
+                                                           tracing_options);
+      }
+      return reader;
+    };
     auto rpc = absl::make_unique<PartialResultSetResume>(
         factory, Idempotency::kIdempotent, retry_policy_prototype_->clone(),
         backoff_policy_prototype_->clone());
@@ -421,7 +458,8 @@ RowStream ConnectionImpl::ReadImpl(
       if (internal::IsSessionNotFound(status)) session->set_bad();
       return MakeStatusOnlyResult<RowStream>(std::move(status));
     }
-    return RowStream(*std::move(reader));
+    return RowStream(
+        MakePipelinedResultSource(*std::move(reader), prefetch_rows));
   }
 }
 
@@ -508,23 +546,8 @@ StatusOr<ResultType> ConnectionImpl::ExecuteSqlImpl(
     return s.status();
   }
 
-  spanner_proto::ExecuteSqlRequest request;
-  request.set_session(session->session_name());
-  *request.mutable_transaction() = *s;
-  auto sql_statement = internal::ToProto(std::move(params.statement));
-  request.set_sql(std::move(*sql_statement.mutable_sql()));
-  *request.mutable_params() = std::move(*sql_statement.mutable_params());
-  *request.mutable_param_types() =
-      std::move(*sql_statement.mutable_param_types());
-  request.set_seqno(seqno);
-  request.set_query_mode(query_mode);
-  if (params.partition_token) {
-    request.set_partition_token(*std::move(params.partition_token));
-  }
-  if (params.query_options.optimizer_version()) {
-    request.mutable_query_options()->set_optimizer_version(
-        *params.query_options.optimizer_version());
-  }
+  auto request = MakeExecuteSqlRequest(*session, *s, seqno, std::move(params),
+                                       query_mode);
 
   for (;;) {
     auto reader = retry_resume_fn(request);
@@ -574,9 +597,10 @@ ResultType ConnectionImpl::CommonQueryImpl(
   auto const& backoff_policy = backoff_policy_prototype_;
   auto const tracing_enabled = rpc_stream_tracing_enabled_;
   auto const tracing_options = tracing_options_;
+  auto const prefetch_rows = params.query_options.prefetch_rows().value_or(0);
   auto retry_resume_fn =
-      [stub, retry_policy, backoff_policy, tracing_enabled,
-       tracing_options](spanner_proto::ExecuteSqlRequest& request) mutable
+      [stub, retry_policy, backoff_policy, tracing_enabled, tracing_options,
+       prefetch_rows](spanner_proto::ExecuteSqlRequest& request) mutable
       -> StatusOr<std::unique_ptr<ResultSourceInterface>> {
     auto factory = [stub, request, tracing_enabled,
                     tracing_options](std::string const& resume_token) mutable {
@@ -595,7 +619,9 @@ ResultType ConnectionImpl::CommonQueryImpl(
         std::move(factory), Idempotency::kIdempotent, retry_policy->clone(),
         backoff_policy->clone());
 
-    return PartialResultSetSource::Create(std::move(rpc));
+    auto source = PartialResultSetSource::Create(std::move(rpc));
+    if (!source) return source;
+    return MakePipelinedResultSource(*std::move(source), prefetch_rows);
   };
 
   StatusOr<ResultType> response =
@@ -880,6 +906,14 @@ StatusOr<CommitResult> ConnectionImpl::CommitImpl(
     return s.status();
   }
 
+  // A read-write transaction with no statements can use a transaction that
+  // the pool already began on the session.
+  bool const begin_read_write = s->has_begin() && s->begin().has_read_write();
+  if (!session && begin_read_write) {
+    auto session_or = session_pool_->AllocateForWrite();
+    if (!session_or) return std::move(session_or).status();
+    session = std::move(*session_or);
+  }
   auto prepare_status = PrepareSession(session);
   if (!prepare_status.ok()) {
     return prepare_status;
@@ -891,6 +925,10 @@ StatusOr<CommitResult> ConnectionImpl::CommitImpl(
     *request.add_mutations() = std::move(m).as_proto();
   }
 
+  if (begin_read_write) {
+    auto id = session->TakeWriteTransactionId();
+    if (!id.empty()) s->set_id(std::move(id));
+  }
   if (s->selector_case() != spanner_proto::TransactionSelector::kId) {
     auto begin = BeginTransaction(
         session, s->has_begin() ? s->begin() : s->single_use(), __func__);
@@ -906,9 +944,17 @@ StatusOr<CommitResult> ConnectionImpl::CommitImpl(
   auto response = internal::RetryLoop(
       retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
       true,
-      [&stub](grpc::ClientContext& context,
-              spanner_proto::CommitRequest const& request) {
-        return stub->Commit(context, request);
+      [&stub, &session](grpc::ClientContext& context,
+                        spanner_proto::CommitRequest const& request) {
+        auto response = stub->Commit(context, request);
+        if (!response && response.status().code() == StatusCode::kAborted) {
+          // Remember how long the service wants us to wait before rerunning
+          // the transaction, see `Client::Commit()`.
+          auto delay = internal::RetryDelayFromTrailers(
+              context.GetServerTrailingMetadata());
+          if (delay) session->set_retry_delay(*delay);
+        }
+        return response;
       },
       request, __func__);
   if (!response) {
@@ -933,20 +979,19 @@ Status ConnectionImpl::RollbackImpl(
                   "Cannot rollback a single-use transaction");
   }
 
+  if (s->has_begin()) {
+    // No statement has begun the transaction (the first one would have done
+    // so inline), so there is nothing to roll back on the server.
+    s = Status(StatusCode::kFailedPrecondition,
+               "Transaction has been rolled back");  // invalidate it
+    return Status();
+  }
+
   auto prepare_status = PrepareSession(session);
   if (!prepare_status.ok()) {
     return prepare_status;
   }
 
-  if (s->has_begin()) {
-    auto begin = BeginTransaction(session, s->begin(), __func__);
-    if (!begin.ok()) {
-      s = begin.status();  // invalidate the transaction
-      return begin.status();
-    }
-    s->set_id(begin->id());
-  }
-
   spanner_proto::RollbackRequest request;
   request.set_session(session->session_name());
   request.set_transaction_id(s->id());
@@ -963,6 +1008,540 @@ Status ConnectionImpl::RollbackImpl(
   return status;
 }
 
+struct AsyncOperationContext {
+  CompletionQueue cq;
+  std::shared_ptr<SessionPool> session_pool;
+  std::shared_ptr<RetryPolicy const> retry_policy;
+  std::shared_ptr<BackoffPolicy const> backoff_policy;
+};
+
+std::shared_ptr<AsyncOperationContext const>
+ConnectionImpl::MakeAsyncOperationContext() {
+  return std::make_shared<AsyncOperationContext>(AsyncOperationContext{
+      background_threads_->cq(), session_pool_, retry_policy_prototype_,
+      backoff_policy_prototype_});
+}
+
+namespace {
+
+using AsyncContextPtr = std::shared_ptr<AsyncOperationContext const>;
+
+/**
+ * Presents the rows of a `ResultSet` as a single `PartialResultSet`, so that
+ * `PartialResultSetSource` can decode the response of a unary RPC.
+ */
+class ResultSetReader : public PartialResultSetReader {
+ public:
+  explicit ResultSetReader(spanner_proto::ResultSet result_set)
+      : result_set_(std::move(result_set)) {}
+  ~ResultSetReader() override = default;
+
+  void TryCancel() override {}
+
+  absl::optional<spanner_proto::PartialResultSet> Read() override {
+    if (done_) return {};
+    done_ = true;
+    spanner_proto::PartialResultSet result;
+    result.mutable_metadata()->Swap(result_set_.mutable_metadata());
+    for (auto& row : *result_set_.mutable_rows()) {
+      for (auto& value : *row.mutable_values()) {
+        result.add_values()->Swap(&value);
+      }
+    }
+    if (result_set_.has_stats()) {
+      result.mutable_stats()->Swap(result_set_.mutable_stats());
+    }
+    return result;
+  }
+
+  Status Finish() override { return Status(); }
+
+ private:
+  spanner_proto::ResultSet result_set_;
+  bool done_ = false;
+};
+
+/// Marks `session` as bad if the operation failed because it does not exist.
+template <typename T>
+future<StatusOr<T>> CheckSessionNotFound(SessionHolder& session,
+                                         future<StatusOr<T>> f) {
+  return f.then([&session](future<StatusOr<T>> f) -> StatusOr<T> {
+    auto response = f.get();
+    if (!response && internal::IsSessionNotFound(response.status())) {
+      session->set_bad();
+    }
+    return response;
+  });
+}
+
+/// Ensures `session` holds a `Session`, allocating one if needed.
+future<Status> AsyncPrepareSession(AsyncContextPtr const& context,
+                                   SessionHolder& session,
+                                   bool for_write = false) {
+  if (session) return make_ready_future(Status());
+  auto f = for_write ? context->session_pool->AsyncAllocateForWrite()
+                     : context->session_pool->AsyncAllocate();
+  return f.then([&session](future<StatusOr<SessionHolder>> f) -> Status {
+    auto session_or = f.get();
+    if (!session_or) return std::move(session_or).status();
+    session = *std::move(session_or);
+    return Status();
+  });
+}
+
+future<StatusOr<spanner_proto::Transaction>> AsyncBeginTransaction(
+    AsyncContextPtr const& context, SessionHolder& session,
+    spanner_proto::TransactionOptions options, char const* func) {
+  spanner_proto::BeginTransactionRequest request;
+  request.set_session(session->session_name());
+  *request.mutable_options() = std::move(options);
+  auto stub = context->session_pool->GetStub(*session);
+  return CheckSessionNotFound(
+      session,
+      google::cloud::internal::StartRetryAsyncUnaryRpc(
+          context->cq, func, context->retry_policy->clone(),
+          context->backoff_policy->clone(),
+          /*is_idempotent=*/true,
+          [stub](grpc::ClientContext* context,
+                 spanner_proto::BeginTransactionRequest const& request,
+                 grpc::CompletionQueue* cq) {
+            return stub->AsyncBeginTransaction(*context, request, cq);
+          },
+          std::move(request)));
+}
+
+future<StatusOr<spanner_proto::ResultSet>> AsyncReadCall(
+    AsyncContextPtr const& context, std::shared_ptr<SpannerStub> const& stub,
+    spanner_proto::ReadRequest const& request) {
+  return google::cloud::internal::StartRetryAsyncUnaryRpc(
+      context->cq, __func__, context->retry_policy->clone(),
+      context->backoff_policy->clone(),
+      /*is_idempotent=*/true,
+      [stub](grpc::ClientContext* context,
+             spanner_proto::ReadRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return stub->AsyncRead(*context, request, cq);
+      },
+      request);
+}
+
+future<StatusOr<spanner_proto::ResultSet>> AsyncExecuteSqlCall(
+    AsyncContextPtr const& context, std::shared_ptr<SpannerStub> const& stub,
+    spanner_proto::ExecuteSqlRequest const& request) {
+  return google::cloud::internal::StartRetryAsyncUnaryRpc(
+      context->cq, __func__, context->retry_policy->clone(),
+      context->backoff_policy->clone(),
+      /*is_idempotent=*/true,
+      [stub](grpc::ClientContext* context,
+             spanner_proto::ExecuteSqlRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return stub->AsyncExecuteSql(*context, request, cq);
+      },
+      request);
+}
+
+future<StatusOr<spanner_proto::ExecuteBatchDmlResponse>>
+AsyncExecuteBatchDmlCall(AsyncContextPtr const& context,
+                         std::shared_ptr<SpannerStub> const& stub,
+                         spanner_proto::ExecuteBatchDmlRequest const& request) {
+  return google::cloud::internal::StartRetryAsyncUnaryRpc(
+      context->cq, __func__, context->retry_policy->clone(),
+      context->backoff_policy->clone(),
+      /*is_idempotent=*/true,
+      [stub](grpc::ClientContext* context,
+             spanner_proto::ExecuteBatchDmlRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return stub->AsyncExecuteBatchDml(*context, request, cq);
+      },
+      request);
+}
+
+/**
+ * Makes the `Commit` RPC, retrying transient failures. Like `CommitImpl()`, it
+ * records in @p session how long the service wants us to wait before
+ * rerunning an aborted transaction, see `Client::Commit()`. That delay is in
+ * the trailing metadata, so this does not use `StartRetryAsyncUnaryRpc()`,
+ * which does not expose the `grpc::ClientContext`.
+ */
+future<StatusOr<spanner_proto::CommitResponse>> AsyncCommitCall(
+    CompletionQueue cq, std::shared_ptr<SpannerStub> stub,
+    spanner_proto::CommitRequest request,
+    std::shared_ptr<RetryPolicy> retry_policy,
+    std::shared_ptr<BackoffPolicy> backoff_policy, SessionHolder& session) {
+  using Response = StatusOr<spanner_proto::CommitResponse>;
+  auto client_context = absl::make_unique<grpc::ClientContext>();
+  // The future shares ownership of the context with the operation.
+  grpc::ClientContext const* trailers_source = client_context.get();
+  auto f = cq.MakeUnaryRpc(
+      [stub](grpc::ClientContext* context,
+             spanner_proto::CommitRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return stub->AsyncCommit(*context, request, cq);
+      },
+      request, std::move(client_context));
+  return f.then([cq, stub, request, retry_policy, backoff_policy, &session,
+                 trailers_source](future<Response> f) mutable
+                -> future<Response> {
+    // Read the trailers before `get()` releases the context.
+    auto delay = internal::RetryDelayFromTrailers(
+        trailers_source->GetServerTrailingMetadata());
+    auto response = f.get();
+    if (response) return make_ready_future(std::move(response));
+    if (response.status().code() == StatusCode::kAborted && delay) {
+      session->set_retry_delay(*delay);
+    }
+    if (!retry_policy->OnFailure(response.status())) {
+      return make_ready_future(std::move(response));
+    }
+    return cq.MakeRelativeTimer(backoff_policy->OnCompletion())
+        .then([cq, stub, request, retry_policy, backoff_policy, &session](
+                  future<StatusOr<std::chrono::system_clock::time_point>>
+                      f) mutable -> future<Response> {
+          auto timer = f.get();
+          if (!timer) {
+            return make_ready_future(Response(std::move(timer).status()));
+          }
+          return AsyncCommitCall(std::move(cq), std::move(stub),
+                                 std::move(request), std::move(retry_policy),
+                                 std::move(backoff_policy), session);
+        });
+  });
+}
+
+/// Returns the transaction begun inline by a statement, or `nullptr`.
+spanner_proto::Transaction const* BegunTransaction(
+    spanner_proto::ResultSet const& response) {
+  if (!response.metadata().has_transaction()) return nullptr;
+  return &response.metadata().transaction();
+}
+
+spanner_proto::Transaction const* BegunTransaction(
+    spanner_proto::ExecuteBatchDmlResponse const& response) {
+  if (response.result_sets_size() == 0) return nullptr;
+  return BegunTransaction(response.result_sets(0));
+}
+
+/// Returns true if the server ran (and so must have begun) the statement.
+bool ExecutedStatements(spanner_proto::ResultSet const&) { return true; }
+
+bool ExecutedStatements(
+    spanner_proto::ExecuteBatchDmlResponse const& response) {
+  return response.result_sets_size() > 0;
+}
+
+/**
+ * Runs `call(context, stub, request)`, beginning the transaction the same way
+ * the synchronous operations do: inline when `s` asks for a new transaction,
+ * with a fallback to an explicit `BeginTransaction` if the statement fails
+ * before the transaction is started.
+ */
+template <typename Response, typename Request, typename Call>
+future<StatusOr<Response>> AsyncStatement(
+    AsyncContextPtr context, SessionHolder& session,
+    StatusOr<spanner_proto::TransactionSelector>& s, Request request,
+    Call call, char const* func) {
+  auto stub = context->session_pool->GetStub(*session);
+  auto f = call(context, stub, request);
+  if (!s->has_begin()) return CheckSessionNotFound(session, std::move(f));
+  auto response = f.then([context, &session, &s, stub, request, call,
+                          func](future<StatusOr<Response>> f) mutable
+                         -> future<StatusOr<Response>> {
+    auto response = f.get();
+    if (response) {
+      auto const* transaction = BegunTransaction(*response);
+      if (transaction != nullptr) {
+        s->set_id(transaction->id());
+        return make_ready_future(std::move(response));
+      }
+      if (ExecutedStatements(*response)) {
+        s = MissingTransactionStatus(func);
+        return make_ready_future(StatusOr<Response>(s.status()));
+      }
+    }
+    auto begin = AsyncBeginTransaction(context, session, s->begin(), func);
+    return begin.then(
+        [context, &s, stub, request, call,
+         response](future<StatusOr<spanner_proto::Transaction>> f) mutable
+        -> future<StatusOr<Response>> {
+          auto begin = f.get();
+          if (!begin) {
+            s = std::move(begin).status();  // invalidate the transaction
+            return make_ready_future(std::move(response));
+          }
+          s->set_id(begin->id());
+          *request.mutable_transaction() = *s;
+          return call(context, stub, request);
+        });
+  });
+  return CheckSessionNotFound(session, std::move(response));
+}
+
+StatusOr<RowStream> MakeRowStream(
+    StatusOr<spanner_proto::ResultSet> response) {
+  if (!response) return std::move(response).status();
+  auto source = PartialResultSetSource::Create(
+      absl::make_unique<ResultSetReader>(*std::move(response)));
+  if (!source) return std::move(source).status();
+  return RowStream(*std::move(source));
+}
+
+future<StatusOr<RowStream>> AsyncReadImpl(
+    AsyncContextPtr context, SessionHolder& session,
+    StatusOr<spanner_proto::TransactionSelector>& s,
+    Connection::ReadParams params) {
+  if (!s.ok()) return make_ready_future(StatusOr<RowStream>(s.status()));
+  return AsyncPrepareSession(context, session)
+      .then([context, &session, &s,
+             params](future<Status> f) mutable -> future<StatusOr<RowStream>> {
+        auto status = f.get();
+        if (!status.ok()) {
+          return make_ready_future(StatusOr<RowStream>(std::move(status)));
+        }
+        auto request = MakeReadRequest(*session, *s, std::move(params));
+        return AsyncStatement<spanner_proto::ResultSet>(
+                   std::move(context), session, s, std::move(request),
+                   AsyncReadCall, "AsyncRead")
+            .then([](future<StatusOr<spanner_proto::ResultSet>> f) {
+              return MakeRowStream(f.get());
+            });
+      });
+}
+
+future<StatusOr<spanner_proto::ResultSet>> AsyncExecuteSqlImpl(
+    AsyncContextPtr context, SessionHolder& session,
+    StatusOr<spanner_proto::TransactionSelector>& s, std::int64_t seqno,
+    Connection::SqlParams params, char const* func) {
+  using Response = StatusOr<spanner_proto::ResultSet>;
+  if (!s.ok()) return make_ready_future(Response(s.status()));
+  return AsyncPrepareSession(context, session)
+      .then([context, &session, &s, seqno, params,
+             func](future<Status> f) mutable -> future<Response> {
+        auto status = f.get();
+        if (!status.ok()) return make_ready_future(Response(std::move(status)));
+        auto request =
+            MakeExecuteSqlRequest(*session, *s, seqno, std::move(params),
+                                  spanner_proto::ExecuteSqlRequest::NORMAL);
+        return AsyncStatement<spanner_proto::ResultSet>(
+            std::move(context), session, s, std::move(request),
+            AsyncExecuteSqlCall, func);
+      });
+}
+
+future<StatusOr<RowStream>> AsyncExecuteQueryImpl(
+    AsyncContextPtr context, SessionHolder& session,
+    StatusOr<spanner_proto::TransactionSelector>& s, std::int64_t seqno,
+    Connection::SqlParams params) {
+  return AsyncExecuteSqlImpl(std::move(context), session, s, seqno,
+                             std::move(params), "AsyncExecuteQuery")
+      .then([](future<StatusOr<spanner_proto::ResultSet>> f) {
+        return MakeRowStream(f.get());
+      });
+}
+
+future<StatusOr<DmlResult>> AsyncExecuteDmlImpl(
+    AsyncContextPtr context, SessionHolder& session,
+    StatusOr<spanner_proto::TransactionSelector>& s, std::int64_t seqno,
+    Connection::SqlParams params) {
+  return AsyncExecuteSqlImpl(std::move(context), session, s, seqno,
+                             std::move(params), "AsyncExecuteDml")
+      .then([](future<StatusOr<spanner_proto::ResultSet>> f)
+                -> StatusOr<DmlResult> {
+        auto response = f.get();
+        if (!response) return std::move(response).status();
+        auto source = DmlResultSetSource::Create(*std::move(response));
+        if (!source) return std::move(source).status();
+        return DmlResult(*std::move(source));
+      });
+}
+
+future<StatusOr<BatchDmlResult>> AsyncExecuteBatchDmlImpl(
+    AsyncContextPtr context, SessionHolder& session,
+    StatusOr<spanner_proto::TransactionSelector>& s, std::int64_t seqno,
+    Connection::ExecuteBatchDmlParams params) {
+  using Result = StatusOr<BatchDmlResult>;
+  if (!s.ok()) return make_ready_future(Result(s.status()));
+  return AsyncPrepareSession(context, session)
+      .then([context, &session, &s, seqno,
+             params](future<Status> f) mutable -> future<Result> {
+        auto status = f.get();
+        if (!status.ok()) return make_ready_future(Result(std::move(status)));
+        spanner_proto::ExecuteBatchDmlRequest request;
+        request.set_session(session->session_name());
+        request.set_seqno(seqno);
+        *request.mutable_transaction() = *s;
+        for (auto& sql : params.statements) {
+          *request.add_statements() = internal::ToProto(std::move(sql));
+        }
+        return AsyncStatement<spanner_proto::ExecuteBatchDmlResponse>(
+                   std::move(context), session, s, std::move(request),
+                   AsyncExecuteBatchDmlCall, "AsyncExecuteBatchDml")
+            .then([](future<StatusOr<spanner_proto::ExecuteBatchDmlResponse>>
+                         f) -> Result {
+              auto response = f.get();
+              if (!response) return std::move(response).status();
+              BatchDmlResult result;
+              result.status =
+                  google::cloud::MakeStatusFromRpcError(response->status());
+              for (auto const& result_set : response->result_sets()) {
+                result.stats.push_back({result_set.stats().row_count_exact()});
+              }
+              return result;
+            });
+      });
+}
+
+future<StatusOr<CommitResult>> AsyncCommitImpl(
+    AsyncContextPtr context, SessionHolder& session,
+    StatusOr<spanner_proto::TransactionSelector>& s,
+    Connection::CommitParams params) {
+  using Result = StatusOr<CommitResult>;
+  if (!s.ok()) {
+    // Fail the commit if the transaction has been invalidated.
+    return make_ready_future(Result(s.status()));
+  }
+
+  // As in `CommitImpl()`, prefer a session with a prepared transaction.
+  bool const begin_read_write = s->has_begin() && s->begin().has_read_write();
+  return AsyncPrepareSession(context, session, begin_read_write)
+      .then([context, &session, &s, params,
+             begin_read_write](future<Status> f) mutable -> future<Result> {
+        auto status = f.get();
+        if (!status.ok()) return make_ready_future(Result(std::move(status)));
+
+        spanner_proto::CommitRequest request;
+        request.set_session(session->session_name());
+        for (auto&& m : params.mutations) {
+          *request.add_mutations() = std::move(m).as_proto();
+        }
+        if (begin_read_write) {
+          auto id = session->TakeWriteTransactionId();
+          if (!id.empty()) s->set_id(std::move(id));
+        }
+        auto begun = make_ready_future(Status());
+        if (s->selector_case() != spanner_proto::TransactionSelector::kId) {
+          begun = AsyncBeginTransaction(
+                      context, session,
+                      s->has_begin() ? s->begin() : s->single_use(),
+                      "AsyncCommit")
+                      .then([&s](future<StatusOr<spanner_proto::Transaction>>
+                                     f) -> Status {
+                        auto begin = f.get();
+                        if (!begin) {
+                          s = begin.status();  // invalidate the transaction
+                          return std::move(begin).status();
+                        }
+                        s->set_id(begin->id());
+                        return Status();
+                      });
+        }
+        return begun.then([context, &session, &s, request](
+                              future<Status> f) mutable -> future<Result> {
+          auto status = f.get();
+          if (!status.ok()) return make_ready_future(Result(std::move(status)));
+          request.set_transaction_id(s->id());
+          auto stub = context->session_pool->GetStub(*session);
+          return CheckSessionNotFound(
+                     session,
+                     AsyncCommitCall(
+                         context->cq, std::move(stub), std::move(request),
+                         context->retry_policy->clone(),
+                         context->backoff_policy->clone(), session))
+              .then([](future<StatusOr<spanner_proto::CommitResponse>> f)
+                        -> Result {
+                auto response = f.get();
+                if (!response) return std::move(response).status();
+                auto timestamp = internal::TimestampFromProto(
+                    response->commit_timestamp());
+                if (!timestamp) return std::move(timestamp).status();
+                CommitResult r;
+                r.commit_timestamp = *std::move(timestamp);
+                return r;
+              });
+        });
+      });
+}
+
+}  // namespace
+
+// The visitors of `internal::AsyncVisit()` may run after these functions
+// return, so they share ownership of the context and parameters.
+future<StatusOr<RowStream>> ConnectionImpl::AsyncRead(ReadParams params) {
+  auto context = MakeAsyncOperationContext();
+  auto txn = std::move(params.transaction);
+  auto p = std::make_shared<ReadParams>(std::move(params));
+  return internal::AsyncVisit(
+      std::move(txn),
+      [context, p](SessionHolder& session,
+                   StatusOr<spanner_proto::TransactionSelector>& s,
+                   std::int64_t) {
+        return AsyncReadImpl(context, session, s, std::move(*p));
+      });
+}
+
+future<StatusOr<RowStream>> ConnectionImpl::AsyncExecuteQuery(
+    SqlParams params) {
+  auto context = MakeAsyncOperationContext();
+  auto txn = std::move(params.transaction);
+  auto p = std::make_shared<SqlParams>(std::move(params));
+  return internal::AsyncVisit(
+      std::move(txn),
+      [context, p](SessionHolder& session,
+                   StatusOr<spanner_proto::TransactionSelector>& s,
+                   std::int64_t seqno) {
+        return AsyncExecuteQueryImpl(context, session, s, seqno,
+                                     std::move(*p));
+      });
+}
+
+future<StatusOr<DmlResult>> ConnectionImpl::AsyncExecuteDml(SqlParams params) {
+  auto context = MakeAsyncOperationContext();
+  auto txn = std::move(params.transaction);
+  auto p = std::make_shared<SqlParams>(std::move(params));
+  return internal::AsyncVisit(
+      std::move(txn),
+      [context, p](SessionHolder& session,
+                   StatusOr<spanner_proto::TransactionSelector>& s,
+                   std::int64_t seqno) {
+        return AsyncExecuteDmlImpl(context, session, s, seqno, std::move(*p));
+      });
+}
+
+future<StatusOr<BatchDmlResult>> ConnectionImpl::AsyncExecuteBatchDml(
+    ExecuteBatchDmlParams params) {
+  auto context = MakeAsyncOperationContext();
+  auto txn = std::move(params.transaction);
+  auto p = std::make_shared<ExecuteBatchDmlParams>(std::move(params));
+  return internal::AsyncVisit(
+      std::move(txn),
+      [context, p](SessionHolder& session,
+                   StatusOr<spanner_proto::TransactionSelector>& s,
+                   std::int64_t seqno) {
+        return AsyncExecuteBatchDmlImpl(context, session, s, seqno,
+                                        std::move(*p));
+      });
+}
+
+future<StatusOr<CommitResult>> ConnectionImpl::AsyncCommit(
+    CommitParams params) {
+  auto context = MakeAsyncOperationContext();
+  auto txn = std::move(params.transaction);
+  auto p = std::make_shared<CommitParams>(std::move(params));
+  return internal::AsyncVisit(
+      std::move(txn),
+      [context, p](SessionHolder& session,
+                   StatusOr<spanner_proto::TransactionSelector>& s,
+                   std::int64_t) {
+        return AsyncCommitImpl(context, session, s, std::move(*p));
+      });
+}
+
+future<Status> ConnectionImpl::AsyncBackoff(std::chrono::milliseconds delay) {
+  return background_threads_->cq().MakeRelativeTimer(delay).then(
+      [](future<StatusOr<std::chrono::system_clock::time_point>> f) {
+        return f.get().status();
+      });
+}
+
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
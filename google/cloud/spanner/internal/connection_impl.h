@@ -28,6 +28,7 @@
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include <google/spanner/v1/spanner.pb.h>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <mutex>
@@ -60,6 +61,9 @@ std::shared_ptr<ConnectionImpl> MakeConnection(
     std::unique_ptr<BackoffPolicy> backoff_policy =
         DefaultConnectionBackoffPolicy());
 
+/// The state used by the asynchronous operations of `ConnectionImpl`.
+struct AsyncOperationContext;
+
 /**
  * A concrete `Connection` subclass that uses gRPC to actually talk to a real
  * Spanner instance. See `MakeConnection()` for a factory function that creates
@@ -83,6 +87,14 @@ class ConnectionImpl : public Connection {
   StatusOr<CommitResult> Commit(CommitParams) override;
   Status Rollback(RollbackParams) override;
 
+  future<StatusOr<RowStream>> AsyncRead(ReadParams) override;
+  future<StatusOr<RowStream>> AsyncExecuteQuery(SqlParams) override;
+  future<StatusOr<DmlResult>> AsyncExecuteDml(SqlParams) override;
+  future<StatusOr<BatchDmlResult>> AsyncExecuteBatchDml(
+      ExecuteBatchDmlParams) override;
+  future<StatusOr<CommitResult>> AsyncCommit(CommitParams) override;
+  future<Status> AsyncBackoff(std::chrono::milliseconds delay) override;
+
  private:
   // Only the factory method can construct instances of this class.
   friend std::shared_ptr<ConnectionImpl> MakeConnection(
@@ -159,6 +171,12 @@ class ConnectionImpl : public Connection {
   Status RollbackImpl(SessionHolder& session,
                       StatusOr<google::spanner::v1::TransactionSelector>& s);
 
+  /**
+   * Captures what the continuations of an asynchronous operation need, as they
+   * may outlive this `ConnectionImpl`.
+   */
+  std::shared_ptr<AsyncOperationContext const> MakeAsyncOperationContext();
+
   template <typename ResultType>
   StatusOr<ResultType> ExecuteSqlImpl(
       SessionHolder& session,
@@ -0,0 +1,447 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/internal/connection_impl.h"
+#include "google/cloud/spanner/internal/spanner_stub.h"
+#include "google/cloud/spanner/mutations.h"
+#include "google/cloud/internal/port_platform.h"
+#include "absl/base/attributes.h"
+#include "absl/memory/memory.h"
+#include <benchmark/benchmark.h>
+#include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// These benchmarks measure the client-side cost of queries and commits. The
+// `ConnectionImpl` uses a fake `SpannerStub` that answers every request from
+// memory, so there is no network or server time in the results.
+//
+// The replacement `operator new` counts the allocations of each operation.
+// The replacements are not inlined, so the compiler still sees calls to the
+// matching `operator new` and `operator delete`.
+
+namespace {
+std::atomic<std::int64_t> allocation_count{0};
+}  // namespace
+
+ABSL_ATTRIBUTE_NOINLINE void* operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (auto* p = std::malloc(size == 0 ? 1 : size)) return p;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  throw std::bad_alloc();
+#else
+  std::abort();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+ABSL_ATTRIBUTE_NOINLINE void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+namespace {
+
+namespace spanner_proto = ::google::spanner::v1;
+
+/// The shape of the results returned by `FakeSpannerStub`.
+struct ResultShape {
+  int rows;
+  int rows_per_response;
+  std::size_t string_size;
+  // Splits the last value of each response into the next response.
+  bool chunked;
+};
+
+// Returns the `PartialResultSet`s of a query of `(INT64, STRING)` rows.
+std::vector<spanner_proto::PartialResultSet> MakeResponses(
+    ResultShape const& shape) {
+  std::vector<std::vector<std::string>> values;
+  for (int row = 0; row != shape.rows; ++row) {
+    if (row % shape.rows_per_response == 0) values.emplace_back();
+    values.back().push_back(std::to_string(row));
+    values.back().push_back(std::string(shape.string_size, 'x'));
+  }
+  if (values.empty()) values.emplace_back();
+
+  std::vector<spanner_proto::PartialResultSet> responses(values.size());
+  auto& fields = *responses.front()
+                      .mutable_metadata()
+                      ->mutable_row_type()
+                      ->mutable_fields();
+  fields.Add()->set_name("Id");
+  fields.Mutable(0)->mutable_type()->set_code(spanner_proto::INT64);
+  fields.Add()->set_name("Name");
+  fields.Mutable(1)->mutable_type()->set_code(spanner_proto::STRING);
+
+  for (std::size_t i = 0; i != values.size(); ++i) {
+    auto& current = values[i];
+    if (shape.chunked && i + 1 != values.size()) {
+      auto& last = current.back();
+      auto const half = last.size() / 2;
+      auto& next = values[i + 1];
+      next.insert(next.begin(), last.substr(half));
+      last.resize(half);
+      responses[i].set_chunked_value(true);
+    }
+    for (auto& v : current) {
+      responses[i].add_values()->set_string_value(std::move(v));
+    }
+    responses[i].set_resume_token("token-" + std::to_string(i));
+  }
+  return responses;
+}
+
+/// Yields a copy of each of @p responses, as if they had just been parsed.
+class FakeReader
+    : public grpc::ClientReaderInterface<spanner_proto::PartialResultSet> {
+ public:
+  explicit FakeReader(
+      std::shared_ptr<std::vector<spanner_proto::PartialResultSet> const>
+          responses)
+      : responses_(std::move(responses)) {}
+
+  bool Read(spanner_proto::PartialResultSet* response) override {
+    if (next_ == responses_->size()) return false;
+    *response = (*responses_)[next_++];
+    return true;
+  }
+  bool NextMessageSize(std::uint32_t* sz) override {
+    if (next_ == responses_->size()) return false;
+    *sz = static_cast<std::uint32_t>((*responses_)[next_].ByteSizeLong());
+    return true;
+  }
+  grpc::Status Finish() override { return grpc::Status(); }
+  void WaitForInitialMetadata() override {}
+
+ private:
+  std::shared_ptr<std::vector<spanner_proto::PartialResultSet> const>
+      responses_;
+  std::size_t next_ = 0;
+};
+
+/// Answers the synchronous RPCs used by queries, reads, and commits.
+class FakeSpannerStub : public SpannerStub {
+ public:
+  FakeSpannerStub(ResultShape const& shape, int channel)
+      : session_prefix_("/sessions/channel-" + std::to_string(channel) + "-"),
+        responses_(
+            std::make_shared<std::vector<spanner_proto::PartialResultSet>>(
+                MakeResponses(shape))) {}
+
+  StatusOr<spanner_proto::Session> CreateSession(
+      grpc::ClientContext&,
+      spanner_proto::CreateSessionRequest const&) override {
+    return Unimplemented();
+  }
+  StatusOr<spanner_proto::BatchCreateSessionsResponse> BatchCreateSessions(
+      grpc::ClientContext&,
+      spanner_proto::BatchCreateSessionsRequest const& request) override {
+    spanner_proto::BatchCreateSessionsResponse response;
+    for (int i = 0; i != request.session_count(); ++i) {
+      response.add_session()->set_name(
+          request.database() + session_prefix_ +
+          std::to_string(session_id_.fetch_add(1)));
+    }
+    return response;
+  }
+  std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+      spanner_proto::BatchCreateSessionsResponse>>
+  AsyncBatchCreateSessions(grpc::ClientContext&,
+                           spanner_proto::BatchCreateSessionsRequest const&,
+                           grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  StatusOr<spanner_proto::Session> GetSession(
+      grpc::ClientContext&, spanner_proto::GetSessionRequest const&) override {
+    return Unimplemented();
+  }
+  StatusOr<spanner_proto::ListSessionsResponse> ListSessions(
+      grpc::ClientContext&,
+      spanner_proto::ListSessionsRequest const&) override {
+    return Unimplemented();
+  }
+  Status DeleteSession(grpc::ClientContext&,
+                       spanner_proto::DeleteSessionRequest const&) override {
+    return Status();
+  }
+  std::unique_ptr<
+      grpc::ClientAsyncResponseReaderInterface<google::protobuf::Empty>>
+  AsyncDeleteSession(grpc::ClientContext&,
+                     spanner_proto::DeleteSessionRequest const&,
+                     grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  StatusOr<spanner_proto::ResultSet> ExecuteSql(
+      grpc::ClientContext&, spanner_proto::ExecuteSqlRequest const&) override {
+    return Unimplemented();
+  }
+  std::unique_ptr<
+      grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>
+  AsyncExecuteSql(grpc::ClientContext&, spanner_proto::ExecuteSqlRequest const&,
+                  grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  std::unique_ptr<grpc::ClientReaderInterface<spanner_proto::PartialResultSet>>
+  ExecuteStreamingSql(grpc::ClientContext&,
+                      spanner_proto::ExecuteSqlRequest const&) override {
+    return absl::make_unique<FakeReader>(responses_);
+  }
+  StatusOr<spanner_proto::ExecuteBatchDmlResponse> ExecuteBatchDml(
+      grpc::ClientContext&,
+      spanner_proto::ExecuteBatchDmlRequest const&) override {
+    return Unimplemented();
+  }
+  std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+      spanner_proto::ExecuteBatchDmlResponse>>
+  AsyncExecuteBatchDml(grpc::ClientContext&,
+                       spanner_proto::ExecuteBatchDmlRequest const&,
+                       grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  std::unique_ptr<grpc::ClientReaderInterface<spanner_proto::PartialResultSet>>
+  StreamingRead(grpc::ClientContext&,
+                spanner_proto::ReadRequest const&) override {
+    return absl::make_unique<FakeReader>(responses_);
+  }
+  std::unique_ptr<
+      grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>
+  AsyncRead(grpc::ClientContext&, spanner_proto::ReadRequest const&,
+            grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  StatusOr<spanner_proto::Transaction> BeginTransaction(
+      grpc::ClientContext&,
+      spanner_proto::BeginTransactionRequest const&) override {
+    spanner_proto::Transaction txn;
+    txn.set_id("txn-" + std::to_string(transaction_id_.fetch_add(1)));
+    return txn;
+  }
+  std::unique_ptr<
+      grpc::ClientAsyncResponseReaderInterface<spanner_proto::Transaction>>
+  AsyncBeginTransaction(grpc::ClientContext&,
+                        spanner_proto::BeginTransactionRequest const&,
+                        grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  StatusOr<spanner_proto::CommitResponse> Commit(
+      grpc::ClientContext&, spanner_proto::CommitRequest const&) override {
+    spanner_proto::CommitResponse response;
+    response.mutable_commit_timestamp()->set_seconds(1577836800);
+    return response;
+  }
+  std::unique_ptr<
+      grpc::ClientAsyncResponseReaderInterface<spanner_proto::CommitResponse>>
+  AsyncCommit(grpc::ClientContext&, spanner_proto::CommitRequest const&,
+              grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  Status Rollback(grpc::ClientContext&,
+                  spanner_proto::RollbackRequest const&) override {
+    return Status();
+  }
+  StatusOr<spanner_proto::PartitionResponse> PartitionQuery(
+      grpc::ClientContext&,
+      spanner_proto::PartitionQueryRequest const&) override {
+    return Unimplemented();
+  }
+  StatusOr<spanner_proto::PartitionResponse> PartitionRead(
+      grpc::ClientContext&,
+      spanner_proto::PartitionReadRequest const&) override {
+    return Unimplemented();
+  }
+
+ private:
+  static Status Unimplemented() {
+    return Status(StatusCode::kUnimplemented, "not used by the benchmarks");
+  }
+
+  std::string const session_prefix_;
+  std::shared_ptr<std::vector<spanner_proto::PartialResultSet> const>
+      responses_;
+  std::atomic<std::int64_t> session_id_{0};
+  std::atomic<std::int64_t> transaction_id_{0};
+};
+
+Client MakeFakeClient(ResultShape const& shape, int num_channels = 4) {
+  std::vector<std::shared_ptr<SpannerStub>> stubs;
+  for (int i = 0; i != num_channels; ++i) {
+    stubs.push_back(std::make_shared<FakeSpannerStub>(shape, i));
+  }
+  // Create the sessions up front, so the pool never grows in the background,
+  // and the fake stub does not need the asynchronous RPCs.
+  auto pool_options = SessionPoolOptions()
+                          .set_min_sessions(100 * num_channels)
+                          .set_write_sessions_fraction(0);
+  return Client(MakeConnection(
+      Database("test-project", "test-instance", "test-db"), std::move(stubs),
+      ConnectionOptions(grpc::InsecureChannelCredentials()),
+      std::move(pool_options)));
+}
+
+/// Reports the allocations per iteration since construction.
+class AllocationCounter {
+ public:
+  explicit AllocationCounter(benchmark::State& state)
+      : state_(state), start_(allocation_count.load()) {}
+  ~AllocationCounter() {
+    auto const count = allocation_count.load() - start_;
+    state_.counters["allocations"] = benchmark::Counter(
+        static_cast<double>(count), benchmark::Counter::kAvgIterations);
+  }
+
+ private:
+  benchmark::State& state_;
+  std::int64_t start_;
+};
+
+// Run on (1 X 2100 MHz CPU )
+// CPU Caches:
+//   L1 Data 48 KiB (x1)
+//   L1 Instruction 32 KiB (x1)
+//   L2 Unified 2048 KiB (x1)
+//   L3 Unified 307200 KiB (x1)
+// ----------------------------------------------------------------------------
+// Benchmark                        Time        CPU  Iterations UserCounters...
+// ----------------------------------------------------------------------------
+// BM_QueryRows/10/0           749811 ns  684771 ns    142 allocations=5.392k
+// BM_QueryRows/1000/0         681594 ns  674311 ns    103 allocations=5.2k
+// BM_QueryRows/10/1           714650 ns  713138 ns    102 allocations=6.086k
+// BM_QuerySingleRow             8344 ns    8211 ns   8303 allocations=75
+// BM_Commit                     7903 ns    7874 ns   8783 allocations=74
+// BM_QueryContention/threads:1  8329 ns    8302 ns   8607
+// BM_QueryContention/threads:8  6935 ns    8134 ns  14264
+
+using RowType = std::tuple<std::int64_t, std::string>;
+
+int ReadAll(RowStream& rows, benchmark::State& state) {
+  int count = 0;
+  for (auto const& row : StreamOf<RowType>(rows)) {
+    if (!row) {
+      state.SkipWithError(row.status().message().c_str());
+      break;
+    }
+    benchmark::DoNotOptimize(std::get<1>(*row).data());
+    ++count;
+  }
+  return count;
+}
+
+// The client CPU per row of a large query. The arguments are the number of
+// rows in each `PartialResultSet`, and whether values span responses.
+void BM_QueryRows(benchmark::State& state) {
+  ResultShape const shape{1000, static_cast<int>(state.range(0)), 64,
+                          state.range(1) != 0};
+  auto client = MakeFakeClient(shape);
+  std::int64_t rows = 0;
+  {
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+      auto stream = client.ExecuteQuery(SqlStatement("SELECT Id, Name FROM T"));
+      rows += ReadAll(stream, state);
+    }
+  }
+  state.SetItemsProcessed(rows);
+}
+BENCHMARK(BM_QueryRows)
+    ->Args({10, 0})
+    ->Args({100, 0})
+    ->Args({1000, 0})
+    ->Args({10, 1})
+    ->Args({100, 1})
+    ->Args({1000, 1});
+
+// The same as `BM_QueryRows`, with the rows read ahead on a background thread.
+void BM_QueryRowsPrefetch(benchmark::State& state) {
+  ResultShape const shape{1000, static_cast<int>(state.range(0)), 64, false};
+  auto client = MakeFakeClient(shape);
+  auto const opts = QueryOptions().set_prefetch_rows(256);
+  std::int64_t rows = 0;
+  for (auto _ : state) {
+    auto stream =
+        client.ExecuteQuery(SqlStatement("SELECT Id, Name FROM T"), opts);
+    rows += ReadAll(stream, state);
+  }
+  state.SetItemsProcessed(rows);
+}
+BENCHMARK(BM_QueryRowsPrefetch)->Arg(10)->Arg(100)->UseRealTime();
+
+// The fixed client cost of a query returning a single row.
+void BM_QuerySingleRow(benchmark::State& state) {
+  auto client = MakeFakeClient(ResultShape{1, 1, 16, false});
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    auto stream = client.ExecuteQuery(SqlStatement("SELECT Id, Name FROM T"));
+    ReadAll(stream, state);
+  }
+}
+BENCHMARK(BM_QuerySingleRow);
+
+// The client cost of committing a read-write transaction with one mutation.
+void BM_Commit(benchmark::State& state) {
+  auto client = MakeFakeClient(ResultShape{1, 1, 16, false});
+  auto const mutation = InsertOrUpdateMutationBuilder("T", {"Id", "Name"})
+                            .EmplaceRow(std::int64_t{1}, "name")
+                            .Build();
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    auto result = client.Commit(Mutations{mutation});
+    if (!result) state.SkipWithError(result.status().message().c_str());
+  }
+}
+BENCHMARK(BM_Commit);
+
+// Session pool contention: many threads running single-row queries through
+// one shared client. The wall time per query should stay flat as threads are
+// added, until the machine runs out of cores.
+void BM_QueryContention(benchmark::State& state) {
+  static auto* const kClient =
+      new Client(MakeFakeClient(ResultShape{1, 1, 16, false}));
+  for (auto _ : state) {
+    auto stream = kClient->ExecuteQuery(SqlStatement("SELECT Id, Name FROM T"));
+    ReadAll(stream, state);
+  }
+}
+BENCHMARK(BM_QueryContention)->ThreadRange(1, 32)->UseRealTime();
+
+// Session pool contention for commits, which also begin a transaction.
+void BM_CommitContention(benchmark::State& state) {
+  static auto* const kClient =
+      new Client(MakeFakeClient(ResultShape{1, 1, 16, false}));
+  auto const mutation = InsertOrUpdateMutationBuilder("T", {"Id", "Name"})
+                            .EmplaceRow(std::int64_t{1}, "name")
+                            .Build();
+  for (auto _ : state) {
+    auto result = kClient->Commit(Mutations{mutation});
+    if (!result) state.SkipWithError(result.status().message().c_str());
+  }
+}
+BENCHMARK(BM_CommitContention)->ThreadRange(1, 32)->UseRealTime();
+
+}  // namespace
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
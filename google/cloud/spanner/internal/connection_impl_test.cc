@@ -19,6 +19,8 @@
 #include "google/cloud/spanner/testing/mock_spanner_stub.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include "google/cloud/testing_util/is_proto_equal.h"
+#include "google/cloud/testing_util/mock_async_response_reader.h"
+#include "google/cloud/testing_util/mock_completion_queue.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include "absl/memory/memory.h"
 #include "absl/types/optional.h"
@@ -57,12 +59,15 @@ namespace {
 
 using ::google::cloud::spanner_testing::HasSessionAndTransactionId;
 using ::google::cloud::testing_util::IsProtoEqual;
+using ::google::cloud::testing_util::MockAsyncResponseReader;
+using ::google::cloud::testing_util::MockCompletionQueue;
 using ::google::cloud::testing_util::StatusIs;
 using ::google::protobuf::TextFormat;
 using ::testing::_;
 using ::testing::AtLeast;
 using ::testing::ByMove;
 using ::testing::DoAll;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::HasSubstr;
 using ::testing::InSequence;
@@ -71,6 +76,7 @@ using ::testing::Return;
 using ::testing::Sequence;
 using ::testing::SetArgPointee;
 using ::testing::StartsWith;
+using ::testing::StrictMock;
 using ::testing::UnorderedPointwise;
 
 namespace spanner_proto = ::google::spanner::v1;
@@ -308,6 +314,77 @@ TEST(ConnectionImplTest, ReadSuccess) {
   EXPECT_EQ(row_number, expected.size());
 }
 
+/// @test Verify that a read on a background thread resumes after the call.
+TEST(ConnectionImplTest, ReadPipelinedResume) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+
+  auto db = Database("dummy_project", "dummy_instance", "dummy_database_id");
+  auto conn = MakeConnection(
+      db, {mock}, ConnectionOptions{grpc::InsecureChannelCredentials()});
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce(Return(MakeSessionsResponse({"test-session-name"})));
+
+  auto constexpr kText1 = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "UserId",
+          type: { code: INT64 }
+        }
+      }
+    }
+    values: { string_value: "12" }
+    resume_token: "after-12"
+  )pb";
+  spanner_proto::PartialResultSet response1;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText1, &response1));
+  auto reader1 = absl::make_unique<MockGrpcReader>();
+  EXPECT_CALL(*reader1, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(response1), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*reader1, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again")));
+
+  auto constexpr kText2 = R"pb(
+    values: { string_value: "42" }
+  )pb";
+  spanner_proto::PartialResultSet response2;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText2, &response2));
+  auto reader2 = absl::make_unique<MockGrpcReader>();
+  EXPECT_CALL(*reader2, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(response2), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*reader2, Finish()).WillOnce(Return(grpc::Status()));
+
+  EXPECT_CALL(*mock, StreamingRead(_, _))
+      .WillOnce([&reader1](grpc::ClientContext&,
+                           spanner_proto::ReadRequest const& request) {
+        EXPECT_EQ("table", request.table());
+        EXPECT_TRUE(request.resume_token().empty());
+        return std::move(reader1);
+      })
+      .WillOnce([&reader2](grpc::ClientContext&,
+                           spanner_proto::ReadRequest const& request) {
+        // The resumed request is a copy of the original one.
+        EXPECT_EQ("table", request.table());
+        EXPECT_EQ("after-12", request.resume_token());
+        return std::move(reader2);
+      });
+
+  ReadOptions read_options;
+  read_options.prefetch_rows = 1;
+  auto rows =
+      conn->Read({MakeSingleUseTransaction(Transaction::ReadOnlyOptions()),
+                  "table", KeySet::All(), {"UserId"}, read_options});
+  std::vector<std::int64_t> actual;
+  for (auto& row : StreamOf<std::tuple<std::int64_t>>(rows)) {
+    ASSERT_STATUS_OK(row);
+    actual.push_back(std::get<0>(*row));
+  }
+  EXPECT_THAT(actual, ElementsAre(12, 42));
+}
+
 TEST(ConnectionImplTest, ReadPermanentFailure) {
   auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
 
@@ -1807,6 +1884,137 @@ TEST(ConnectionImplTest, CommitSuccessWithTransactionId) {
   EXPECT_STATUS_OK(commit);
 }
 
+TEST(ConnectionImplTest, AsyncExecuteDmlBeginsTransaction) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("dummy_project", "dummy_instance", "dummy_database_id");
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"test-session-name"}))));
+
+  auto reader = absl::make_unique<
+      StrictMock<MockAsyncResponseReader<spanner_proto::ResultSet>>>();
+  EXPECT_CALL(*mock, AsyncExecuteSql(_, _, _))
+      .WillOnce([&reader](grpc::ClientContext&,
+                          spanner_proto::ExecuteSqlRequest const& request,
+                          grpc::CompletionQueue*) {
+        EXPECT_EQ("test-session-name", request.session());
+        EXPECT_TRUE(request.transaction().begin().has_read_write());
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<
+            grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>(
+            reader.get());
+      });
+  EXPECT_CALL(*reader, Finish(_, _, _))
+      .WillOnce(
+          [](spanner_proto::ResultSet* result, grpc::Status* status, void*) {
+            auto constexpr kResultSetText = R"pb(
+              metadata: { transaction: { id: "test-txn-id" } }
+              stats: { row_count_exact: 42 }
+            )pb";
+            ASSERT_TRUE(TextFormat::ParseFromString(kResultSetText, result));
+            *status = grpc::Status::OK;
+          });
+  EXPECT_CALL(*mock, Commit(_, _))
+      .WillOnce([](grpc::ClientContext&,
+                   spanner_proto::CommitRequest const& request) {
+        EXPECT_EQ("test-txn-id", request.transaction_id());
+        spanner_proto::CommitResponse response;
+        *response.mutable_commit_timestamp() = internal::TimestampToProto(
+            MakeTimestamp(std::chrono::system_clock::from_time_t(123)).value());
+        return response;
+      });
+
+  auto impl = std::make_shared<MockCompletionQueue>();
+  auto conn = MakeConnection(
+      db, {mock},
+      ConnectionOptions{grpc::InsecureChannelCredentials()}
+          .DisableBackgroundThreads(CompletionQueue(impl)),
+      SessionPoolOptions{}.set_min_sessions(1));
+  auto txn = MakeReadWriteTransaction();
+  auto pending =
+      conn->AsyncExecuteDml({txn, SqlStatement("UPDATE ..."), {}, {}});
+  EXPECT_EQ(std::future_status::timeout,
+            pending.wait_for(std::chrono::milliseconds(0)));
+
+  impl->SimulateCompletion(true);
+  auto result = pending.get();
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(42, result->RowsModified());
+
+  // The commit uses the transaction begun by the asynchronous statement.
+  auto commit = conn->Commit({txn});
+  EXPECT_STATUS_OK(commit);
+}
+
+TEST(ConnectionImplTest, AsyncCommitRetriesTransientFailures) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("dummy_project", "dummy_instance", "dummy_database_id");
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"test-session-name"}))));
+
+  using Reader = StrictMock<
+      MockAsyncResponseReader<spanner_proto::CommitResponse>>;
+  auto unavailable = absl::make_unique<Reader>();
+  auto aborted = absl::make_unique<Reader>();
+  EXPECT_CALL(*mock, AsyncCommit(_, _, _))
+      .WillOnce([&unavailable](grpc::ClientContext&,
+                               spanner_proto::CommitRequest const& request,
+                               grpc::CompletionQueue*) {
+        EXPECT_EQ("test-txn-id", request.transaction_id());
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            spanner_proto::CommitResponse>>(unavailable.get());
+      })
+      .WillOnce([&aborted](grpc::ClientContext&,
+                           spanner_proto::CommitRequest const& request,
+                           grpc::CompletionQueue*) {
+        EXPECT_EQ("test-txn-id", request.transaction_id());
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            spanner_proto::CommitResponse>>(aborted.get());
+      });
+  EXPECT_CALL(*unavailable, Finish(_, _, _))
+      .WillOnce([](spanner_proto::CommitResponse*, grpc::Status* status,
+                   void*) {
+        *status = grpc::Status(grpc::StatusCode::UNAVAILABLE, "try again");
+      });
+  // An aborted transaction must be rerun, not the commit retried.
+  EXPECT_CALL(*aborted, Finish(_, _, _))
+      .WillOnce([](spanner_proto::CommitResponse*, grpc::Status* status,
+                   void*) {
+        *status = grpc::Status(grpc::StatusCode::ABORTED, "aborted");
+      });
+
+  auto impl = std::make_shared<MockCompletionQueue>();
+  auto conn = MakeConnection(
+      db, {mock},
+      ConnectionOptions{grpc::InsecureChannelCredentials()}
+          .DisableBackgroundThreads(CompletionQueue(impl)),
+      SessionPoolOptions{}.set_min_sessions(1));
+  auto txn = MakeReadWriteTransaction();
+  SetTransactionId(txn, "test-txn-id");
+  auto pending = conn->AsyncCommit({txn, {}});
+  // Complete the first call, the backoff timer, and the second call.
+  for (int i = 0; i != 3; ++i) {
+    EXPECT_EQ(std::future_status::timeout,
+              pending.wait_for(std::chrono::milliseconds(0)));
+    impl->SimulateCompletion(true);
+  }
+  auto commit = pending.get();
+  EXPECT_EQ(StatusCode::kAborted, commit.status().code());
+}
+
+TEST(ConnectionImplTest, AsyncBackoff) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("dummy_project", "dummy_instance", "dummy_database_id");
+  auto conn = MakeConnection(
+      db, {mock}, ConnectionOptions{grpc::InsecureChannelCredentials()});
+
+  auto const start = std::chrono::steady_clock::now();
+  auto status = conn->AsyncBackoff(std::chrono::milliseconds(10)).get();
+  EXPECT_STATUS_OK(status);
+  EXPECT_LE(std::chrono::milliseconds(10),
+            std::chrono::steady_clock::now() - start);
+}
+
 TEST(ConnectionImplTest, RollbackGetSessionFailure) {
   auto db = Database("project", "instance", "database");
 
@@ -1831,31 +2039,22 @@ TEST(ConnectionImplTest, RollbackGetSessionFailure) {
 
 TEST(ConnectionImplTest, RollbackBeginTransaction) {
   auto db = Database("project", "instance", "database");
-  std::string const session_name = "test-session-name";
 
+  // The transaction was never begun, so nothing is sent to the server.
   auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
-  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
-      .WillOnce(
-          [&db](grpc::ClientContext&,
-                spanner_proto::BatchCreateSessionsRequest const& request) {
-            EXPECT_EQ(db.FullName(), request.database());
-            return MakeSessionsResponse({"test-session-name"});
-          });
-  EXPECT_CALL(*mock, BeginTransaction(_, _))
-      .WillOnce(Return(MakeTestTransaction("RollbackBeginTransaction")));
-  EXPECT_CALL(*mock, Rollback(_, _))
-      .WillOnce([](grpc::ClientContext&,
-                   spanner_proto::RollbackRequest const& request) {
-        EXPECT_EQ("test-session-name", request.session());
-        EXPECT_EQ("RollbackBeginTransaction", request.transaction_id());
-        return Status();
-      });
-
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _)).Times(0);
+  EXPECT_CALL(*mock, BeginTransaction(_, _)).Times(0);
+  EXPECT_CALL(*mock, Rollback(_, _)).Times(0);
   auto conn = MakeConnection(
       db, {mock}, ConnectionOptions{grpc::InsecureChannelCredentials()});
   auto txn = MakeReadWriteTransaction();
   auto rollback = conn->Rollback({txn});
   EXPECT_STATUS_OK(rollback);
+
+  // The transaction cannot be used after it is rolled back.
+  auto commit = conn->Commit({txn});
+  EXPECT_THAT(commit.status(), StatusIs(StatusCode::kFailedPrecondition,
+                                       HasSubstr("rolled back")));
 }
 
 TEST(ConnectionImplTest, RollbackSingleUseTransaction) {
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "google/cloud/spanner/internal/merge_chunk.h"
+#include "absl/memory/memory.h"
+#include <iterator>
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -74,6 +77,109 @@ Status MergeChunk(google::protobuf::Value& value,
   return Status(StatusCode::kUnknown, "unknown Value type");
 }
 
+ChunkedValue::ChunkedValue(google::protobuf::Value value)
+    : kind_(value.kind_case()) {
+  switch (kind_) {
+    case google::protobuf::Value::kStringValue:
+      pieces_.push_back(std::move(*value.mutable_string_value()));
+      break;
+    case google::protobuf::Value::kListValue:
+      AppendElements(*value.mutable_list_value()->mutable_values(), 0);
+      break;
+    default:
+      value_ = std::move(value);
+      break;
+  }
+}
+
+Status ChunkedValue::Merge(google::protobuf::Value&& chunk) {
+  if (kind_ != chunk.kind_case()) {
+    return Status(StatusCode::kInvalidArgument, "mismatched types");
+  }
+  switch (kind_) {
+    case google::protobuf::Value::kBoolValue:
+    case google::protobuf::Value::kNumberValue:
+    case google::protobuf::Value::kNullValue:
+    case google::protobuf::Value::kStructValue:
+      return Status(StatusCode::kInvalidArgument, "invalid type");
+
+    case google::protobuf::Value::kStringValue: {
+      pieces_.push_back(std::move(*chunk.mutable_string_value()));
+      return Status();
+    }
+
+    case google::protobuf::Value::kListValue: {
+      auto& chunk_list = *chunk.mutable_list_value()->mutable_values();
+      if (!last_) {
+        AppendElements(chunk_list, 0);
+        return Status();
+      }
+
+      // Recursively merge the last element of the value with the first
+      // element of chunk_list if necessary.
+      int begin = 0;
+      if (!chunk_list.empty() &&
+          (last_->kind_ == google::protobuf::Value::kStringValue ||
+           last_->kind_ == google::protobuf::Value::kListValue)) {
+        auto const status = last_->Merge(std::move(*chunk_list.Mutable(0)));
+        if (!status.ok()) return status;
+        begin = 1;
+      }
+      AppendElements(chunk_list, begin);
+      return Status();
+    }
+
+    default:
+      break;
+  }
+  return Status(StatusCode::kUnknown, "unknown Value type");
+}
+
+google::protobuf::Value ChunkedValue::Release() && {
+  switch (kind_) {
+    case google::protobuf::Value::kStringValue: {
+      std::size_t size = 0;
+      for (auto const& piece : pieces_) size += piece.size();
+      auto s = std::move(pieces_.front());
+      s.reserve(size);
+      for (auto i = std::next(pieces_.begin()); i != pieces_.end(); ++i) {
+        s += *i;
+      }
+      google::protobuf::Value value;
+      value.set_string_value(std::move(s));
+      return value;
+    }
+
+    case google::protobuf::Value::kListValue: {
+      google::protobuf::Value value;
+      auto& values = *value.mutable_list_value()->mutable_values();
+      values.Swap(&elements_);
+      if (last_) *values.Add() = std::move(*last_).Release();
+      return value;
+    }
+
+    default:
+      break;
+  }
+  return std::move(value_);
+}
+
+// Moves `values[begin..]` to the end of the list, transferring ownership of
+// the elements instead of copying them. The previous last element is complete
+// once anything follows it, so it is built then.
+void ChunkedValue::AppendElements(
+    google::protobuf::RepeatedPtrField<google::protobuf::Value>& values,
+    int begin) {
+  auto const count = values.size() - begin;
+  if (count <= 0) return;
+  if (last_) *elements_.Add() = std::move(*last_).Release();
+  std::vector<google::protobuf::Value*> released(count);
+  values.ExtractSubrange(begin, count, released.data());
+  for (int i = 0; i != count - 1; ++i) elements_.AddAllocated(released[i]);
+  std::unique_ptr<google::protobuf::Value> last(released.back());
+  last_ = absl::make_unique<ChunkedValue>(std::move(*last));
+}
+
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
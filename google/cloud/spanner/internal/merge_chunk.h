@@ -18,6 +18,9 @@
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/status.h"
 #include <google/protobuf/struct.pb.h>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -47,6 +50,47 @@ namespace internal {
 Status MergeChunk(google::protobuf::Value& value,
                   google::protobuf::Value&& chunk);
 
+/**
+ * Accumulates a value that is split into chunks over several responses.
+ *
+ * `Merge()` follows the same rules as `MergeChunk()`, but it only gathers the
+ * pieces: string chunks are kept in a list, and complete list elements are
+ * set aside. `Release()` then builds the merged value once. A value split into
+ * many chunks is assembled in time linear in its size, without reallocating
+ * and copying the partial value on each merge.
+ */
+class ChunkedValue {
+ public:
+  explicit ChunkedValue(google::protobuf::Value value);
+
+  ChunkedValue(ChunkedValue&&) = default;
+  ChunkedValue& operator=(ChunkedValue&&) = default;
+
+  /// Merges @p chunk into the value, or returns an error.
+  Status Merge(google::protobuf::Value&& chunk);
+
+  /// Returns the merged value.
+  google::protobuf::Value Release() &&;
+
+ private:
+  void AppendElements(
+      google::protobuf::RepeatedPtrField<google::protobuf::Value>& values,
+      int begin);
+
+  google::protobuf::Value::KindCase kind_;
+
+  // A `kStringValue` is the concatenation of these pieces.
+  std::vector<std::string> pieces_;
+
+  // A `kListValue` holds these complete elements, followed by `last_`, which
+  // the next chunk may continue. `last_` is null for an empty list.
+  google::protobuf::RepeatedPtrField<google::protobuf::Value> elements_;
+  std::unique_ptr<ChunkedValue> last_;
+
+  // Values of any other kind, which cannot be merged.
+  google::protobuf::Value value_;
+};
+
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
@@ -15,6 +15,9 @@
 #include "google/cloud/spanner/internal/merge_chunk.h"
 #include "google/cloud/spanner/value.h"
 #include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -116,6 +119,86 @@ void BM_MergeChunkListsOfListOfString(benchmark::State& state) {
 }
 BENCHMARK(BM_MergeChunkListsOfListOfString);
 
+// Splits a 4MiB STRING value into `count` chunks, as Spanner does with large
+// values that span several PartialResultSets.
+std::vector<google::protobuf::Value> MakeStringChunks(std::int64_t count) {
+  auto const size = std::size_t{4} * 1024 * 1024 / count;
+  std::vector<google::protobuf::Value> chunks;
+  for (std::int64_t i = 0; i != count; ++i) {
+    chunks.push_back(MakeProtoValue(std::string(size, 'a' + i % 26)));
+  }
+  return chunks;
+}
+
+// Splits an ARRAY<STRING> with 4096 1KiB elements into `count` chunks, with
+// each chunk boundary in the middle of an element.
+std::vector<google::protobuf::Value> MakeListChunks(std::int64_t count) {
+  auto const per_chunk = 4096 / count;
+  std::vector<google::protobuf::Value> chunks;
+  for (std::int64_t i = 0; i != count; ++i) {
+    std::vector<std::string> elements;
+    elements.emplace_back(512, 'x');
+    for (std::int64_t j = 1; j < per_chunk; ++j) {
+      elements.emplace_back(1024, 'y');
+    }
+    elements.emplace_back(512, 'z');
+    chunks.push_back(MakeProtoValue(std::move(elements)));
+  }
+  return chunks;
+}
+
+void BM_MergeChunkLargeString(benchmark::State& state) {
+  auto const chunks = MakeStringChunks(state.range(0));
+  for (auto _ : state) {
+    auto pieces = chunks;
+    auto value = std::move(pieces.front());
+    for (std::size_t i = 1; i != pieces.size(); ++i) {
+      benchmark::DoNotOptimize(MergeChunk(value, std::move(pieces[i])));
+    }
+    benchmark::DoNotOptimize(value);
+  }
+}
+BENCHMARK(BM_MergeChunkLargeString)->Arg(4)->Arg(64)->Arg(512);
+
+void BM_ChunkedValueLargeString(benchmark::State& state) {
+  auto const chunks = MakeStringChunks(state.range(0));
+  for (auto _ : state) {
+    auto pieces = chunks;
+    ChunkedValue value(std::move(pieces.front()));
+    for (std::size_t i = 1; i != pieces.size(); ++i) {
+      benchmark::DoNotOptimize(value.Merge(std::move(pieces[i])));
+    }
+    benchmark::DoNotOptimize(std::move(value).Release());
+  }
+}
+BENCHMARK(BM_ChunkedValueLargeString)->Arg(4)->Arg(64)->Arg(512);
+
+void BM_MergeChunkLargeListOfStrings(benchmark::State& state) {
+  auto const chunks = MakeListChunks(state.range(0));
+  for (auto _ : state) {
+    auto pieces = chunks;
+    auto value = std::move(pieces.front());
+    for (std::size_t i = 1; i != pieces.size(); ++i) {
+      benchmark::DoNotOptimize(MergeChunk(value, std::move(pieces[i])));
+    }
+    benchmark::DoNotOptimize(value);
+  }
+}
+BENCHMARK(BM_MergeChunkLargeListOfStrings)->Arg(4)->Arg(64)->Arg(512);
+
+void BM_ChunkedValueLargeListOfStrings(benchmark::State& state) {
+  auto const chunks = MakeListChunks(state.range(0));
+  for (auto _ : state) {
+    auto pieces = chunks;
+    ChunkedValue value(std::move(pieces.front()));
+    for (std::size_t i = 1; i != pieces.size(); ++i) {
+      benchmark::DoNotOptimize(value.Merge(std::move(pieces[i])));
+    }
+    benchmark::DoNotOptimize(std::move(value).Release());
+  }
+}
+BENCHMARK(BM_ChunkedValueLargeListOfStrings)->Arg(4)->Arg(64)->Arg(512);
+
 }  // namespace
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
@@ -116,6 +116,39 @@ TEST(MergeChunk, ExampleListsOfListOfString) {
   EXPECT_THAT(a, IsProtoEqual(expected));
 }
 
+// "a", "b", "c", "d" => "abcd"
+TEST(ChunkedValue, ManyStringChunks) {
+  ChunkedValue value(MakeProtoValue("a"));
+  for (auto const* s : {"b", "c", "", "d"}) {
+    ASSERT_STATUS_OK(value.Merge(MakeProtoValue(s)));
+  }
+  EXPECT_THAT(std::move(value).Release(),
+              IsProtoEqual(MakeProtoValue("abcd")));
+}
+
+// ["a", ["b"]], [["c"]], [["d", "e"], "f"], ["g"] => ["a", ["bcd", "e"], "fg"]
+TEST(ChunkedValue, ManyListChunks) {
+  ChunkedValue value(MakeProtoValue(
+      std::vector<Value>{Value("a"), Value(std::vector<std::string>{"b"})}));
+  ASSERT_STATUS_OK(value.Merge(MakeProtoValue(
+      std::vector<Value>{Value(std::vector<std::string>{"c"})})));
+  ASSERT_STATUS_OK(value.Merge(MakeProtoValue(std::vector<Value>{
+      Value(std::vector<std::string>{"d", "e"}), Value("f")})));
+  ASSERT_STATUS_OK(value.Merge(MakeProtoValue(std::vector<std::string>{"g"})));
+
+  auto expected = MakeProtoValue(std::vector<Value>{
+      Value("a"), Value(std::vector<std::string>{"bcd", "e"}), Value("fg")});
+  EXPECT_THAT(std::move(value).Release(), IsProtoEqual(expected));
+}
+
+TEST(ChunkedValue, ErrorInNestedList) {
+  ChunkedValue value(MakeProtoValue(std::vector<Value>{
+      Value(std::vector<std::string>{"a"})}));
+  auto status = value.Merge(MakeProtoValue(std::vector<std::string>{"b"}));
+  EXPECT_FALSE(status.ok());
+  EXPECT_THAT(status.message(), testing::HasSubstr("mismatched types"));
+}
+
 //
 // Tests some edge cases that we think should probably work.
 //
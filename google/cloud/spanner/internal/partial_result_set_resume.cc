@@ -21,7 +21,11 @@ namespace spanner {
 inline namespace SPANNER_CLIENT_NS {
 namespace internal {
 
-void PartialResultSetResume::TryCancel() { child_->TryCancel(); }
+void PartialResultSetResume::TryCancel() {
+  std::lock_guard<std::mutex> lk(mu_);
+  cancelled_ = true;
+  child_->TryCancel();
+}
 
 absl::optional<google::spanner::v1::PartialResultSet>
 PartialResultSetResume::Read() {
@@ -39,6 +43,8 @@ PartialResultSetResume::Read() {
       return {};
     }
     std::this_thread::sleep_for(backoff_policy_prototype_->OnCompletion());
+    std::lock_guard<std::mutex> lk(mu_);
+    if (cancelled_) return {};
     last_status_.reset();
     child_ = factory_(last_resume_token_);
   } while (!retry_policy_prototype_->IsExhausted());
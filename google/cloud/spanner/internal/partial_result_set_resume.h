@@ -22,6 +22,7 @@
 #include "absl/types/optional.h"
 #include <functional>
 #include <memory>
+#include <mutex>
 
 namespace google {
 namespace cloud {
@@ -67,6 +68,10 @@ class PartialResultSetResume : public PartialResultSetReader {
   std::string last_resume_token_;
   std::unique_ptr<PartialResultSetReader> child_;
   absl::optional<Status> last_status_;
+  // `TryCancel()` may be called from another thread than the one reading, so
+  // replacing `child_` and cancelling it are serialized.
+  std::mutex mu_;
+  bool cancelled_ = false;  // GUARDED_BY(mu_)
 };
 
 }  // namespace internal
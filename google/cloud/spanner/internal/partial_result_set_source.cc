@@ -42,11 +42,44 @@ StatusOr<std::unique_ptr<ResultSourceInterface>> PartialResultSetSource::Create(
 }
 
 StatusOr<Row> PartialResultSetSource::NextRow() {
-  if (finished_) {
-    return Row();
+  auto buffered = BufferRow();
+  if (!buffered) return std::move(buffered).status();
+  if (!*buffered) return Row();
+
+  std::vector<Value> values;
+  values.reserve(column_types_.size());
+  auto iter = buffer_.begin();
+  for (auto const& type : column_types_) {
+    values.push_back(FromProto(type, std::move(*iter)));
+    ++iter;
   }
+  buffer_.erase(buffer_.begin(), iter);
+  return internal::MakeRow(std::move(values), columns_);
+}
+
+StatusOr<bool> PartialResultSetSource::NextRowValues(
+    std::vector<google::protobuf::Value>& values) {
+  auto buffered = BufferRow();
+  if (!buffered || !*buffered) return buffered;
 
-  while (buffer_.empty() || buffer_.size() < columns_->size()) {
+  // Swap the values out of the buffer, rather than copying them, so any
+  // strings are not copied either.
+  auto const n = column_types_.size();
+  values.resize(n);
+  auto iter = buffer_.begin();
+  for (std::size_t i = 0; i != n; ++i, ++iter) values[i].Swap(&*iter);
+  buffer_.erase(buffer_.begin(), iter);
+  return true;
+}
+
+/**
+ * Reads from the stream until `buffer_` holds all the values of the next row.
+ * Returns false if the stream ended cleanly before any more values arrived.
+ */
+StatusOr<bool> PartialResultSetSource::BufferRow() {
+  if (finished_) return false;
+
+  while (buffer_.empty() || buffer_.size() < column_types_.size()) {
     auto status = ReadFromStream();
     if (!status.ok()) {
       return status;
@@ -59,25 +92,15 @@ StatusOr<Row> PartialResultSetSource::NextRow() {
       if (!buffer_.empty()) {
         return Status(StatusCode::kInternal, "incomplete row at end of stream");
       }
-      return Row();
+      return false;
     }
   }
 
-  auto const& fields = metadata_->row_type().fields();
-  if (fields.empty()) {
+  if (metadata_->row_type().fields().empty()) {
     return Status(StatusCode::kInternal,
                   "response metadata is missing row type information");
   }
-
-  std::vector<Value> values;
-  values.reserve(fields.size());
-  auto iter = buffer_.begin();
-  for (auto const& field : fields) {
-    values.push_back(FromProto(field.type(), std::move(*iter)));
-    ++iter;
-  }
-  buffer_.erase(buffer_.begin(), iter);
-  return internal::MakeRow(std::move(values), columns_);
+  return true;
 }
 
 PartialResultSetSource::~PartialResultSetSource() {
@@ -110,12 +133,15 @@ Status PartialResultSetSource::ReadFromStream() {
       GCP_LOG(WARNING) << "Unexpectedly received two sets of metadata";
     } else {
       metadata_ = std::move(*result_set->mutable_metadata());
-      // Copies the column names into a shared_ptr that will be shared with
-      // every Row object returned from NextRow().
-      columns_ = std::make_shared<std::vector<std::string>>();
+      // Copies the column names and types into objects that will be shared
+      // with every Row and Value returned from NextRow().
+      std::vector<std::string> names;
       for (auto const& field : metadata_->row_type().fields()) {
-        columns_->push_back(field.name());
+        names.push_back(field.name());
+        column_types_.push_back(
+            std::make_shared<google::spanner::v1::Type const>(field.type()));
       }
+      columns_ = std::make_shared<ColumnIndex const>(std::move(names));
     }
   }
 
@@ -144,8 +170,9 @@ Status PartialResultSetSource::ReadFromStream() {
   //
   // The final values yielded are: `A`, `B`, `C1C2`, `D`, `E1E2E3`, `F`.
   //
-  // n.b. One value can span more than two responses (the `E1E2E3` case above);
-  // the code "just works" without needing to treat that as a special-case.
+  // n.b. One value can span more than two responses (the `E1E2E3` case above).
+  // The chunks are gathered in `chunk_`, and the value is only built once its
+  // last chunk arrives, so large values are not copied on every response.
   if (chunk_) {
     if (new_values.empty()) {
       return Status(StatusCode::kInternal,
@@ -153,12 +180,15 @@ Status PartialResultSetSource::ReadFromStream() {
                     "to merge with prior chunked_value");
     }
     auto& front = new_values[0];
-    auto merge_status = MergeChunk(*chunk_, std::move(front));
+    auto merge_status = chunk_->Merge(std::move(front));
     if (!merge_status.ok()) {
       return merge_status;
     }
-    using std::swap;
-    swap(*chunk_, front);
+    if (new_values.size() == 1 && result_set->chunked_value()) {
+      // The value continues in the next response.
+      return {};  // OK
+    }
+    front = std::move(*chunk_).Release();
     chunk_ = {};
   }
 
@@ -168,7 +198,7 @@ Status PartialResultSetSource::ReadFromStream() {
                     "PartialResultSet had chunked_value "
                     "set true but contained no values");
     }
-    chunk_ = std::move(new_values[new_values.size() - 1]);
+    chunk_.emplace(std::move(new_values[new_values.size() - 1]));
     new_values.RemoveLast();
   }
 
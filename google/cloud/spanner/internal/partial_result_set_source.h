@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PARTIAL_RESULT_SET_SOURCE_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PARTIAL_RESULT_SET_SOURCE_H
 
+#include "google/cloud/spanner/internal/merge_chunk.h"
 #include "google/cloud/spanner/internal/partial_result_set_reader.h"
 #include "google/cloud/spanner/results.h"
 #include "google/cloud/spanner/value.h"
@@ -27,6 +28,7 @@
 #include <grpcpp/grpcpp.h>
 #include <deque>
 #include <memory>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -49,6 +51,11 @@ class PartialResultSetSource : public internal::ResultSourceInterface {
 
   StatusOr<Row> NextRow() override;
 
+  StatusOr<bool> NextRowValues(
+      std::vector<google::protobuf::Value>& values) override;
+  bool HasTypedRowValues() const override { return true; }
+  void TryCancel() override { reader_->TryCancel(); }
+
   absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
     return metadata_;
   }
@@ -63,13 +70,15 @@ class PartialResultSetSource : public internal::ResultSourceInterface {
       : reader_(std::move(reader)) {}
 
   Status ReadFromStream();
+  StatusOr<bool> BufferRow();
 
   std::unique_ptr<PartialResultSetReader> reader_;
   absl::optional<google::spanner::v1::ResultSetMetadata> metadata_;
   absl::optional<google::spanner::v1::ResultSetStats> stats_;
   std::deque<google::protobuf::Value> buffer_;
-  absl::optional<google::protobuf::Value> chunk_;
-  std::shared_ptr<std::vector<std::string>> columns_;
+  absl::optional<ChunkedValue> chunk_;
+  std::shared_ptr<ColumnIndex const> columns_;
+  std::vector<std::shared_ptr<google::spanner::v1::Type const>> column_types_;
   bool finished_ = false;
 };
 
@@ -24,6 +24,8 @@
 #include <array>
 #include <cstdint>
 #include <string>
+#include <tuple>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -256,6 +258,170 @@ TEST(PartialResultSetSourceTest, SingleResponse) {
   EXPECT_THAT(*actual_stats, IsProtoEqual(expected_stats));
 }
 
+/**
+ * @test Verify that `NextRowValues()` yields the value protos of each row.
+ */
+TEST(PartialResultSetSourceTest, NextRowValues) {
+  auto grpc_reader = absl::make_unique<MockPartialResultSetReader>();
+  auto constexpr kText = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "UserId",
+          type: { code: INT64 }
+        }
+        fields: {
+          name: "UserName",
+          type: { code: STRING }
+        }
+      }
+    }
+    values: { string_value: "10" }
+    values: { string_value: "user10" }
+    values: { string_value: "22" }
+    values: { null_value: NULL_VALUE }
+  )pb";
+  spanner_proto::PartialResultSet response;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText, &response));
+  EXPECT_CALL(*grpc_reader, Read())
+      .WillOnce(Return(response))
+      .WillOnce(Return(absl::optional<spanner_proto::PartialResultSet>{}));
+  EXPECT_CALL(*grpc_reader, Finish()).WillOnce(Return(Status()));
+
+  auto reader = PartialResultSetSource::Create(std::move(grpc_reader));
+  ASSERT_STATUS_OK(reader);
+
+  std::vector<google::protobuf::Value> values;
+  auto more = (*reader)->NextRowValues(values);
+  ASSERT_STATUS_OK(more);
+  EXPECT_TRUE(*more);
+  ASSERT_EQ(2, values.size());
+  EXPECT_EQ("10", values[0].string_value());
+  EXPECT_EQ("user10", values[1].string_value());
+
+  more = (*reader)->NextRowValues(values);
+  ASSERT_STATUS_OK(more);
+  EXPECT_TRUE(*more);
+  ASSERT_EQ(2, values.size());
+  EXPECT_EQ("22", values[0].string_value());
+  EXPECT_EQ(google::protobuf::Value::kNullValue, values[1].kind_case());
+
+  more = (*reader)->NextRowValues(values);
+  ASSERT_STATUS_OK(more);
+  EXPECT_FALSE(*more);
+}
+
+/**
+ * @test Verify that `StreamOf()` decodes the rows of a `PartialResultSetSource`
+ * directly into tuples, and reports type mismatches.
+ */
+TEST(PartialResultSetSourceTest, StreamOfTuples) {
+  auto constexpr kText = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "UserId",
+          type: { code: INT64 }
+        }
+        fields: {
+          name: "UserName",
+          type: { code: STRING }
+        }
+      }
+    }
+    values: { string_value: "10" }
+    values: { string_value: "user10" }
+    values: { string_value: "22" }
+    values: { null_value: NULL_VALUE }
+  )pb";
+  spanner_proto::PartialResultSet response;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText, &response));
+  auto make_rows = [&response] {
+    auto grpc_reader = absl::make_unique<MockPartialResultSetReader>();
+    EXPECT_CALL(*grpc_reader, Read())
+        .WillOnce(Return(response))
+        .WillRepeatedly(
+            Return(absl::optional<spanner_proto::PartialResultSet>{}));
+    EXPECT_CALL(*grpc_reader, Finish()).WillRepeatedly(Return(Status()));
+    auto source = PartialResultSetSource::Create(std::move(grpc_reader));
+    EXPECT_STATUS_OK(source);
+    return RowStream(*std::move(source));
+  };
+
+  using RowType = std::tuple<std::int64_t, absl::optional<std::string>>;
+  auto rows = make_rows();
+  std::vector<RowType> actual;
+  for (auto& row : StreamOf<RowType>(rows)) {
+    ASSERT_STATUS_OK(row);
+    actual.push_back(*std::move(row));
+  }
+  std::vector<RowType> const expected = {
+      RowType{10, std::string("user10")},
+      RowType{22, absl::optional<std::string>{}},
+  };
+  EXPECT_EQ(expected, actual);
+
+  // A `std::string` cannot hold the NULL in the second row.
+  rows = make_rows();
+  std::vector<StatusOr<std::tuple<std::int64_t, std::string>>> results;
+  for (auto& row : StreamOf<std::tuple<std::int64_t, std::string>>(rows)) {
+    results.push_back(std::move(row));
+  }
+  ASSERT_EQ(2, results.size());
+  EXPECT_STATUS_OK(results[0]);
+  EXPECT_EQ(StatusCode::kUnknown, results[1].status().code());
+  EXPECT_THAT(results[1].status().message(), HasSubstr("null value"));
+
+  rows = make_rows();
+  auto wrong_type = StreamOf<std::tuple<std::string, std::string>>(rows);
+  auto it = wrong_type.begin();
+  ASSERT_NE(it, wrong_type.end());
+  EXPECT_EQ(StatusCode::kUnknown, it->status().code());
+  EXPECT_THAT(it->status().message(), HasSubstr("wrong type"));
+  EXPECT_EQ(++it, wrong_type.end());
+
+  rows = make_rows();
+  auto wrong_size = StreamOf<std::tuple<std::int64_t>>(rows);
+  auto wrong_size_it = wrong_size.begin();
+  ASSERT_NE(wrong_size_it, wrong_size.end());
+  EXPECT_EQ(StatusCode::kInvalidArgument, wrong_size_it->status().code());
+}
+
+/**
+ * @test Verify that `StreamOf()` reports no tuple mismatch for an empty result,
+ * as decoding each `Row` would not.
+ */
+TEST(PartialResultSetSourceTest, StreamOfTuplesNoRows) {
+  auto constexpr kText = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "UserId",
+          type: { code: INT64 }
+        }
+        fields: {
+          name: "UserName",
+          type: { code: STRING }
+        }
+      }
+    }
+  )pb";
+  spanner_proto::PartialResultSet response;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText, &response));
+  auto grpc_reader = absl::make_unique<MockPartialResultSetReader>();
+  EXPECT_CALL(*grpc_reader, Read())
+      .WillOnce(Return(response))
+      .WillRepeatedly(
+          Return(absl::optional<spanner_proto::PartialResultSet>{}));
+  EXPECT_CALL(*grpc_reader, Finish()).WillOnce(Return(Status()));
+  auto source = PartialResultSetSource::Create(std::move(grpc_reader));
+  ASSERT_STATUS_OK(source);
+  RowStream rows(*std::move(source));
+
+  auto wrong_size = StreamOf<std::tuple<std::string>>(rows);
+  EXPECT_EQ(wrong_size.begin(), wrong_size.end());
+}
+
 /**
  * @test Verify the functionality of the PartialResultSetSource when the gRPC
  * reader returns data across multiple Read() calls.
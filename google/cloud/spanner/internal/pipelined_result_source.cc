@@ -0,0 +1,142 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/pipelined_result_source.h"
+#include "google/cloud/spanner/value.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+
+PipelinedResultSource::PipelinedResultSource(
+    std::unique_ptr<ResultSourceInterface> source, std::size_t capacity)
+    : source_(std::move(source)),
+      capacity_((std::max)(capacity, std::size_t{1})),
+      metadata_(source_->Metadata()) {
+  // Copies the column names and types into objects that will be shared with
+  // every Row and Value returned from NextRow(), as PartialResultSetSource
+  // does.
+  std::vector<std::string> names;
+  if (metadata_) {
+    for (auto const& field : metadata_->row_type().fields()) {
+      names.push_back(field.name());
+      column_types_.push_back(
+          std::make_shared<google::spanner::v1::Type const>(field.type()));
+    }
+  }
+  columns_ = std::make_shared<ColumnIndex const>(std::move(names));
+}
+
+PipelinedResultSource::~PipelinedResultSource() {
+  bool finished;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    cancelled_ = true;
+    finished = finished_;
+  }
+  has_space_.notify_all();
+  if (!worker_.joinable()) return;
+  // The background thread may be blocked reading the stream, which could take
+  // arbitrarily long, so cancel the stream before waiting for the thread.
+  if (!finished) source_->TryCancel();
+  worker_.join();
+}
+
+StatusOr<Row> PipelinedResultSource::NextRow() {
+  std::vector<google::protobuf::Value> protos;
+  auto next = NextRowValues(protos);
+  if (!next) return std::move(next).status();
+  if (!*next) return Row();
+
+  std::vector<Value> values;
+  values.reserve(column_types_.size());
+  for (std::size_t i = 0; i != column_types_.size(); ++i) {
+    values.push_back(FromProto(column_types_[i], std::move(protos[i])));
+  }
+  return internal::MakeRow(std::move(values), columns_);
+}
+
+StatusOr<bool> PipelinedResultSource::NextRowValues(
+    std::vector<google::protobuf::Value>& values) {
+  if (!worker_.joinable()) worker_ = std::thread([this] { Run(); });
+
+  if (ready_.empty()) {
+    {
+      // Take every row read so far, so the lock is not held for each one.
+      std::unique_lock<std::mutex> lk(mu_);
+      has_rows_.wait(lk, [this] { return !queue_.empty() || finished_; });
+      ready_.swap(queue_);
+    }
+    has_space_.notify_one();
+    if (ready_.empty()) return false;
+  }
+
+  auto item = std::move(ready_.front());
+  ready_.pop_front();
+  if (!item) return std::move(item).status();
+  values.swap(*item);
+  return true;
+}
+
+absl::optional<google::spanner::v1::ResultSetStats>
+PipelinedResultSource::Stats() const {
+  // Before the background thread starts the caller still owns `source_`.
+  if (!worker_.joinable()) return source_->Stats();
+  std::lock_guard<std::mutex> lk(mu_);
+  return stats_;
+}
+
+void PipelinedResultSource::Run() {
+  for (;;) {
+    std::vector<google::protobuf::Value> values;
+    auto next = source_->NextRowValues(values);
+    bool const done = !next || !*next;
+
+    std::unique_lock<std::mutex> lk(mu_);
+    has_space_.wait(lk,
+                    [this] { return queue_.size() < capacity_ || cancelled_; });
+    if (cancelled_) return;
+    if (!next) {
+      queue_.emplace_back(std::move(next).status());
+    } else if (*next) {
+      queue_.emplace_back(std::move(values));
+    }
+    if (done) {
+      // Like PartialResultSetSource, the stream ends after an error.
+      stats_ = source_->Stats();
+      finished_ = true;
+    }
+    lk.unlock();
+    has_rows_.notify_one();
+    if (done) return;
+  }
+}
+
+std::unique_ptr<ResultSourceInterface> MakePipelinedResultSource(
+    std::unique_ptr<ResultSourceInterface> source, std::size_t capacity) {
+  if (capacity == 0 || !source->HasTypedRowValues()) return source;
+  return absl::make_unique<PipelinedResultSource>(std::move(source), capacity);
+}
+
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
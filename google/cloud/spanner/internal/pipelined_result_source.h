@@ -0,0 +1,116 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PIPELINED_RESULT_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PIPELINED_RESULT_SOURCE_H
+
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/row.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/status_or.h"
+#include "absl/types/optional.h"
+#include <google/spanner/v1/spanner.pb.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+
+/**
+ * Reads the rows of another source on a background thread, ahead of the
+ * caller.
+ *
+ * The background thread pulls the rows of @p source (and thus the
+ * `PartialResultSet`s under them) into a queue of at most `capacity` rows,
+ * while the caller processes the rows read earlier. The caller takes the
+ * whole queue at once, so at most `2 * capacity` rows are buffered.
+ *
+ * The thread starts on the first call to `NextRow()` or `NextRowValues()`, so
+ * a source that is discarded before it is read costs nothing. The wrapped
+ * source must have typed row values, and it is only ever used by one thread
+ * at a time: the caller before the thread starts, the thread afterwards.
+ *
+ * Each source read this way has its own `std::thread`, which is why the
+ * library only pipelines the streams the application asked for, through the
+ * `prefetch_rows` options.
+ *
+ * The destructor cancels the stream under @p source, so a read in progress on
+ * the background thread returns, and then joins the thread.
+ */
+class PipelinedResultSource : public ResultSourceInterface {
+ public:
+  PipelinedResultSource(std::unique_ptr<ResultSourceInterface> source,
+                        std::size_t capacity);
+  ~PipelinedResultSource() override;
+
+  StatusOr<Row> NextRow() override;
+
+  StatusOr<bool> NextRowValues(
+      std::vector<google::protobuf::Value>& values) override;
+  bool HasTypedRowValues() const override { return true; }
+  void TryCancel() override { source_->TryCancel(); }
+
+  absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
+    return metadata_;
+  }
+
+  absl::optional<google::spanner::v1::ResultSetStats> Stats() const override;
+
+ private:
+  using Item = StatusOr<std::vector<google::protobuf::Value>>;
+
+  void Run();
+
+  std::unique_ptr<ResultSourceInterface> source_;
+  std::size_t const capacity_;
+  absl::optional<google::spanner::v1::ResultSetMetadata> metadata_;
+  std::shared_ptr<ColumnIndex const> columns_;
+  std::vector<std::shared_ptr<google::spanner::v1::Type const>> column_types_;
+
+  // Only used by the caller.
+  std::deque<Item> ready_;
+  std::thread worker_;
+
+  mutable std::mutex mu_;
+  std::condition_variable has_rows_;
+  std::condition_variable has_space_;
+  std::deque<Item> queue_;  // GUARDED_BY(mu_)
+  absl::optional<google::spanner::v1::ResultSetStats>
+      stats_;               // GUARDED_BY(mu_)
+  bool finished_ = false;   // GUARDED_BY(mu_)
+  bool cancelled_ = false;  // GUARDED_BY(mu_)
+};
+
+/**
+ * Returns @p source, read ahead on a background thread if @p capacity is not
+ * zero and the source has typed row values.
+ */
+std::unique_ptr<ResultSourceInterface> MakePipelinedResultSource(
+    std::unique_ptr<ResultSourceInterface> source, std::size_t capacity);
+
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PIPELINED_RESULT_SOURCE_H
@@ -0,0 +1,220 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/pipelined_result_source.h"
+#include "google/cloud/spanner/internal/partial_result_set_source.h"
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/row.h"
+#include "google/cloud/spanner/testing/mock_partial_result_set_reader.h"
+#include "google/cloud/spanner/value.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "absl/memory/memory.h"
+#include <google/protobuf/text_format.h>
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+namespace {
+
+namespace spanner_proto = ::google::spanner::v1;
+
+using ::google::cloud::spanner_testing::MockPartialResultSetReader;
+using ::google::protobuf::TextFormat;
+using ::testing::ElementsAre;
+
+// Returns @p count responses of two rows each, the first of which has the
+// metadata, and the last of which has the stats.
+std::vector<spanner_proto::PartialResultSet> MakeResponses(int count) {
+  std::vector<spanner_proto::PartialResultSet> responses(count);
+  auto constexpr kMetadata = R"pb(
+    row_type: {
+      fields: {
+        name: "Id",
+        type: { code: INT64 }
+      }
+      fields: {
+        name: "Name",
+        type: { code: STRING }
+      }
+    }
+  )pb";
+  EXPECT_TRUE(TextFormat::ParseFromString(
+      kMetadata, responses.front().mutable_metadata()));
+  responses.back().mutable_stats()->set_row_count_exact(2 * count);
+  std::int64_t id = 0;
+  for (auto& r : responses) {
+    for (int i = 0; i != 2; ++i, ++id) {
+      r.add_values()->set_string_value(std::to_string(id));
+      r.add_values()->set_string_value("name-" + std::to_string(id));
+    }
+  }
+  return responses;
+}
+
+// Returns a reader that yields @p responses and then finishes with @p status.
+std::unique_ptr<MockPartialResultSetReader> MakeReader(
+    std::vector<spanner_proto::PartialResultSet> responses,
+    Status status = Status()) {
+  auto reader = absl::make_unique<MockPartialResultSetReader>();
+  auto pending = std::make_shared<std::vector<spanner_proto::PartialResultSet>>(
+      std::move(responses));
+  auto next = std::make_shared<std::size_t>(0);
+  EXPECT_CALL(*reader, Read())
+      .WillRepeatedly(
+          [pending, next]() -> absl::optional<spanner_proto::PartialResultSet> {
+            if (*next == pending->size()) return {};
+            return (*pending)[(*next)++];
+          });
+  EXPECT_CALL(*reader, Finish()).WillOnce([status] { return status; });
+  return reader;
+}
+
+std::unique_ptr<ResultSourceInterface> MakeSource(
+    std::unique_ptr<PartialResultSetReader> reader, std::size_t capacity) {
+  auto source = PartialResultSetSource::Create(std::move(reader));
+  EXPECT_STATUS_OK(source);
+  return MakePipelinedResultSource(*std::move(source), capacity);
+}
+
+TEST(PipelinedResultSourceTest, ReadsAllRows) {
+  auto source = MakeSource(MakeReader(MakeResponses(5)), 3);
+  ASSERT_TRUE(source->Metadata().has_value());
+  EXPECT_EQ(2, source->Metadata()->row_type().fields_size());
+
+  std::vector<std::int64_t> ids;
+  for (;;) {
+    auto row = source->NextRow();
+    ASSERT_STATUS_OK(row);
+    if (row->size() == 0) break;
+    EXPECT_EQ(Value("name-" + std::to_string(ids.size())), row->values()[1]);
+    auto id = row->get<std::int64_t>("Id");
+    ASSERT_STATUS_OK(id);
+    ids.push_back(*id);
+  }
+  EXPECT_THAT(ids, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+  ASSERT_TRUE(source->Stats().has_value());
+  EXPECT_EQ(10, source->Stats()->row_count_exact());
+
+  // The end of the stream is sticky.
+  auto row = source->NextRow();
+  ASSERT_STATUS_OK(row);
+  EXPECT_EQ(0, row->size());
+}
+
+TEST(PipelinedResultSourceTest, TypedRowValues) {
+  RowStream rows(MakeSource(MakeReader(MakeResponses(3)), 1));
+  std::vector<std::int64_t> ids;
+  using RowType = std::tuple<std::int64_t, std::string>;
+  for (auto const& row : StreamOf<RowType>(rows)) {
+    ASSERT_STATUS_OK(row);
+    EXPECT_EQ("name-" + std::to_string(std::get<0>(*row)), std::get<1>(*row));
+    ids.push_back(std::get<0>(*row));
+  }
+  EXPECT_THAT(ids, ElementsAre(0, 1, 2, 3, 4, 5));
+}
+
+TEST(PipelinedResultSourceTest, ErrorEndsStream) {
+  auto source = MakeSource(
+      MakeReader(MakeResponses(1), Status(StatusCode::kPermissionDenied, "no")),
+      2);
+  std::vector<google::protobuf::Value> values;
+  for (int i = 0; i != 2; ++i) {
+    auto next = source->NextRowValues(values);
+    ASSERT_STATUS_OK(next);
+    EXPECT_TRUE(*next);
+    EXPECT_EQ(2, values.size());
+  }
+  auto next = source->NextRowValues(values);
+  EXPECT_EQ(StatusCode::kPermissionDenied, next.status().code());
+  next = source->NextRowValues(values);
+  ASSERT_STATUS_OK(next);
+  EXPECT_FALSE(*next);
+}
+
+TEST(PipelinedResultSourceTest, DestroyedEarly) {
+  auto reader = MakeReader(MakeResponses(100), Status(StatusCode::kCancelled,
+                                                      "cancelled"));
+  // Destroying the source must cancel the stream to stop the background
+  // thread, and PartialResultSetSource then cancels the unfinished stream.
+  EXPECT_CALL(*reader, TryCancel()).Times(2);
+  auto source = MakeSource(std::move(reader), 1);
+  auto row = source->NextRow();
+  ASSERT_STATUS_OK(row);
+  EXPECT_EQ(2, row->size());
+}
+
+TEST(PipelinedResultSourceTest, DestroyedWhileReading) {
+  auto responses = MakeResponses(1);
+  auto reader = absl::make_unique<MockPartialResultSetReader>();
+  std::promise<void> reading;
+  std::promise<void> cancelled;
+  // The second read blocks, like a gRPC read waiting for the server, until
+  // the stream is cancelled.
+  EXPECT_CALL(*reader, Read())
+      .WillOnce([&responses] {
+        return absl::make_optional(responses.front());
+      })
+      .WillOnce([&reading, &cancelled] {
+        reading.set_value();
+        cancelled.get_future().get();
+        return absl::optional<spanner_proto::PartialResultSet>{};
+      });
+  EXPECT_CALL(*reader, TryCancel()).WillOnce([&cancelled] {
+    cancelled.set_value();
+  });
+  EXPECT_CALL(*reader, Finish()).WillOnce([] {
+    return Status(StatusCode::kCancelled, "cancelled");
+  });
+
+  auto source = MakeSource(std::move(reader), 1);
+  auto row = source->NextRow();
+  ASSERT_STATUS_OK(row);
+  EXPECT_EQ(2, row->size());
+  reading.get_future().get();
+  source.reset();
+}
+
+TEST(PipelinedResultSourceTest, NeverRead) {
+  auto reader = MakeReader(MakeResponses(2), Status(StatusCode::kCancelled,
+                                                    "cancelled"));
+  EXPECT_CALL(*reader, TryCancel()).Times(1);
+  auto source = MakeSource(std::move(reader), 4);
+  EXPECT_FALSE(source->Stats().has_value());
+}
+
+TEST(PipelinedResultSourceTest, DisabledWithZeroCapacity) {
+  auto reader = MakeReader(MakeResponses(1));
+  EXPECT_CALL(*reader, TryCancel()).Times(1);
+  auto source = PartialResultSetSource::Create(std::move(reader));
+  ASSERT_STATUS_OK(source);
+  auto const* plain = source->get();
+  auto result = MakePipelinedResultSource(*std::move(source), 0);
+  EXPECT_EQ(plain, result.get());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -18,6 +18,7 @@
 #include "google/cloud/spanner/internal/channel.h"
 #include "google/cloud/spanner/internal/clock.h"
 #include "google/cloud/spanner/version.h"
+#include "absl/types/optional.h"
 #include <atomic>
 #include <chrono>
 #include <memory>
@@ -58,6 +59,37 @@ class Session {
   void set_bad() { is_bad_.store(true, std::memory_order_relaxed); }
   bool is_bad() const { return is_bad_.load(std::memory_order_relaxed); }
 
+  /**
+   * Returns the ID of the read-write transaction the pool began on this
+   * session, if any, and forgets it. Returns an empty string otherwise.
+   *
+   * The transaction can only be used once, so only the owner of the session
+   * should call this, right before using the transaction.
+   */
+  std::string TakeWriteTransactionId() {
+    std::string id;
+    id.swap(write_transaction_id_);
+    return id;
+  }
+
+  /**
+   * Records the delay the service suggested when it aborted a transaction on
+   * this session, so the transaction rerun loop can honor it.
+   *
+   * As with `TakeWriteTransactionId()`, only the owner of the session should
+   * use these two functions.
+   */
+  void set_retry_delay(std::chrono::milliseconds delay) {
+    retry_delay_ = delay;
+  }
+
+  /// Returns the delay recorded by `set_retry_delay()`, if any, and forgets it.
+  absl::optional<std::chrono::milliseconds> TakeRetryDelay() {
+    auto delay = retry_delay_;
+    retry_delay_.reset();
+    return delay;
+  }
+
  private:
   // Give `SessionPool` access to the private methods below.
   friend class SessionPool;
@@ -67,12 +99,24 @@ class Session {
   // thread-safe manner (i.e. using external locking).
   Clock::time_point last_use_time() const { return last_use_time_; }
   void update_last_use_time() { last_use_time_ = clock_->Now(); }
+  void set_last_use_time(Clock::time_point t) { last_use_time_ = t; }
+
+  bool is_write_prepared() const { return !write_transaction_id_.empty(); }
+  Clock::time_point write_prepared_time() const { return write_prepared_time_; }
+  void set_write_transaction_id(std::string id) {
+    write_transaction_id_ = std::move(id);
+    write_prepared_time_ = clock_->Now();
+  }
+  void clear_write_transaction_id() { write_transaction_id_.clear(); }
 
   std::string const session_name_;
   std::shared_ptr<Channel> const channel_;
   std::atomic<bool> is_bad_;
   std::shared_ptr<Clock> clock_;
   Clock::time_point last_use_time_;
+  std::string write_transaction_id_;
+  Clock::time_point write_prepared_time_;
+  absl::optional<std::chrono::milliseconds> retry_delay_;
 };
 
 /**
@@ -16,13 +16,17 @@
 #include "google/cloud/spanner/internal/connection_impl.h"
 #include "google/cloud/spanner/internal/retry_loop.h"
 #include "google/cloud/spanner/internal/session.h"
+#include "google/cloud/spanner/internal/status_utils.h"
 #include "google/cloud/completion_queue.h"
 #include "google/cloud/internal/async_retry_unary_rpc.h"
 #include "google/cloud/log.h"
 #include "google/cloud/status.h"
 #include "absl/memory/memory.h"
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <iterator>
 #include <random>
 #include <thread>
 #include <utility>
@@ -36,6 +40,35 @@ namespace internal {
 
 namespace spanner_proto = ::google::spanner::v1;
 
+namespace {
+// Spanner may abort read-write transactions that are idle for more than 10
+// seconds, so write-prepared sessions are demoted before that.
+auto constexpr kWritePreparedMaxAge = std::chrono::seconds(8);
+
+// Each background pass sends at most this many refreshes on each channel,
+// the rest wait for the next pass. That is enough to keep thousands of
+// sessions per channel alive, without a burst of RPCs when many sessions
+// expire at once.
+auto constexpr kMaxRefreshesPerChannel = 10;
+
+// Numbers the threads that allocate sessions in the order they first do so.
+// Unlike hashing `std::thread::id`, which is often an aligned address, this
+// spreads the home shards of the threads evenly.
+std::size_t ThreadOrdinal() {
+  static std::atomic<std::size_t> next_ordinal{0};
+  thread_local std::size_t const ordinal = next_ordinal++;
+  return ordinal;
+}
+
+// A channel is clearly busier than another when it has at least 2, and at
+// least 25%, more sessions in use. Smaller differences come and go as the
+// sessions are allocated and released, and are not worth leaving the home
+// shard for.
+bool ClearlyBusier(int active, int other_active) {
+  return active - other_active >= (std::max)(2, other_active / 4);
+}
+}  // namespace
+
 std::shared_ptr<SessionPool> MakeSessionPool(
     Database db, std::vector<std::shared_ptr<SpannerStub>> stubs,
     SessionPoolOptions options, google::cloud::CompletionQueue cq,
@@ -64,16 +97,17 @@ SessionPool::SessionPool(Database db,
       backoff_policy_prototype_(std::move(backoff_policy)),
       clock_(std::move(clock)),
       max_pool_size_(options_.max_sessions_per_channel() *
-                     static_cast<int>(stubs.size())),
-      random_generator_(std::random_device()()) {
+                     static_cast<int>(stubs.size())) {
   if (stubs.empty()) {
     google::cloud::internal::ThrowInvalidArgument(
         "SessionPool requires a non-empty set of stubs");
   }
 
   channels_.reserve(stubs.size());
+  shards_.reserve(stubs.size());
   for (auto& stub : stubs) {
     channels_.push_back(std::make_shared<Channel>(std::move(stub)));
+    shards_.push_back(absl::make_unique<Shard>());
   }
   // `channels_` is never resized after this point.
   next_dissociated_stub_channel_ = channels_.begin();
@@ -88,6 +122,13 @@ void SessionPool::Initialize() {
 }
 
 SessionPool::~SessionPool() {
+  // There are no references to this object, so nothing can release sessions
+  // to satisfy the remaining async waiters.
+  for (auto& waiter : async_waiters_) {
+    waiter.session.set_value(
+        Status(StatusCode::kCancelled, "session pool destroyed"));
+  }
+
   // All references to this object are via `shared_ptr`; since we're in the
   // destructor that implies there can be no concurrent accesses to any member
   // variables, including `current_timer_`.
@@ -118,6 +159,7 @@ void SessionPool::ScheduleBackgroundWork(std::chrono::seconds relative_time) {
 
 void SessionPool::DoBackgroundWork() {
   MaintainPoolSize();
+  PrepareWriteSessions();
   RefreshExpiringSessions();
   ScheduleBackgroundWork(std::chrono::seconds(5));
 }
@@ -134,28 +176,93 @@ void SessionPool::MaintainPoolSize() {
 }
 
 // Refresh all sessions whose last-use time is older than the keep-alive
-// interval. Issues asynchronous RPCs, so this method does not block.
+// interval, or delete them if the pool has more idle sessions than it needs.
+// Issues asynchronous RPCs, so this method does not block.
 void SessionPool::RefreshExpiringSessions() {
   std::vector<std::pair<std::shared_ptr<SpannerStub>, std::string>>
       sessions_to_refresh;
+  std::vector<std::pair<std::shared_ptr<SpannerStub>, std::string>>
+      sessions_to_delete;
   auto now = clock_->Now();
   auto refresh_limit = now - options_.keep_alive_interval();
   {
     std::unique_lock<std::mutex> lk(mu_);
     if (last_use_time_lower_bound_ <= refresh_limit) {
       last_use_time_lower_bound_ = now;
-      for (auto const& session : sessions_) {
-        auto last_use_time = session->last_use_time();
-        if (last_use_time <= refresh_limit) {
-          sessions_to_refresh.emplace_back(session->channel()->stub,
-                                           session->session_name());
-          session->update_last_use_time();
-        } else if (last_use_time < last_use_time_lower_bound_) {
-          last_use_time_lower_bound_ = last_use_time;
+      // Refreshed sessions are marked as used up to 10% of the interval in
+      // the past, so sessions created (or refreshed) together drift apart and
+      // their next refreshes are spread out.
+      std::uniform_int_distribution<std::chrono::microseconds::rep> jitter(
+          0, std::chrono::duration_cast<std::chrono::microseconds>(
+                 options_.keep_alive_interval())
+                     .count() /
+                 10);
+      // Sessions unused for a whole interval are a sign of low traffic, keep
+      // only the ones we were asked to.
+      auto const keep =
+          (std::max)(options_.min_sessions(), options_.max_idle_sessions());
+      auto excess = total_sessions_ - keep;
+      // Channels are not trimmed below their share of the sessions we keep,
+      // so the deletions rebalance the channels with more sessions.
+      auto const channel_count = static_cast<int>(channels_.size());
+      auto const fair_share = (keep + channel_count - 1) / channel_count;
+      for (std::size_t i = 0; i != shards_.size(); ++i) {
+        auto& shard = *shards_[i];
+        auto const& channel = channels_[i];
+        int refreshes = 0;
+        std::lock_guard<std::mutex> shard_lk(shard.mu);
+        for (auto* sessions : {&shard.sessions, &shard.write_sessions}) {
+          // The sessions are in least-recently-used order, so the oldest ones
+          // are deleted first.
+          for (auto it = sessions->begin(); it != sessions->end();) {
+            auto& session = *it;
+            auto last_use_time = session->last_use_time();
+            if (last_use_time > refresh_limit) {
+              last_use_time_lower_bound_ =
+                  (std::min)(last_use_time_lower_bound_, last_use_time);
+              ++it;
+              continue;
+            }
+            if (excess > 0 && channel->session_count > fair_share) {
+              --excess;
+              --total_sessions_;
+              --channel->session_count;
+              --idle_sessions_;
+              if (sessions == &shard.write_sessions) --idle_write_sessions_;
+              sessions_to_delete.emplace_back(channel->stub,
+                                              session->session_name());
+              it = sessions->erase(it);
+              continue;
+            }
+            if (refreshes == kMaxRefreshesPerChannel) {
+              // Leave it for the next pass.
+              last_use_time_lower_bound_ =
+                  (std::min)(last_use_time_lower_bound_, last_use_time);
+              ++it;
+              continue;
+            }
+            ++refreshes;
+            sessions_to_refresh.emplace_back(channel->stub,
+                                             session->session_name());
+            auto const refresh_time =
+                now - std::chrono::microseconds(jitter(generator_));
+            session->set_last_use_time(refresh_time);
+            last_use_time_lower_bound_ =
+                (std::min)(last_use_time_lower_bound_, refresh_time);
+            ++it;
+          }
         }
       }
     }
   }
+  for (auto& session : sessions_to_delete) {
+    AsyncDeleteSession(cq_, session.first, std::move(session.second))
+        .then([](future<StatusOr<google::protobuf::Empty>> result) {
+          // The session is no longer in the pool, and the backend GC will
+          // collect it if the delete fails.
+          (void)result.get();
+        });
+  }
   for (auto& refresh : sessions_to_refresh) {
     AsyncRefreshSession(cq_, refresh.first, std::move(refresh.second))
         .then([](future<StatusOr<spanner_proto::ResultSet>> result) {
@@ -169,6 +276,96 @@ void SessionPool::RefreshExpiringSessions() {
   }
 }
 
+// Begin read-write transactions on idle sessions until (approximately)
+// `write_sessions_fraction()` of the pool is write-prepared, and demote the
+// write-prepared sessions whose transaction is about to be aborted. Issues
+// asynchronous RPCs, so this method does not block.
+void SessionPool::PrepareWriteSessions() {
+  if (options_.write_sessions_fraction() <= 0) return;
+  auto const expired_limit = clock_->Now() - kWritePreparedMaxAge;
+  for (auto const& shard : shards_) {
+    std::lock_guard<std::mutex> shard_lk(shard->mu);
+    auto& write_sessions = shard->write_sessions;
+    auto const it = std::stable_partition(
+        write_sessions.begin(), write_sessions.end(),
+        [expired_limit](std::unique_ptr<Session> const& session) {
+          return session->write_prepared_time() > expired_limit;
+        });
+    // The demoted sessions go to the front, they are not recently used.
+    for (auto i = it; i != write_sessions.end(); ++i) {
+      (*i)->clear_write_transaction_id();
+    }
+    idle_write_sessions_ -= static_cast<int>(write_sessions.end() - it);
+    shard->sessions.insert(shard->sessions.begin(),
+                           std::make_move_iterator(it),
+                           std::make_move_iterator(write_sessions.end()));
+    write_sessions.erase(it, write_sessions.end());
+  }
+
+  int to_prepare;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto const target = static_cast<int>(
+        std::ceil(options_.write_sessions_fraction() * total_sessions_));
+    to_prepare =
+        target - idle_write_sessions_.load() - write_prepares_in_progress_;
+  }
+  if (to_prepare <= 0) return;
+
+  // Use the least recently used sessions, the most recently used ones are
+  // more likely to be in the backend's cache for reads.
+  std::vector<std::unique_ptr<Session>> sessions;
+  for (auto const& shard : shards_) {
+    std::lock_guard<std::mutex> shard_lk(shard->mu);
+    auto const n = (std::min)(to_prepare - static_cast<int>(sessions.size()),
+                              static_cast<int>(shard->sessions.size()));
+    auto const end = shard->sessions.begin() + n;
+    sessions.insert(sessions.end(),
+                    std::make_move_iterator(shard->sessions.begin()),
+                    std::make_move_iterator(end));
+    shard->sessions.erase(shard->sessions.begin(), end);
+    idle_sessions_ -= n;
+    if (static_cast<int>(sessions.size()) == to_prepare) break;
+  }
+  if (sessions.empty()) return;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    write_prepares_in_progress_ += static_cast<int>(sessions.size());
+  }
+
+  std::weak_ptr<SessionPool> pool = shared_from_this();
+  for (auto& session : sessions) {
+    ++session->channel()->active_sessions;
+    auto const& stub = session->channel()->stub;
+    auto const& session_name = session->session_name();
+    // The callback owns the `Session` until it is released to the pool.
+    auto* s = session.release();
+    AsyncBeginTransaction(cq_, stub, session_name)
+        .then([pool, s](future<StatusOr<spanner_proto::Transaction>> result) {
+          std::unique_ptr<Session> session(s);
+          if (auto shared_pool = pool.lock()) {
+            shared_pool->HandleBeginTransactionDone(std::move(session),
+                                                    result.get());
+          }
+        });
+  }
+}
+
+void SessionPool::HandleBeginTransactionDone(
+    std::unique_ptr<Session> session,
+    StatusOr<spanner_proto::Transaction> response) {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    --write_prepares_in_progress_;
+  }
+  if (response) {
+    session->set_write_transaction_id(std::move(*response->mutable_id()));
+  } else if (IsSessionNotFound(response.status())) {
+    session->set_bad();
+  }
+  Release(std::move(session));
+}
+
 /**
  * Grow the session pool by creating up to `sessions_to_create` sessions and
  * adding them to the pool.  Note that `lk` may be released and reacquired in
@@ -210,13 +407,19 @@ SessionPool::ComputeCreateCounts(int sessions_to_create) {
   int target_total_sessions =
       (std::min)(total_sessions_ + sessions_to_create, max_pool_size_);
 
-  // Sort the channels in *descending* order of session count.
+  // Sort the channels in *descending* order of session count. The channels
+  // earlier in the order get any sessions left over by the rounding, so
+  // among channels with the same session count, prefer the ones with the
+  // fewest sessions in use.
   std::vector<std::shared_ptr<Channel>> channels_by_count = channels_;
   std::sort(channels_by_count.begin(), channels_by_count.end(),
             [](std::shared_ptr<Channel> const& lhs,
                std::shared_ptr<Channel> const& rhs) {
               // Use `>` to sort in descending order.
-              return lhs->session_count > rhs->session_count;
+              if (lhs->session_count != rhs->session_count) {
+                return lhs->session_count > rhs->session_count;
+              }
+              return lhs->active_sessions.load() < rhs->active_sessions.load();
             });
 
   // Compute the number of new Sessions to create on each channel.
@@ -266,22 +469,34 @@ Status SessionPool::CreateSessions(
 }
 
 StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool) {
-  std::unique_lock<std::mutex> lk(mu_);
+  return Allocate(dissociate_from_pool, /*for_write=*/false);
+}
+
+StatusOr<SessionHolder> SessionPool::AllocateForWrite() {
+  return Allocate(/*dissociate_from_pool=*/false, /*for_write=*/true);
+}
+
+StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool,
+                                              bool for_write) {
   for (;;) {
-    if (!sessions_.empty()) {
-      // return the most recently used session.
-      auto session = std::move(sessions_.back());
-      sessions_.pop_back();
+    // The fast path does not need `mu_`.
+    if (auto session = TryPop(for_write)) {
       if (dissociate_from_pool) {
+        std::lock_guard<std::mutex> lk(mu_);
         --total_sessions_;
         auto const& channel = session->channel();
         if (channel) {
           --channel->session_count;
+          --channel->active_sessions;
         }
       }
       return {MakeSessionHolder(std::move(session), dissociate_from_pool)};
     }
 
+    std::unique_lock<std::mutex> lk(mu_);
+    // A session may have been released since `TryPop()` returned.
+    if (idle_sessions_.load() > 0) continue;
+
     // If the pool is at its max size, fail or wait until someone returns a
     // session to the pool then try again.
     if (total_sessions_ >= max_pool_size_) {
@@ -289,7 +504,7 @@ StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool) {
         return Status(StatusCode::kResourceExhausted, "session pool exhausted");
       }
       Wait(lk, [this] {
-        return !sessions_.empty() || total_sessions_ < max_pool_size_;
+        return idle_sessions_.load() > 0 || total_sessions_ < max_pool_size_;
       });
       continue;
     }
@@ -302,7 +517,7 @@ StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool) {
     // number of waiters in the `sessions_to_create` calculation below.
     if (create_calls_in_progress_ > 0) {
       Wait(lk, [this] {
-        return !sessions_.empty() || create_calls_in_progress_ == 0;
+        return idle_sessions_.load() > 0 || create_calls_in_progress_ == 0;
       });
       continue;
     }
@@ -317,6 +532,122 @@ StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool) {
   }
 }
 
+future<StatusOr<SessionHolder>> SessionPool::AsyncAllocate() {
+  return AsyncAllocate(/*for_write=*/false);
+}
+
+future<StatusOr<SessionHolder>> SessionPool::AsyncAllocateForWrite() {
+  return AsyncAllocate(/*for_write=*/true);
+}
+
+future<StatusOr<SessionHolder>> SessionPool::AsyncAllocate(bool for_write) {
+  if (auto session = TryPop(for_write)) {
+    return make_ready_future(StatusOr<SessionHolder>(
+        MakeSessionHolder(std::move(session), /*dissociate_from_pool=*/false)));
+  }
+
+  std::unique_lock<std::mutex> lk(mu_);
+  if (idle_sessions_.load() == 0 && total_sessions_ >= max_pool_size_ &&
+      options_.action_on_exhaustion() == ActionOnExhaustion::kFail) {
+    return make_ready_future(StatusOr<SessionHolder>(
+        Status(StatusCode::kResourceExhausted, "session pool exhausted")));
+  }
+  async_waiters_.push_back(
+      AsyncWaiter{for_write, promise<StatusOr<SessionHolder>>()});
+  auto f = async_waiters_.back().session.get_future();
+  ++num_waiting_for_session_;
+
+  // Like `Allocate()`, add `min_sessions` plus one for this caller, but do not
+  // wait for them.
+  if (total_sessions_ < max_pool_size_ && create_calls_in_progress_ == 0) {
+    (void)Grow(lk, options_.min_sessions() + 1,
+               WaitForSessionAllocation::kNoWait);
+  }
+  lk.unlock();
+
+  // A session may have been released before this caller was queued.
+  ServeAsyncWaiters();
+  return f;
+}
+
+void SessionPool::ServeAsyncWaiters() {
+  std::vector<std::pair<AsyncWaiter, std::unique_ptr<Session>>> ready;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    while (!async_waiters_.empty()) {
+      auto session = TryPop(async_waiters_.front().for_write);
+      if (!session) break;
+      ready.emplace_back(std::move(async_waiters_.front()), std::move(session));
+      async_waiters_.pop_front();
+      --num_waiting_for_session_;
+    }
+  }
+  // Satisfy the futures without the lock held, as that runs their callbacks.
+  for (auto& r : ready) {
+    r.first.session.set_value(
+        MakeSessionHolder(std::move(r.second), /*dissociate_from_pool=*/false));
+  }
+}
+
+std::unique_ptr<Session> SessionPool::TryPop(bool for_write) {
+  auto const idle = idle_sessions_.load();
+  if (idle == 0) return nullptr;
+  auto const idle_write = idle_write_sessions_.load();
+  auto const shard_count = shards_.size();
+  auto const home = ThreadOrdinal() % shard_count;
+  // Start at the home shard, unless its channel is clearly busier than the
+  // channel of one other shard, taken in turn. Comparing two channels is
+  // enough to avoid the overloaded ones, while most threads keep to their own
+  // shard, and mutex.
+  auto start = home;
+  if (shard_count > 1) {
+    thread_local std::size_t next_other = 0;
+    auto const other = (home + 1 + next_other++ % (shard_count - 1)) %
+                       shard_count;
+    if (ClearlyBusier(channels_[home]->active_sessions.load(),
+                      channels_[other]->active_sessions.load())) {
+      start = other;
+    }
+  }
+  // The first pass only looks for the preferred kind of session, skip it if
+  // there are none.
+  bool const have_preferred = for_write ? idle_write > 0 : idle > idle_write;
+  for (int pass = have_preferred ? 0 : 1; pass != 2; ++pass) {
+    for (std::size_t i = 0; i != shard_count; ++i) {
+      auto& shard = *shards_[(start + i) % shard_count];
+      std::lock_guard<std::mutex> lk(shard.mu);
+      auto* sessions = for_write ? &shard.write_sessions : &shard.sessions;
+      if (sessions->empty() && pass == 1) {
+        sessions = for_write ? &shard.sessions : &shard.write_sessions;
+      }
+      if (sessions->empty()) continue;
+      // return the most recently used session.
+      auto session = std::move(sessions->back());
+      sessions->pop_back();
+      --idle_sessions_;
+      ++session->channel()->active_sessions;
+      if (sessions == &shard.write_sessions) {
+        --idle_write_sessions_;
+        // Do not hand out transactions that the caller will not use, or that
+        // are likely to be aborted already.
+        auto const expired_limit = clock_->Now() - kWritePreparedMaxAge;
+        if (!for_write || session->write_prepared_time() <= expired_limit) {
+          session->clear_write_transaction_id();
+        }
+      }
+      return session;
+    }
+  }
+  return nullptr;
+}
+
+SessionPool::Shard& SessionPool::ShardFor(
+    std::shared_ptr<Channel> const& channel) {
+  // There are only a handful of channels, a linear search is fast enough.
+  auto const it = std::find(channels_.begin(), channels_.end(), channel);
+  return *shards_[static_cast<std::size_t>(it - channels_.begin())];
+}
+
 std::shared_ptr<SpannerStub> SessionPool::GetStub(Session const& session) {
   auto const& channel = session.channel();
   if (channel) {
@@ -334,23 +665,51 @@ std::shared_ptr<SpannerStub> SessionPool::GetStub(Session const& session) {
   return stub;
 }
 
+std::vector<SessionPool::ChannelStats> SessionPool::GetChannelStats() {
+  std::vector<ChannelStats> stats;
+  std::lock_guard<std::mutex> lk(mu_);
+  for (std::size_t i = 0; i != channels_.size(); ++i) {
+    auto& shard = *shards_[i];
+    std::lock_guard<std::mutex> shard_lk(shard.mu);
+    stats.push_back(ChannelStats{
+        channels_[i]->session_count, channels_[i]->active_sessions.load(),
+        static_cast<int>(shard.sessions.size() + shard.write_sessions.size())});
+  }
+  return stats;
+}
+
 void SessionPool::Release(std::unique_ptr<Session> session) {
-  std::unique_lock<std::mutex> lk(mu_);
   if (session->is_bad()) {
     // Once we have support for background processing, we may want to signal
     // that to replenish this bad session.
+    std::lock_guard<std::mutex> lk(mu_);
     --total_sessions_;
     auto const& channel = session->channel();
     if (channel) {
       --channel->session_count;
+      --channel->active_sessions;
     }
     return;
   }
-  session->update_last_use_time();
-  sessions_.push_back(std::move(session));
-  if (num_waiting_for_session_ > 0) {
-    lk.unlock();
+  --session->channel()->active_sessions;
+  auto& shard = ShardFor(session->channel());
+  bool const write_prepared = session->is_write_prepared();
+  {
+    std::lock_guard<std::mutex> lk(shard.mu);
+    session->update_last_use_time();
+    auto& sessions = write_prepared ? shard.write_sessions : shard.sessions;
+    sessions.push_back(std::move(session));
+  }
+  if (write_prepared) ++idle_write_sessions_;
+  ++idle_sessions_;
+  // Waiters increment `num_waiting_for_session_` and then check
+  // `idle_sessions_` with `mu_` held, so either they see this session or we
+  // see them. Acquiring `mu_` guarantees they are blocked in `Wait()` before
+  // they are notified.
+  if (num_waiting_for_session_.load() > 0) {
+    { std::lock_guard<std::mutex> lk(mu_); }
     cond_.notify_one();
+    ServeAsyncWaiters();
   }
 }
 
@@ -444,6 +803,25 @@ future<StatusOr<google::protobuf::Empty>> SessionPool::AsyncDeleteSession(
       std::move(request));
 }
 
+/// Begin a read-write transaction on the session `session_name`.
+future<StatusOr<spanner_proto::Transaction>> SessionPool::AsyncBeginTransaction(
+    CompletionQueue& cq, std::shared_ptr<SpannerStub> const& stub,
+    std::string session_name) {
+  spanner_proto::BeginTransactionRequest request;
+  request.set_session(std::move(session_name));
+  request.mutable_options()->mutable_read_write();
+  return google::cloud::internal::StartRetryAsyncUnaryRpc(
+      cq, __func__, retry_policy_prototype_->clone(),
+      backoff_policy_prototype_->clone(),
+      /*is_idempotent=*/true,
+      [stub](grpc::ClientContext* context,
+             spanner_proto::BeginTransactionRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return stub->AsyncBeginTransaction(*context, request, cq);
+      },
+      std::move(request));
+}
+
 /// Refresh the session `session_name` by executing a `SELECT 1` query on it.
 future<StatusOr<spanner_proto::ResultSet>> SessionPool::AsyncRefreshSession(
     CompletionQueue& cq, std::shared_ptr<SpannerStub> const& stub,
@@ -469,23 +847,45 @@ Status SessionPool::HandleBatchCreateSessionsDone(
   std::unique_lock<std::mutex> lk(mu_);
   --create_calls_in_progress_;
   if (!response.ok()) {
+    // Nothing else will create sessions for the async waiters, so they fail
+    // like a synchronous `Allocate()` would.
+    std::deque<AsyncWaiter> failed;
+    if (create_calls_in_progress_ == 0 && idle_sessions_.load() == 0) {
+      failed.swap(async_waiters_);
+      num_waiting_for_session_ -= static_cast<int>(failed.size());
+    }
+    lk.unlock();
+    for (auto& waiter : failed) waiter.session.set_value(response.status());
     return response.status();
   }
   // Add sessions to the pool and update counters for `channel` and the pool.
   auto const sessions_created = response->session_size();
   channel->session_count += sessions_created;
   total_sessions_ += sessions_created;
-  sessions_.reserve(sessions_.size() + sessions_created);
-  for (auto& session : *response->mutable_session()) {
-    sessions_.push_back(absl::make_unique<Session>(
-        std::move(*session.mutable_name()), channel, clock_));
+  {
+    auto& shard = ShardFor(channel);
+    std::lock_guard<std::mutex> shard_lk(shard.mu);
+    shard.sessions.reserve(shard.sessions.size() + sessions_created);
+    for (auto& session : *response->mutable_session()) {
+      shard.sessions.push_back(absl::make_unique<Session>(
+          std::move(*session.mutable_name()), channel, clock_));
+    }
   }
-  // Shuffle the pool so we distribute returned sessions across channels.
-  std::shuffle(sessions_.begin(), sessions_.end(), random_generator_);
+  idle_sessions_ += sessions_created;
 
   // Wake up anyone who was waiting for a `Session`.
   lk.unlock();
   cond_.notify_all();
+  ServeAsyncWaiters();
+
+  // `AsyncAllocate()` only grows the pool when no sessions are being created,
+  // so keep growing, as `Allocate()` does, while async callers still wait.
+  lk.lock();
+  if (!async_waiters_.empty() && create_calls_in_progress_ == 0 &&
+      total_sessions_ < max_pool_size_) {
+    (void)Grow(lk, options_.min_sessions() + 1,
+               WaitForSessionAllocation::kNoWait);
+  }
   return Status();
 }
 
@@ -25,15 +25,17 @@
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/completion_queue.h"
 #include "google/cloud/future.h"
+#include "google/cloud/internal/random.h"
 #include "google/cloud/status_or.h"
 #include <google/spanner/v1/spanner.pb.h>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
-#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -57,6 +59,18 @@ struct SessionPoolFriendForTest;
  * Allocation from the pool is LIFO to take advantage of the fact the Spanner
  * backends maintain a cache of sessions which is valid for 30 seconds, so
  * re-using Sessions as quickly as possible has performance advantages.
+ *
+ * To reduce contention, the idle sessions are kept in per-channel shards, each
+ * with its own mutex. A thread allocates from its "home" shard (the threads
+ * are assigned to the shards in turn), and steals from the other shards when
+ * its home shard is empty. Sessions are always released to the shard of their
+ * channel. The pool-wide mutex is only used to create sessions, to wait for
+ * sessions, and for the accounting that enforces the pool size limits.
+ *
+ * If `SessionPoolOptions::write_sessions_fraction()` is set, the background
+ * work begins read-write transactions on some of the idle sessions. These
+ * "write-prepared" sessions are kept apart from the other idle sessions, and
+ * handed out by `AllocateForWrite()` so commits can skip `BeginTransaction`.
  */
 class SessionPool : public std::enable_shared_from_this<SessionPool> {
  public:
@@ -94,11 +108,46 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
    */
   StatusOr<SessionHolder> Allocate(bool dissociate_from_pool = false);
 
+  /**
+   * Allocate a `Session` for a read-write transaction.
+   *
+   * Prefers sessions where the pool already began a read-write transaction,
+   * use `Session::TakeWriteTransactionId()` to get its ID. Otherwise behaves
+   * like `Allocate()`.
+   */
+  StatusOr<SessionHolder> AllocateForWrite();
+
+  /**
+   * Asynchronously allocate a `Session` from the pool.
+   *
+   * This never blocks. If there are no idle sessions the returned future is
+   * satisfied when a session is released to the pool, or created. Like
+   * `Allocate()`, it is satisfied with an error if the pool is exhausted and
+   * configured with `ActionOnExhaustion::kFail`, or if creating sessions fails.
+   */
+  future<StatusOr<SessionHolder>> AsyncAllocate();
+
+  /// Like `AsyncAllocate()`, but prefers sessions as `AllocateForWrite()` does.
+  future<StatusOr<SessionHolder>> AsyncAllocateForWrite();
+
   /**
    * Return a `SpannerStub` to be used when making calls using `session`.
    */
   std::shared_ptr<SpannerStub> GetStub(Session const& session);
 
+  /// The sessions of a single channel, see `GetChannelStats()`.
+  struct ChannelStats {
+    int sessions;
+    int active_sessions;
+    int idle_sessions;
+  };
+
+  /**
+   * Return a snapshot of the sessions on each channel, in the order of the
+   * stubs given to the constructor.
+   */
+  std::vector<ChannelStats> GetChannelStats();
+
  private:
   // Represents a request to create `session_count` sessions on `channel`
   // See `ComputeCreateCounts` and `CreateSessions`.
@@ -108,9 +157,38 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
   };
   enum class WaitForSessionAllocation { kWait, kNoWait };
 
+  StatusOr<SessionHolder> Allocate(bool dissociate_from_pool, bool for_write);
+  future<StatusOr<SessionHolder>> AsyncAllocate(bool for_write);
+
+  // A call to `AsyncAllocate()` waiting for a session.
+  struct AsyncWaiter {
+    bool for_write;
+    promise<StatusOr<SessionHolder>> session;
+  };
+
+  // Satisfy the `async_waiters_` while there are idle sessions.
+  void ServeAsyncWaiters();  // LOCKS_EXCLUDED(mu_)
+
   // Release session back to the pool.
   void Release(std::unique_ptr<Session> session);
 
+  // The idle sessions on a single channel, used in LIFO order. Sessions with
+  // a pre-begun read-write transaction are kept in `write_sessions`.
+  struct Shard {
+    std::mutex mu;
+    std::vector<std::unique_ptr<Session>> sessions;        // GUARDED_BY(mu)
+    std::vector<std::unique_ptr<Session>> write_sessions;  // GUARDED_BY(mu)
+  };
+
+  // Pop an idle session, trying the home shard of this thread first (or
+  // another shard if the home channel is clearly busier than that shard's),
+  // and then stealing from the other shards. Sessions of the preferred kind
+  // (see `for_write`) are returned first. Returns `nullptr` if there are none.
+  std::unique_ptr<Session> TryPop(bool for_write);  // LOCKS_EXCLUDED(mu_)
+
+  // The shard for sessions on `channel`.
+  Shard& ShardFor(std::shared_ptr<Channel> const& channel);
+
   // Called when a thread needs to wait for a `Session` to become available.
   // @p specifies the condition to wait for.
   template <typename Predicate>
@@ -149,6 +227,9 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
   future<StatusOr<google::spanner::v1::ResultSet>> AsyncRefreshSession(
       CompletionQueue& cq, std::shared_ptr<SpannerStub> const& stub,
       std::string session_name);
+  future<StatusOr<google::spanner::v1::Transaction>> AsyncBeginTransaction(
+      CompletionQueue& cq, std::shared_ptr<SpannerStub> const& stub,
+      std::string session_name);
 
   Status HandleBatchCreateSessionsDone(
       std::shared_ptr<Channel> const& channel,
@@ -160,6 +241,10 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
   void DoBackgroundWork();
   void MaintainPoolSize();
   void RefreshExpiringSessions();
+  void PrepareWriteSessions();
+  void HandleBeginTransactionDone(
+      std::unique_ptr<Session> session,
+      StatusOr<google::spanner::v1::Transaction> response);
 
   Database const db_;
   SessionPoolOptions const options_;
@@ -168,18 +253,33 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
   std::shared_ptr<Session::Clock> clock_;
   int const max_pool_size_;
-  std::mt19937 random_generator_;
+
+  // One shard per channel, in the same order as `channels_`. Not resized
+  // after the constructor runs.
+  std::vector<std::unique_ptr<Shard>> shards_;
+  // The number of sessions in all the shards. It may briefly disagree with
+  // the shards while a session is pushed or popped.
+  std::atomic<int> idle_sessions_{0};
+  // The number of sessions in the `write_sessions` of all the shards, these
+  // are included in `idle_sessions_`.
+  std::atomic<int> idle_write_sessions_{0};
+  // Updated with `mu_` held, but read without it by `Release()`. Includes
+  // the `async_waiters_`.
+  std::atomic<int> num_waiting_for_session_{0};
 
   std::mutex mu_;
   std::condition_variable cond_;
-  std::vector<std::unique_ptr<Session>> sessions_;  // GUARDED_BY(mu_)
-  int total_sessions_ = 0;                          // GUARDED_BY(mu_)
-  int create_calls_in_progress_ = 0;                // GUARDED_BY(mu_)
-  int num_waiting_for_session_ = 0;                 // GUARDED_BY(mu_)
+  int total_sessions_ = 0;                 // GUARDED_BY(mu_)
+  int create_calls_in_progress_ = 0;       // GUARDED_BY(mu_)
+  int write_prepares_in_progress_ = 0;     // GUARDED_BY(mu_)
+  std::deque<AsyncWaiter> async_waiters_;  // GUARDED_BY(mu_)
 
-  // Lower bound on all `sessions_[i]->last_use_time()` values.
+  // Lower bound on the `last_use_time()` of all the idle sessions.
   Session::Clock::time_point last_use_time_lower_bound_ =
       clock_->Now();  // GUARDED_BY(mu_)
+  // Spreads out the session refreshes.
+  google::cloud::internal::DefaultPRNG generator_ =
+      google::cloud::internal::MakeDefaultPRNG();  // GUARDED_BY(mu_)
 
   future<void> current_timer_;
 
@@ -25,8 +25,13 @@
 #include "absl/memory/memory.h"
 #include <google/protobuf/text_format.h>
 #include <gmock/gmock.h>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -44,6 +49,7 @@ using ::google::cloud::testing_util::MockCompletionQueue;
 using ::google::protobuf::TextFormat;
 using ::testing::_;
 using ::testing::ByMove;
+using ::testing::ElementsAre;
 using ::testing::HasSubstr;
 using ::testing::Return;
 using ::testing::StrictMock;
@@ -303,6 +309,107 @@ TEST(SessionPool, MaxSessionsBlockUntilRelease) {
   t.join();
 }
 
+TEST(SessionPool, AsyncAllocateWaitsForRelease) {
+  int const max_sessions_per_channel = 1;
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("project", "instance", "database");
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"s1"}))));
+
+  SessionPoolOptions options;
+  options.set_max_sessions_per_channel(max_sessions_per_channel)
+      .set_action_on_exhaustion(ActionOnExhaustion::kBlock);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, {mock}, options, threads.cq());
+  auto session = pool->Allocate();
+  ASSERT_STATUS_OK(session);
+
+  // The pool is at its limit, so the allocation waits for s1 to be released.
+  auto pending = pool->AsyncAllocate();
+  EXPECT_EQ(std::future_status::timeout,
+            pending.wait_for(std::chrono::milliseconds(0)));
+  session->reset();
+  auto async_session = pending.get();
+  ASSERT_STATUS_OK(async_session);
+  EXPECT_EQ((*async_session)->session_name(), "s1");
+
+  // With s1 idle again, the allocation is satisfied immediately.
+  async_session->reset();
+  pending = pool->AsyncAllocate();
+  EXPECT_EQ(std::future_status::ready,
+            pending.wait_for(std::chrono::milliseconds(0)));
+  async_session = pending.get();
+  ASSERT_STATUS_OK(async_session);
+  EXPECT_EQ((*async_session)->session_name(), "s1");
+}
+
+TEST(SessionPool, AsyncAllocateFailOnExhaustion) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("project", "instance", "database");
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"s1"}))));
+
+  SessionPoolOptions options;
+  options.set_max_sessions_per_channel(1).set_action_on_exhaustion(
+      ActionOnExhaustion::kFail);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, {mock}, options, threads.cq());
+  auto session = pool->Allocate();
+  ASSERT_STATUS_OK(session);
+  auto async_session = pool->AsyncAllocate().get();
+  EXPECT_EQ(async_session.status().code(), StatusCode::kResourceExhausted);
+}
+
+TEST(SessionPool, AsyncAllocateGrowsForEachWaiter) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  using Reader =
+      MockAsyncResponseReader<spanner_proto::BatchCreateSessionsResponse>;
+  std::vector<std::unique_ptr<Reader>> readers;
+  for (auto const* name : {"s1", "s2"}) {
+    readers.push_back(absl::make_unique<Reader>());
+    EXPECT_CALL(*readers.back(), Finish(_, _, _))
+        .WillOnce([name](spanner_proto::BatchCreateSessionsResponse* response,
+                         grpc::Status* status, void*) {
+          *response = MakeSessionsResponse({name});
+          *status = grpc::Status::OK;
+        });
+  }
+  auto next_reader = readers.begin();
+  EXPECT_CALL(*mock, AsyncBatchCreateSessions(_, SessionCountIs(1), _))
+      .Times(2)
+      .WillRepeatedly(
+          [&next_reader](grpc::ClientContext&,
+                         spanner_proto::BatchCreateSessionsRequest const&,
+                         grpc::CompletionQueue*) {
+            // This is safe. See comments in MockAsyncResponseReader.
+            return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+                spanner_proto::BatchCreateSessionsResponse>>(
+                (next_reader++)->get());
+          });
+
+  auto db = Database("project", "instance", "database");
+  SessionPoolOptions options;
+  options.set_min_sessions(0).set_max_sessions_per_channel(2);
+  auto impl = std::make_shared<MockCompletionQueue>();
+  auto pool = MakeSessionPool(db, {mock}, options, CompletionQueue(impl));
+
+  // The first caller starts creating a session, the second waits for it.
+  auto f1 = pool->AsyncAllocate();
+  auto f2 = pool->AsyncAllocate();
+  impl->SimulateCompletion(true);
+  auto s1 = f1.get();
+  ASSERT_STATUS_OK(s1);
+  EXPECT_EQ("s1", (*s1)->session_name());
+
+  // The pool grows again for the caller still waiting.
+  EXPECT_EQ(std::future_status::timeout,
+            f2.wait_for(std::chrono::milliseconds(0)));
+  impl->SimulateCompletion(true);
+  auto s2 = f2.get();
+  ASSERT_STATUS_OK(s2);
+  EXPECT_EQ("s2", (*s2)->session_name());
+}
+
 TEST(SessionPool, Labels) {
   auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
   auto db = Database("project", "instance", "database");
@@ -353,9 +460,11 @@ TEST(SessionPool, MultipleChannelsPreAllocation) {
   auto mock3 = std::make_shared<spanner_testing::MockSpannerStub>();
   auto db = Database("project", "instance", "database");
   EXPECT_CALL(*mock1, BatchCreateSessions(_, _))
-      .WillOnce(Return(ByMove(MakeSessionsResponse({"c1s1", "c1s2", "c1s3"}))));
+      .WillOnce(
+          Return(ByMove(MakeSessionsResponse({"c1s1", "c1s2", "c1s3"}))));
   EXPECT_CALL(*mock2, BatchCreateSessions(_, _))
-      .WillOnce(Return(ByMove(MakeSessionsResponse({"c2s1", "c2s2", "c2s3"}))));
+      .WillOnce(
+          Return(ByMove(MakeSessionsResponse({"c2s1", "c2s2", "c2s3"}))));
   EXPECT_CALL(*mock3, BatchCreateSessions(_, _))
       .WillOnce(Return(ByMove(MakeSessionsResponse({"c3s1", "c3s2", "c3s3"}))));
 
@@ -383,6 +492,183 @@ TEST(SessionPool, MultipleChannelsPreAllocation) {
   EXPECT_EQ(session.status().message(), "session pool exhausted");
 }
 
+TEST(SessionPool, MultipleChannelsKeepStubAffinity) {
+  auto mock1 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto mock2 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("project", "instance", "database");
+  EXPECT_CALL(*mock1, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"c1s1", "c1s2"}))));
+  EXPECT_CALL(*mock2, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"c2s1", "c2s2"}))));
+
+  SessionPoolOptions options;
+  options.set_min_sessions(4)
+      .set_max_sessions_per_channel(2)
+      .set_action_on_exhaustion(ActionOnExhaustion::kFail);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, {mock1, mock2}, options, threads.cq());
+
+  // Allocate and release all the sessions a few times, each session must be
+  // returned to (and used with) the channel that created it.
+  for (int iteration = 0; iteration != 3; ++iteration) {
+    std::vector<SessionHolder> sessions;
+    std::vector<std::string> session_names;
+    for (int i = 0; i != 4; ++i) {
+      auto session = pool->Allocate();
+      ASSERT_STATUS_OK(session);
+      auto const& name = (*session)->session_name();
+      session_names.push_back(name);
+      EXPECT_EQ(name.substr(0, 2) == "c1" ? mock1 : mock2,
+                pool->GetStub(**session));
+      sessions.push_back(*std::move(session));
+    }
+    EXPECT_THAT(session_names,
+                UnorderedElementsAre("c1s1", "c1s2", "c2s1", "c2s2"));
+    auto session = pool->Allocate();
+    EXPECT_EQ(session.status().code(), StatusCode::kResourceExhausted);
+  }
+}
+
+TEST(SessionPool, MultipleChannelsSkipBusyChannel) {
+  auto mock1 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto mock2 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("project", "instance", "database");
+  EXPECT_CALL(*mock1, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"c1s1", "c1s2", "c1s3"}))));
+  EXPECT_CALL(*mock2, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"c2s1", "c2s2", "c2s3"}))));
+
+  SessionPoolOptions options;
+  options.set_min_sessions(6).set_max_sessions_per_channel(3);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, {mock1, mock2}, options, threads.cq());
+
+  // The first two sessions come from the home shard of this thread, the third
+  // from the other channel, as the home channel is then clearly busier.
+  {
+    auto s1 = pool->Allocate();
+    ASSERT_STATUS_OK(s1);
+    auto s2 = pool->Allocate();
+    ASSERT_STATUS_OK(s2);
+    EXPECT_EQ(pool->GetStub(**s1), pool->GetStub(**s2));
+    auto s3 = pool->Allocate();
+    ASSERT_STATUS_OK(s3);
+    EXPECT_NE(pool->GetStub(**s1), pool->GetStub(**s3));
+
+    std::vector<int> active;
+    for (auto const& s : pool->GetChannelStats()) {
+      EXPECT_EQ(3, s.sessions);
+      active.push_back(s.active_sessions);
+    }
+    EXPECT_THAT(active, UnorderedElementsAre(2, 1));
+  }
+  for (auto const& s : pool->GetChannelStats()) {
+    EXPECT_EQ(3, s.sessions);
+    EXPECT_EQ(0, s.active_sessions);
+    EXPECT_EQ(3, s.idle_sessions);
+  }
+}
+
+TEST(SessionPool, MultipleChannelsSpreadConcurrentAllocations) {
+  int const channel_count = 2;
+  int const thread_count = 8;
+  auto db = Database("project", "instance", "database");
+  std::vector<std::shared_ptr<SpannerStub>> stubs;
+  for (int i = 0; i != channel_count; ++i) {
+    auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+    EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+        .WillOnce([i](grpc::ClientContext&,
+                      spanner_proto::BatchCreateSessionsRequest const& r) {
+          std::vector<std::string> names;
+          for (int j = 0; j != r.session_count(); ++j) {
+            names.push_back("c" + std::to_string(i) + "s" + std::to_string(j));
+          }
+          return MakeSessionsResponse(std::move(names));
+        });
+    stubs.push_back(std::move(mock));
+  }
+
+  SessionPoolOptions options;
+  options.set_min_sessions(channel_count * thread_count)
+      .set_max_sessions_per_channel(thread_count);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, stubs, options, threads.cq());
+
+  // Each thread holds its session until all of them have one.
+  std::mutex mu;
+  std::condition_variable cv;
+  int allocated = 0;
+  std::vector<SessionPool::ChannelStats> stats;
+  auto worker = [&] {
+    auto session = pool->Allocate();
+    EXPECT_STATUS_OK(session);
+    std::unique_lock<std::mutex> lk(mu);
+    if (++allocated == thread_count) {
+      stats = pool->GetChannelStats();
+      cv.notify_all();
+    }
+    cv.wait(lk, [&] { return allocated == thread_count; });
+  };
+  std::vector<std::thread> workers;
+  for (int i = 0; i != thread_count; ++i) workers.emplace_back(worker);
+  for (auto& t : workers) t.join();
+
+  // The threads have different home shards, and no channel is left idle.
+  ASSERT_EQ(channel_count, stats.size());
+  for (auto const& s : stats) {
+    EXPECT_GE(s.active_sessions, thread_count / channel_count - 1);
+  }
+}
+
+TEST(SessionPool, ConcurrentAllocateRelease) {
+  int const max_sessions_per_channel = 2;
+  int const channel_count = 3;
+  int const max_sessions = max_sessions_per_channel * channel_count;
+  auto db = Database("project", "instance", "database");
+  std::atomic<int> session_id(0);
+  std::vector<std::shared_ptr<SpannerStub>> stubs;
+  for (int i = 0; i != channel_count; ++i) {
+    auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+    EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+        .WillRepeatedly(
+            [&session_id](grpc::ClientContext&,
+                          spanner_proto::BatchCreateSessionsRequest const& r) {
+              std::vector<std::string> names;
+              for (int j = 0; j != r.session_count(); ++j) {
+                names.push_back("s" + std::to_string(++session_id));
+              }
+              return MakeSessionsResponse(std::move(names));
+            });
+    stubs.push_back(std::move(mock));
+  }
+
+  SessionPoolOptions options;
+  options.set_max_sessions_per_channel(max_sessions_per_channel)
+      .set_action_on_exhaustion(ActionOnExhaustion::kBlock);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, stubs, options, threads.cq());
+
+  std::atomic<int> in_use(0);
+  std::atomic<int> max_in_use(0);
+  auto worker = [&] {
+    for (int i = 0; i != 1000; ++i) {
+      auto session = pool->Allocate();
+      ASSERT_STATUS_OK(session);
+      auto const n = ++in_use;
+      for (auto m = max_in_use.load(); n > m;) {
+        if (max_in_use.compare_exchange_weak(m, n)) break;
+      }
+      --in_use;
+    }
+  };
+  std::vector<std::thread> workers;
+  for (int i = 0; i != 8; ++i) workers.emplace_back(worker);
+  for (auto& t : workers) t.join();
+
+  EXPECT_LE(max_in_use.load(), max_sessions);
+  EXPECT_LE(session_id.load(), max_sessions);
+}
+
 TEST(SessionPool, GetStubForStublessSession) {
   auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
   auto db = Database("project", "instance", "database");
@@ -429,6 +715,7 @@ TEST(SessionPool, SessionRefresh) {
   auto db = Database("project", "instance", "database");
   SessionPoolOptions options;
   options.set_keep_alive_interval(std::chrono::seconds(1));
+  options.set_max_idle_sessions(2);
   auto impl = std::make_shared<MockCompletionQueue>();
   auto clock = std::make_shared<FakeSteadyClock>();
   auto pool =
@@ -460,6 +747,223 @@ TEST(SessionPool, SessionRefresh) {
   impl->SimulateCompletion(true);
 }
 
+TEST(SessionPool, SessionRefreshRateLimited) {
+  auto mock = std::make_shared<StrictMock<spanner_testing::MockSpannerStub>>();
+  std::vector<std::string> names;
+  for (int i = 0; i != 12; ++i) names.push_back("s" + std::to_string(i));
+  EXPECT_CALL(*mock, BatchCreateSessions(_, SessionCountIs(12)))
+      .WillOnce(Return(ByMove(MakeSessionsResponse(names))));
+
+  auto reader = absl::make_unique<
+      StrictMock<MockAsyncResponseReader<spanner_proto::ResultSet>>>();
+  std::vector<std::string> refreshed;
+  EXPECT_CALL(*mock, AsyncExecuteSql(_, _, _))
+      .Times(12)
+      .WillRepeatedly([&reader, &refreshed](
+                          grpc::ClientContext&,
+                          spanner_proto::ExecuteSqlRequest const& request,
+                          grpc::CompletionQueue*) {
+        refreshed.push_back(request.session());
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<
+            grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>(
+            reader.get());
+      });
+  EXPECT_CALL(*reader, Finish(_, _, _))
+      .Times(12)
+      .WillRepeatedly([](spanner_proto::ResultSet*, grpc::Status* status,
+                         void*) { *status = grpc::Status::OK; });
+
+  auto db = Database("project", "instance", "database");
+  SessionPoolOptions options;
+  options.set_min_sessions(12);
+  options.set_keep_alive_interval(std::chrono::seconds(1));
+  auto impl = std::make_shared<MockCompletionQueue>();
+  auto clock = std::make_shared<FakeSteadyClock>();
+  auto pool =
+      MakeSessionPool(db, {mock}, options, CompletionQueue(impl), clock);
+  clock->AdvanceTime(options.keep_alive_interval() * 2);
+
+  // The first pass only refreshes some of the sessions on the channel.
+  impl->SimulateCompletion(true);
+  EXPECT_EQ(10, refreshed.size());
+
+  // The next pass refreshes the rest, but not the sessions just refreshed.
+  impl->SimulateCompletion(true);
+  EXPECT_EQ(12, refreshed.size());
+  std::sort(refreshed.begin(), refreshed.end());
+  std::sort(names.begin(), names.end());
+  EXPECT_EQ(names, refreshed);
+
+  // Complete the last refreshes, there is nothing else to refresh.
+  impl->SimulateCompletion(true);
+}
+
+TEST(SessionPool, IdleSessionsTrimmed) {
+  auto mock = std::make_shared<StrictMock<spanner_testing::MockSpannerStub>>();
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"s1"}))))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"s2"}))))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"s3"}))));
+
+  auto delete_reader = absl::make_unique<
+      StrictMock<MockAsyncResponseReader<google::protobuf::Empty>>>();
+  std::vector<std::string> deleted;
+  EXPECT_CALL(*mock, AsyncDeleteSession(_, _, _))
+      .Times(2)
+      .WillRepeatedly([&delete_reader, &deleted](
+                          grpc::ClientContext&,
+                          spanner_proto::DeleteSessionRequest const& request,
+                          grpc::CompletionQueue*) {
+        deleted.push_back(request.name());
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<
+            grpc::ClientAsyncResponseReaderInterface<google::protobuf::Empty>>(
+            delete_reader.get());
+      });
+  EXPECT_CALL(*delete_reader, Finish(_, _, _))
+      .Times(2)
+      .WillRepeatedly([](google::protobuf::Empty*, grpc::Status* status,
+                         void*) { *status = grpc::Status::OK; });
+
+  auto refresh_reader = absl::make_unique<
+      StrictMock<MockAsyncResponseReader<spanner_proto::ResultSet>>>();
+  EXPECT_CALL(*mock, AsyncExecuteSql(_, _, _))
+      .WillOnce([&refresh_reader](
+                    grpc::ClientContext&,
+                    spanner_proto::ExecuteSqlRequest const& request,
+                    grpc::CompletionQueue*) {
+        EXPECT_EQ("s1", request.session());
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<
+            grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>(
+            refresh_reader.get());
+      });
+  EXPECT_CALL(*refresh_reader, Finish(_, _, _))
+      .WillOnce([](spanner_proto::ResultSet*, grpc::Status* status, void*) {
+        *status = grpc::Status::OK;
+      });
+
+  auto db = Database("project", "instance", "database");
+  SessionPoolOptions options;
+  options.set_max_idle_sessions(1);
+  options.set_keep_alive_interval(std::chrono::seconds(1));
+  auto impl = std::make_shared<MockCompletionQueue>();
+  auto clock = std::make_shared<FakeSteadyClock>();
+  auto pool =
+      MakeSessionPool(db, {mock}, options, CompletionQueue(impl), clock);
+
+  {
+    // Release the sessions in the order "s3", "s2", "s1".
+    auto s1 = pool->Allocate();
+    ASSERT_STATUS_OK(s1);
+    auto s2 = pool->Allocate();
+    ASSERT_STATUS_OK(s2);
+    auto s3 = pool->Allocate();
+    ASSERT_STATUS_OK(s3);
+  }
+  clock->AdvanceTime(options.keep_alive_interval() * 2);
+
+  // The two least recently used sessions are deleted, "s1" is refreshed.
+  impl->SimulateCompletion(true);
+  EXPECT_THAT(deleted, ElementsAre("s3", "s2"));
+  impl->SimulateCompletion(true);
+
+  auto session = pool->Allocate();
+  ASSERT_STATUS_OK(session);
+  EXPECT_EQ("s1", (*session)->session_name());
+}
+
+// Sets expectations for a single `AsyncBeginTransaction()` call on the
+// session `session_name`, which returns the transaction `transaction_id`.
+void ExpectBeginTransaction(
+    spanner_testing::MockSpannerStub& mock,
+    MockAsyncResponseReader<spanner_proto::Transaction>& reader,
+    std::string session_name, std::string transaction_id) {
+  EXPECT_CALL(mock, AsyncBeginTransaction(_, _, _))
+      .WillOnce([&reader, session_name](
+                    grpc::ClientContext&,
+                    spanner_proto::BeginTransactionRequest const& request,
+                    grpc::CompletionQueue*) {
+        EXPECT_EQ(session_name, request.session());
+        EXPECT_TRUE(request.options().has_read_write());
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            spanner_proto::Transaction>>(&reader);
+      });
+  EXPECT_CALL(reader, Finish(_, _, _))
+      .WillOnce([transaction_id](spanner_proto::Transaction* transaction,
+                                 grpc::Status* status, void*) {
+        transaction->set_id(transaction_id);
+        *status = grpc::Status::OK;
+      });
+}
+
+TEST(SessionPool, WritePreparedSessions) {
+  auto mock = std::make_shared<StrictMock<spanner_testing::MockSpannerStub>>();
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"s1", "s2"}))));
+  auto reader = absl::make_unique<
+      StrictMock<MockAsyncResponseReader<spanner_proto::Transaction>>>();
+  ExpectBeginTransaction(*mock, *reader, "s1", "tx1");
+
+  auto db = Database("project", "instance", "database");
+  SessionPoolOptions options;
+  options.set_min_sessions(2);
+  options.set_write_sessions_fraction(0.5);
+  auto impl = std::make_shared<MockCompletionQueue>();
+  auto clock = std::make_shared<FakeSteadyClock>();
+  auto pool =
+      MakeSessionPool(db, {mock}, options, CompletionQueue(impl), clock);
+
+  // The first completion runs the background work, which begins a transaction
+  // on the least recently used session. The second completes that call.
+  impl->SimulateCompletion(true);
+  impl->SimulateCompletion(true);
+
+  {
+    // Read-only users get the sessions without a transaction.
+    auto session = pool->Allocate();
+    ASSERT_STATUS_OK(session);
+    EXPECT_EQ("s2", (*session)->session_name());
+    EXPECT_EQ("", (*session)->TakeWriteTransactionId());
+  }
+  {
+    auto session = pool->AllocateForWrite();
+    ASSERT_STATUS_OK(session);
+    EXPECT_EQ("s1", (*session)->session_name());
+    EXPECT_EQ("tx1", (*session)->TakeWriteTransactionId());
+    EXPECT_EQ("", (*session)->TakeWriteTransactionId());
+  }
+}
+
+TEST(SessionPool, WritePreparedSessionExpires) {
+  auto mock = std::make_shared<StrictMock<spanner_testing::MockSpannerStub>>();
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"s1"}))));
+  auto reader = absl::make_unique<
+      StrictMock<MockAsyncResponseReader<spanner_proto::Transaction>>>();
+  ExpectBeginTransaction(*mock, *reader, "s1", "tx1");
+
+  auto db = Database("project", "instance", "database");
+  SessionPoolOptions options;
+  options.set_min_sessions(1);
+  options.set_write_sessions_fraction(1.0);
+  auto impl = std::make_shared<MockCompletionQueue>();
+  auto clock = std::make_shared<FakeSteadyClock>();
+  auto pool =
+      MakeSessionPool(db, {mock}, options, CompletionQueue(impl), clock);
+  impl->SimulateCompletion(true);
+  impl->SimulateCompletion(true);
+
+  // Spanner may have aborted the transaction by now, so it is not used.
+  clock->AdvanceTime(std::chrono::seconds(10));
+  auto session = pool->AllocateForWrite();
+  ASSERT_STATUS_OK(session);
+  EXPECT_EQ("s1", (*session)->session_name());
+  EXPECT_EQ("", (*session)->TakeWriteTransactionId());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
@@ -80,15 +80,35 @@ class DefaultSpannerStub : public SpannerStub {
   StatusOr<spanner_proto::ExecuteBatchDmlResponse> ExecuteBatchDml(
       grpc::ClientContext& client_context,
       spanner_proto::ExecuteBatchDmlRequest const& request) override;
+  std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+      spanner_proto::ExecuteBatchDmlResponse>>
+  AsyncExecuteBatchDml(grpc::ClientContext& client_context,
+                       spanner_proto::ExecuteBatchDmlRequest const& request,
+                       grpc::CompletionQueue* cq) override;
   std::unique_ptr<grpc::ClientReaderInterface<spanner_proto::PartialResultSet>>
   StreamingRead(grpc::ClientContext& client_context,
                 spanner_proto::ReadRequest const& request) override;
+  std::unique_ptr<
+      grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>
+  AsyncRead(grpc::ClientContext& client_context,
+            spanner_proto::ReadRequest const& request,
+            grpc::CompletionQueue* cq) override;
   StatusOr<spanner_proto::Transaction> BeginTransaction(
       grpc::ClientContext& client_context,
       spanner_proto::BeginTransactionRequest const& request) override;
+  std::unique_ptr<
+      grpc::ClientAsyncResponseReaderInterface<spanner_proto::Transaction>>
+  AsyncBeginTransaction(grpc::ClientContext& client_context,
+                        spanner_proto::BeginTransactionRequest const& request,
+                        grpc::CompletionQueue* cq) override;
   StatusOr<spanner_proto::CommitResponse> Commit(
       grpc::ClientContext& client_context,
       spanner_proto::CommitRequest const& request) override;
+  std::unique_ptr<
+      grpc::ClientAsyncResponseReaderInterface<spanner_proto::CommitResponse>>
+  AsyncCommit(grpc::ClientContext& client_context,
+              spanner_proto::CommitRequest const& request,
+              grpc::CompletionQueue* cq) override;
   Status Rollback(grpc::ClientContext& client_context,
                   spanner_proto::RollbackRequest const& request) override;
   StatusOr<spanner_proto::PartitionResponse> PartitionQuery(
@@ -219,12 +239,29 @@ DefaultSpannerStub::ExecuteBatchDml(
   return response;
 }
 
+std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+    spanner_proto::ExecuteBatchDmlResponse>>
+DefaultSpannerStub::AsyncExecuteBatchDml(
+    grpc::ClientContext& client_context,
+    spanner_proto::ExecuteBatchDmlRequest const& request,
+    grpc::CompletionQueue* cq) {
+  return grpc_stub_->AsyncExecuteBatchDml(&client_context, request, cq);
+}
+
 std::unique_ptr<grpc::ClientReaderInterface<spanner_proto::PartialResultSet>>
 DefaultSpannerStub::StreamingRead(grpc::ClientContext& client_context,
                                   spanner_proto::ReadRequest const& request) {
   return grpc_stub_->StreamingRead(&client_context, request);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::ResultSet>>
+DefaultSpannerStub::AsyncRead(grpc::ClientContext& client_context,
+                              spanner_proto::ReadRequest const& request,
+                              grpc::CompletionQueue* cq) {
+  return grpc_stub_->AsyncRead(&client_context, request, cq);
+}
+
 StatusOr<spanner_proto::Transaction> DefaultSpannerStub::BeginTransaction(
     grpc::ClientContext& client_context,
     spanner_proto::BeginTransactionRequest const& request) {
@@ -237,6 +274,15 @@ StatusOr<spanner_proto::Transaction> DefaultSpannerStub::BeginTransaction(
   return response;
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::Transaction>>
+DefaultSpannerStub::AsyncBeginTransaction(
+    grpc::ClientContext& client_context,
+    spanner_proto::BeginTransactionRequest const& request,
+    grpc::CompletionQueue* cq) {
+  return grpc_stub_->AsyncBeginTransaction(&client_context, request, cq);
+}
+
 StatusOr<spanner_proto::CommitResponse> DefaultSpannerStub::Commit(
     grpc::ClientContext& client_context,
     spanner_proto::CommitRequest const& request) {
@@ -249,6 +295,14 @@ StatusOr<spanner_proto::CommitResponse> DefaultSpannerStub::Commit(
   return response;
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::CommitResponse>>
+DefaultSpannerStub::AsyncCommit(grpc::ClientContext& client_context,
+                                spanner_proto::CommitRequest const& request,
+                                grpc::CompletionQueue* cq) {
+  return grpc_stub_->AsyncCommit(&client_context, request, cq);
+}
+
 Status DefaultSpannerStub::Rollback(
     grpc::ClientContext& client_context,
     spanner_proto::RollbackRequest const& request) {
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/spanner/internal/status_utils.h"
+#include <google/rpc/error_details.pb.h>
 #include <string>
 
 namespace google {
@@ -27,6 +28,22 @@ bool IsSessionNotFound(google::cloud::Status const& status) {
          status.message().find("Session not found") != std::string::npos;
 }
 
+absl::optional<std::chrono::milliseconds> RetryDelayFromTrailers(
+    std::multimap<grpc::string_ref, grpc::string_ref> const& trailers) {
+  auto const it = trailers.find("google.rpc.retryinfo-bin");
+  if (it == trailers.end()) return {};
+  google::rpc::RetryInfo info;
+  if (!info.ParseFromArray(it->second.data(),
+                           static_cast<int>(it->second.size())) ||
+      !info.has_retry_delay()) {
+    return {};
+  }
+  auto const& d = info.retry_delay();
+  if (d.seconds() < 0 || d.nanos() < 0) return {};
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::seconds(d.seconds()) + std::chrono::nanoseconds(d.nanos()));
+}
+
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
@@ -17,6 +17,10 @@
 
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/status.h"
+#include "absl/types/optional.h"
+#include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <map>
 
 namespace google {
 namespace cloud {
@@ -27,6 +31,16 @@ namespace internal {
 /// Determine if `status` represents a "Session not found" error.
 bool IsSessionNotFound(google::cloud::Status const& status);
 
+/**
+ * Returns the retry delay the service suggests in the `google.rpc.RetryInfo`
+ * trailing metadata of a failed RPC, if any.
+ *
+ * Spanner includes this delay when it aborts a transaction, telling the client
+ * how long to wait before rerunning it.
+ */
+absl::optional<std::chrono::milliseconds> RetryDelayFromTrailers(
+    std::multimap<grpc::string_ref, grpc::string_ref> const& trailers);
+
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
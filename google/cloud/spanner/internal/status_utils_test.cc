@@ -13,7 +13,11 @@
 // limitations under the License.
 
 #include "google/cloud/spanner/internal/status_utils.h"
+#include <google/rpc/error_details.pb.h>
 #include <gmock/gmock.h>
+#include <chrono>
+#include <map>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -35,6 +39,36 @@ TEST(StatusUtils, SessionNotFound) {
   EXPECT_FALSE(internal::IsSessionNotFound(not_not_found));
 }
 
+TEST(StatusUtils, RetryDelayFromTrailers) {
+  google::rpc::RetryInfo info;
+  info.mutable_retry_delay()->set_seconds(1);
+  info.mutable_retry_delay()->set_nanos(250 * 1000 * 1000);
+  auto const serialized = info.SerializeAsString();
+
+  std::multimap<grpc::string_ref, grpc::string_ref> trailers;
+  EXPECT_FALSE(internal::RetryDelayFromTrailers(trailers).has_value());
+
+  trailers.emplace("some-other-key", "value");
+  EXPECT_FALSE(internal::RetryDelayFromTrailers(trailers).has_value());
+
+  trailers.emplace("google.rpc.retryinfo-bin", serialized);
+  auto delay = internal::RetryDelayFromTrailers(trailers);
+  ASSERT_TRUE(delay.has_value());
+  EXPECT_EQ(std::chrono::milliseconds(1250), *delay);
+}
+
+TEST(StatusUtils, RetryDelayFromTrailersInvalid) {
+  std::string const garbage = "\xff\xff\xff";
+  std::multimap<grpc::string_ref, grpc::string_ref> trailers;
+  trailers.emplace("google.rpc.retryinfo-bin", garbage);
+  EXPECT_FALSE(internal::RetryDelayFromTrailers(trailers).has_value());
+
+  std::string const empty = google::rpc::RetryInfo().SerializeAsString();
+  trailers.clear();
+  trailers.emplace("google.rpc.retryinfo-bin", empty);
+  EXPECT_FALSE(internal::RetryDelayFromTrailers(trailers).has_value());
+}
+
 }  // namespace
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
@@ -22,6 +22,29 @@ namespace internal {
 
 TransactionImpl::~TransactionImpl() = default;
 
+void TransactionImpl::EndPending(bool abandoned) {
+  bool done = false;
+  std::vector<promise<void>> waiters;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    done = !abandoned && !(selector_ && selector_->has_begin());
+    state_ = done ? State::kDone : State::kBegin;
+    if (done) {
+      begun_.store(selector_ && selector_->has_id(),
+                   std::memory_order_release);
+    }
+    waiters.swap(waiters_);
+  }
+  if (done) {
+    cond_.notify_all();
+  } else {
+    cond_.notify_one();
+  }
+  // Each asynchronous visitor tries again, and those that lose the race to
+  // the next "begin" visitor wait for it in turn.
+  for (auto& w : waiters) w.set_value();
+}
+
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
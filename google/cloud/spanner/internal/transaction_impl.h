@@ -17,14 +17,19 @@
 
 #include "google/cloud/spanner/internal/session.h"
 #include "google/cloud/spanner/version.h"
+#include "google/cloud/future.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/port_platform.h"
 #include "google/cloud/status_or.h"
 #include <google/spanner/v1/transaction.pb.h>
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -55,6 +60,7 @@ class TransactionImpl {
         selector_(std::move(selector)),
         seqno_(0) {
     state_ = selector_->has_begin() ? State::kBegin : State::kDone;
+    begun_.store(selector_->has_id(), std::memory_order_release);
   }
 
   ~TransactionImpl();
@@ -77,6 +83,9 @@ class TransactionImpl {
   // the error state in a manner appropriate for the operation.
   //
   // A monotonically-increasing sequence number is also passed to the functor.
+  //
+  // Once the transaction ID has been assigned concurrent visitors do not
+  // lock, only the visitors that race with the first one wait for it.
   template <typename Functor>
   VisitInvokeResult<Functor> Visit(Functor&& f) {
     static_assert(google::cloud::internal::is_invocable<
@@ -84,10 +93,12 @@ class TransactionImpl {
                       StatusOr<google::spanner::v1::TransactionSelector>&,
                       std::int64_t>::value,
                   "TransactionImpl::Visit() functor has incompatible type.");
-    std::int64_t seqno;
+    std::int64_t const seqno = ++seqno_;  // what about overflow?
+    if (begun_.load(std::memory_order_acquire)) {
+      return f(session_, selector_, seqno);
+    }
     {
       std::unique_lock<std::mutex> lock(mu_);
-      seqno = ++seqno_;  // what about overflow?
       cond_.wait(lock, [this] { return state_ != State::kPending; });
       if (state_ == State::kDone) {
         lock.unlock();
@@ -100,44 +111,107 @@ class TransactionImpl {
     try {
 #endif
       auto r = f(session_, selector_, seqno);
-      bool done = false;
-      {
-        std::lock_guard<std::mutex> lock(mu_);
-        state_ =
-            selector_ && selector_->has_begin() ? State::kBegin : State::kDone;
-        done = (state_ == State::kDone);
-      }
-      if (done) {
-        cond_.notify_all();
-      } else {
-        cond_.notify_one();
-      }
+      EndPending(/*abandoned=*/false);
       return r;
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
     } catch (...) {
-      {
-        std::lock_guard<std::mutex> lock(mu_);
-        state_ = State::kBegin;
-      }
-      cond_.notify_one();
+      EndPending(/*abandoned=*/true);
       throw;
     }
 #endif
   }
 
+  // Like `Visit()`, but the functor starts an asynchronous operation and
+  // returns a `future<>` for its result. If the visitor is beginning the
+  // transaction, other visitors wait until that future is satisfied, rather
+  // than until the functor returns.
+  //
+  // The visitors of `AsyncVisit()` never block. One that must wait is run by
+  // a continuation once the pending visitor finishes, possibly after this
+  // call returns, so the functor must own the state it uses.
+  //
+  // The caller must keep this object alive until the returned future is
+  // satisfied, see `internal::AsyncVisit()`.
+  template <typename Functor>
+  VisitInvokeResult<Functor> AsyncVisit(Functor&& f) {
+    static_assert(google::cloud::internal::is_invocable<
+                      Functor, SessionHolder&,
+                      StatusOr<google::spanner::v1::TransactionSelector>&,
+                      std::int64_t>::value,
+                  "TransactionImpl::AsyncVisit() functor has incompatible "
+                  "type.");
+    std::int64_t const seqno = ++seqno_;  // what about overflow?
+    return AsyncVisitImpl(std::forward<Functor>(f), seqno);
+  }
+
  private:
+  template <typename Functor>
+  VisitInvokeResult<Functor> AsyncVisitImpl(Functor&& f, std::int64_t seqno) {
+    using Result = VisitInvokeResult<Functor>;
+    if (begun_.load(std::memory_order_acquire)) {
+      return f(session_, selector_, seqno);
+    }
+    {
+      std::unique_lock<std::mutex> lock(mu_);
+      if (state_ == State::kPending) {
+        // Waiting here could block the thread that satisfies the pending
+        // visitor's future, so try again when it is done instead.
+        waiters_.emplace_back();
+        auto done = waiters_.back().get_future();
+        lock.unlock();
+        using Visitor = typename std::decay<Functor>::type;
+        Visitor visitor(std::forward<Functor>(f));
+        return done.then([this, visitor, seqno](future<void>) mutable {
+          return AsyncVisitImpl(std::move(visitor), seqno);
+        });
+      }
+      if (state_ == State::kDone) {
+        lock.unlock();
+        return f(session_, selector_, seqno);
+      }
+      state_ = State::kPending;
+    }
+    // selector_->has_begin(), but only one visitor active at a time.
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+#endif
+      return f(session_, selector_, seqno).then([this](Result r) {
+        EndPending(/*abandoned=*/false);
+        return r.get();
+      });
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    } catch (...) {
+      EndPending(/*abandoned=*/true);
+      throw;
+    }
+#endif
+  }
+
+  // Ends the `kPending` state, and wakes the visitors waiting for it. The
+  // transaction is begun unless the visitor left the selector in the "begin"
+  // state, or @p abandoned it by throwing.
+  void EndPending(bool abandoned);
+
   enum class State {
     kBegin,    // waiting for a future visitor to assign a transaction ID
     kPending,  // waiting for an active visitor to assign a transaction ID
     kDone,     // a transaction ID has been assigned (or we are single-use)
   };
-  State state_;
+  State state_;  // GUARDED_BY(mu_)
+  // Set, after `session_` and `selector_`, when `selector_` holds a
+  // transaction ID. Functors must not modify the selector once it is no
+  // longer "begin", and a begun transaction keeps the session that began it,
+  // so visitors that see this flag read both without `mu_`. The other `kDone`
+  // transactions do not take this path: the functors of single-use
+  // transactions still assign the session and may invalidate the selector.
+  std::atomic<bool> begun_{false};
 
   std::mutex mu_;
   std::condition_variable cond_;
+  std::vector<promise<void>> waiters_;  // GUARDED_BY(mu_)
   SessionHolder session_;
   StatusOr<google::spanner::v1::TransactionSelector> selector_;
-  std::int64_t seqno_;
+  std::atomic<std::int64_t> seqno_;
 };
 
 }  // namespace internal
@@ -15,9 +15,11 @@
 #include "google/cloud/spanner/internal/transaction_impl.h"
 #include "google/cloud/spanner/timestamp.h"
 #include "google/cloud/spanner/transaction.h"
+#include "google/cloud/future.h"
 #include "google/cloud/internal/port_platform.h"
 #include "absl/memory/memory.h"
 #include <gmock/gmock.h>
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <future>
@@ -250,6 +252,109 @@ TEST(InternalTransaction, ReadFailsAndTxnInvalidated) {
   EXPECT_EQ(128, MultiThreadedRead(128, &client, 1562361252, "sess2", "txn2"));
 }
 
+TEST(InternalTransaction, AsyncVisitBeginsTransaction) {
+  auto txn = MakeReadWriteTransaction();
+  google::cloud::promise<std::string> begun;
+  auto result = internal::AsyncVisit(
+      txn, [&begun](SessionHolder&, StatusOr<TransactionSelector>& selector,
+                    std::int64_t) {
+        EXPECT_TRUE(selector->has_begin());
+        return begun.get_future().then(
+            [&selector](google::cloud::future<std::string> f) {
+              selector->set_id(f.get());
+              return 42;
+            });
+      });
+
+  // Another visitor waits until the transaction ID is known.
+  auto visitor = std::async(std::launch::async, [txn] {
+    return internal::Visit(
+        txn, [](SessionHolder&, StatusOr<TransactionSelector>& selector,
+                std::int64_t) { return selector->id(); });
+  });
+  EXPECT_EQ(std::future_status::timeout,
+            visitor.wait_for(std::chrono::milliseconds(10)));
+
+  begun.set_value("txn0");
+  EXPECT_EQ(42, result.get());
+  EXPECT_EQ("txn0", visitor.get());
+}
+
+TEST(InternalTransaction, AsyncVisitFromContinuation) {
+  auto txn = MakeReadWriteTransaction();
+  google::cloud::promise<std::string> begun;
+  auto first = internal::AsyncVisit(
+      txn, [&begun](SessionHolder&, StatusOr<TransactionSelector>& selector,
+                    std::int64_t) {
+        EXPECT_TRUE(selector->has_begin());
+        return begun.get_future().then(
+            [&selector](google::cloud::future<std::string> f) {
+              selector->set_id(f.get());
+              return 42;
+            });
+      });
+
+  // Another visitor, started by a continuation on the thread that will also
+  // satisfy the first one (like a `CompletionQueue` thread), must not block
+  // that thread while it waits for the transaction ID.
+  google::cloud::promise<void> cq;
+  auto second = cq.get_future().then([txn](google::cloud::future<void>) {
+    return internal::AsyncVisit(
+        txn, [](SessionHolder&, StatusOr<TransactionSelector>& selector,
+                std::int64_t) {
+          return google::cloud::make_ready_future(selector->id());
+        });
+  });
+  cq.set_value();
+  EXPECT_FALSE(second.is_ready());
+
+  begun.set_value("txn0");
+  EXPECT_EQ(42, first.get());
+  EXPECT_EQ("txn0", second.get());
+}
+
+TEST(InternalTransaction, ConcurrentVisitsAfterBegin) {
+  auto txn = MakeReadWriteTransaction();
+  internal::Visit(txn, [](SessionHolder& session,
+                          StatusOr<TransactionSelector>& selector,
+                          std::int64_t) {
+    EXPECT_TRUE(selector->has_begin());
+    session = internal::MakeDissociatedSessionHolder("sess0");
+    selector->set_id("txn0");
+    return 0;
+  });
+
+  // The visitors of the begun transaction run concurrently, and each one sees
+  // the session and ID, and gets its own sequence number.
+  int const n_threads = 16;
+  int const n_visits = 1000;
+  std::mutex mu;
+  std::vector<std::int64_t> seqnos;
+  auto visit = [&] {
+    std::vector<std::int64_t> mine;
+    for (int i = 0; i != n_visits; ++i) {
+      internal::Visit(txn, [&mine](SessionHolder& session,
+                                   StatusOr<TransactionSelector>& selector,
+                                   std::int64_t seqno) {
+        EXPECT_EQ("sess0", session->session_name());
+        EXPECT_EQ("txn0", selector->id());
+        mine.push_back(seqno);
+        return 0;
+      });
+    }
+    std::lock_guard<std::mutex> lk(mu);
+    seqnos.insert(seqnos.end(), mine.begin(), mine.end());
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i != n_threads; ++i) threads.emplace_back(visit);
+  for (auto& t : threads) t.join();
+
+  std::sort(seqnos.begin(), seqnos.end());
+  ASSERT_EQ(n_threads * n_visits, seqnos.size());
+  EXPECT_EQ(seqnos.end(), std::adjacent_find(seqnos.begin(), seqnos.end()));
+  EXPECT_LT(1, seqnos.front());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
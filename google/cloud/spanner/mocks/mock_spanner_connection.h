@@ -21,6 +21,7 @@
 #include "google/cloud/spanner/row.h"
 #include "google/cloud/spanner/version.h"
 #include <gmock/gmock.h>
+#include <chrono>
 
 namespace google {
 namespace cloud {
@@ -57,6 +58,16 @@ class MockConnection : public spanner::Connection {
                StatusOr<spanner::BatchDmlResult>(ExecuteBatchDmlParams));
   MOCK_METHOD1(Commit, StatusOr<spanner::CommitResult>(CommitParams));
   MOCK_METHOD1(Rollback, Status(RollbackParams));
+  MOCK_METHOD1(AsyncRead, future<StatusOr<spanner::RowStream>>(ReadParams));
+  MOCK_METHOD1(AsyncExecuteQuery,
+               future<StatusOr<spanner::RowStream>>(SqlParams));
+  MOCK_METHOD1(AsyncExecuteDml,
+               future<StatusOr<spanner::DmlResult>>(SqlParams));
+  MOCK_METHOD1(AsyncExecuteBatchDml, future<StatusOr<spanner::BatchDmlResult>>(
+                                         ExecuteBatchDmlParams));
+  MOCK_METHOD1(AsyncCommit,
+               future<StatusOr<spanner::CommitResult>>(CommitParams));
+  MOCK_METHOD1(AsyncBackoff, future<Status>(std::chrono::milliseconds));
 };
 
 /**
@@ -71,6 +82,7 @@ class MockResultSetSource : public spanner::internal::ResultSourceInterface {
                absl::optional<google::spanner::v1::ResultSetMetadata>());
   MOCK_CONST_METHOD0(Stats,
                      absl::optional<google::spanner::v1::ResultSetStats>());
+  MOCK_METHOD0(TryCancel, void());
 };
 
 }  // namespace SPANNER_CLIENT_NS
@@ -30,6 +30,14 @@ void PrintTo(Mutation const& m, std::ostream* os) {
   *os << "Mutation={" << m.m_.DebugString() << "}";
 }
 
+namespace internal {
+
+google::spanner::v1::Mutation const& MutationProto(Mutation const& m) {
+  return m.m_;
+}
+
+}  // namespace internal
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
 }  // namespace cloud
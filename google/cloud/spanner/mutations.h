@@ -26,10 +26,13 @@ namespace cloud {
 namespace spanner {
 inline namespace SPANNER_CLIENT_NS {
 
+class Mutation;
+
 namespace internal {
 template <typename Op>
 class WriteMutationBuilder;
 class DeleteMutationBuilder;
+google::spanner::v1::Mutation const& MutationProto(Mutation const& m);
 }  // namespace internal
 
 /**
@@ -84,6 +87,8 @@ class Mutation {
   template <typename Op>
   friend class internal::WriteMutationBuilder;
   friend class internal::DeleteMutationBuilder;
+  friend google::spanner::v1::Mutation const& internal::MutationProto(
+      Mutation const&);
   explicit Mutation(google::spanner::v1::Mutation m) : m_(std::move(m)) {}
 
   google::spanner::v1::Mutation m_;
@@ -14,12 +14,9 @@
 
 #include "google/cloud/spanner/numeric.h"
 #include "google/cloud/status.h"
-#include "absl/strings/string_view.h"
 #include <algorithm>
-#include <cerrno>
 #include <cmath>
-#include <cstddef>
-#include <deque>
+#include <cstdlib>
 #include <iomanip>
 #include <limits>
 #include <locale>
@@ -33,13 +30,14 @@ inline namespace SPANNER_CLIENT_NS {
 
 namespace {
 
-inline bool IsDigit(char ch) {
-  return std::isdigit(static_cast<unsigned char>(ch)) != 0;
-}
+// The largest number of decimal digits in the scaled value of a `Numeric`.
+constexpr std::size_t kMaxDigits = Numeric::kIntPrec + Numeric::kFracPrec;
 
-inline bool IsSpace(char ch) {
-  return std::isspace(static_cast<unsigned char>(ch)) != 0;
-}
+// 10^kScaleExponent, the scale of the `Numeric` representation.
+constexpr std::int64_t kScaleExponent = Numeric::kFracPrec;
+constexpr std::uint64_t kScale = 1000000000;
+
+inline bool IsDigit(char ch) { return ch >= '0' && ch <= '9'; }
 
 Status InvalidArgument(std::string message) {
   return Status(StatusCode::kInvalidArgument, std::move(message));
@@ -49,57 +47,151 @@ Status OutOfRange(std::string message) {
   return Status(StatusCode::kOutOfRange, std::move(message));
 }
 
-// Do the pieces form a canonical, in-range value, with no rounding required?
-bool IsCanonical(absl::string_view sign_part, absl::string_view int_part,
-                 absl::string_view frac_part) {
-  if (int_part.empty()) return false;
-  if (int_part.size() > Numeric::kIntPrec) return false;
-  if (frac_part.size() > 1 + Numeric::kFracPrec) return false;
-  if (int_part.size() == 1 && int_part.front() == '0') {
-    if (frac_part.empty()) {  // Should match "0".
-      if (!sign_part.empty()) return false;
-    } else {  // Should match "-?0.[0-9]*[1-9]".
-      if (!sign_part.empty() && sign_part.front() == '+') return false;
-      if (frac_part.size() == 1 || frac_part.back() == '0') return false;
-    }
-  } else {  // Should match "-?[1-9][0-9]*(.[0-9]*[1-9])?".
-    if (!sign_part.empty() && sign_part.front() == '+') return false;
-    if (int_part.front() == '0') return false;
-    if (frac_part.size() == 1) return false;
-    if (!frac_part.empty() && frac_part.back() == '0') return false;
+// The number of decimal digits that always fit in a `std::uint64_t`.
+constexpr std::size_t kChunkDigits = 19;
+
+constexpr std::uint64_t kPowersOf10[kChunkDigits + 1] = {
+    1ULL,
+    10ULL,
+    100ULL,
+    1000ULL,
+    10000ULL,
+    100000ULL,
+    1000000ULL,
+    10000000ULL,
+    100000000ULL,
+    1000000000ULL,
+    10000000000ULL,
+    100000000000ULL,
+    1000000000000ULL,
+    10000000000000ULL,
+    100000000000000ULL,
+    1000000000000000ULL,
+    10000000000000000ULL,
+    100000000000000000ULL,
+    1000000000000000000ULL,
+    10000000000000000000ULL,
+};
+
+// Returns 10^n, for n <= kMaxDigits.
+absl::uint128 Pow10(std::size_t n) {
+  if (n <= kChunkDigits) return kPowersOf10[n];
+  return absl::uint128(kPowersOf10[kChunkDigits]) *
+         kPowersOf10[n - kChunkDigits];
+}
+
+// The magnitude of the largest scaled value, 10^kMaxDigits - 1.
+constexpr absl::uint128 kMaxMagnitude =
+    absl::MakeUint128(5421010862427522170ULL, 687399551400673279ULL);
+
+absl::uint128 Magnitude(absl::int128 value) {
+  // Negating the most-negative value would overflow, but such values are
+  // rejected before they get here.
+  return value < 0 ? absl::uint128(-value) : absl::uint128(value);
+}
+
+absl::int128 ApplySign(bool negative, absl::uint128 magnitude) {
+  auto const value = absl::int128(magnitude);
+  return negative ? -value : value;
+}
+
+// Multiplies `magnitude` by 10^`exponent`, rounding to an integer with
+// halfway cases rounding away from zero. Returns false if the result would
+// be larger than `kMaxMagnitude`.
+bool Scale(absl::uint128& magnitude, std::int64_t exponent) {
+  if (magnitude == 0) return true;
+  if (exponent >= 0) {
+    if (exponent > static_cast<std::int64_t>(kMaxDigits)) return false;
+    auto const p = Pow10(static_cast<std::size_t>(exponent));
+    if (magnitude > kMaxMagnitude / p) return false;
+    magnitude *= p;
+    return true;
+  }
+  // The largest `absl::uint128` is less than 0.5 * 10^(kMaxDigits + 1).
+  if (-exponent > static_cast<std::int64_t>(kMaxDigits)) {
+    magnitude = 0;
+    return true;
   }
-  return true;
+  auto const p = Pow10(static_cast<std::size_t>(-exponent));
+  auto const r = magnitude % p;
+  magnitude /= p;
+  if (r >= p - r) ++magnitude;
+  return magnitude <= kMaxMagnitude;
 }
 
-// Round the value to `prec` digits after the decimal point, with halfway
-// cases rounding away from zero.
-void Round(std::deque<char>& int_rep, std::deque<char>& frac_rep,
-           std::size_t prec) {
-  static constexpr auto kDigits = "0123456789";
-
-  auto it = frac_rep.begin() + (std::min)(prec, frac_rep.size());
-  if (frac_rep.size() <= prec || std::strchr(kDigits, *it) - kDigits < 5) {
-    // Round towards zero.
-    while (it != frac_rep.begin() && *(it - 1) == '0') --it;
-    frac_rep.erase(it, frac_rep.end());
-    return;
+// Accumulates up to `kMaxDigits` decimal digits, using 64-bit arithmetic for
+// all but one multiplication per `kChunkDigits` digits.
+class DigitAccumulator {
+ public:
+  void Add(char ch) {
+    chunk_ = chunk_ * 10 + static_cast<std::uint64_t>(ch - '0');
+    if (++chunk_digits_ == kChunkDigits) Flush();
   }
 
-  // Round away from zero (requires add and carry).
-  while (it != frac_rep.begin()) {
-    if (*--it != '9') {
-      *it = *(std::strchr(kDigits, *it) + 1);
-      frac_rep.erase(++it, frac_rep.end());
-      return;
-    }
+  absl::uint128 Value() {
+    Flush();
+    return value_;
   }
 
-  // Carry into the integer part.
-  frac_rep.clear();
-  int_rep.push_front('0');
-  it = int_rep.end();
-  while (*--it == '9') *it = '0';
-  *it = *(std::strchr(kDigits, *it) + 1);
+ private:
+  void Flush() {
+    value_ = value_ * kPowersOf10[chunk_digits_] + chunk_;
+    chunk_ = 0;
+    chunk_digits_ = 0;
+  }
+
+  absl::uint128 value_ = 0;
+  std::uint64_t chunk_ = 0;
+  std::size_t chunk_digits_ = 0;
+};
+
+// Divides `v` by `kScale`, returning the remainder. As `kScale` is less than
+// 2^32 this only needs 64-bit divisions by a constant, unlike the general
+// 128-bit division.
+std::uint64_t DivModScale(absl::uint128& v) {
+  auto const hi = absl::Uint128High64(v);
+  auto const lo = absl::Uint128Low64(v);
+  if (hi == 0) {
+    v = lo / kScale;
+    return lo % kScale;
+  }
+  std::uint64_t const limbs[] = {hi >> 32, hi & 0xFFFFFFFF, lo >> 32,
+                                 lo & 0xFFFFFFFF};
+  std::uint64_t q[4];
+  std::uint64_t r = 0;
+  for (int i = 0; i != 4; ++i) {
+    auto const n = (r << 32) | limbs[i];
+    q[i] = n / kScale;
+    r = n % kScale;
+  }
+  v = absl::MakeUint128((q[0] << 32) | q[1], (q[2] << 32) | q[3]);
+  return r;
+}
+
+// Converts `v` to the nearest double. The `absl::uint128` conversion converts
+// the two halves separately, and then rounds again when adding them.
+double Uint128ToDouble(absl::uint128 v) {
+  auto const hi = absl::Uint128High64(v);
+  if (hi == 0) return static_cast<double>(absl::Uint128Low64(v));
+  // Keep the 64 most significant bits, and fold the others into the lowest
+  // of them, so that converting those rounds as converting `v` would.
+  int shift = 0;
+  for (auto h = hi; h != 0; h >>= 1) ++shift;
+  auto bits = absl::Uint128Low64(v >> shift);
+  if ((v & ((absl::uint128(1) << shift) - 1)) != 0) bits |= 1;
+  return std::ldexp(static_cast<double>(bits), shift);
+}
+
+// Writes the decimal digits of `v`, zero padded to `width`, so that they end
+// just before `p`. Returns a pointer to the first digit.
+char* FormatDigits(std::uint64_t v, char* p, std::size_t width) {
+  char* const end = p;
+  do {
+    *--p = static_cast<char>('0' + v % 10);
+    v /= 10;
+  } while (v != 0);
+  while (static_cast<std::size_t>(end - p) < width) *--p = '0';
+  return p;
 }
 
 }  // namespace
@@ -122,112 +214,156 @@ Status DataLoss(std::string message) {
   return Status(StatusCode::kDataLoss, std::move(message));
 }
 
+Numeric NumericFromScaledValue(absl::int128 value) { return Numeric(value); }
+
+absl::int128 NumericScaledValue(Numeric const& n) { return n.rep_; }
+
 // Succeeds if `s` matches either of these regular expressions ...
 //
 //   [-+]?[0-9]+(.[0-9]*)?([eE][-+]?[0-9]+)?
 //   [-+]?.[0-9]+([eE][-+]?[0-9]+)?
 //
-// and the value is within the allowed range, producing a representation
-// that matches one of these regular expressions ...
+// and the value is within the allowed range after the fractional part has
+// been rounded to `kFracPrec` decimal places.
 //
-//   0                                      // value == 0
-//   -?0.[0-9]{0,8}[1-9]                    // 0 < abs(value) < 1
-//   -?[1-9][0-9]{0,28}(.[0-9]{0,8}[1-9])?  // abs(value) >= 1
-//
-// where the fractional part has been rounded to `kFracPrec` decimal places.
-StatusOr<Numeric> MakeNumeric(std::string s) {
-  char const* p = s.c_str();
+// The digits are accumulated directly into the scaled 128-bit value, so the
+// usual, canonical inputs are converted without any allocations.
+StatusOr<Numeric> ParseNumeric(absl::string_view s) {
+  char const* p = s.data();
   char const* e = p + s.size();
 
   // Consume any sign part.
-  auto sign_part = absl::string_view(p, 0);
-  if (p != e && (*p == '+' || *p == '-')) {
-    sign_part = absl::string_view(p++, 1);
-  }
+  bool negative = false;
+  if (p != e && (*p == '+' || *p == '-')) negative = *p++ == '-';
 
-  // Consume any integral part.
+  // Consume any integral and fractional parts (the latter without the decimal
+  // point), accumulating their digits on the way. Any excess digits wrap the
+  // accumulator, but then the value is recomputed below.
+  DigitAccumulator acc;
   char const* ip = p;
-  for (; p != e && IsDigit(*p); ++p) continue;
+  for (; p != e && IsDigit(*p); ++p) acc.Add(*p);
   auto int_part = absl::string_view(ip, p - ip);
-
-  // Consume any fractional part.
   auto frac_part = absl::string_view(p, 0);
   if (p != e && *p == '.') {
-    char const* fp = p++;
-    for (; p != e && IsDigit(*p); ++p) continue;
+    char const* fp = ++p;
+    for (; p != e && IsDigit(*p); ++p) acc.Add(*p);
     frac_part = absl::string_view(fp, p - fp);
   }
 
-  // This is the expected case, and avoids any allocations.
-  if (p == e && IsCanonical(sign_part, int_part, frac_part)) {
-    return Numeric(std::move(s));
+  // This is the expected case, which needs no rounding or range checks, so
+  // the accumulated digits are the (unscaled) value.
+  if (p == e && int_part.size() <= Numeric::kIntPrec &&
+      frac_part.size() <= Numeric::kFracPrec &&
+      (!int_part.empty() || !frac_part.empty())) {
+    auto const scale = kPowersOf10[Numeric::kFracPrec - frac_part.size()];
+    return NumericFromScaledValue(ApplySign(negative, acc.Value() * scale));
   }
 
   // Consume any exponent part.
-  long exponent = 0;  // NOLINT(google-runtime-int)
+  std::int64_t exponent = 0;
   if (p != e && (*p == 'e' || *p == 'E')) {
-    if (p + 1 != e && !IsSpace(*(p + 1))) {
-      errno = 0;
-      char* ep = nullptr;
-      exponent = std::strtol(p + 1, &ep, 10);
-      if (ep != p + 1) {
-        if (errno != 0) return OutOfRange(std::move(s));
-        p = ep;
+    char const* ep = p + 1;
+    bool negative_exponent = false;
+    if (ep != e && (*ep == '+' || *ep == '-')) {
+      negative_exponent = *ep++ == '-';
+    }
+    if (ep != e && IsDigit(*ep)) {
+      constexpr auto kMax = (std::numeric_limits<std::int64_t>::max)();
+      for (; ep != e && IsDigit(*ep); ++ep) {
+        auto const d = *ep - '0';
+        if (exponent > (kMax - d) / 10) return OutOfRange(std::string(s));
+        exponent = exponent * 10 + d;
       }
+      if (negative_exponent) exponent = -exponent;
+      p = ep;
     }
   }
 
   // That must have consumed everything.
-  if (p != e) return InvalidArgument(std::move(s));
+  if (p != e) return InvalidArgument(std::string(s));
 
   // There must be at least one digit.
-  if (int_part.empty() && frac_part.size() <= 1) {
-    return InvalidArgument(std::move(s));
+  if (int_part.empty() && frac_part.empty()) {
+    return InvalidArgument(std::string(s));
   }
 
-  auto int_rep = std::deque<char>(int_part.begin(), int_part.end());
-  auto frac_rep = std::deque<char>(frac_part.begin(), frac_part.end());
-  if (!frac_rep.empty()) frac_rep.pop_front();  // remove the decimal point
+  // The digits of "int_part.frac_part", multiplied by 10^shift, give the
+  // value in units of 10^-kFracPrec.
+  auto const max_shift = static_cast<std::int64_t>(s.size() + kMaxDigits);
+  exponent = (std::max)(-max_shift, (std::min)(exponent, max_shift));
+  auto const shift = exponent + kScaleExponent -
+                     static_cast<std::int64_t>(frac_part.size());
 
-  // Symbolically multiply "int_rep.frac_rep" by 10^exponent.
-  if (exponent >= 0) {
-    auto shift = std::min<std::size_t>(exponent, frac_rep.size());
-    int_rep.insert(int_rep.end(), frac_rep.begin(), frac_rep.begin() + shift);
-    int_rep.insert(int_rep.end(), exponent - shift, '0');
-    frac_rep.erase(frac_rep.begin(), frac_rep.begin() + shift);
-  } else {
-    auto shift = std::min<std::size_t>(-exponent, int_rep.size());
-    frac_rep.insert(frac_rep.begin(), int_rep.end() - shift, int_rep.end());
-    frac_rep.insert(frac_rep.begin(), -exponent - shift, '0');
-    int_rep.erase(int_rep.end() - shift, int_rep.end());
+  // Drop any leading zeros.
+  while (!int_part.empty() && int_part.front() == '0') {
+    int_part.remove_prefix(1);
+  }
+  if (int_part.empty()) {
+    while (!frac_part.empty() && frac_part.front() == '0') {
+      frac_part.remove_prefix(1);
+    }
+  }
+  auto const digits =
+      static_cast<std::int64_t>(int_part.size() + frac_part.size());
+  auto digit = [&int_part, &frac_part](std::size_t i) {
+    return i < int_part.size() ? int_part[i] : frac_part[i - int_part.size()];
+  };
+
+  // The number of digits that remain before the (scaled) decimal point.
+  auto const keep = digits + shift;
+  absl::uint128 magnitude = 0;
+  if (digits != 0 && keep > 0) {
+    if (keep > static_cast<std::int64_t>(kMaxDigits)) {
+      return OutOfRange(std::string(s));
+    }
+    auto const n = static_cast<std::size_t>((std::min)(keep, digits));
+    DigitAccumulator keep_acc;
+    for (std::size_t i = 0; i != n; ++i) keep_acc.Add(digit(i));
+    magnitude = keep_acc.Value();
+    if (keep > digits) {
+      magnitude *= Pow10(static_cast<std::size_t>(keep - digits));
+    } else if (keep < digits && digit(n) >= '5') {
+      ++magnitude;  // round away from zero
+    }
+    if (magnitude > kMaxMagnitude) return OutOfRange(std::string(s));
+  } else if (digits != 0 && keep == 0 && digit(0) >= '5') {
+    magnitude = 1;
+  }
+  return NumericFromScaledValue(ApplySign(negative, magnitude));
+}
+
+StatusOr<Numeric> MakeNumeric(std::string s) { return ParseNumeric(s); }
+
+StatusOr<Numeric> MakeNumeric(absl::int128 i, int exponent) {
+  // Avoid negating the most-negative value, which cannot be in range.
+  auto const negative = i < 0;
+  auto magnitude = negative ? absl::uint128(-(i + 1)) + 1 : absl::uint128(i);
+  if (!Scale(magnitude, exponent + kScaleExponent)) {
+    auto message = ToString(i);
+    if (exponent != 0) message += 'e' + std::to_string(exponent);
+    return OutOfRange(std::move(message));
   }
+  return NumericFromScaledValue(ApplySign(negative, magnitude));
+}
 
-  // Round/canonicalize the fractional part.
-  Round(int_rep, frac_rep, Numeric::kFracPrec);
-
-  // Canonicalize and range check the integer part.
-  while (!int_rep.empty() && int_rep.front() == '0') int_rep.pop_front();
-  if (int_rep.size() > Numeric::kIntPrec) return OutOfRange(std::move(s));
-
-  // Add any sign and decimal point.
-  bool empty = int_rep.empty() && frac_rep.empty();
-  bool negate = !empty && !sign_part.empty() && sign_part.front() == '-';
-  if (int_rep.empty()) int_rep.push_front('0');
-  if (negate) int_rep.push_front('-');
-  if (!frac_rep.empty()) frac_rep.push_front('.');
-
-  // Construct the final value using the canonical representation.
-  std::string rep;
-  rep.reserve(int_rep.size() + frac_rep.size());
-  rep.append(int_rep.begin(), int_rep.end());
-  rep.append(frac_rep.begin(), frac_rep.end());
-  return Numeric(std::move(rep));
+StatusOr<Numeric> MakeNumeric(absl::uint128 u, int exponent) {
+  auto magnitude = u;
+  if (!Scale(magnitude, exponent + kScaleExponent)) {
+    auto message = ToString(u);
+    if (exponent != 0) message += 'e' + std::to_string(exponent);
+    return OutOfRange(std::move(message));
+  }
+  return NumericFromScaledValue(ApplySign(false, magnitude));
 }
 
-// Like `MakeNumeric(s)`, but with an out-of-band exponent.
-StatusOr<Numeric> MakeNumeric(std::string s, int exponent) {
-  if (exponent != 0) s += 'e' + std::to_string(exponent);
-  return MakeNumeric(std::move(s));
+StatusOr<Numeric> ScaleNumeric(Numeric const& n, int exponent) {
+  if (exponent == 0) return n;
+  auto const value = NumericScaledValue(n);
+  auto magnitude = Magnitude(value);
+  if (!Scale(magnitude, exponent)) {
+    return OutOfRange(n.ToString() + 'e' + std::to_string(exponent));
+  }
+  return NumericFromScaledValue(ApplySign(value < 0, magnitude));
 }
 
 }  // namespace internal
@@ -235,10 +371,45 @@ StatusOr<Numeric> MakeNumeric(std::string s, int exponent) {
 constexpr std::size_t Numeric::kIntPrec;
 constexpr std::size_t Numeric::kFracPrec;
 
-Numeric::Numeric() : rep_("0") {}
+Numeric::Numeric() : rep_(0) {}
+
+std::string Numeric::ToString() const {
+  // Room for a sign, the integer digits, a decimal point, and the fraction.
+  char buf[1 + kIntPrec + 1 + kFracPrec];
+  char* const end = buf + sizeof(buf);
+  char* p = end;
+
+  auto magnitude = Magnitude(rep_);
+  auto frac = DivModScale(magnitude);
+  if (frac != 0) {
+    auto width = kFracPrec;
+    for (; frac % 10 == 0; frac /= 10) --width;
+    p = FormatDigits(frac, p, width);
+    *--p = '.';
+  }
+
+  // The integer part has at most kIntPrec digits, which are formatted in
+  // groups of kFracPrec digits.
+  auto const low = DivModScale(magnitude);
+  auto const mid = DivModScale(magnitude);
+  auto const high = absl::Uint128Low64(magnitude);
+  if (high != 0) {
+    p = FormatDigits(low, p, kFracPrec);
+    p = FormatDigits(mid, p, kFracPrec);
+    p = FormatDigits(high, p, 1);
+  } else if (mid != 0) {
+    p = FormatDigits(low, p, kFracPrec);
+    p = FormatDigits(mid, p, 1);
+  } else {
+    p = FormatDigits(low, p, 1);
+  }
+
+  if (rep_ < 0) *--p = '-';
+  return std::string(p, end);
+}
 
 StatusOr<Numeric> MakeNumeric(std::string s) {
-  return internal::MakeNumeric(std::move(s));
+  return internal::ParseNumeric(s);
 }
 
 StatusOr<Numeric> MakeNumeric(double d) {
@@ -247,7 +418,27 @@ StatusOr<Numeric> MakeNumeric(double d) {
   ss << std::setprecision(std::numeric_limits<double>::digits10 + 1) << d;
   std::string s = std::move(ss).str();
   if (!std::isfinite(d)) return OutOfRange(std::move(s));
-  return internal::MakeNumeric(std::move(s));
+  return internal::ParseNumeric(s);
+}
+
+double ToDouble(Numeric const& n) {
+  auto const value = internal::NumericScaledValue(n);
+  auto integral = Magnitude(value);
+  auto const frac = DivModScale(integral);
+  // Integral values need only a single, correctly rounded, conversion.
+  if (frac == 0) {
+    auto const d = Uint128ToDouble(integral);
+    return value < 0 ? -d : d;
+  }
+  // As do values with an exactly representable scaled value, as the division
+  // is correctly rounded too.
+  constexpr auto kExact = std::uint64_t{1}
+                          << std::numeric_limits<double>::digits;
+  if (Magnitude(value) <= kExact) {
+    return static_cast<double>(value) / static_cast<double>(kScale);
+  }
+  // Otherwise leave the rounding to the library.
+  return std::atof(n.ToString().c_str());
 }
 
 }  // namespace SPANNER_CLIENT_NS
@@ -19,8 +19,9 @@
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include "absl/numeric/int128.h"
-#include <cstdlib>
-#include <cstring>
+#include "absl/strings/string_view.h"
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <ostream>
 #include <string>
@@ -36,7 +37,8 @@ class Numeric;  // defined below
 
 // Internal forward declarations to befriend.
 namespace internal {
-StatusOr<Numeric> MakeNumeric(std::string s);
+Numeric NumericFromScaledValue(absl::int128 value);
+absl::int128 NumericScaledValue(Numeric const& n);
 }  // namespace internal
 
 /**
@@ -94,10 +96,7 @@ class Numeric {
    *
    * Note: The string never includes an exponent field.
    */
-  ///@{
-  std::string const& ToString() const& { return rep_; }
-  std::string&& ToString() && { return std::move(rep_); }
-  ///@}
+  std::string ToString() const;
 
   /// Relational operators
   ///@{
@@ -115,9 +114,10 @@ class Numeric {
   }
 
  private:
-  friend StatusOr<Numeric> internal::MakeNumeric(std::string s);
-  explicit Numeric(std::string rep) : rep_(std::move(rep)) {}
-  std::string rep_;  // a valid and canonical NUMERIC representation
+  friend Numeric internal::NumericFromScaledValue(absl::int128 value);
+  friend absl::int128 internal::NumericScaledValue(Numeric const& n);
+  explicit Numeric(absl::int128 rep) : rep_(rep) {}
+  absl::int128 rep_;  // the value scaled by 10^kFracPrec
 };
 
 namespace internal {
@@ -132,7 +132,27 @@ std::string ToString(absl::uint128 value);
 
 // Forward declarations.
 Status DataLoss(std::string message);
-StatusOr<Numeric> MakeNumeric(std::string s, int exponent);
+StatusOr<Numeric> MakeNumeric(std::string s);
+StatusOr<Numeric> MakeNumeric(absl::int128 i, int exponent);
+StatusOr<Numeric> MakeNumeric(absl::uint128 u, int exponent);
+
+// Like `MakeNumeric(std::string)`, but parses a view of the characters, such
+// as the NUMERIC string in a `google::protobuf::Value`, without copying them.
+StatusOr<Numeric> ParseNumeric(absl::string_view s);
+
+// Returns `n` scaled by 10^`exponent`, rounded to `kFracPrec` decimal places.
+StatusOr<Numeric> ScaleNumeric(Numeric const& n, int exponent);
+
+// Returns the integer nearest to `value` / 10^`kFracPrec`, with halfway cases
+// rounding away from zero.
+inline absl::int128 RoundScaledValue(absl::int128 value) {
+  constexpr std::int64_t kScale = 1000000000;  // 10^Numeric::kFracPrec
+  auto q = value / kScale;
+  auto const r = value % kScale;
+  if (r >= kScale / 2) ++q;
+  if (r <= -kScale / 2) --q;
+  return q;
+}
 
 }  // namespace internal
 
@@ -167,11 +187,23 @@ StatusOr<Numeric> MakeNumeric(double d);
  *
  * Fails on any (scaled) argument outside the NUMERIC value range.
  */
-template <typename T, typename std::enable_if<
-                          std::numeric_limits<T>::is_integer, int>::type = 0>
+///@{
+template <typename T,
+          typename std::enable_if<std::numeric_limits<T>::is_integer &&
+                                      !std::numeric_limits<T>::is_signed,
+                                  int>::type = 0>
+StatusOr<Numeric> MakeNumeric(T i, int exponent = 0) {
+  return internal::MakeNumeric(absl::uint128(i), exponent);
+}
+
+template <typename T,
+          typename std::enable_if<std::numeric_limits<T>::is_integer &&
+                                      std::numeric_limits<T>::is_signed,
+                                  int>::type = 0>
 StatusOr<Numeric> MakeNumeric(T i, int exponent = 0) {
-  return internal::MakeNumeric(internal::ToString(i), exponent);
+  return internal::MakeNumeric(absl::int128(i), exponent);
 }
+///@}
 
 /**
  * Conversion to the closest double value, with possible loss of precision.
@@ -179,9 +211,7 @@ StatusOr<Numeric> MakeNumeric(T i, int exponent = 0) {
  * Always succeeds (i.e., can never overflow, assuming a double can hold
  * values up to 10^(kIntPrec+1)).
  */
-inline double ToDouble(Numeric const& n) {
-  return std::atof(n.ToString().c_str());
-}
+double ToDouble(Numeric const& n);
 
 /**
  * Conversion to the nearest integer value, scaled by 10^`exponent`.
@@ -204,36 +234,15 @@ template <typename T,
                                       !std::numeric_limits<T>::is_signed,
                                   int>::type = 0>
 StatusOr<T> ToInteger(Numeric const& n, int exponent = 0) {
-  std::string const& rep = n.ToString();
-  if (exponent != 0) {
-    auto const en = internal::MakeNumeric(rep, exponent);
-    return en ? ToInteger<T>(*en, 0) : en.status();
-  }
-  T v = 0;
-  constexpr auto kDigits = "0123456789";
-  constexpr auto kMax = (std::numeric_limits<T>::max)();
-  enum { kIntPart, kFracPart } state = kIntPart;
-  for (auto const ch : rep) {
-    auto dp = std::strchr(kDigits, ch);
-    if (state == kFracPart) {
-      if (dp - kDigits >= 5) {  // dp != nullptr
-        if (v == kMax) return internal::DataLoss(rep);
-        v += 1;
-      }
-      break;
-    }
-    if (dp == nullptr) {
-      if (ch == '-') return internal::DataLoss(rep);
-      state = kFracPart;  // ch == '.'
-    } else {
-      if (v > kMax / 10) return internal::DataLoss(rep);
-      v *= 10;
-      auto d = static_cast<T>(dp - kDigits);
-      if (v > kMax - d) return internal::DataLoss(rep);
-      v += d;
-    }
+  auto const en = internal::ScaleNumeric(n, exponent);
+  if (!en) return en.status();
+  auto const value = internal::NumericScaledValue(*en);
+  if (value < 0) return internal::DataLoss(en->ToString());
+  auto const v = absl::uint128(internal::RoundScaledValue(value));
+  if (v > absl::uint128((std::numeric_limits<T>::max)())) {
+    return internal::DataLoss(en->ToString());
   }
-  return v;
+  return static_cast<T>(v);
 }
 
 template <typename T,
@@ -241,43 +250,14 @@ template <typename T,
                                       std::numeric_limits<T>::is_signed,
                                   int>::type = 0>
 StatusOr<T> ToInteger(Numeric const& n, int exponent = 0) {
-  std::string const& rep = n.ToString();
-  if (exponent != 0) {
-    auto const en = internal::MakeNumeric(rep, exponent);
-    return en ? ToInteger<T>(*en, 0) : en.status();
-  }
-  T v = 0;
-  constexpr auto kDigits = "0123456789";
-  constexpr auto kMin = (std::numeric_limits<T>::min)();
-  bool negate = true;
-  enum { kIntPart, kFracPart } state = kIntPart;
-  for (auto const ch : rep) {
-    auto dp = std::strchr(kDigits, ch);
-    if (state == kFracPart) {
-      if (dp - kDigits >= 5) {  // dp != nullptr
-        if (v == kMin) return internal::DataLoss(rep);
-        v -= 1;
-      }
-      break;
-    }
-    if (dp == nullptr) {
-      if (ch == '-') {
-        negate = false;
-      } else {
-        state = kFracPart;  // ch == '.'
-      }
-    } else {
-      if (v < kMin / 10) return internal::DataLoss(rep);
-      v *= 10;
-      auto d = static_cast<T>(dp - kDigits);
-      if (v < kMin + d) return internal::DataLoss(rep);
-      v -= d;
-    }
+  auto const en = internal::ScaleNumeric(n, exponent);
+  if (!en) return en.status();
+  auto const v = internal::RoundScaledValue(internal::NumericScaledValue(*en));
+  if (v < absl::int128((std::numeric_limits<T>::min)()) ||
+      v > absl::int128((std::numeric_limits<T>::max)())) {
+    return internal::DataLoss(en->ToString());
   }
-  if (!negate) return v;
-  constexpr auto kMax = (std::numeric_limits<T>::max)();
-  if (kMin != -kMax && v == kMin) return internal::DataLoss(rep);
-  return -v;
+  return static_cast<T>(v);
 }
 ///@}
 
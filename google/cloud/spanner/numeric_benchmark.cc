@@ -24,25 +24,28 @@ namespace spanner {
 inline namespace SPANNER_CLIENT_NS {
 namespace {
 
-// Run on (96 X 2000.17 MHz CPU s)
+// Run on (1 X 2100 MHz CPU )
 // CPU Caches:
-//   L1 Data 32K (x48)
-//   L1 Instruction 32K (x48)
-//   L2 Unified 1024K (x48)
-//   L3 Unified 39424K (x2)
-// Load Average: 0.22, 1.93, 3.67
+//   L1 Data 48 KiB (x1)
+//   L1 Instruction 32 KiB (x1)
+//   L2 Unified 2048 KiB (x1)
+//   L3 Unified 307200 KiB (x1)
+// Load Average: 0.94, 0.82, 0.71
 // ------------------------------------------------------------------------
 // Benchmark                              Time             CPU   Iterations
 // ------------------------------------------------------------------------
-// BM_NumericFromStringCanonical       76.0 ns         76.0 ns      8999376
-// BM_NumericFromString                 369 ns          369 ns      1925749
-// BM_NumericFromDouble                2072 ns         2072 ns       340812
-// BM_NumericFromUnsigned               168 ns          168 ns      4151959
-// BM_NumericFromInteger                165 ns          165 ns      4238271
-// BM_NumericToString                 0.360 ns        0.360 ns   1000000000
-// BM_NumericToDouble                   115 ns          115 ns      6120955
-// BM_NumericToUnsigned                83.8 ns         83.8 ns      8466831
-// BM_NumericToInteger                 86.3 ns         86.3 ns      8092890
+// BM_NumericFromStringCanonical        119 ns          117 ns      6009184
+// BM_NumericFromString                 223 ns          220 ns      3237559
+// BM_NumericFromStringShort           38.2 ns         37.5 ns     17154222
+// BM_NumericFromDouble                2102 ns         2078 ns       325392
+// BM_NumericFromUnsigned              18.8 ns         17.7 ns     37201653
+// BM_NumericFromInteger               19.0 ns         18.8 ns     35442881
+// BM_NumericToString                   175 ns          173 ns      4191469
+// BM_NumericToStringShort             45.2 ns         43.4 ns     16684423
+// BM_NumericToDouble                  31.6 ns         31.1 ns     22445869
+// BM_NumericToDoubleFraction          12.4 ns         12.2 ns     57685090
+// BM_NumericToUnsigned                20.6 ns         20.3 ns     34674710
+// BM_NumericToInteger                 21.0 ns         20.5 ns     31740480
 
 void BM_NumericFromStringCanonical(benchmark::State& state) {
   std::string s = "99999999999999999999999999999.999999999";
@@ -60,6 +63,14 @@ void BM_NumericFromString(benchmark::State& state) {
 }
 BENCHMARK(BM_NumericFromString);
 
+void BM_NumericFromStringShort(benchmark::State& state) {
+  std::string s = "-1234.5678";
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MakeNumeric(s));
+  }
+}
+BENCHMARK(BM_NumericFromStringShort);
+
 void BM_NumericFromDouble(benchmark::State& state) {
   double d = 9.999999999999999e+28;
   for (auto _ : state) {
@@ -93,6 +104,15 @@ void BM_NumericToString(benchmark::State& state) {
 }
 BENCHMARK(BM_NumericToString);
 
+void BM_NumericToStringShort(benchmark::State& state) {
+  std::string s = "-1234.5678";
+  Numeric n = MakeNumeric(s).value();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(n.ToString());
+  }
+}
+BENCHMARK(BM_NumericToStringShort);
+
 void BM_NumericToDouble(benchmark::State& state) {
   double d = 9.999999999999999e+28;
   Numeric n = MakeNumeric(d).value();
@@ -102,6 +122,14 @@ void BM_NumericToDouble(benchmark::State& state) {
 }
 BENCHMARK(BM_NumericToDouble);
 
+void BM_NumericToDoubleFraction(benchmark::State& state) {
+  Numeric n = MakeNumeric("-1234.5678").value();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ToDouble(n));
+  }
+}
+BENCHMARK(BM_NumericToDoubleFraction);
+
 void BM_NumericToUnsigned(benchmark::State& state) {
   auto u = std::numeric_limits<std::uint64_t>::max();
   Numeric n = MakeNumeric(u).value();
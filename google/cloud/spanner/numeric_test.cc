@@ -15,7 +15,9 @@
 #include "google/cloud/spanner/numeric.h"
 #include "absl/numeric/int128.h"
 #include <gmock/gmock.h>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <limits>
 #include <sstream>
 #include <string>
@@ -228,6 +230,22 @@ TEST(Numeric, MakeNumericString) {
                 .ToString());
 }
 
+TEST(Numeric, MakeNumericStringExtremeExponent) {
+  EXPECT_EQ("0", MakeNumeric("0e9223372036854775807").value().ToString());
+  EXPECT_EQ("0", MakeNumeric("1e-9223372036854775807").value().ToString());
+  EXPECT_EQ("0.000000001", MakeNumeric("5e-10").value().ToString());
+  EXPECT_EQ("0", MakeNumeric("4.9e-10").value().ToString());
+}
+
+TEST(Numeric, ParseNumericView) {
+  auto const s = std::string("-12.50 and more");
+  EXPECT_EQ("-12.5", internal::ParseNumeric(absl::string_view(s).substr(0, 6))
+                         .value()
+                         .ToString());
+  EXPECT_THAT(internal::ParseNumeric(s).status(),
+              HasStatus(StatusCode::kInvalidArgument, s));
+}
+
 TEST(Numeric, MakeNumericStringFail) {
   // Valid chars, but incomplete.
   EXPECT_THAT(MakeNumeric("").status(),
@@ -308,6 +326,16 @@ TEST(Numeric, MakeNumericStringRoundingFail) {
       HasStatus(StatusCode::kDataLoss, "18446744073709551615.5"));
 }
 
+TEST(Numeric, ToDoubleRoundsOnce) {
+  // 2^64 + 2^63 + 2^11 + 1 is just above the midpoint of two doubles, but its
+  // lowest 64 bits alone round down to that midpoint, which then rounds down
+  // to the even double.
+  auto const n = MakeNumeric("27670116110564329473").value();
+  EXPECT_EQ(std::ldexp(3.0, 63) + std::ldexp(1.0, 12), ToDouble(n));
+  EXPECT_EQ(-std::ldexp(3.0, 63) - std::ldexp(1.0, 12),
+            ToDouble(MakeNumeric("-27670116110564329473").value()));
+}
+
 TEST(Numeric, MakeNumericDouble) {
   // Zero can be matched exactly.
   EXPECT_EQ(0.0, ToDouble(MakeNumeric(0.0).value()));
@@ -349,6 +377,12 @@ TEST(Numeric, MakeNumericDouble) {
   EXPECT_DOUBLE_EQ(12e-9, ToDouble(MakeNumeric(12.3456789e-9).value()));
   EXPECT_DOUBLE_EQ(1e-9, ToDouble(MakeNumeric(1.23456789e-9).value()));
   EXPECT_EQ(0.0, ToDouble(MakeNumeric(0.123456789e-9).value()));
+
+  // Values with a fraction and more significant digits than a double holds.
+  for (auto const* s : {"12345678901234567.5", "-9007199.254740993",
+                        "99999999999999999999999999999.999999999"}) {
+    EXPECT_EQ(std::atof(s), ToDouble(MakeNumeric(s).value())) << s;
+  }
 }
 
 TEST(Numeric, MakeNumericDoubleFail) {
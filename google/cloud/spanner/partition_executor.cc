@@ -0,0 +1,307 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/partition_executor.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+// Starts the partition at the given position, returning its rows.
+using PartitionRunner = std::function<RowStream(std::size_t)>;
+
+// Called with the final status of each partition.
+using PartitionDone = std::function<void(std::size_t, Status const&)>;
+
+// Called with the stream of a partition when it starts reading it, and with
+// `nullptr` before the stream is destroyed.
+using PartitionTracker = std::function<void(std::size_t, RowStream*)>;
+
+// Registers a stream with a `PartitionTracker` for as long as it is alive.
+class TrackedStream {
+ public:
+  TrackedStream(PartitionTracker const& track, std::size_t index,
+                RowStream& rows)
+      : track_(track), index_(index) {
+    track_(index_, &rows);
+  }
+  ~TrackedStream() { track_(index_, nullptr); }
+
+  TrackedStream(TrackedStream const&) = delete;
+  TrackedStream& operator=(TrackedStream const&) = delete;
+
+ private:
+  PartitionTracker const& track_;
+  std::size_t index_;
+};
+
+Status CancelledStatus() {
+  return Status(StatusCode::kCancelled, "partition execution cancelled");
+}
+
+std::size_t WorkerCount(PartitionExecutorOptions const& options,
+                        std::size_t partitions) {
+  auto count = options.max_concurrency();
+  if (count < 1) count = static_cast<int>(std::thread::hardware_concurrency());
+  return (std::min)(static_cast<std::size_t>((std::max)(count, 1)),
+                    partitions);
+}
+
+Status RunPartition(PartitionRunner const& run, std::size_t index,
+                    PartitionRowSink const& sink,
+                    PartitionExecutorOptions const& options,
+                    std::atomic<bool> const& cancelled,
+                    PartitionTracker const& track) {
+  auto retry_policy = options.retry_policy()->clone();
+  auto backoff_policy = options.backoff_policy()->clone();
+  for (;;) {
+    bool yielded = false;
+    Status status;
+    auto rows = run(index);
+    TrackedStream tracked(track, index, rows);
+    for (auto& row : rows) {
+      if (!row) {
+        status = std::move(row).status();
+        break;
+      }
+      yielded = true;
+      auto sink_status = sink(index, *std::move(row));
+      if (!sink_status.ok()) return sink_status;
+      if (cancelled) return CancelledStatus();
+    }
+    if (status.ok()) return status;
+    // Rows cannot be taken back from the sink, so only partitions that failed
+    // before yielding any rows are retried.
+    if (yielded || cancelled || !retry_policy->OnFailure(status)) {
+      return status;
+    }
+    std::this_thread::sleep_for(backoff_policy->OnCompletion());
+  }
+}
+
+// Runs `count` partitions on up to `options.max_concurrency()` threads,
+// including the calling thread.
+std::vector<Status> RunPartitions(std::size_t count, PartitionRunner const& run,
+                                  PartitionRowSink const& sink,
+                                  PartitionExecutorOptions const& options,
+                                  std::atomic<bool> const& cancelled,
+                                  PartitionDone const& done,
+                                  PartitionTracker const& track) {
+  std::vector<Status> results(count);
+  std::atomic<std::size_t> next(0);
+  auto worker = [&] {
+    for (auto i = next++; i < count; i = next++) {
+      results[i] = cancelled ? CancelledStatus()
+                             : RunPartition(run, i, sink, options, cancelled,
+                                            track);
+      done(i, results[i]);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < WorkerCount(options, count); ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& t : threads) t.join();
+  return results;
+}
+
+std::vector<Status> ExecutePartitionsImpl(
+    std::size_t count, PartitionRunner const& run, PartitionRowSink const& sink,
+    PartitionExecutorOptions const& options) {
+  std::atomic<bool> cancelled(false);
+  return RunPartitions(count, run, sink, options, cancelled,
+                       [](std::size_t, Status const&) {},
+                       [](std::size_t, RowStream*) {});
+}
+
+/**
+ * Returns the rows of several partitions, which run in the background, as a
+ * single stream.
+ *
+ * The partitions push their rows into a bounded queue, and wait while it is
+ * full. The first partition that fails stops the others. Stopping a partition
+ * also cancels its stream, so that a partition blocked reading from the
+ * server does not delay the destructor.
+ */
+class MergedPartitionSource : public internal::ResultSourceInterface {
+ public:
+  MergedPartitionSource(std::size_t count, PartitionRunner run,
+                        PartitionExecutorOptions const& options)
+      : capacity_((std::max)(options.queue_capacity(), std::size_t{1})),
+        streams_(count, nullptr) {
+    runner_ = std::thread([this, count, run, options] {
+      RunPartitions(
+          count, run,
+          [this](std::size_t, Row row) { return Push(std::move(row)); },
+          options, cancelled_,
+          [this](std::size_t, Status const& status) { OnDone(status); },
+          [this](std::size_t i, RowStream* rows) { Track(i, rows); });
+      std::lock_guard<std::mutex> lk(mu_);
+      finished_ = true;
+      has_rows_.notify_all();
+    });
+  }
+
+  ~MergedPartitionSource() override {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      cancelled_ = true;
+      CancelStreams();
+    }
+    has_space_.notify_all();
+    runner_.join();
+  }
+
+  StatusOr<Row> NextRow() override {
+    std::unique_lock<std::mutex> lk(mu_);
+    has_rows_.wait(lk, [this] {
+      return !rows_.empty() || !status_.ok() || finished_;
+    });
+    if (!rows_.empty()) {
+      auto row = std::move(rows_.front());
+      rows_.pop_front();
+      lk.unlock();
+      has_space_.notify_one();
+      return row;
+    }
+    if (!status_.ok()) return status_;
+    return Row();
+  }
+
+  absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
+    return {};
+  }
+
+  absl::optional<google::spanner::v1::ResultSetStats> Stats() const override {
+    return {};
+  }
+
+ private:
+  Status Push(Row row) {
+    std::unique_lock<std::mutex> lk(mu_);
+    has_space_.wait(lk,
+                    [this] { return rows_.size() < capacity_ || cancelled_; });
+    if (cancelled_) return CancelledStatus();
+    rows_.push_back(std::move(row));
+    lk.unlock();
+    has_rows_.notify_one();
+    return {};
+  }
+
+  void OnDone(Status const& status) {
+    if (status.ok()) return;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      if (!status_.ok() || cancelled_) return;
+      status_ = status;
+      cancelled_ = true;
+      CancelStreams();
+    }
+    has_rows_.notify_all();
+    has_space_.notify_all();
+  }
+
+  void Track(std::size_t index, RowStream* rows) {
+    std::lock_guard<std::mutex> lk(mu_);
+    streams_[index] = rows;
+    // A partition may start its stream just after the others were cancelled.
+    if (rows != nullptr && cancelled_) internal::TryCancel(*rows);
+  }
+
+  // Cancels the streams of the running partitions. Must be called with `mu_`
+  // held, which keeps the streams alive.
+  void CancelStreams() {
+    for (auto* rows : streams_) {
+      if (rows != nullptr) internal::TryCancel(*rows);
+    }
+  }
+
+  std::size_t const capacity_;
+  std::mutex mu_;
+  std::condition_variable has_rows_;
+  std::condition_variable has_space_;
+  std::deque<Row> rows_;
+  Status status_;
+  bool finished_ = false;
+  std::vector<RowStream*> streams_;  // GUARDED_BY(mu_)
+  std::atomic<bool> cancelled_{false};
+  std::thread runner_;
+};
+
+}  // namespace
+
+std::vector<Status> ExecutePartitions(Client client,
+                                      std::vector<QueryPartition> partitions,
+                                      PartitionRowSink sink,
+                                      PartitionExecutorOptions const& options,
+                                      QueryOptions const& query_options) {
+  return ExecutePartitionsImpl(
+      partitions.size(),
+      [&](std::size_t i) {
+        return client.ExecuteQuery(partitions[i], query_options);
+      },
+      sink, options);
+}
+
+std::vector<Status> ExecutePartitions(Client client,
+                                      std::vector<ReadPartition> partitions,
+                                      PartitionRowSink sink,
+                                      PartitionExecutorOptions const& options) {
+  return ExecutePartitionsImpl(
+      partitions.size(),
+      [&](std::size_t i) { return client.Read(partitions[i]); }, sink,
+      options);
+}
+
+RowStream MergePartitions(Client client, std::vector<QueryPartition> partitions,
+                          PartitionExecutorOptions const& options,
+                          QueryOptions const& query_options) {
+  auto const count = partitions.size();
+  auto shared = std::make_shared<std::vector<QueryPartition>>(
+      std::move(partitions));
+  PartitionRunner run = [client, shared,
+                         query_options](std::size_t i) mutable {
+    return client.ExecuteQuery((*shared)[i], query_options);
+  };
+  return RowStream(
+      absl::make_unique<MergedPartitionSource>(count, std::move(run), options));
+}
+
+RowStream MergePartitions(Client client, std::vector<ReadPartition> partitions,
+                          PartitionExecutorOptions const& options) {
+  auto const count = partitions.size();
+  auto shared =
+      std::make_shared<std::vector<ReadPartition>>(std::move(partitions));
+  PartitionRunner run = [client, shared](std::size_t i) mutable {
+    return client.Read((*shared)[i]);
+  };
+  return RowStream(
+      absl::make_unique<MergedPartitionSource>(count, std::move(run), options));
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
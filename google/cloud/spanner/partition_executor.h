@@ -0,0 +1,195 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_PARTITION_EXECUTOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_PARTITION_EXECUTOR_H
+
+#include "google/cloud/spanner/backoff_policy.h"
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/query_options.h"
+#include "google/cloud/spanner/query_partition.h"
+#include "google/cloud/spanner/read_partition.h"
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/retry_policy.h"
+#include "google/cloud/spanner/row.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/status.h"
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Controls how `ExecutePartitions()` and `MergePartitions()` run partitions.
+ */
+class PartitionExecutorOptions {
+ public:
+  PartitionExecutorOptions()
+      : retry_policy_(std::make_shared<LimitedErrorCountRetryPolicy>(3)),
+        backoff_policy_(std::make_shared<ExponentialBackoffPolicy>(
+            std::chrono::milliseconds(100), std::chrono::seconds(10), 2.0)) {}
+
+  /**
+   * The maximum number of partitions that run at the same time.
+   *
+   * Values less than 1 select the number of hardware threads.
+   */
+  PartitionExecutorOptions& set_max_concurrency(int count) {
+    max_concurrency_ = count;
+    return *this;
+  }
+
+  /// Returns the maximum number of partitions that run at the same time.
+  int max_concurrency() const { return max_concurrency_; }
+
+  /**
+   * The maximum number of rows `MergePartitions()` buffers before the
+   * partitions wait for the caller to consume them.
+   */
+  PartitionExecutorOptions& set_queue_capacity(std::size_t capacity) {
+    queue_capacity_ = capacity;
+    return *this;
+  }
+
+  /// Returns the maximum number of rows buffered by `MergePartitions()`.
+  std::size_t queue_capacity() const { return queue_capacity_; }
+
+  /**
+   * Controls how often a failed partition is retried.
+   *
+   * Each partition makes a copy of this policy, so a partition that fails
+   * does not use up the retries of any other partition.
+   */
+  PartitionExecutorOptions& set_retry_policy(
+      std::shared_ptr<RetryPolicy const> policy) {
+    retry_policy_ = std::move(policy);
+    return *this;
+  }
+
+  /// Returns the retry policy for each partition.
+  std::shared_ptr<RetryPolicy const> const& retry_policy() const {
+    return retry_policy_;
+  }
+
+  /// Controls how long to wait before retrying a failed partition.
+  PartitionExecutorOptions& set_backoff_policy(
+      std::shared_ptr<BackoffPolicy const> policy) {
+    backoff_policy_ = std::move(policy);
+    return *this;
+  }
+
+  /// Returns the backoff policy for each partition.
+  std::shared_ptr<BackoffPolicy const> const& backoff_policy() const {
+    return backoff_policy_;
+  }
+
+ private:
+  int max_concurrency_ = 0;
+  std::size_t queue_capacity_ = 1024;
+  std::shared_ptr<RetryPolicy const> retry_policy_;
+  std::shared_ptr<BackoffPolicy const> backoff_policy_;
+};
+
+/**
+ * Receives the rows of each partition run by `ExecutePartitions()`.
+ *
+ * The first argument is the position of the partition in the vector given to
+ * `ExecutePartitions()`. The sink is called from several threads at once, but
+ * never concurrently for the same partition, and the rows of each partition
+ * arrive in order. Returning an error stops that partition, and the error is
+ * reported as its result.
+ */
+using PartitionRowSink = std::function<Status(std::size_t, Row)>;
+
+/**
+ * Runs @p partitions concurrently, passing each row to @p sink.
+ *
+ * Up to `options.max_concurrency()` partitions run at the same time, one on
+ * the calling thread and the rest on threads created for this call, each
+ * taking the next partition that has not started. The partitions share the
+ * channels and sessions of @p client. The call returns once every partition
+ * has finished.
+ *
+ * A partition that fails before it yields any rows is retried on its own, as
+ * allowed by the options' retry and backoff policies. Rows cannot be taken
+ * back from the sink, so a partition that fails after yielding rows is not
+ * retried. Streams that break part way through are already resumed by the
+ * client.
+ *
+ * @return the final status of each partition, in the same order as
+ *     @p partitions.
+ *
+ * @par Example
+ * @code
+ * auto partitions = client.PartitionQuery(txn, statement);
+ * if (!partitions) throw std::runtime_error(partitions.status().message());
+ * auto results = spanner::ExecutePartitions(
+ *     client, *std::move(partitions),
+ *     [](std::size_t, spanner::Row row) { return Export(std::move(row)); });
+ * @endcode
+ */
+std::vector<Status> ExecutePartitions(
+    Client client, std::vector<QueryPartition> partitions,
+    PartitionRowSink sink,
+    PartitionExecutorOptions const& options = PartitionExecutorOptions(),
+    QueryOptions const& query_options = {});
+
+/**
+ * Runs the read @p partitions concurrently, passing each row to @p sink.
+ *
+ * This works just like the overload for `QueryPartition`s above.
+ */
+std::vector<Status> ExecutePartitions(
+    Client client, std::vector<ReadPartition> partitions, PartitionRowSink sink,
+    PartitionExecutorOptions const& options = PartitionExecutorOptions());
+
+/**
+ * Runs @p partitions concurrently, and returns their rows as a single stream.
+ *
+ * The partitions run in the background as described for
+ * `ExecutePartitions()`, and their rows are interleaved in the order they
+ * arrive. At most `options.queue_capacity()` rows are buffered; when the
+ * buffer is full the partitions wait for the caller to read more rows.
+ *
+ * If a partition fails, the other partitions are stopped, and the stream
+ * returns the error after any rows already buffered. Destroying the stream
+ * stops any partitions that are still running.
+ */
+RowStream MergePartitions(
+    Client client, std::vector<QueryPartition> partitions,
+    PartitionExecutorOptions const& options = PartitionExecutorOptions(),
+    QueryOptions const& query_options = {});
+
+/**
+ * Runs the read @p partitions concurrently, and returns their rows as a single
+ * stream.
+ *
+ * This works just like the overload for `QueryPartition`s above.
+ */
+RowStream MergePartitions(
+    Client client, std::vector<ReadPartition> partitions,
+    PartitionExecutorOptions const& options = PartitionExecutorOptions());
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_PARTITION_EXECUTOR_H
@@ -0,0 +1,269 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/partition_executor.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/spanner/query_partition.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::ByMove;
+using ::testing::Return;
+using ::testing::UnorderedElementsAre;
+
+// Returns a stream with @p rows, which may be abandoned part way through.
+RowStream MakeStream(std::vector<StatusOr<Row>> rows) {
+  auto pending = std::make_shared<std::deque<StatusOr<Row>>>(
+      std::make_move_iterator(rows.begin()),
+      std::make_move_iterator(rows.end()));
+  auto source = absl::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*source, NextRow())
+      .WillRepeatedly([pending]() -> StatusOr<Row> {
+        if (pending->empty()) return Row();
+        auto row = std::move(pending->front());
+        pending->pop_front();
+        return row;
+      });
+  EXPECT_CALL(*source, TryCancel()).Times(AnyNumber());
+  return RowStream(std::move(source));
+}
+
+std::vector<QueryPartition> MakePartitions(int count) {
+  std::vector<QueryPartition> partitions;
+  for (int i = 0; i != count; ++i) {
+    partitions.push_back(internal::MakeQueryPartition(
+        "txn", "session", std::to_string(i), SqlStatement("select 1")));
+  }
+  return partitions;
+}
+
+PartitionExecutorOptions TestOptions() {
+  return PartitionExecutorOptions()
+      .set_max_concurrency(2)
+      .set_backoff_policy(std::make_shared<ExponentialBackoffPolicy>(
+          std::chrono::microseconds(1), std::chrono::microseconds(10), 2.0));
+}
+
+std::int64_t PartitionNumber(Connection::SqlParams const& params) {
+  return std::stoll(params.partition_token.value_or("-1"));
+}
+
+class RowCollector {
+ public:
+  PartitionRowSink Sink() {
+    return [this](std::size_t, Row row) -> Status {
+      auto value = row.get<std::int64_t>(0);
+      if (!value) return std::move(value).status();
+      std::lock_guard<std::mutex> lk(mu_);
+      values_.push_back(*value);
+      return Status();
+    };
+  }
+
+  std::vector<std::int64_t> values() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return values_;
+  }
+
+ private:
+  std::mutex mu_;
+  std::vector<std::int64_t> values_;
+};
+
+TEST(PartitionExecutorTest, ExecuteAllPartitions) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery(_))
+      .Times(3)
+      .WillRepeatedly([](Connection::SqlParams const& params) -> RowStream {
+        auto n = PartitionNumber(params);
+        return MakeStream({MakeTestRow(n * 10), MakeTestRow(n * 10 + 1)});
+      });
+
+  RowCollector collector;
+  auto results = ExecutePartitions(Client(conn), MakePartitions(3),
+                                   collector.Sink(), TestOptions());
+  ASSERT_EQ(3, results.size());
+  for (auto const& status : results) EXPECT_STATUS_OK(status);
+  EXPECT_THAT(collector.values(), UnorderedElementsAre(0, 1, 10, 11, 20, 21));
+}
+
+TEST(PartitionExecutorTest, RetryBeforeFirstRow) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery(_))
+      .WillOnce(Return(ByMove(
+          MakeStream({Status(StatusCode::kUnavailable, "try-again")}))))
+      .WillOnce(Return(ByMove(MakeStream({MakeTestRow(std::int64_t{7})}))));
+
+  RowCollector collector;
+  auto results = ExecutePartitions(Client(conn), MakePartitions(1),
+                                   collector.Sink(), TestOptions());
+  ASSERT_EQ(1, results.size());
+  EXPECT_STATUS_OK(results[0]);
+  EXPECT_THAT(collector.values(), UnorderedElementsAre(7));
+}
+
+TEST(PartitionExecutorTest, NoRetryAfterFirstRow) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery(_))
+      .WillOnce(Return(ByMove(
+          MakeStream({MakeTestRow(std::int64_t{7}),
+                      Status(StatusCode::kUnavailable, "try-again")}))));
+
+  RowCollector collector;
+  auto results = ExecutePartitions(Client(conn), MakePartitions(1),
+                                   collector.Sink(), TestOptions());
+  ASSERT_EQ(1, results.size());
+  EXPECT_EQ(StatusCode::kUnavailable, results[0].code());
+  EXPECT_THAT(collector.values(), UnorderedElementsAre(7));
+}
+
+TEST(PartitionExecutorTest, NoRetryOnPermanentError) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery(_))
+      .WillOnce(Return(ByMove(
+          MakeStream({Status(StatusCode::kPermissionDenied, "uh-oh")}))));
+
+  RowCollector collector;
+  auto results = ExecutePartitions(Client(conn), MakePartitions(1),
+                                   collector.Sink(), TestOptions());
+  ASSERT_EQ(1, results.size());
+  EXPECT_EQ(StatusCode::kPermissionDenied, results[0].code());
+  EXPECT_TRUE(collector.values().empty());
+}
+
+TEST(PartitionExecutorTest, SinkErrorStopsPartition) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery(_))
+      .WillOnce(Return(ByMove(MakeStream(
+          {MakeTestRow(std::int64_t{1}), MakeTestRow(std::int64_t{2})}))));
+
+  int calls = 0;
+  auto results = ExecutePartitions(
+      Client(conn), MakePartitions(1),
+      [&calls](std::size_t, Row const&) {
+        ++calls;
+        return Status(StatusCode::kAborted, "sink full");
+      },
+      TestOptions());
+  ASSERT_EQ(1, results.size());
+  EXPECT_EQ(StatusCode::kAborted, results[0].code());
+  EXPECT_EQ(1, calls);
+}
+
+TEST(PartitionExecutorTest, MergeAllPartitions) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery(_))
+      .Times(4)
+      .WillRepeatedly([](Connection::SqlParams const& params) -> RowStream {
+        auto n = PartitionNumber(params);
+        return MakeStream({MakeTestRow(n * 10), MakeTestRow(n * 10 + 1)});
+      });
+
+  auto rows = MergePartitions(Client(conn), MakePartitions(4),
+                              TestOptions().set_queue_capacity(1));
+  std::vector<std::int64_t> values;
+  for (auto const& row : StreamOf<std::tuple<std::int64_t>>(rows)) {
+    ASSERT_STATUS_OK(row);
+    values.push_back(std::get<0>(*row));
+  }
+  EXPECT_THAT(values, UnorderedElementsAre(0, 1, 10, 11, 20, 21, 30, 31));
+}
+
+TEST(PartitionExecutorTest, MergeReportsError) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery(_))
+      .WillRepeatedly([](Connection::SqlParams const& params) -> RowStream {
+        if (PartitionNumber(params) == 1) {
+          return MakeStream({Status(StatusCode::kPermissionDenied, "uh-oh")});
+        }
+        return MakeStream({MakeTestRow(std::int64_t{1})});
+      });
+
+  auto rows = MergePartitions(Client(conn), MakePartitions(3), TestOptions());
+  Status last;
+  for (auto const& row : rows) {
+    if (!row) last = row.status();
+  }
+  EXPECT_EQ(StatusCode::kPermissionDenied, last.code());
+}
+
+TEST(PartitionExecutorTest, MergeDestroyedEarly) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery(_))
+      .WillRepeatedly([](Connection::SqlParams const& params) -> RowStream {
+        auto n = PartitionNumber(params);
+        return MakeStream({MakeTestRow(n), MakeTestRow(n), MakeTestRow(n)});
+      });
+
+  auto rows = MergePartitions(Client(conn), MakePartitions(8),
+                              TestOptions().set_queue_capacity(1));
+  auto it = rows.begin();
+  ASSERT_NE(it, rows.end());
+  EXPECT_STATUS_OK(*it);
+  // Destroying `rows` must stop the partitions waiting on the full queue.
+}
+
+TEST(PartitionExecutorTest, MergeDestroyedWhileReading) {
+  std::promise<void> reading;
+  std::promise<void> cancelled;
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery(_))
+      .WillOnce([&reading, &cancelled](Connection::SqlParams const&) {
+        auto source = absl::make_unique<MockResultSetSource>();
+        // The read blocks, like a gRPC read waiting for the server, until the
+        // stream is cancelled.
+        EXPECT_CALL(*source, NextRow())
+            .WillOnce([&reading, &cancelled]() -> StatusOr<Row> {
+              reading.set_value();
+              cancelled.get_future().get();
+              return Status(StatusCode::kCancelled, "cancelled");
+            });
+        EXPECT_CALL(*source, TryCancel()).WillOnce([&cancelled] {
+          cancelled.set_value();
+        });
+        return RowStream(std::move(source));
+      });
+
+  auto rows = MergePartitions(Client(conn), MakePartitions(1), TestOptions());
+  reading.get_future().get();
+  // Destroying `rows` must cancel the stream of the running partition.
+  rows = RowStream();
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -18,6 +18,7 @@
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/optional.h"
 #include "absl/types/optional.h"
+#include <cstddef>
 #include <string>
 
 namespace google {
@@ -54,8 +55,28 @@ class QueryOptions {
     return *this;
   }
 
+  /// Returns the number of rows to read ahead of the caller.
+  absl::optional<std::size_t> const& prefetch_rows() const {
+    return prefetch_rows_;
+  }
+
+  /**
+   * Sets the number of rows to read ahead of the caller on a background
+   * thread, so that receiving and decoding the results of a query overlaps
+   * with their processing. Each stream read ahead uses its own thread. Zero
+   * disables the background reads.
+   *
+   * Unlike the other options, this one is applied by the client library and is
+   * not sent to the server. It is ignored by the DML and partitioning calls.
+   */
+  QueryOptions& set_prefetch_rows(absl::optional<std::size_t> rows) {
+    prefetch_rows_ = std::move(rows);
+    return *this;
+  }
+
   friend bool operator==(QueryOptions const& a, QueryOptions const& b) {
-    return a.optimizer_version_ == b.optimizer_version_;
+    return a.optimizer_version_ == b.optimizer_version_ &&
+           a.prefetch_rows_ == b.prefetch_rows_;
   }
 
   friend bool operator!=(QueryOptions const& a, QueryOptions const& b) {
@@ -64,6 +85,7 @@ class QueryOptions {
 
  private:
   absl::optional<std::string> optimizer_version_;
+  absl::optional<std::size_t> prefetch_rows_;
 };
 
 }  // namespace SPANNER_CLIENT_NS
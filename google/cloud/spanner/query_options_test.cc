@@ -38,6 +38,21 @@ TEST(QueryOptionsTest, OptimizerVersion) {
   EXPECT_EQ(copy, default_constructed);
 }
 
+TEST(QueryOptionsTest, PrefetchRows) {
+  QueryOptions const default_constructed{};
+  EXPECT_FALSE(default_constructed.prefetch_rows().has_value());
+
+  auto copy = default_constructed;
+  copy.set_prefetch_rows(0);
+  EXPECT_NE(copy, default_constructed);
+  copy.set_prefetch_rows(128);
+  EXPECT_NE(copy, default_constructed);
+  EXPECT_EQ(128, *copy.prefetch_rows());
+
+  copy.set_prefetch_rows(absl::optional<std::size_t>{});
+  EXPECT_EQ(copy, default_constructed);
+}
+
 }  // namespace
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
@@ -17,6 +17,8 @@
 
 #include "google/cloud/spanner/version.h"
 #include <google/spanner/v1/spanner.pb.h>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace google {
@@ -38,10 +40,20 @@ struct ReadOptions {
    * A limit cannot be specified when calling `PartitionRead`.
    */
   std::int64_t limit = 0;
+
+  /**
+   * If non-zero, the rows are read ahead of the caller on a background thread,
+   * buffering up to this many rows, so that receiving and decoding the results
+   * overlaps with their processing. This is a client-side option, and is not
+   * sent to the server. It is most useful for large reads. Each stream read
+   * ahead uses its own thread.
+   */
+  std::size_t prefetch_rows = 0;
 };
 
 inline bool operator==(ReadOptions const& lhs, ReadOptions const& rhs) {
-  return lhs.limit == rhs.limit && lhs.index_name == rhs.index_name;
+  return lhs.limit == rhs.limit && lhs.index_name == rhs.index_name &&
+         lhs.prefetch_rows == rhs.prefetch_rows;
 }
 
 inline bool operator!=(ReadOptions const& lhs, ReadOptions const& rhs) {
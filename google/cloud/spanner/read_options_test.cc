@@ -33,6 +33,10 @@ TEST(ReadOptionsTest, Equality) {
   EXPECT_NE(test_options_0, test_options_1);
   test_options_1.limit = 42;
   EXPECT_EQ(test_options_0, test_options_1);
+  test_options_0.prefetch_rows = 64;
+  EXPECT_NE(test_options_0, test_options_1);
+  test_options_1.prefetch_rows = 64;
+  EXPECT_EQ(test_options_0, test_options_1);
   test_options_1 = test_options_0;
   EXPECT_EQ(test_options_0, test_options_1);
 }
@@ -18,6 +18,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -67,6 +68,26 @@ absl::optional<spanner::ExecutionPlan> GetExecutionPlan(
 }
 }  // namespace
 
+namespace internal {
+
+StatusOr<bool> ResultSourceInterface::NextRowValues(
+    std::vector<google::protobuf::Value>& values) {
+  auto row = NextRow();
+  if (!row) return std::move(row).status();
+  values.clear();
+  if (row->size() == 0) return false;
+  for (auto& v : std::move(*row).values()) {
+    values.push_back(internal::ToProto(std::move(v)).second);
+  }
+  return true;
+}
+
+void TryCancel(RowStream& rows) {
+  if (rows.source_) rows.source_->TryCancel();
+}
+
+}  // namespace internal
+
 absl::optional<Timestamp> RowStream::ReadTimestamp() const {
   return GetReadTimestamp(source_);
 }
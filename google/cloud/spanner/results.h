@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_RESULTS_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_RESULTS_H
 
+#include "google/cloud/spanner/internal/tuple_utils.h"
 #include "google/cloud/spanner/row.h"
 #include "google/cloud/spanner/timestamp.h"
 #include "google/cloud/spanner/version.h"
@@ -24,6 +25,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -41,6 +43,8 @@ inline namespace SPANNER_CLIENT_NS {
  */
 using ExecutionPlan = ::google::spanner::v1::QueryPlan;
 
+class RowStream;
+
 namespace internal {
 class ResultSourceInterface {
  public:
@@ -49,7 +53,120 @@ class ResultSourceInterface {
   virtual StatusOr<Row> NextRow() = 0;
   virtual absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() = 0;
   virtual absl::optional<google::spanner::v1::ResultSetStats> Stats() const = 0;
+  // Moves the values of the next row into `values`, replacing its contents,
+  // or returns false at end-of-stream. The default implementation converts the
+  // values from `NextRow()`.
+  virtual StatusOr<bool> NextRowValues(
+      std::vector<google::protobuf::Value>& values);
+  // Returns true if the values from `NextRowValues()` always match the row
+  // type in `Metadata()`, so they can be decoded without building `Row`s.
+  virtual bool HasTypedRowValues() const { return false; }
+  // Cancels the stream under the source, if any, so that a call to
+  // `NextRow()` or `NextRowValues()` blocked on another thread returns. It is
+  // safe to call from any thread.
+  virtual void TryCancel() {}
+};
+
+/**
+ * Decodes the rows of a `ResultSourceInterface` straight into `Tuple`s.
+ *
+ * The conversion for each column is selected at compile time from the `Tuple`
+ * element types, and the types are checked against the result set metadata
+ * once rather than for every value. Values are moved from the protos, so no
+ * `Row` or `Value` objects are created. Other sources, or those without row
+ * type metadata, are decoded through `NextRow()`.
+ */
+template <typename Tuple>
+class TupleDecoder {
+ public:
+  explicit TupleDecoder(ResultSourceInterface* source) : source_(source) {}
+
+  absl::optional<StatusOr<Tuple>> operator()() {
+    if (!initialized_) Initialize();
+    if (fields_.empty()) {
+      auto row = source_->NextRow();
+      if (!row) return StatusOr<Tuple>(std::move(row).status());
+      if (row->size() == 0) return {};
+      return std::move(*row).template get<Tuple>();
+    }
+
+    auto more = source_->NextRowValues(values_);
+    if (!more) return StatusOr<Tuple>(std::move(more).status());
+    if (!*more) return {};
+    // As with `Row::get<Tuple>()`, a `Tuple` that does not match the row type
+    // is only reported for a row, so an empty result yields no error.
+    if (!type_status_.ok()) return StatusOr<Tuple>(type_status_);
+    if (values_.size() != std::tuple_size<Tuple>::value) {
+      return StatusOr<Tuple>(Status(StatusCode::kInvalidArgument,
+                                    "Tuple has the wrong number of elements"));
+    }
+    Tuple tup;
+    Status status;
+    std::size_t i = 0;
+    internal::ForEach(tup, DecodeColumn{*this, status, i});
+    if (!status.ok()) return StatusOr<Tuple>(std::move(status));
+    return StatusOr<Tuple>(std::move(tup));
+  }
+
+ private:
+  void Initialize() {
+    initialized_ = true;
+    if (!source_->HasTypedRowValues()) return;
+    auto metadata = source_->Metadata();
+    if (!metadata) return;
+    for (auto& field : *metadata->mutable_row_type()->mutable_fields()) {
+      fields_.push_back(std::move(*field.mutable_type()));
+    }
+    if (fields_.empty()) return;
+    if (fields_.size() != std::tuple_size<Tuple>::value) {
+      type_status_ = Status(StatusCode::kInvalidArgument,
+                            "Tuple has the wrong number of elements");
+      return;
+    }
+    Tuple tup;
+    std::size_t i = 0;
+    internal::ForEach(tup, CheckColumnType{*this, i});
+  }
+
+  struct CheckColumnType {
+    TupleDecoder& decoder;
+    std::size_t& i;
+    template <typename T>
+    void operator()(T const&) const {
+      if (!internal::TypeMatches<T>(decoder.fields_[i++])) {
+        decoder.type_status_ = Status(StatusCode::kUnknown, "wrong type");
+      }
+    }
+  };
+
+  struct DecodeColumn {
+    TupleDecoder& decoder;
+    Status& status;
+    std::size_t& i;
+    template <typename T>
+    void operator()(T& t) const {
+      if (!status.ok()) return;
+      auto value = internal::DecodeValue<T>(decoder.fields_[i],
+                                            std::move(decoder.values_[i]));
+      ++i;
+      if (!value) {
+        status = std::move(value).status();
+      } else {
+        t = *std::move(value);
+      }
+    }
+  };
+
+  ResultSourceInterface* source_;
+  bool initialized_ = false;
+  Status type_status_;
+  std::vector<google::spanner::v1::Type> fields_;
+  std::vector<google::protobuf::Value> values_;
 };
+
+// Calls `TryCancel()` on the source of @p rows, if any. It is safe to call
+// while another thread reads from @p rows.
+void TryCancel(RowStream& rows);
 }  // namespace internal
 
 /**
@@ -94,9 +211,36 @@ class RowStream {
   absl::optional<Timestamp> ReadTimestamp() const;
 
  private:
+  template <typename Tuple>
+  friend TupleStream<Tuple> StreamOf(RowStream& rows);
+  friend void internal::TryCancel(RowStream& rows);
+
   std::unique_ptr<internal::ResultSourceInterface> source_;
 };
 
+/**
+ * A factory that creates a `TupleStream<Tuple>` from the rows of @p rows.
+ *
+ * This overload decodes each row directly into a `Tuple`, without building
+ * the intermediate `Row` and `Value` objects, and is chosen automatically
+ * when `StreamOf()` is given a `RowStream`.
+ *
+ * @note ownership of @p rows is not transferred, so it must outlive the
+ *     returned `TupleStream`.
+ */
+template <typename Tuple>
+TupleStream<Tuple> StreamOf(RowStream& rows) {
+  if (!rows.source_) {
+    return TupleStream<Tuple>(RowStreamIterator(), RowStreamIterator());
+  }
+  auto decoder =
+      std::make_shared<internal::TupleDecoder<Tuple>>(rows.source_.get());
+  return TupleStream<Tuple>(
+      typename TupleStream<Tuple>::iterator::Source([decoder] {
+        return (*decoder)();
+      }));
+}
+
 /**
  * Represents the result of a data modifying operation using
  * `spanner::Client::ExecuteDml()`.
@@ -16,20 +16,57 @@
 #include "google/cloud/log.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
-#include <algorithm>
-#include <iterator>
+#include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
 namespace spanner {
 inline namespace SPANNER_CLIENT_NS {
 
+namespace {
+
+// All the default constructed rows share the same (empty) columns.
+std::shared_ptr<internal::ColumnIndex const> const& EmptyColumns() {
+  static auto const* const kColumns =
+      new std::shared_ptr<internal::ColumnIndex const>(
+          std::make_shared<internal::ColumnIndex const>(
+              std::vector<std::string>{}));
+  return *kColumns;
+}
+
+}  // namespace
+
 namespace internal {
+
+ColumnIndex::ColumnIndex(std::vector<std::string> names)
+    : names_(std::move(names)) {
+  positions_.reserve(names_.size());
+  // emplace() keeps the first position of any repeated name.
+  for (std::size_t i = 0; i != names_.size(); ++i) {
+    positions_.emplace(names_[i], i);
+  }
+}
+
+absl::optional<std::size_t> ColumnIndex::Find(std::string const& name) const {
+  auto it = positions_.find(name);
+  if (it == positions_.end()) return absl::nullopt;
+  return it->second;
+}
+
 Row MakeRow(std::vector<Value> values,
             std::shared_ptr<const std::vector<std::string>> columns) {
+  return MakeRow(std::move(values), std::make_shared<ColumnIndex const>(
+                                        std::vector<std::string>(*columns)));
+}
+
+Row MakeRow(std::vector<Value> values,
+            std::shared_ptr<ColumnIndex const> columns) {
   return Row(std::move(values), std::move(columns));
 }
+
 }  // namespace internal
 
 Row MakeTestRow(std::vector<std::pair<std::string, Value>> pairs) {
@@ -42,14 +79,14 @@ Row MakeTestRow(std::vector<std::pair<std::string, Value>> pairs) {
   return internal::MakeRow(std::move(values), std::move(columns));
 }
 
-Row::Row() : Row({}, std::make_shared<std::vector<std::string>>()) {}
+Row::Row() : Row({}, EmptyColumns()) {}
 
 Row::Row(std::vector<Value> values,
-         std::shared_ptr<const std::vector<std::string>> columns)
+         std::shared_ptr<internal::ColumnIndex const> columns)
     : values_(std::move(values)), columns_(std::move(columns)) {
-  if (values_.size() != columns_->size()) {
+  if (values_.size() != columns_->names().size()) {
     GCP_LOG(FATAL) << "Row's value and column sizes do not match: "
-                   << values_.size() << " vs " << columns_->size();
+                   << values_.size() << " vs " << columns_->names().size();
   }
 }
 
@@ -61,13 +98,13 @@ StatusOr<Value> Row::get(std::size_t pos) const {
 
 // NOLINTNEXTLINE(readability-identifier-naming)
 StatusOr<Value> Row::get(std::string const& name) const {
-  auto it = std::find(columns_->begin(), columns_->end(), name);
-  if (it != columns_->end()) return get(std::distance(columns_->begin(), it));
+  auto pos = columns_->Find(name);
+  if (pos) return get(*pos);
   return Status(StatusCode::kInvalidArgument, "column name not found");
 }
 
 bool operator==(Row const& a, Row const& b) {
-  return a.values_ == b.values_ && *a.columns_ == *b.columns_;
+  return a.values_ == b.values_ && a.columns() == b.columns();
 }
 
 //
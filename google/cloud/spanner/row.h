@@ -20,12 +20,14 @@
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
+#include "absl/types/optional.h"
 #include <functional>
 #include <iterator>
 #include <memory>
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -35,9 +37,34 @@ namespace spanner {
 inline namespace SPANNER_CLIENT_NS {
 
 class Row;
+class RowStream;
 namespace internal {
+
+/**
+ * The column names of a result set, with a hash index from each name to its
+ * position.
+ *
+ * All the `Row`s from a result set share a single instance, so looking up a
+ * column by name takes constant time and builds nothing per row.
+ */
+class ColumnIndex {
+ public:
+  explicit ColumnIndex(std::vector<std::string> names);
+
+  std::vector<std::string> const& names() const { return names_; }
+
+  /// Returns the position of the first column named @p name, if any.
+  absl::optional<std::size_t> Find(std::string const& name) const;
+
+ private:
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, std::size_t> positions_;
+};
+
 Row MakeRow(std::vector<Value>,
             std::shared_ptr<const std::vector<std::string>>);
+Row MakeRow(std::vector<Value>, std::shared_ptr<ColumnIndex const>);
+
 }  // namespace internal
 
 /**
@@ -89,10 +116,12 @@ class Row {
   ///@}
 
   /// Returns the number of columns in the row.
-  std::size_t size() const { return columns_->size(); }
+  std::size_t size() const { return columns_->names().size(); }
 
   /// Returns the column names for the row.
-  std::vector<std::string> const& columns() const { return *columns_; }
+  std::vector<std::string> const& columns() const {
+    return columns_->names();
+  }
 
   /// Returns the `Value` objects in the given row.
   std::vector<Value> const& values() const& { return values_; }
@@ -167,7 +196,7 @@ class Row {
 
  private:
   friend Row internal::MakeRow(std::vector<Value>,
-                               std::shared_ptr<const std::vector<std::string>>);
+                               std::shared_ptr<internal::ColumnIndex const>);
   struct ExtractValue {
     Status& status;
     template <typename T, typename It>
@@ -188,10 +217,10 @@ class Row {
    * @note columns.size() must equal values.size()
    */
   Row(std::vector<Value> values,
-      std::shared_ptr<const std::vector<std::string>> columns);
+      std::shared_ptr<internal::ColumnIndex const> columns);
 
   std::vector<Value> values_;
-  std::shared_ptr<const std::vector<std::string>> columns_;
+  std::shared_ptr<internal::ColumnIndex const> columns_;
 };
 
 /**
@@ -328,6 +357,21 @@ class TupleStreamIterator {
     ParseTuple();
   }
 
+  /**
+   * A function that returns a sequence of `StatusOr<Tuple>` objects, decoded
+   * without an intermediate `Row`. Returning an empty optional indicates that
+   * there are no more rows.
+   */
+  using Source = std::function<absl::optional<StatusOr<Tuple>>()>;
+
+  /**
+   * Creates an iterator that consumes tuples from the given @p source, which
+   * must not be `nullptr`.
+   */
+  explicit TupleStreamIterator(Source source) : source_(std::move(source)) {
+    NextTuple();
+  }
+
   reference operator*() { return tup_; }
   pointer operator->() { return &tup_; }
 
@@ -335,6 +379,14 @@ class TupleStreamIterator {
   const_pointer operator->() const { return &tup_; }
 
   TupleStreamIterator& operator++() {
+    if (source_) {
+      if (!tup_) {
+        source_ = nullptr;
+        return *this;
+      }
+      NextTuple();
+      return *this;
+    }
     if (!tup_) {
       it_ = end_;
       return *this;
@@ -352,7 +404,7 @@ class TupleStreamIterator {
 
   friend bool operator==(TupleStreamIterator const& a,
                          TupleStreamIterator const& b) {
-    return a.it_ == b.it_;
+    return a.it_ == b.it_ && !a.source_ == !b.source_;
   }
 
   friend bool operator!=(TupleStreamIterator const& a,
@@ -366,9 +418,19 @@ class TupleStreamIterator {
     tup_ = *it_ ? std::move(*it_)->template get<Tuple>() : it_->status();
   }
 
+  void NextTuple() {
+    auto tup = source_();
+    if (!tup) {
+      source_ = nullptr;  // No more tuples to consume; become "end"
+      return;
+    }
+    tup_ = *std::move(tup);
+  }
+
   value_type tup_;
   RowStreamIterator it_;
   RowStreamIterator end_;
+  Source source_;  // Only used when iterating without `Row`s.
 };
 
 /**
@@ -411,11 +473,16 @@ class TupleStream {
  private:
   template <typename T, typename RowRange>
   friend TupleStream<T> StreamOf(RowRange&& range);
+  template <typename T>
+  friend TupleStream<T> StreamOf(RowStream& rows);
 
   template <typename It>
   explicit TupleStream(It&& start, It&& end)
       : begin_(std::forward<It>(start), std::forward<It>(end)) {}
 
+  explicit TupleStream(typename iterator::Source source)
+      : begin_(std::move(source)) {}
+
   iterator begin_;
   iterator end_;
 };
@@ -122,6 +122,19 @@ TEST(Row, GetByColumnName) {
   EXPECT_EQ(Value(true), *row.get("c"));
 }
 
+TEST(Row, GetByRepeatedColumnName) {
+  Row row = MakeTestRow({
+      {"a", Value(1)},  //
+      {"b", Value(2)},  //
+      {"a", Value(3)}   //
+  });
+
+  // Like SQL, a name that appears more than once refers to the first column.
+  EXPECT_EQ(Value(1), *row.get("a"));
+  EXPECT_EQ(Value(2), *row.get("b"));
+  EXPECT_EQ(Value(3), *row.get(2));
+}
+
 TEST(Row, TemplatedGetByPosition) {
   Row row = MakeTestRow(1, "blah", true);
 
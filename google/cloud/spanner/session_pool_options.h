@@ -61,6 +61,8 @@ class SessionPoolOptions {
     min_sessions_ =
         (std::min)(min_sessions_, max_sessions_per_channel_ * num_channels);
     max_idle_sessions_ = (std::max)(max_idle_sessions_, 0);
+    write_sessions_fraction_ =
+        (std::min)((std::max)(write_sessions_fraction_, 0.0), 1.0);
     return *this;
   }
 
@@ -93,6 +95,10 @@ class SessionPoolOptions {
   /**
    * Set the maximum number of sessions to keep in the pool in an idle state.
    * Values <= 0 are treated as 0.
+   *
+   * Sessions that are not used for a whole `keep_alive_interval()` are
+   * deleted, instead of refreshed, while the pool has more than this many
+   * sessions, and more than `min_sessions()`.
    */
   SessionPoolOptions& set_max_idle_sessions(int count) {
     max_idle_sessions_ = count;
@@ -102,6 +108,24 @@ class SessionPoolOptions {
   /// Return the maximum number of idle sessions to keep in the pool.
   int max_idle_sessions() const { return max_idle_sessions_; }
 
+  /**
+   * Set the fraction of the sessions to prepare for read-write transactions.
+   *
+   * The pool begins a read-write transaction in the background on this
+   * fraction of its sessions. A read-write transaction that commits without
+   * running any statements (e.g., `Client::Commit(Mutations)`) uses these
+   * prepared transactions, saving the `BeginTransaction` round trip.
+   * Values are clamped to the [0.0, 1.0] range, the default is 0.0, which
+   * disables this feature.
+   */
+  SessionPoolOptions& set_write_sessions_fraction(double fraction) {
+    write_sessions_fraction_ = fraction;
+    return *this;
+  }
+
+  /// Return the fraction of the sessions prepared for read-write transactions.
+  double write_sessions_fraction() const { return write_sessions_fraction_; }
+
   /// Set whether to block or fail on pool exhaustion.
   SessionPoolOptions& set_action_on_exhaustion(ActionOnExhaustion action) {
     action_on_exhaustion_ = action;
@@ -150,6 +174,7 @@ class SessionPoolOptions {
   int min_sessions_ = 0;
   int max_sessions_per_channel_ = 100;
   int max_idle_sessions_ = 0;
+  double write_sessions_fraction_ = 0.0;
   ActionOnExhaustion action_on_exhaustion_ = ActionOnExhaustion::kBlock;
   std::chrono::seconds keep_alive_interval_ = std::chrono::minutes(55);
   std::map<std::string, std::string> labels_;
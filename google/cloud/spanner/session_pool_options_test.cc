@@ -42,6 +42,20 @@ TEST(SessionPoolOptionsTest, MaxIdleSessions) {
   EXPECT_EQ(0, options.max_idle_sessions());
 }
 
+TEST(SessionPoolOptionsTest, WriteSessionsFraction) {
+  SessionPoolOptions options;
+  EXPECT_EQ(0.0, options.write_sessions_fraction());
+  options.set_write_sessions_fraction(-0.5).EnforceConstraints(
+      /*num_channels=*/1);
+  EXPECT_EQ(0.0, options.write_sessions_fraction());
+  options.set_write_sessions_fraction(1.5).EnforceConstraints(
+      /*num_channels=*/1);
+  EXPECT_EQ(1.0, options.write_sessions_fraction());
+  options.set_write_sessions_fraction(0.25).EnforceConstraints(
+      /*num_channels=*/1);
+  EXPECT_EQ(0.25, options.write_sessions_fraction());
+}
+
 TEST(SessionPoolOptionsTest, MaxMinSessionsConflict) {
   SessionPoolOptions options;
   options.set_min_sessions(10)
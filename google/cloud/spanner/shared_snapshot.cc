@@ -0,0 +1,80 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/shared_snapshot.h"
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+SharedSnapshot::SharedSnapshot(Client client, SharedSnapshotOptions options)
+    : client_(std::move(client)), options_(std::move(options)) {}
+
+RowStream SharedSnapshot::Read(std::string table, KeySet keys,
+                               std::vector<std::string> columns,
+                               ReadOptions read_options) {
+  bool starts_window;
+  auto opts = NextReadOptions(starts_window);
+  auto rows = client_.Read(std::move(opts), std::move(table), std::move(keys),
+                           std::move(columns), std::move(read_options));
+  if (starts_window) UpdateTimestamp(rows);
+  return rows;
+}
+
+RowStream SharedSnapshot::ExecuteQuery(SqlStatement statement,
+                                       QueryOptions const& opts) {
+  bool starts_window;
+  auto txn_opts = NextReadOptions(starts_window);
+  auto rows = client_.ExecuteQuery(std::move(txn_opts), std::move(statement),
+                                   opts);
+  if (starts_window) UpdateTimestamp(rows);
+  return rows;
+}
+
+absl::optional<Timestamp> SharedSnapshot::read_timestamp() {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (Clock::now() >= window_end_) return {};
+  return read_timestamp_;
+}
+
+Transaction::SingleUseOptions SharedSnapshot::NextReadOptions(
+    bool& starts_window) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (read_timestamp_ && Clock::now() < window_end_) {
+    starts_window = false;
+    return Transaction::ReadOnlyOptions(*read_timestamp_);
+  }
+  starts_window = true;
+  return Transaction::SingleUseOptions(options_.max_staleness());
+}
+
+void SharedSnapshot::UpdateTimestamp(RowStream const& rows) {
+  // The response metadata, and the timestamp in it, arrive with the first
+  // response of the stream, which `Read()` and `ExecuteQuery()` wait for.
+  auto timestamp = rows.ReadTimestamp();
+  if (!timestamp) return;
+  std::lock_guard<std::mutex> lk(mu_);
+  auto const now = Clock::now();
+  // Another read may have started the window first, keep its timestamp.
+  if (read_timestamp_ && now < window_end_) return;
+  read_timestamp_ = *timestamp;
+  window_end_ = now + options_.window();
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,132 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_SHARED_SNAPSHOT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_SHARED_SNAPSHOT_H
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/keys.h"
+#include "google/cloud/spanner/query_options.h"
+#include "google/cloud/spanner/read_options.h"
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/sql_statement.h"
+#include "google/cloud/spanner/timestamp.h"
+#include "google/cloud/spanner/transaction.h"
+#include "google/cloud/spanner/version.h"
+#include "absl/types/optional.h"
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Controls how often `SharedSnapshot` picks a new read timestamp.
+ */
+class SharedSnapshotOptions {
+ public:
+  /**
+   * How long the reads share a read timestamp.
+   *
+   * The first read after the window ends picks a new timestamp.
+   */
+  SharedSnapshotOptions& set_window(std::chrono::milliseconds window) {
+    window_ = window;
+    return *this;
+  }
+  std::chrono::milliseconds window() const { return window_; }
+
+  /**
+   * The staleness bound of the reads that pick a new read timestamp.
+   *
+   * Cloud Spanner picks the newest timestamp within this bound at which it
+   * can serve the read without blocking.
+   */
+  SharedSnapshotOptions& set_max_staleness(
+      std::chrono::nanoseconds max_staleness) {
+    max_staleness_ = max_staleness;
+    return *this;
+  }
+  std::chrono::nanoseconds max_staleness() const { return max_staleness_; }
+
+ private:
+  std::chrono::milliseconds window_ = std::chrono::seconds(1);
+  std::chrono::nanoseconds max_staleness_ = std::chrono::seconds(15);
+};
+
+/**
+ * Runs stale single-use reads at a read timestamp shared for a time window.
+ *
+ * A single-use read with a `max_staleness` bound lets Cloud Spanner pick its
+ * read timestamp. Applications that send many such reads can use this class
+ * instead. The first read in each `window()` uses the bound, and the
+ * timestamp Cloud Spanner picks for it is then used as the exact
+ * `read_timestamp` of the other reads in the window. The reads in a window
+ * observe the same snapshot of the database, and reads at the same timestamp
+ * are easier for the service to cache. The reads are still single-use
+ * transactions, so they run concurrently on different sessions of the pool.
+ *
+ * Reads that start while no timestamp is known for the window, for example
+ * while the first read is in progress, use the staleness bound as well.
+ *
+ * Instances of this class are safe to use from several threads.
+ *
+ * @par Example
+ * @code
+ * spanner::SharedSnapshot snapshot(
+ *     client, spanner::SharedSnapshotOptions().set_window(
+ *                 std::chrono::milliseconds(500)));
+ * auto rows = snapshot.Read("Albums", spanner::KeySet::All(), {"AlbumId"});
+ * @endcode
+ */
+class SharedSnapshot {
+ public:
+  explicit SharedSnapshot(
+      Client client, SharedSnapshotOptions options = SharedSnapshotOptions());
+
+  /// Reads in a single-use transaction at the current shared timestamp.
+  RowStream Read(std::string table, KeySet keys,
+                 std::vector<std::string> columns,
+                 ReadOptions read_options = {});
+
+  /// Runs the query in a single-use transaction at the current timestamp.
+  RowStream ExecuteQuery(SqlStatement statement, QueryOptions const& opts = {});
+
+  /// The read timestamp of the current window, if known.
+  absl::optional<Timestamp> read_timestamp();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  // The options for the next read, and whether it should set the timestamp.
+  Transaction::SingleUseOptions NextReadOptions(bool& starts_window);
+  void UpdateTimestamp(RowStream const& rows);
+
+  Client client_;
+  SharedSnapshotOptions const options_;
+  std::mutex mu_;
+  absl::optional<Timestamp> read_timestamp_;  // GUARDED_BY(mu_)
+  Clock::time_point window_end_;              // GUARDED_BY(mu_)
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_SHARED_SNAPSHOT_H
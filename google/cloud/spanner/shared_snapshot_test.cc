@@ -0,0 +1,141 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/shared_snapshot.h"
+#include "google/cloud/spanner/internal/transaction_impl.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "absl/memory/memory.h"
+#include "absl/time/time.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+namespace spanner_proto = ::google::spanner::v1;
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::testing::_;
+using ::testing::Return;
+
+// Returns the read-only options of a single-use transaction.
+spanner_proto::TransactionOptions::ReadOnly ReadOnlyOf(
+    Transaction const& txn) {
+  return internal::Visit(
+      txn, [](internal::SessionHolder&,
+              StatusOr<spanner_proto::TransactionSelector>& s, std::int64_t) {
+        EXPECT_TRUE(s && s->has_single_use());
+        return s ? s->single_use().read_only()
+                 : spanner_proto::TransactionOptions::ReadOnly{};
+      });
+}
+
+// Returns an empty stream read at @p seconds past the epoch, if not zero.
+RowStream MakeStream(std::int64_t seconds) {
+  auto source = absl::make_unique<MockResultSetSource>();
+  spanner_proto::ResultSetMetadata metadata;
+  if (seconds != 0) {
+    metadata.mutable_transaction()->mutable_read_timestamp()->set_seconds(
+        seconds);
+  }
+  EXPECT_CALL(*source, Metadata()).WillRepeatedly(Return(metadata));
+  EXPECT_CALL(*source, NextRow()).WillRepeatedly(Return(Row()));
+  return RowStream(std::move(source));
+}
+
+TEST(SharedSnapshotTest, ReadsShareTimestamp) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Read(_))
+      .WillOnce([](Connection::ReadParams const& params) {
+        auto ro = ReadOnlyOf(params.transaction);
+        EXPECT_EQ(std::chrono::seconds(5).count(),
+                  ro.max_staleness().seconds());
+        return MakeStream(1000);
+      })
+      .WillOnce([](Connection::ReadParams const& params) {
+        auto ro = ReadOnlyOf(params.transaction);
+        EXPECT_TRUE(ro.has_read_timestamp());
+        EXPECT_EQ(1000, ro.read_timestamp().seconds());
+        return MakeStream(1000);
+      });
+  EXPECT_CALL(*conn, ExecuteQuery(_))
+      .WillOnce([](Connection::SqlParams const& params) {
+        auto ro = ReadOnlyOf(params.transaction);
+        EXPECT_EQ(1000, ro.read_timestamp().seconds());
+        return MakeStream(1000);
+      });
+
+  SharedSnapshot snapshot(Client(conn),
+                          SharedSnapshotOptions()
+                              .set_window(std::chrono::hours(1))
+                              .set_max_staleness(std::chrono::seconds(5)));
+  EXPECT_FALSE(snapshot.read_timestamp().has_value());
+  snapshot.Read("T", KeySet::All(), {"C"});
+  auto timestamp = snapshot.read_timestamp();
+  ASSERT_TRUE(timestamp.has_value());
+  EXPECT_EQ(MakeTimestamp(absl::FromUnixSeconds(1000)).value(), *timestamp);
+  snapshot.Read("T", KeySet::All(), {"C"});
+  snapshot.ExecuteQuery(SqlStatement("SELECT C FROM T"));
+}
+
+TEST(SharedSnapshotTest, NewTimestampEachWindow) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery(_))
+      .WillOnce([](Connection::SqlParams const& params) {
+        EXPECT_TRUE(ReadOnlyOf(params.transaction).has_max_staleness());
+        return MakeStream(1000);
+      })
+      .WillOnce([](Connection::SqlParams const& params) {
+        EXPECT_TRUE(ReadOnlyOf(params.transaction).has_max_staleness());
+        return MakeStream(2000);
+      });
+
+  // With an empty window every read picks its own timestamp.
+  SharedSnapshot snapshot(
+      Client(conn),
+      SharedSnapshotOptions().set_window(std::chrono::milliseconds(0)));
+  auto rows = snapshot.ExecuteQuery(SqlStatement("SELECT 1"));
+  EXPECT_EQ(MakeTimestamp(absl::FromUnixSeconds(1000)).value(),
+            rows.ReadTimestamp());
+  rows = snapshot.ExecuteQuery(SqlStatement("SELECT 1"));
+  EXPECT_EQ(MakeTimestamp(absl::FromUnixSeconds(2000)).value(),
+            rows.ReadTimestamp());
+}
+
+TEST(SharedSnapshotTest, FailedReadDoesNotStartWindow) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Read(_))
+      .WillOnce([](Connection::ReadParams const&) { return MakeStream(0); })
+      .WillOnce([](Connection::ReadParams const& params) {
+        EXPECT_TRUE(ReadOnlyOf(params.transaction).has_max_staleness());
+        return MakeStream(0);
+      });
+
+  SharedSnapshot snapshot{Client(conn)};
+  snapshot.Read("T", KeySet::All(), {"C"});
+  EXPECT_FALSE(snapshot.read_timestamp().has_value());
+  snapshot.Read("T", KeySet::All(), {"C"});
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
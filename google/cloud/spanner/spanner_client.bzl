@@ -20,6 +20,7 @@ spanner_client_hdrs = [
     "backoff_policy.h",
     "backup.h",
     "batch_dml_result.h",
+    "bulk_mutation_loader.h",
     "bytes.h",
     "client.h",
     "client_options.h",
@@ -31,6 +32,7 @@ spanner_client_hdrs = [
     "database_admin_client.h",
     "database_admin_connection.h",
     "date.h",
+    "dml_batcher.h",
     "iam_updater.h",
     "instance.h",
     "instance_admin_client.h",
@@ -52,6 +54,7 @@ spanner_client_hdrs = [
     "internal/partial_result_set_reader.h",
     "internal/partial_result_set_resume.h",
     "internal/partial_result_set_source.h",
+    "internal/pipelined_result_source.h",
     "internal/polling_loop.h",
     "internal/retry_loop.h",
     "internal/session.h",
@@ -63,6 +66,7 @@ spanner_client_hdrs = [
     "keys.h",
     "mutations.h",
     "numeric.h",
+    "partition_executor.h",
     "partition_options.h",
     "partitioned_dml_result.h",
     "polling_policy.h",
@@ -74,6 +78,7 @@ spanner_client_hdrs = [
     "retry_policy.h",
     "row.h",
     "session_pool_options.h",
+    "shared_snapshot.h",
     "sql_statement.h",
     "timestamp.h",
     "tracing_options.h",
@@ -86,12 +91,15 @@ spanner_client_hdrs = [
 
 spanner_client_srcs = [
     "backup.cc",
+    "bulk_mutation_loader.cc",
     "bytes.cc",
     "client.cc",
+    "connection.cc",
     "connection_options.cc",
     "database.cc",
     "database_admin_client.cc",
     "database_admin_connection.cc",
+    "dml_batcher.cc",
     "instance.cc",
     "instance_admin_client.cc",
     "instance_admin_connection.cc",
@@ -109,6 +117,7 @@ spanner_client_srcs = [
     "internal/metadata_spanner_stub.cc",
     "internal/partial_result_set_resume.cc",
     "internal/partial_result_set_source.cc",
+    "internal/pipelined_result_source.cc",
     "internal/retry_loop.cc",
     "internal/session.cc",
     "internal/session_pool.cc",
@@ -118,11 +127,13 @@ spanner_client_srcs = [
     "keys.cc",
     "mutations.cc",
     "numeric.cc",
+    "partition_executor.cc",
     "partition_options.cc",
     "query_partition.cc",
     "read_partition.cc",
     "results.cc",
     "row.cc",
+    "shared_snapshot.cc",
     "sql_statement.cc",
     "timestamp.cc",
     "transaction.cc",
@@ -18,7 +18,9 @@
 
 spanner_client_benchmarks = [
     "bytes_benchmark.cc",
+    "internal/connection_impl_benchmark.cc",
     "internal/merge_chunk_benchmark.cc",
     "numeric_benchmark.cc",
     "row_benchmark.cc",
+    "timestamp_benchmark.cc",
 ]
@@ -18,6 +18,7 @@
 
 spanner_client_unit_tests = [
     "backup_test.cc",
+    "bulk_mutation_loader_test.cc",
     "bytes_test.cc",
     "client_options_test.cc",
     "client_test.cc",
@@ -26,6 +27,7 @@ spanner_client_unit_tests = [
     "database_admin_client_test.cc",
     "database_admin_connection_test.cc",
     "database_test.cc",
+    "dml_batcher_test.cc",
     "instance_admin_client_test.cc",
     "instance_admin_connection_test.cc",
     "instance_test.cc",
@@ -42,6 +44,7 @@ spanner_client_unit_tests = [
     "internal/metadata_spanner_stub_test.cc",
     "internal/partial_result_set_resume_test.cc",
     "internal/partial_result_set_source_test.cc",
+    "internal/pipelined_result_source_test.cc",
     "internal/polling_loop_test.cc",
     "internal/retry_loop_test.cc",
     "internal/session_pool_test.cc",
@@ -52,6 +55,7 @@ spanner_client_unit_tests = [
     "keys_test.cc",
     "mutations_test.cc",
     "numeric_test.cc",
+    "partition_executor_test.cc",
     "partition_options_test.cc",
     "query_options_test.cc",
     "query_partition_test.cc",
@@ -61,6 +65,7 @@ spanner_client_unit_tests = [
     "retry_policy_test.cc",
     "row_test.cc",
     "session_pool_options_test.cc",
+    "shared_snapshot_test.cc",
     "spanner_version_test.cc",
     "sql_statement_test.cc",
     "testing/cleanup_stale_databases_test.cc",
@@ -86,6 +86,13 @@ class MockSpannerStub : public google::cloud::spanner::internal::SpannerStub {
                    grpc::ClientContext&,
                    google::spanner::v1::ExecuteBatchDmlRequest const&));
 
+  MOCK_METHOD3(AsyncExecuteBatchDml,
+               std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+                   google::spanner::v1::ExecuteBatchDmlResponse>>(
+                   grpc::ClientContext&,
+                   google::spanner::v1::ExecuteBatchDmlRequest const&,
+                   grpc::CompletionQueue*));
+
   MOCK_METHOD2(Read, StatusOr<google::spanner::v1::ResultSet>(
                          grpc::ClientContext&,
                          google::spanner::v1::ReadRequest const&));
@@ -96,15 +103,36 @@ class MockSpannerStub : public google::cloud::spanner::internal::SpannerStub {
           grpc::ClientReaderInterface<google::spanner::v1::PartialResultSet>>(
           grpc::ClientContext&, google::spanner::v1::ReadRequest const&));
 
+  MOCK_METHOD3(AsyncRead,
+               std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+                   google::spanner::v1::ResultSet>>(
+                   grpc::ClientContext&,
+                   google::spanner::v1::ReadRequest const&,
+                   grpc::CompletionQueue*));
+
   MOCK_METHOD2(BeginTransaction,
                StatusOr<google::spanner::v1::Transaction>(
                    grpc::ClientContext&,
                    google::spanner::v1::BeginTransactionRequest const&));
 
+  MOCK_METHOD3(AsyncBeginTransaction,
+               std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+                   google::spanner::v1::Transaction>>(
+                   grpc::ClientContext&,
+                   google::spanner::v1::BeginTransactionRequest const&,
+                   grpc::CompletionQueue*));
+
   MOCK_METHOD2(Commit, StatusOr<google::spanner::v1::CommitResponse>(
                            grpc::ClientContext&,
                            google::spanner::v1::CommitRequest const&));
 
+  MOCK_METHOD3(AsyncCommit,
+               std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+                   google::spanner::v1::CommitResponse>>(
+                   grpc::ClientContext&,
+                   google::spanner::v1::CommitRequest const&,
+                   grpc::CompletionQueue*));
+
   MOCK_METHOD2(Rollback, Status(grpc::ClientContext&,
                                 google::spanner::v1::RollbackRequest const&));
 
@@ -13,8 +13,11 @@
 // limitations under the License.
 
 #include "google/cloud/spanner/timestamp.h"
+#include "google/cloud/internal/format_time_point.h"
+#include "google/cloud/internal/parse_rfc3339.h"
 #include "google/cloud/internal/time_utils.h"
 #include "google/cloud/status.h"
+#include <cstdint>
 #include <string>
 
 namespace google {
@@ -73,12 +76,18 @@ std::ostream& operator<<(std::ostream& os, Timestamp ts) {
 namespace internal {
 
 // Timestamp objects are always formatted in UTC, and we always format them
-// with a trailing 'Z'. However, we're a bit more liberal in the UTC offsets we
-// accept, thus the use of '%Ez' in kParseSpec.
-auto constexpr kFormatSpec = "%E4Y-%m-%dT%H:%M:%E*SZ";
+// with a trailing 'Z'. That is also the form Spanner returns, which is parsed
+// without going through absl. However, we're a bit more liberal in the UTC
+// offsets we accept, thus the use of '%Ez' in kParseSpec.
 auto constexpr kParseSpec = "%Y-%m-%dT%H:%M:%E*S%Ez";
 
 StatusOr<Timestamp> TimestampFromRFC3339(std::string const& s) {
+  std::int64_t seconds;
+  std::int32_t nanos;
+  if (google::cloud::internal::ParseCanonicalRfc3339(s, &seconds, &nanos)) {
+    return MakeTimestamp(absl::FromUnixSeconds(seconds) +
+                         absl::Nanoseconds(nanos));
+  }
   absl::Time t;
   std::string err;
   if (absl::ParseTime(kParseSpec, s, &t, &err)) return MakeTimestamp(t);
@@ -87,7 +96,11 @@ StatusOr<Timestamp> TimestampFromRFC3339(std::string const& s) {
 
 std::string TimestampToRFC3339(Timestamp ts) {
   auto const t = ts.get<absl::Time>().value();  // Cannot fail.
-  return absl::FormatTime(kFormatSpec, t, absl::UTCTimeZone());
+  auto const seconds = absl::ToUnixSeconds(t);  // Rounds toward the past.
+  auto const nanos =
+      (t - absl::FromUnixSeconds(seconds)) / absl::Nanoseconds(1);
+  return google::cloud::internal::FormatRfc3339(
+      seconds, static_cast<std::int32_t>(nanos));
 }
 
 StatusOr<Timestamp> TimestampFromProto(protobuf::Timestamp const& proto) {
@@ -36,6 +36,8 @@ template <typename T>
 Transaction MakeSingleUseTransaction(T&&);
 template <typename Functor>
 VisitInvokeResult<Functor> Visit(Transaction, Functor&&);
+template <typename Functor>
+VisitInvokeResult<Functor> AsyncVisit(Transaction, Functor&&);
 Transaction MakeTransactionFromIds(std::string session_id,
                                    std::string transaction_id);
 }  // namespace internal
@@ -167,6 +169,9 @@ class Transaction {
   template <typename Functor>
   friend internal::VisitInvokeResult<Functor> internal::Visit(Transaction,
                                                               Functor&&);
+  template <typename Functor>
+  friend internal::VisitInvokeResult<Functor> internal::AsyncVisit(
+      Transaction, Functor&&);
   friend Transaction internal::MakeTransactionFromIds(
       std::string session_id, std::string transaction_id);
 
@@ -227,6 +232,15 @@ VisitInvokeResult<Functor> Visit(Transaction txn, Functor&& f) {
   return txn.impl_->Visit(std::forward<Functor>(f));
 }
 
+// The continuation holds a reference to the transaction until the operation
+// completes, as the functor (and `TransactionImpl::AsyncVisit()`) use it.
+template <typename Functor>
+VisitInvokeResult<Functor> AsyncVisit(Transaction txn, Functor&& f) {
+  auto impl = std::move(txn.impl_);
+  return impl->AsyncVisit(std::forward<Functor>(f))
+      .then([impl](VisitInvokeResult<Functor> r) { return r.get(); });
+}
+
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
@@ -20,9 +20,11 @@
 #include <cmath>
 #include <cstdlib>
 #include <iomanip>
+#include <memory>
 #include <ios>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -31,6 +33,25 @@ inline namespace SPANNER_CLIENT_NS {
 
 namespace {
 
+auto constexpr kCommitTimestamp = "spanner.commit_timestamp()";
+
+std::string FormatDate(absl::CivilDay d) {
+  // absl::FormatCivilTime doesn't pad the year to 4-digits, which Spanner
+  // needs as part of its RFC-3339 requirement.
+  std::ostringstream ss;
+  ss << std::internal << std::setfill('0') << std::setw(4) << d.year() << '-';
+  ss << std::setfill('0') << std::setw(2) << d.month() << '-';
+  ss << std::setfill('0') << std::setw(2) << d.day();
+  return std::move(ss).str();
+}
+
+StatusOr<absl::CivilDay> ParseDate(std::string const& s) {
+  absl::CivilDay day;
+  if (absl::ParseCivilTime(s, &day)) return day;
+  return Status(StatusCode::kInvalidArgument,
+                s + ": Failed to match RFC3339 full-date");
+}
+
 // Compares two sets of Type and Value protos for equality. This method calls
 // itself recursively to compare subtypes and subvalues.
 bool Equal(google::spanner::v1::Type const& pt1,
@@ -186,21 +207,133 @@ std::ostream& StreamHelper(std::ostream& os, google::protobuf::Value const& v,
 namespace internal {
 
 Value FromProto(google::spanner::v1::Type t, google::protobuf::Value v) {
-  return Value(std::move(t), std::move(v));
+  return FromProto(Value::ShareType(std::move(t)), std::move(v));
+}
+
+Value FromProto(std::shared_ptr<google::spanner::v1::Type const> t,
+                google::protobuf::Value v) {
+  auto payload = Value::PayloadFromProto(t ? *t : Value::DefaultType(),
+                                         std::move(v));
+  return Value(std::move(t), std::move(payload));
 }
 
 std::pair<google::spanner::v1::Type, google::protobuf::Value> ToProto(Value v) {
-  return std::make_pair(std::move(v.type_), std::move(v.value_));
+  auto type = v.type();
+  return std::make_pair(std::move(type),
+                        Value::PayloadToProto(std::move(v.payload_)));
 }
 
 }  // namespace internal
 
 bool operator==(Value const& a, Value const& b) {
-  return Equal(a.type_, a.value_, b.type_, b.value_);
+  auto const* pa = absl::get_if<google::protobuf::Value>(&a.payload_);
+  auto const* pb = absl::get_if<google::protobuf::Value>(&b.payload_);
+  if (pa != nullptr && pb != nullptr) {
+    return Equal(a.type(), *pa, b.type(), *pb);
+  }
+  if (a.type().code() != b.type().code()) return false;
+  if (a.payload_.index() != b.payload_.index()) return false;
+  if (auto const* x = absl::get_if<bool>(&a.payload_)) {
+    return *x == absl::get<bool>(b.payload_);
+  }
+  if (auto const* x = absl::get_if<std::int64_t>(&a.payload_)) {
+    return *x == absl::get<std::int64_t>(b.payload_);
+  }
+  if (auto const* x = absl::get_if<double>(&a.payload_)) {
+    // NaN compares not equal, even to itself.
+    return *x == absl::get<double>(b.payload_);
+  }
+  if (auto const* x = absl::get_if<std::string>(&a.payload_)) {
+    return *x == absl::get<std::string>(b.payload_);
+  }
+  // Both are NULL, which may still differ in their ARRAY or STRUCT types.
+  return Equal(a.type(), Value::PayloadToProto(a.payload_), b.type(),
+               Value::PayloadToProto(b.payload_));
 }
 
 std::ostream& operator<<(std::ostream& os, Value const& v) {
-  return StreamHelper(os, v.value_, v.type_, StreamMode::kScalar);
+  auto const* pv = absl::get_if<google::protobuf::Value>(&v.payload_);
+  if (pv != nullptr) {
+    return StreamHelper(os, *pv, v.type(), StreamMode::kScalar);
+  }
+  return StreamHelper(os, Value::PayloadToProto(v.payload_), v.type(),
+                      StreamMode::kScalar);
+}
+
+google::spanner::v1::Type const& Value::DefaultType() {
+  static auto const* const kType = new google::spanner::v1::Type;
+  return *kType;
+}
+
+std::shared_ptr<google::spanner::v1::Type const> Value::ShareType(
+    google::spanner::v1::Type t) {
+  // A scalar type is fully described by its code, so there is a single,
+  // never destroyed, instance for each one. The returned pointers do not own
+  // these instances, so copying them does not touch a shared reference count.
+  static auto const* const kScalarTypes = [] {
+    auto* types = new std::vector<google::spanner::v1::Type>(
+        google::spanner::v1::TypeCode_MAX + 1);
+    for (std::size_t i = 0; i != types->size(); ++i) {
+      (*types)[i].set_code(static_cast<google::spanner::v1::TypeCode>(i));
+    }
+    return types;
+  }();
+  auto const code = static_cast<std::size_t>(t.code());
+  if (!t.has_array_element_type() && !t.has_struct_type() &&
+      code < kScalarTypes->size()) {
+    return std::shared_ptr<google::spanner::v1::Type const>(
+        std::shared_ptr<google::spanner::v1::Type const>{},
+        &(*kScalarTypes)[code]);
+  }
+  return std::make_shared<google::spanner::v1::Type const>(std::move(t));
+}
+
+Value::Payload Value::PayloadFromProto(google::spanner::v1::Type const& t,
+                                       google::protobuf::Value v) {
+  if (v.kind_case() == google::protobuf::Value::kNullValue) return Null{};
+  // Values that fail to decode stay as protos, so `get()` reports the error.
+  switch (t.code()) {
+    case google::spanner::v1::TypeCode::BOOL: {
+      auto b = GetValue(bool{}, v, t);
+      if (b) return *b;
+      break;
+    }
+    case google::spanner::v1::TypeCode::INT64: {
+      auto i = GetValue(std::int64_t{}, v, t);
+      if (i) return *i;
+      break;
+    }
+    case google::spanner::v1::TypeCode::FLOAT64: {
+      auto d = GetValue(double{}, v, t);
+      if (d) return *d;
+      break;
+    }
+    case google::spanner::v1::TypeCode::STRING:
+    case google::spanner::v1::TypeCode::BYTES:
+    case google::spanner::v1::TypeCode::NUMERIC:
+    case google::spanner::v1::TypeCode::TIMESTAMP:
+    case google::spanner::v1::TypeCode::DATE:
+      if (v.kind_case() == google::protobuf::Value::kStringValue) {
+        return std::move(*v.mutable_string_value());
+      }
+      break;
+    default:
+      break;
+  }
+  return v;
+}
+
+google::protobuf::Value Value::PayloadToProto(Payload p) {
+  if (auto* v = absl::get_if<google::protobuf::Value>(&p)) return std::move(*v);
+  if (auto const* b = absl::get_if<bool>(&p)) return MakeValueProto(*b);
+  if (auto const* i = absl::get_if<std::int64_t>(&p)) return MakeValueProto(*i);
+  if (auto const* d = absl::get_if<double>(&p)) return MakeValueProto(*d);
+  if (auto* s = absl::get_if<std::string>(&p)) {
+    return MakeValueProto(std::move(*s));
+  }
+  google::protobuf::Value v;
+  v.set_null_value(google::protobuf::NullValue::NULL_VALUE);
+  return v;
 }
 
 //
@@ -311,6 +444,26 @@ google::spanner::v1::Type Value::MakeTypeProto(char const*) {
   return MakeTypeProto(std::string{});
 }
 
+//
+// Value::MakePayload
+//
+
+Value::Payload Value::MakePayload(Bytes b) {
+  return internal::BytesToBase64(std::move(b));
+}
+
+Value::Payload Value::MakePayload(Numeric n) { return std::move(n).ToString(); }
+
+Value::Payload Value::MakePayload(Timestamp ts) {
+  return internal::TimestampToRFC3339(ts);
+}
+
+Value::Payload Value::MakePayload(CommitTimestamp) {
+  return std::string(kCommitTimestamp);
+}
+
+Value::Payload Value::MakePayload(absl::CivilDay d) { return FormatDate(d); }
+
 //
 // Value::MakeValueProto
 //
@@ -365,19 +518,13 @@ google::protobuf::Value Value::MakeValueProto(Timestamp ts) {
 
 google::protobuf::Value Value::MakeValueProto(CommitTimestamp) {
   google::protobuf::Value v;
-  v.set_string_value("spanner.commit_timestamp()");
+  v.set_string_value(kCommitTimestamp);
   return v;
 }
 
 google::protobuf::Value Value::MakeValueProto(absl::CivilDay d) {
   google::protobuf::Value v;
-  // absl::FormatCivilTime doesn't pad the year to 4-digits, which Spanner
-  // needs as part of its RFC-3339 requirement.
-  std::ostringstream ss;
-  ss << std::internal << std::setfill('0') << std::setw(4) << d.year() << '-';
-  ss << std::setfill('0') << std::setw(2) << d.month() << '-';
-  ss << std::setfill('0') << std::setw(2) << d.day();
-  v.set_string_value(std::move(ss).str());
+  v.set_string_value(FormatDate(d));
   return v;
 }
 
@@ -474,7 +621,7 @@ StatusOr<Numeric> Value::GetValue(Numeric const&,
   if (pv.kind_case() != google::protobuf::Value::kStringValue) {
     return Status(StatusCode::kUnknown, "missing NUMERIC");
   }
-  auto decoded = MakeNumeric(pv.string_value());
+  auto decoded = internal::ParseNumeric(pv.string_value());
   if (!decoded) return decoded.status();
   return *decoded;
 }
@@ -492,7 +639,7 @@ StatusOr<CommitTimestamp> Value::GetValue(CommitTimestamp,
                                           google::protobuf::Value const& pv,
                                           google::spanner::v1::Type const&) {
   if (pv.kind_case() != google::protobuf::Value::kStringValue ||
-      pv.string_value() != "spanner.commit_timestamp()") {
+      pv.string_value() != kCommitTimestamp) {
     return Status(StatusCode::kUnknown, "invalid commit_timestamp");
   }
   return CommitTimestamp{};
@@ -504,11 +651,82 @@ StatusOr<absl::CivilDay> Value::GetValue(absl::CivilDay,
   if (pv.kind_case() != google::protobuf::Value::kStringValue) {
     return Status(StatusCode::kUnknown, "missing DATE");
   }
-  auto const& s = pv.string_value();
-  absl::CivilDay day;
-  if (absl::ParseCivilTime(s, &day)) return day;
-  return Status(StatusCode::kInvalidArgument,
-                s + ": Failed to match RFC3339 full-date");
+  return ParseDate(pv.string_value());
+}
+
+//
+// Value::GetScalar
+//
+
+StatusOr<bool> Value::GetScalar(ScalarTag<bool>, Payload const& p) {
+  auto const* b = absl::get_if<bool>(&p);
+  if (b == nullptr) return Status(StatusCode::kUnknown, "missing BOOL");
+  return *b;
+}
+
+StatusOr<std::int64_t> Value::GetScalar(ScalarTag<std::int64_t>,
+                                         Payload const& p) {
+  auto const* i = absl::get_if<std::int64_t>(&p);
+  if (i == nullptr) return Status(StatusCode::kUnknown, "missing INT64");
+  return *i;
+}
+
+StatusOr<double> Value::GetScalar(ScalarTag<double>, Payload const& p) {
+  auto const* d = absl::get_if<double>(&p);
+  if (d == nullptr) return Status(StatusCode::kUnknown, "missing FLOAT64");
+  return *d;
+}
+
+StatusOr<std::string> Value::GetScalar(ScalarTag<std::string>,
+                                        Payload const& p) {
+  auto const* s = absl::get_if<std::string>(&p);
+  if (s == nullptr) return Status(StatusCode::kUnknown, "missing STRING");
+  return *s;
+}
+
+StatusOr<std::string> Value::GetScalar(ScalarTag<std::string>, Payload&& p) {
+  auto* s = absl::get_if<std::string>(&p);
+  if (s == nullptr) return Status(StatusCode::kUnknown, "missing STRING");
+  return std::move(*s);
+}
+
+StatusOr<Bytes> Value::GetScalar(ScalarTag<Bytes>, Payload const& p) {
+  auto const* s = absl::get_if<std::string>(&p);
+  if (s == nullptr) return Status(StatusCode::kUnknown, "missing BYTES");
+  auto decoded = internal::BytesFromBase64(*s);
+  if (!decoded) return decoded.status();
+  return *decoded;
+}
+
+StatusOr<Numeric> Value::GetScalar(ScalarTag<Numeric>, Payload const& p) {
+  auto const* s = absl::get_if<std::string>(&p);
+  if (s == nullptr) return Status(StatusCode::kUnknown, "missing NUMERIC");
+  auto decoded = internal::ParseNumeric(*s);
+  if (!decoded) return decoded.status();
+  return *decoded;
+}
+
+StatusOr<Timestamp> Value::GetScalar(ScalarTag<Timestamp>,
+                                      Payload const& p) {
+  auto const* s = absl::get_if<std::string>(&p);
+  if (s == nullptr) return Status(StatusCode::kUnknown, "missing TIMESTAMP");
+  return internal::TimestampFromRFC3339(*s);
+}
+
+StatusOr<CommitTimestamp> Value::GetScalar(ScalarTag<CommitTimestamp>,
+                                            Payload const& p) {
+  auto const* s = absl::get_if<std::string>(&p);
+  if (s == nullptr || *s != kCommitTimestamp) {
+    return Status(StatusCode::kUnknown, "invalid commit_timestamp");
+  }
+  return CommitTimestamp{};
+}
+
+StatusOr<absl::CivilDay> Value::GetScalar(ScalarTag<absl::CivilDay>,
+                                           Payload const& p) {
+  auto const* s = absl::get_if<std::string>(&p);
+  if (s == nullptr) return Status(StatusCode::kUnknown, "missing DATE");
+  return ParseDate(*s);
 }
 
 }  // namespace SPANNER_CLIENT_NS
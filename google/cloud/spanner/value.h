@@ -26,9 +26,12 @@
 #include "google/cloud/status_or.h"
 #include "absl/time/civil_time.h"
 #include "absl/types/optional.h"
+#include "absl/types/variant.h"
 #include <google/protobuf/struct.pb.h>
 #include <google/protobuf/util/message_differencer.h>
 #include <google/spanner/v1/type.pb.h>
+#include <cstdint>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <tuple>
@@ -45,7 +48,14 @@ class Value;  // Defined later in this file.
 // Internal implementation details that callers should not use.
 namespace internal {
 Value FromProto(google::spanner::v1::Type t, google::protobuf::Value v);
+Value FromProto(std::shared_ptr<google::spanner::v1::Type const> t,
+                google::protobuf::Value v);
 std::pair<google::spanner::v1::Type, google::protobuf::Value> ToProto(Value v);
+template <typename T>
+bool TypeMatches(google::spanner::v1::Type const& t);
+template <typename T>
+StatusOr<T> DecodeValue(google::spanner::v1::Type const& t,
+                        google::protobuf::Value&& v);
 }  // namespace internal
 
 /**
@@ -294,26 +304,29 @@ class Value {
    */
   template <typename T>
   StatusOr<T> get() const& {
-    if (!TypeProtoIs(T{}, type_))
+    if (!TypeProtoIs(T{}, type()))
       return Status(StatusCode::kUnknown, "wrong type");
-    if (value_.kind_case() == google::protobuf::Value::kNullValue) {
+    if (absl::holds_alternative<Null>(payload_)) {
       if (IsOptional<T>::value) return T{};
       return Status(StatusCode::kUnknown, "null value");
     }
-    return GetValue(T{}, value_, type_);
+    auto const* pv = absl::get_if<google::protobuf::Value>(&payload_);
+    if (pv != nullptr) return GetValue(T{}, *pv, type());
+    return GetScalar(ScalarTag<T>{}, payload_);
   }
 
   /// @copydoc get()
   template <typename T>
   StatusOr<T> get() && {
-    if (!TypeProtoIs(T{}, type_))
+    if (!TypeProtoIs(T{}, type()))
       return Status(StatusCode::kUnknown, "wrong type");
-    if (value_.kind_case() == google::protobuf::Value::kNullValue) {
+    if (absl::holds_alternative<Null>(payload_)) {
       if (IsOptional<T>::value) return T{};
       return Status(StatusCode::kUnknown, "null value");
     }
-    auto tag = T{};  // Works around an odd msvc issue
-    return GetValue(std::move(tag), std::move(value_), type_);
+    auto* pv = absl::get_if<google::protobuf::Value>(&payload_);
+    if (pv != nullptr) return Decode<T>(std::move(*pv), type());
+    return GetScalar(ScalarTag<T>{}, std::move(payload_));
   }
 
   /**
@@ -339,6 +352,34 @@ class Value {
   friend void PrintTo(Value const& v, std::ostream* os) { *os << v; }
 
  private:
+  // A Spanner NULL of type `type_`.
+  struct Null {};
+
+  // The value in its most compact form. Nulls and scalars are held directly:
+  // BOOL, INT64, and FLOAT64 values as their C++ type, and STRING, BYTES,
+  // NUMERIC, TIMESTAMP, and DATE values as their (string) wire encoding.
+  // ARRAY and STRUCT values, and anything that does not match its type, are
+  // held as the `google.protobuf.Value` they are sent as. The protos for
+  // scalars are only built by `internal::ToProto()`.
+  using Payload = absl::variant<google::protobuf::Value, Null, bool,
+                                std::int64_t, double, std::string>;
+
+  // Returns the type, which is unspecified for default constructed values.
+  google::spanner::v1::Type const& type() const {
+    return type_ ? *type_ : DefaultType();
+  }
+  static google::spanner::v1::Type const& DefaultType();
+
+  // Returns a shared instance of `t`. All the values of a scalar type share
+  // the same instance.
+  static std::shared_ptr<google::spanner::v1::Type const> ShareType(
+      google::spanner::v1::Type t);
+
+  // Converts between `Payload` and the `google.protobuf.Value` wire format.
+  static Payload PayloadFromProto(google::spanner::v1::Type const& t,
+                                  google::protobuf::Value v);
+  static google::protobuf::Value PayloadToProto(Payload p);
+
   // Metafunction that returns true if `T` is an absl::optional<U>
   template <typename T>
   struct IsOptional : std::false_type {};
@@ -351,6 +392,19 @@ class Value {
   template <typename... Ts>
   struct IsVector<std::vector<Ts...>> : std::true_type {};
 
+  // Converts `pv`, whose type must already have been checked against `T`, to
+  // the corresponding C++ type, moving any strings out of it.
+  template <typename T>
+  static StatusOr<T> Decode(google::protobuf::Value&& pv,
+                            google::spanner::v1::Type const& pt) {
+    if (pv.kind_case() == google::protobuf::Value::kNullValue) {
+      if (IsOptional<T>::value) return T{};
+      return Status(StatusCode::kUnknown, "null value");
+    }
+    auto tag = T{};  // Works around an odd msvc issue
+    return GetValue(std::move(tag), std::move(pv), pt);
+  }
+
   // Tag-dispatch overloads to check if a C++ type matches the type specified
   // by the given `Type` proto.
   static bool TypeProtoIs(bool, google::spanner::v1::Type const&);
@@ -459,6 +513,33 @@ class Value {
     }
   };
 
+  // Tag-dispatch overloads to convert a C++ type to its `Payload`. Scalars
+  // are encoded as in the `Value` proto, see `MakeValueProto()` below.
+  static Payload MakePayload(bool b) { return b; }
+  static Payload MakePayload(std::int64_t i) { return i; }
+  static Payload MakePayload(double d) { return d; }
+  static Payload MakePayload(std::string s) { return s; }
+  static Payload MakePayload(Bytes b);
+  static Payload MakePayload(Numeric n);
+  static Payload MakePayload(Timestamp ts);
+  static Payload MakePayload(CommitTimestamp ts);
+  static Payload MakePayload(absl::CivilDay d);
+  static Payload MakePayload(int i) { return std::int64_t{i}; }
+  static Payload MakePayload(char const* s) { return std::string(s); }
+  template <typename T>
+  static Payload MakePayload(absl::optional<T> opt) {
+    if (opt.has_value()) return MakePayload(*std::move(opt));
+    return Null{};
+  }
+  template <typename T>
+  static Payload MakePayload(std::vector<T> vec) {
+    return MakeValueProto(std::move(vec));
+  }
+  template <typename... Ts>
+  static Payload MakePayload(std::tuple<Ts...> tup) {
+    return MakeValueProto(std::move(tup));
+  }
+
   // Encodes the argument as a protobuf according to the rules described in
   // https://github.com/googleapis/googleapis/blob/master/google/spanner/v1/type.proto
   static google::protobuf::Value MakeValueProto(bool b);
@@ -579,6 +660,45 @@ class Value {
     return tup;
   }
 
+  // Tag-dispatch overloads to extract a C++ value from a scalar `Payload`.
+  // Arrays and structs are always held as protos, so they never use these
+  // overloads. The tag is an empty type, rather than a `T{}` value, so that
+  // the overloads cannot match through conversions between the C++ types
+  // (e.g., a zero `std::int64_t` to a `std::string`).
+  template <typename T>
+  struct ScalarTag {};
+  static StatusOr<bool> GetScalar(ScalarTag<bool>, Payload const&);
+  static StatusOr<std::int64_t> GetScalar(ScalarTag<std::int64_t>,
+                                          Payload const&);
+  static StatusOr<double> GetScalar(ScalarTag<double>, Payload const&);
+  static StatusOr<std::string> GetScalar(ScalarTag<std::string>,
+                                         Payload const&);
+  static StatusOr<std::string> GetScalar(ScalarTag<std::string>, Payload&&);
+  static StatusOr<Bytes> GetScalar(ScalarTag<Bytes>, Payload const&);
+  static StatusOr<Numeric> GetScalar(ScalarTag<Numeric>, Payload const&);
+  static StatusOr<Timestamp> GetScalar(ScalarTag<Timestamp>, Payload const&);
+  static StatusOr<CommitTimestamp> GetScalar(ScalarTag<CommitTimestamp>,
+                                             Payload const&);
+  static StatusOr<absl::CivilDay> GetScalar(ScalarTag<absl::CivilDay>,
+                                            Payload const&);
+  template <typename T, typename P>
+  static StatusOr<absl::optional<T>> GetScalar(ScalarTag<absl::optional<T>>,
+                                               P&& p) {
+    auto value = GetScalar(ScalarTag<T>{}, std::forward<P>(p));
+    if (!value) return std::move(value).status();
+    return absl::optional<T>{*std::move(value)};
+  }
+  template <typename T>
+  static StatusOr<std::vector<T>> GetScalar(ScalarTag<std::vector<T>>,
+                                            Payload const&) {
+    return Status(StatusCode::kUnknown, "missing ARRAY");
+  }
+  template <typename... Ts>
+  static StatusOr<std::tuple<Ts...>> GetScalar(ScalarTag<std::tuple<Ts...>>,
+                                               Payload const&) {
+    return Status(StatusCode::kUnknown, "missing STRUCT");
+  }
+
   // A functor to be used with internal::ForEach to extract C++ types from a
   // ListValue proto and store then in a tuple.
   template <typename V>
@@ -628,26 +748,35 @@ class Value {
   }
 
   // A private templated constructor that is called by all the public
-  // constructors to set the type_ and value_ members. The `PrivateConstructor`
-  // type is used so that this overload is never chosen for
+  // constructors to set the type_ and payload_ members. The
+  // `PrivateConstructor` type is used so that this overload is never chosen for
   // non-member/non-friend callers. Otherwise, since visibility restrictions
   // apply after overload resolution, users could get weird error messages if
   // this constructor matched their arguments best.
   struct PrivateConstructor {};
   template <typename T>
   Value(PrivateConstructor, T&& t)
-      : type_(MakeTypeProto(t)), value_(MakeValueProto(std::forward<T>(t))) {}
+      : type_(ShareType(MakeTypeProto(t))),
+        payload_(MakePayload(std::forward<T>(t))) {}
 
-  Value(google::spanner::v1::Type t, google::protobuf::Value v)
-      : type_(std::move(t)), value_(std::move(v)) {}
+  Value(std::shared_ptr<google::spanner::v1::Type const> t, Payload p)
+      : type_(std::move(t)), payload_(std::move(p)) {}
 
   friend Value internal::FromProto(google::spanner::v1::Type,
                                    google::protobuf::Value);
+  friend Value internal::FromProto(
+      std::shared_ptr<google::spanner::v1::Type const>,
+      google::protobuf::Value);
   friend std::pair<google::spanner::v1::Type, google::protobuf::Value>
       internal::ToProto(Value);
+  template <typename T>
+  friend bool internal::TypeMatches(google::spanner::v1::Type const&);
+  template <typename T>
+  friend StatusOr<T> internal::DecodeValue(google::spanner::v1::Type const&,
+                                           google::protobuf::Value&&);
 
-  google::spanner::v1::Type type_;
-  google::protobuf::Value value_;
+  std::shared_ptr<google::spanner::v1::Type const> type_;
+  Payload payload_;
 };
 
 /**
@@ -662,6 +791,27 @@ Value MakeNullValue() {
   return Value(absl::optional<T>{});
 }
 
+namespace internal {
+
+/// Returns true if a `Value` of type @p t can be converted to a `T`.
+template <typename T>
+bool TypeMatches(google::spanner::v1::Type const& t) {
+  return Value::TypeProtoIs(T{}, t);
+}
+
+/**
+ * Converts @p v, of the Spanner type @p t, directly to a `T` without building
+ * a `Value`. The caller must have checked `TypeMatches<T>(t)`. Strings and
+ * bytes are moved out of @p v.
+ */
+template <typename T>
+StatusOr<T> DecodeValue(google::spanner::v1::Type const& t,
+                        google::protobuf::Value&& v) {
+  return Value::Decode<T>(std::move(v), t);
+}
+
+}  // namespace internal
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
 }  // namespace cloud
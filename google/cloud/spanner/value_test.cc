@@ -22,6 +22,7 @@
 #include <cmath>
 #include <ios>
 #include <limits>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -609,6 +610,25 @@ TEST(Value, ProtoConversionInt64) {
   }
 }
 
+TEST(Value, ProtoConversionSharedType) {
+  // Values decoded from a result set share one `Type` per column.
+  auto const type = std::make_shared<google::spanner::v1::Type const>(
+      internal::ToProto(Value(std::vector<std::int64_t>{})).first);
+  for (auto const& vec : std::vector<std::vector<std::int64_t>>{
+           {}, {1}, {1, 2, 3}}) {
+    auto const v =
+        internal::FromProto(type, internal::ToProto(Value(vec)).second);
+    EXPECT_EQ(Value(vec), v);
+    EXPECT_EQ(vec, *v.get<std::vector<std::int64_t>>());
+    auto const p = internal::ToProto(v);
+    EXPECT_THAT(p.first, IsProtoEqual(*type));
+  }
+
+  auto const null = MakeNullValue<std::vector<std::int64_t>>();
+  EXPECT_EQ(null,
+            internal::FromProto(type, internal::ToProto(null).second));
+}
+
 TEST(Value, ProtoConversionFloat64) {
   for (auto x : {-1.0, -0.5, 0.0, 0.5, 1.0}) {
     Value const v(x);
@@ -121,7 +121,12 @@ std::chrono::system_clock::time_point ParseTimestampField(
   if (json.count(field_name) == 0) {
     return std::chrono::system_clock::time_point{};
   }
-  return google::cloud::internal::ParseRfc3339(json[field_name]);
+  auto const& f = json[field_name];
+  if (f.is_string()) {
+    return google::cloud::internal::ParseRfc3339(
+        f.get_ref<std::string const&>());
+  }
+  return google::cloud::internal::ParseRfc3339(f);
 }
 
 }  // namespace internal